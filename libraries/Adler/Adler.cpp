@@ -1,7 +1,7 @@
 //
 //    FILE: Adler.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.2.2
+// VERSION: 0.2.4
 //    DATE: 2022-01-27
 // PURPOSE: Arduino Library for calculating Adler checksum
 //     URL: https://github.com/RobTillaart/Adler
@@ -16,11 +16,11 @@
 //
 //  STATIC FUNCTION
 //
-uint32_t adler32(uint8_t * array, uint16_t length)
+uint32_t adler32(const uint8_t * array, size_t length)
 {
   uint32_t s1 = 1;
   uint32_t s2 = 0;
-  for (uint16_t i = 0; i < length;)
+  for (size_t i = 0; i < length;)
   {
     // if S2 is halfway it is time to do modulo
     while ((i < length) && (s2 < 2147483648ULL))
@@ -35,11 +35,11 @@ uint32_t adler32(uint8_t * array, uint16_t length)
 }
 
 
-uint16_t adler16(uint8_t * array, uint16_t length)
+uint16_t adler16(const uint8_t * array, size_t length)
 {
   uint16_t s1 = 1;
   uint16_t s2 = 0;
-  for (uint16_t i = 0; i < length;)
+  for (size_t i = 0; i < length;)
   {
     // if S2 is halfway it is time to do modulo
     while ((i < length) && (s2 < 32768))
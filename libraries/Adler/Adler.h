@@ -2,7 +2,7 @@
 //
 //    FILE: Adler.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.2.2
+// VERSION: 0.2.4
 //    DATE: 2022-01-27
 // PURPOSE: Arduino Library for calculating Adler checksum
 //     URL: https://github.com/RobTillaart/Adler
@@ -12,7 +12,7 @@
 #include "Arduino.h"
 
 
-#define ADLER_LIB_VERSION        (F("0.2.2"))
+#define ADLER_LIB_VERSION        (F("0.2.4"))
 
 
 const uint32_t ADLER32_MOD_PRIME = 65521;
@@ -23,8 +23,8 @@ const uint16_t ADLER16_MOD_PRIME = 251;
 //
 //  STATIC FUNCTIONS
 //
-uint32_t adler32(uint8_t *data, uint16_t length);
-uint16_t adler16(uint8_t *data, uint16_t length);
+uint32_t adler32(const uint8_t *data, size_t length);
+uint16_t adler16(const uint8_t *data, size_t length);
 
 
 // -- END OF FILE -- 
@@ -1,7 +1,7 @@
 //
 //    FILE: Adler16.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.2.2
+// VERSION: 0.2.4
 //    DATE: 2022-06-14
 // PURPOSE: Arduino Library for calculating Adler-16 checksum
 //     URL: https://github.com/RobTillaart/Adler
@@ -56,7 +56,7 @@ void Adler16::add(uint8_t value)
 //  straightforward going through the array.
 //  small footprint
 //  returns current Adler value
-uint16_t Adler16::add(uint8_t * array, uint16_t length)
+uint16_t Adler16::add(const uint8_t * array, size_t length)
 {
   while (length--)
   {
@@ -72,12 +72,12 @@ uint16_t Adler16::add(uint8_t * array, uint16_t length)
 //  only do modulo when S2 reaches halfway uint16_t
 //                      and at the end of the loop.
 //  returns current Adler value
-uint16_t Adler16::addFast(uint8_t * array, uint16_t length)
+uint16_t Adler16::addFast(const uint8_t * array, size_t length)
 {
   _count += length;
   uint16_t s1 = _s1;
   uint16_t s2 = _s2;
-  for (uint16_t i = 0; i < length;)
+  for (size_t i = 0; i < length;)
   {
     // if S2 is halfway it is time to do modulo
     while ((i < length) && (s2 < 32768))
@@ -119,15 +119,15 @@ void Adler16::add(char value)
 }
 
 
-uint16_t Adler16::add(char * array, uint16_t length)
+uint16_t Adler16::add(const char * array, size_t length)
 {
-  return add((uint8_t *) array, length);
+  return add((const uint8_t *) array, length);
 }
 
 
-uint16_t Adler16::addFast(char * array, uint16_t length)
+uint16_t Adler16::addFast(const char * array, size_t length)
 {
-  return addFast((uint8_t *) array, length);
+  return addFast((const uint8_t *) array, length);
 }
 
 
@@ -2,7 +2,7 @@
 //
 //    FILE: Adler16.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.2.2
+// VERSION: 0.2.4
 //    DATE: 2022-06-15
 // PURPOSE: Arduino Library for calculating Adler-16 checksum
 //     URL: https://github.com/RobTillaart/Adler
@@ -13,7 +13,7 @@
 #include "Arduino.h"
 
 
-#define ADLER16_LIB_VERSION              (F("0.2.2"))
+#define ADLER16_LIB_VERSION              (F("0.2.4"))
 
 
 //  largest prime below 2^8
@@ -28,17 +28,17 @@ public:
 
   void     add(uint8_t value);
   //  returns current Adler value
-  uint16_t add(uint8_t * array, uint16_t length);
+  uint16_t add(const uint8_t * array, size_t length);
   //  trade PROGMEM for speed
   //  returns current Adler value
-  uint16_t addFast(uint8_t * array, uint16_t length);
+  uint16_t addFast(const uint8_t * array, size_t length);
 
   //  wrappers for strings
   void     add(char value);
   //  returns current Adler value
-  uint16_t add(char * array, uint16_t length);
+  uint16_t add(const char * array, size_t length);
   //  returns current Adler value
-  uint16_t addFast(char * array, uint16_t length);
+  uint16_t addFast(const char * array, size_t length);
 
   //  returns current Adler value
   uint16_t getAdler();
@@ -1,7 +1,7 @@
 //
 //    FILE: Adler32.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.2.2
+// VERSION: 0.2.4
 //    DATE: 2022-01-27
 // PURPOSE: Arduino Library for calculating Adler-32 checksum
 //     URL: https://github.com/RobTillaart/Adler
@@ -13,6 +13,22 @@
 #include "Adler32.h"
 
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#define ADLER32_SSE2
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define ADLER32_NEON
+#include <arm_neon.h>
+#endif
+
+
+//  largest n such that 255 n(n+1)/2 + (n+1)(ADLER32_MOD_PRIME - 1) < 2^32
+//  so s2 can not overflow within a block of n bytes.  (zlib)
+#define ADLER32_NMAX                5552
+
+
 Adler32::Adler32()
 {
   begin(1, 0);
@@ -55,40 +71,212 @@ void Adler32::add(uint8_t value)
 //  straightforward going through the array.
 //  small footprint.
 //  returns current Adler value
-uint32_t Adler32::add(uint8_t * array, uint16_t length)
+uint32_t Adler32::add(const uint8_t * array, size_t length)
 {
   while (length--)
   {
     add(*array++);
   }
-  return (_s2 << 16) | _s1;
+  return getAdler();
 }
 
 
+//////////////////////////////////////////////////////////////
+//
+//  BLOCK KERNELS for addFast()
+//
+//  s1 and s2 are < ADLER32_MOD_PRIME on entry and on exit.
+//  length <= ADLER32_NMAX, so modulo is only needed at the end.
+//
+//  The SIMD versions process K chunks of L bytes using
+//    s1 += sum(x[i])
+//    s2 += L * K * s1 + L * sum(s1 before chunk k) + sum((L - i) * x[i])
+//
+static void _adler32_block(uint32_t &s1, uint32_t &s2, const uint8_t * array, size_t length)
+{
+  uint32_t a = s1;
+  uint32_t b = s2;
+  //  unrolled, no multiplications needed, also fast on 8 and 32 bit MCU's.
+  while (length >= 8)
+  {
+    a += array[0]; b += a;
+    a += array[1]; b += a;
+    a += array[2]; b += a;
+    a += array[3]; b += a;
+    a += array[4]; b += a;
+    a += array[5]; b += a;
+    a += array[6]; b += a;
+    a += array[7]; b += a;
+    array  += 8;
+    length -= 8;
+  }
+  while (length--)
+  {
+    a += *array++;
+    b += a;
+  }
+  s1 = a % ADLER32_MOD_PRIME;
+  s2 = b % ADLER32_MOD_PRIME;
+}
+
+
+#if defined(ADLER32_SSE2)
+
+static uint64_t _hsum32(__m128i v)
+{
+  uint32_t t[4];
+  _mm_storeu_si128((__m128i *) t, v);
+  return (uint64_t)t[0] + t[1] + t[2] + t[3];
+}
+
+
+static void _adler32_sse2(uint32_t &s1, uint32_t &s2, const uint8_t * array, size_t length)
+{
+  const size_t  chunks = length / 16;
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i wlo  = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+  const __m128i whi  = _mm_setr_epi16( 8,  7,  6,  5,  4,  3,  2, 1);
+  __m128i vs1 = zero;
+  __m128i vps = zero;
+  __m128i vs2 = zero;
+  for (size_t k = 0; k < chunks; k++)
+  {
+    __m128i v = _mm_loadu_si128((const __m128i *) array);
+    array += 16;
+    vps = _mm_add_epi32(vps, vs1);
+    vs1 = _mm_add_epi32(vs1, _mm_sad_epu8(v, zero));
+    vs2 = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_unpacklo_epi8(v, zero), wlo));
+    vs2 = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_unpackhi_epi8(v, zero), whi));
+  }
+  uint64_t a = s1 + _hsum32(vs1);
+  uint64_t b = s2 + (uint64_t)s1 * chunks * 16 + 16 * _hsum32(vps) + _hsum32(vs2);
+  length -= chunks * 16;
+  while (length--)
+  {
+    a += *array++;
+    b += a;
+  }
+  s1 = a % ADLER32_MOD_PRIME;
+  s2 = b % ADLER32_MOD_PRIME;
+}
+
+
+__attribute__((target("avx2")))
+static void _adler32_avx2(uint32_t &s1, uint32_t &s2, const uint8_t * array, size_t length)
+{
+  const size_t  chunks = length / 32;
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i wlo  = _mm256_setr_epi16(32, 31, 30, 29, 28, 27, 26, 25,
+                                         24, 23, 22, 21, 20, 19, 18, 17);
+  const __m256i whi  = _mm256_setr_epi16(16, 15, 14, 13, 12, 11, 10,  9,
+                                          8,  7,  6,  5,  4,  3,  2,  1);
+  __m256i vs1 = zero;
+  __m256i vps = zero;
+  __m256i vs2 = zero;
+  for (size_t k = 0; k < chunks; k++)
+  {
+    __m256i v = _mm256_loadu_si256((const __m256i *) array);
+    array += 32;
+    vps = _mm256_add_epi32(vps, vs1);
+    vs1 = _mm256_add_epi32(vs1, _mm256_sad_epu8(v, zero));
+    __m256i lo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v));
+    __m256i hi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1));
+    vs2 = _mm256_add_epi32(vs2, _mm256_madd_epi16(lo, wlo));
+    vs2 = _mm256_add_epi32(vs2, _mm256_madd_epi16(hi, whi));
+  }
+  uint64_t S1 = _hsum32(_mm256_castsi256_si128(vs1)) + _hsum32(_mm256_extracti128_si256(vs1, 1));
+  uint64_t PS = _hsum32(_mm256_castsi256_si128(vps)) + _hsum32(_mm256_extracti128_si256(vps, 1));
+  uint64_t S2 = _hsum32(_mm256_castsi256_si128(vs2)) + _hsum32(_mm256_extracti128_si256(vs2, 1));
+  uint64_t a = s1 + S1;
+  uint64_t b = s2 + (uint64_t)s1 * chunks * 32 + 32 * PS + S2;
+  length -= chunks * 32;
+  while (length--)
+  {
+    a += *array++;
+    b += a;
+  }
+  s1 = a % ADLER32_MOD_PRIME;
+  s2 = b % ADLER32_MOD_PRIME;
+}
+
+
+static bool _adler32_hasAVX2()
+{
+  static int8_t avx2 = -1;
+  if (avx2 < 0)
+  {
+    __builtin_cpu_init();
+    avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+  }
+  return avx2 == 1;
+}
+
+#endif  //  ADLER32_SSE2
+
+
+#if defined(ADLER32_NEON)
+
+static void _adler32_neon(uint32_t &s1, uint32_t &s2, const uint8_t * array, size_t length)
+{
+  static const uint8_t weights[16] = { 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+  const size_t    chunks = length / 16;
+  const uint8x8_t wlo = vld1_u8(weights);
+  const uint8x8_t whi = vld1_u8(weights + 8);
+  uint32x4_t vs1 = vdupq_n_u32(0);
+  uint32x4_t vps = vdupq_n_u32(0);
+  uint32x4_t vs2 = vdupq_n_u32(0);
+  for (size_t k = 0; k < chunks; k++)
+  {
+    uint8x16_t v = vld1q_u8(array);
+    array += 16;
+    vps = vaddq_u32(vps, vs1);
+    vs1 = vpadalq_u16(vs1, vpaddlq_u8(v));
+    //  max 2 x 16 x 255 fits in 16 bit.
+    uint16x8_t p = vmull_u8(vget_low_u8(v), wlo);
+    p = vmlal_u8(p, vget_high_u8(v), whi);
+    vs2 = vpadalq_u16(vs2, p);
+  }
+  uint64_t a = s1 + vaddlvq_u32(vs1);
+  uint64_t b = s2 + (uint64_t)s1 * chunks * 16 + 16 * vaddlvq_u32(vps) + vaddlvq_u32(vs2);
+  length -= chunks * 16;
+  while (length--)
+  {
+    a += *array++;
+    b += a;
+  }
+  s1 = a % ADLER32_MOD_PRIME;
+  s2 = b % ADLER32_MOD_PRIME;
+}
+
+#endif  //  ADLER32_NEON
+
+
 //  Optimized version
 //  S1 grows linear
 //  S2 grows quadratic
-//  only do modulo when S2 reaches halfway uint32_t
-//                      and at the end of the loop.
+//  only do modulo every ADLER32_NMAX bytes and at the end.
+//  uses SSE2 / AVX2 / NEON on hosts that support it.
 //  returns current Adler value
-uint32_t Adler32::addFast(uint8_t * array, uint16_t length)
+uint32_t Adler32::addFast(const uint8_t * array, size_t length)
 {
   _count += length;
-  uint32_t s1 = _s1;
-  uint32_t s2 = _s2;
-  for (uint16_t i = 0; i < length;)
+  uint32_t s1 = _s1 % ADLER32_MOD_PRIME;
+  uint32_t s2 = _s2 % ADLER32_MOD_PRIME;
+  while (length > 0)
   {
-    // if S2 is halfway it is time to do modulo
-    while ((i < length) && (s2 < 2147483648ULL))
-    {
-      s1 += array[i++];
-      s2 += s1;
-    }
-    if (s2 >= ADLER32_MOD_PRIME)
-    {
-      s2 %= ADLER32_MOD_PRIME;
-      if (s1 >= ADLER32_MOD_PRIME) s1 %= ADLER32_MOD_PRIME;
-    }
+    size_t n = (length > ADLER32_NMAX) ? ADLER32_NMAX : length;
+#if defined(ADLER32_SSE2)
+    if ((n >= 64) && _adler32_hasAVX2()) _adler32_avx2(s1, s2, array, n);
+    else if (n >= 16)                    _adler32_sse2(s1, s2, array, n);
+    else                                 _adler32_block(s1, s2, array, n);
+#elif defined(ADLER32_NEON)
+    if (n >= 16) _adler32_neon(s1, s2, array, n);
+    else         _adler32_block(s1, s2, array, n);
+#else
+    _adler32_block(s1, s2, array, n);
+#endif
+    array  += n;
+    length -= n;
   }
   _s1 = s1;
   _s2 = s2;
@@ -98,6 +286,8 @@ uint32_t Adler32::addFast(uint8_t * array, uint16_t length)
 
 uint32_t Adler32::getAdler()
 {
+  //  add() may leave _s2 just above the prime.
+  if (_s2 >= ADLER32_MOD_PRIME) _s2 -= ADLER32_MOD_PRIME;
   return (_s2 << 16) | _s1;
 };
 
@@ -118,15 +308,15 @@ void Adler32::add(char value)
 }
 
 
-uint32_t Adler32::add(char * array, uint16_t length)
+uint32_t Adler32::add(const char * array, size_t length)
 {
-  return add((uint8_t *) array, length);
+  return add((const uint8_t *) array, length);
 }
 
 
-uint32_t Adler32::addFast(char * array, uint16_t length)
+uint32_t Adler32::addFast(const char * array, size_t length)
 {
-  return addFast((uint8_t *) array, length);
+  return addFast((const uint8_t *) array, length);
 }
 
 
@@ -88,6 +88,54 @@ unittest(test_ADLER32_lorem)
 }
 
 
+unittest(test_ADLER32_size_t_length)
+{
+  //  more than 64 KB, exceeds the former uint16_t length.
+  static uint8_t buffer[80000];
+  for (uint32_t i = 0; i < 80000UL; i++) buffer[i] = i * 131;
+
+  Adler32 ad32;
+  ad32.begin();
+  for (uint32_t i = 0; i < 80000UL; i++) ad32.add(buffer[i]);
+  uint32_t checksum = ad32.getAdler();
+  assertEqual(80000UL, ad32.count());
+
+  ad32.begin();
+  assertEqual(checksum, ad32.add(buffer, 80000UL));
+  ad32.begin();
+  assertEqual(checksum, ad32.addFast(buffer, 80000UL));
+  assertEqual(80000UL, ad32.count());
+}
+
+
+unittest(test_ADLER32_addFast_blocks)
+{
+  //  addFast() must match add() for all lengths,
+  //  including worst case data and around the block size.
+  static uint8_t buffer[12000];
+  const uint16_t lengths[10] = { 1, 15, 16, 17, 63, 64, 5551, 5552, 5553, 11999 };
+
+  for (int m = 0; m < 2; m++)
+  {
+    for (uint16_t i = 0; i < 12000; i++)
+    {
+      buffer[i] = (m == 0) ? 0xFF : i * 131;
+    }
+    for (int l = 0; l < 10; l++)
+    {
+      uint16_t len = lengths[l];
+      Adler32 A, B;
+      A.begin(65520, 65520);
+      B.begin(65520, 65520);
+      A.add(buffer + 1, len - 1);
+      //  odd offset, unaligned for SIMD loads.
+      assertEqual(A.getAdler(), B.addFast(buffer + 1, len - 1));
+      assertEqual(A.count(), B.count());
+    }
+  }
+}
+
+
 unittest_main()
 
 // --------
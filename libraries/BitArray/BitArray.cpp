@@ -1,7 +1,7 @@
 //
 //    FILE: BitArray.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.2.5
+// VERSION: 0.3.0
 // PURPOSE: BitArray library for Arduino
 //     URL: https://github.com/RobTillaart/BitArray
 //          http://forum.arduino.cc/index.php?topic=361167
@@ -14,213 +14,210 @@
 
 BitArray::BitArray()
 {
+#if !BA_CONTIGUOUS
     for (uint8_t i = 0; i < BA_MAX_SEGMENTS; i++)
     {
         _ar[i] = NULL;
     }
+#endif
 }
 
 
 BitArray::~BitArray()
 {
-    for (uint8_t i = 0; i < BA_MAX_SEGMENTS; i++)
-    {
-        if (_ar[i]) free(_ar[i]);
-    }
+    _free();
 }
 
 
-uint8_t BitArray::begin(const uint8_t bits, const uint16_t size)
+uint8_t BitArray::begin(const uint8_t bits, const uint32_t size)
 {
     if (bits == 0 || bits > 32)
     {
         _error = BA_ELEMENT_SIZE_ERR;
         return _error;
     }
-    if ((1UL * bits * size)/8 > (1UL * BA_MAX_SEGMENTS * BA_SEGMENT_SIZE))
+    uint64_t totalBits = (uint64_t)bits * size;
+#if BA_CONTIGUOUS
+    //  bit positions are uint32_t
+    if (totalBits > 0xFFFFFFFFULL)
+#else
+    if (totalBits / 8 > (1UL * BA_MAX_SEGMENTS * BA_SEGMENT_SIZE))
+#endif
     {
         _error = BA_SIZE_ERR;
         return _error;
     }
 
-    for (uint8_t i = 0; i < BA_MAX_SEGMENTS; i++)
+    _free();
+
+    _bits  = bits;
+    _size  = size;
+    _mask  = (bits == 32) ? 0xFFFFFFFF : ((1UL << bits) - 1);
+    _bytes = (totalBits + 7) / 8;
+    _words = (totalBits + BA_WORD_BITS - 1) / BA_WORD_BITS;
+#if BA_CONTIGUOUS
+    if (_words > 0)
     {
-        if (_ar[i]) free(_ar[i]);
+        _data = (ba_word_t *) malloc(_words * sizeof(ba_word_t));
+        if (_data == NULL)
+        {
+            _error = BA_NO_MEMORY_ERR;
+            return _error;
+        }
+        _segments = 1;
     }
-
-    _segments = 0;
-    _bits = bits;
-    _bytes = (_bits * size + 7) / 8;
-    uint16_t b = _bytes;
-    while (b > 0)
+#else
+    uint32_t w = _words;
+    while (w > 0)
     {
-        _ar[_segments] = (uint8_t*) malloc(min(b, (uint16_t) BA_SEGMENT_SIZE));
+        uint16_t n = min(w, (uint32_t) BA_SEGMENT_WORDS);
+        _ar[_segments] = (ba_word_t *) malloc(n * sizeof(ba_word_t));
         if (_ar[_segments] == NULL)
         {
             _error = BA_NO_MEMORY_ERR;
             return _error;
         }
-        b = b - min(b, (uint16_t) BA_SEGMENT_SIZE);
+        w -= n;
         _segments++;
     }
+#endif
+    clear();
     _error = BA_OK;
     return _error;
 }
 
 
-uint32_t BitArray::get(const uint16_t index)
+uint32_t BitArray::get(const uint32_t index)
 {
     //  if (_error != BA_OK) return BA_ERR;
     //  if (index >= _size) return BA_IDX_RANGE;
-    uint32_t v = 0;
-    uint16_t pos = index * _bits;
-
-    for (uint8_t i = _bits; i-- > 0;)
-    {
-        v <<= 1;
-        v += _bitget(pos + i);
-    }
-    return v;
+    return _read(index * _bits);
 }
 
 
-uint32_t BitArray::set(const uint16_t index, uint32_t value)
+uint32_t BitArray::set(const uint32_t index, uint32_t value)
 {
     //  if (_error != BA_OK) return BA_ERR;
     //  if (index >= _size) return BA_IDX_RANGE;
-    uint16_t pos = index * _bits;
-    uint32_t mask = 1UL;
-    for (uint8_t i = 0; i < _bits; i++)
-    {
-        uint8_t v = (value & mask) > 0 ? 1 : 0;
-        _bitset(pos + i, v);
-        mask <<= 1;
-    }
+    _write(index * _bits, value);
     return value;
 }
 
 
-uint32_t BitArray::toggle(const uint16_t index)
+uint32_t BitArray::toggle(const uint32_t index)
 {
     //  if (_error != BA_OK) return BA_ERR;
     //  if (index >= _size) return BA_IDX_RANGE;
-    uint32_t v = 0;
-    uint16_t pos = index * _bits;
-    for (uint8_t i = _bits; i-- > 0;)
-    {
-        v <<= 1;
-        v += _bittoggle(pos + i);
-    }
+    uint32_t pos = index * _bits;
+    uint32_t v = _read(pos) ^ _mask;
+    _write(pos, v);
     return v;
 }
 
 
 void BitArray::clear()
 {
-    uint16_t b = _bytes;
+#if BA_CONTIGUOUS
+    if (_data) memset(_data, 0, _words * sizeof(ba_word_t));
+#else
+    uint32_t w = _words;
     for (uint8_t s = 0; s < _segments; s++)
     {
-        uint8_t *p = _ar[s];
-        if (p)
-        {
-            uint8_t t = min(b, (uint16_t) BA_SEGMENT_SIZE);
-            b -= t;
-            while(t--)
-            {
-                *p++ = 0;
-            }
-        }
-        if (b == 0) break;
+        uint16_t n = min(w, (uint32_t) BA_SEGMENT_WORDS);
+        if (_ar[s]) memset(_ar[s], 0, n * sizeof(ba_word_t));
+        w -= n;
     }
+#endif
 }
 
 
-
 void BitArray::setAll(uint32_t value)
 {
-  for (uint16_t i = 0; i < capacity(); i++)
-  {
-    set(i, value);
-  }
+    if ((value & _mask) == 0)
+    {
+        clear();
+        return;
+    }
+    uint32_t cap = capacity();
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < cap; i++)
+    {
+        _write(pos, value);
+        pos += _bits;
+    }
 }
 
 
-//      16 bit address usage is faster
-//  TODO verify correctness
-//
-// void BitArray::clear()
-// {
-    // uint16_t b = _bytes;
-    // for (uint8_t s = 0; s < _segments; s++)
-    // {
-        // uint8_t *q = _ar[s];
-        // uint16_t *p = (uint16_t*)q;
-        // if (p)
-        // {
-            // for (uint8_t t = 0; t < BA_SEGMENT_SIZE/2; t++)
-            // {
-              // *p++ = 0;    // might be bug @ edge..
-            // }
-        // }
-        // if (b == 0) break;
-    // }
-// }
-
 /////////////////////////////////////////////////
 //
 //  PRIVATE
 //
-inline uint8_t BitArray::_bitget(uint16_t pos)
+uint32_t BitArray::_read(const uint32_t pos)
 {
-    uint8_t se = 0;
-    uint16_t re = pos;
-    while (re >= (BA_SEGMENT_SIZE * 8))  //  8 == #bits in uint8_t
+    uint32_t w   = pos / BA_WORD_BITS;
+    uint8_t  off = pos % BA_WORD_BITS;
+    ba_word_t v = _word(w) >> off;
+    //  element continues in next word
+    if (off + _bits > BA_WORD_BITS)
     {
-        se++;
-        re -= (BA_SEGMENT_SIZE * 8);
+        v |= _word(w + 1) << (BA_WORD_BITS - off);
     }
-    uint8_t by = re / 8;
-    uint8_t bi = re & 7;
-    uint8_t * p = _ar[se];
-
-    return (p[by] >> bi) & 0x01;    //  bitRead(p[by], bi);
+    return v & _mask;
 }
 
 
-inline void BitArray::_bitset(uint16_t pos, uint8_t value)
+void BitArray::_write(const uint32_t pos, uint32_t value)
 {
-    uint8_t se = 0;
-    uint16_t re = pos;
-    while (re >= (BA_SEGMENT_SIZE * 8))  //  8 == #bits in uint8_t
+    uint32_t w   = pos / BA_WORD_BITS;
+    uint8_t  off = pos % BA_WORD_BITS;
+    value &= _mask;
+    ba_word_t & lo = _word(w);
+    lo = (lo & ~((ba_word_t)_mask << off)) | ((ba_word_t)value << off);
+    //  element continues in next word
+    if (off + _bits > BA_WORD_BITS)
     {
-        se++;
-        re -= (BA_SEGMENT_SIZE * 8);
+        uint8_t shift = BA_WORD_BITS - off;
+        ba_word_t & hi = _word(w + 1);
+        hi = (hi & ~((ba_word_t)_mask >> shift)) | ((ba_word_t)value >> shift);
     }
-    uint8_t by = re / 8;
-    uint8_t bi = re & 7;
-    uint8_t * p = _ar[se];
+}
+
 
-    if (value == 0) p[by] &= ~(1 << bi); //  bitClear(p[by], bi);
-    else p[by] |= (1 << bi);             //  bitSet(p[by], bi);
+ba_word_t & BitArray::_word(const uint32_t w)
+{
+#if BA_CONTIGUOUS
+    return _data[w];
+#else
+    return _ar[w / BA_SEGMENT_WORDS][w % BA_SEGMENT_WORDS];
+#endif
+}
+
+
+uint32_t BitArray::_rangeCount(const uint32_t index, uint32_t count)
+{
+    uint32_t cap = capacity();
+    if (index >= cap) return 0;
+    if (count > cap - index) count = cap - index;
+    return count;
 }
 
 
-inline uint8_t BitArray::_bittoggle(const uint16_t pos)
+void BitArray::_free()
 {
-    uint8_t se = 0;
-    uint16_t re = pos;
-    while (re >= (BA_SEGMENT_SIZE * 8))  //  8 == #bits in uint8_t
+#if BA_CONTIGUOUS
+    if (_data) free(_data);
+    _data = NULL;
+#else
+    for (uint8_t i = 0; i < BA_MAX_SEGMENTS; i++)
     {
-        se++;
-        re -= (BA_SEGMENT_SIZE * 8);
+        if (_ar[i]) free(_ar[i]);
+        _ar[i] = NULL;
     }
-    uint8_t by = re / 8;
-    uint8_t bi = re & 7;
-    uint8_t * p = _ar[se];
-
-    uint8_t mask = 1 << bi;
-    p[by] ^= mask;
-    return (mask > 0);
+#endif
+    _segments = 0;
+    _words = 0;
+    _size  = 0;
+    _bytes = 0;
 }
 
 
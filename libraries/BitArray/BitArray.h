@@ -2,7 +2,7 @@
 //
 //    FILE: bitArray.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.2.5
+// VERSION: 0.3.0
 // PURPOSE: BitArray library for Arduino
 //     URL: https://github.com/RobTillaart/BitArray
 
@@ -11,8 +11,10 @@
 //  The interface uses uint32_t as that will be enough for most purposes.
 //  The main requirement is to optimize storage space.
 //
-//  The BitArray uses an array of segments and the space per segment
+//  On AVR the BitArray uses an array of segments and the space per segment
 //  may not exceed 256 bytes as this is a limit on some processors.
+//  Other processors use one contiguous allocation (BA_CONTIGUOUS).
+//  Elements are read / written with shift and mask on 32 or 64 bit words.
 //
 //  Originally created to store lot of numbers between 1..6 dice rolls
 //  the storage is also usable to store e.g. raw 10 bit analogRead()'s.
@@ -20,10 +22,29 @@
 
 #include "Arduino.h"
 
-#define BITARRAY_LIB_VERSION              (F("0.2.5"))
+#define BITARRAY_LIB_VERSION              (F("0.3.0"))
 
 
+#ifndef BA_CONTIGUOUS
+#if defined(__AVR__)
+#define BA_CONTIGUOUS                     0
+#else
+#define BA_CONTIGUOUS                     1
+#endif
+#endif
+
+//  storage word, native size of the processor.
+#if UINTPTR_MAX > 0xFFFFFFFFUL
+typedef uint64_t ba_word_t;
+#else
+typedef uint32_t ba_word_t;
+#endif
+#define BA_WORD_BITS                      (8 * sizeof(ba_word_t))
+
+
+//  segmented mode only
 #define BA_SEGMENT_SIZE                   200
+#define BA_SEGMENT_WORDS                  (BA_SEGMENT_SIZE / sizeof(ba_word_t))
 
 //  max memory is board type dependent
 //  note the bitArray does not use all of the RAM
@@ -67,29 +88,71 @@ public:
   BitArray();
   ~BitArray();
 
-  uint8_t  begin(const uint8_t bits, const uint16_t size);
+  //  clears the array.
+  uint8_t  begin(const uint8_t bits, const uint32_t size);
 
-  uint16_t capacity() { return _bytes * 8 / _bits; };
-  uint16_t memory()   { return _bytes; };
+  uint32_t capacity() { return _size; };
+  uint32_t memory()   { return _bytes; };
   uint16_t bits()     { return _bits; };
   uint16_t segments() { return _segments; };
   uint8_t  getError() { return _error; };
 
   void     clear();
-  uint32_t get(const uint16_t index);
-  uint32_t set(const uint16_t index, uint32_t value);
+  uint32_t get(const uint32_t index);
+  uint32_t set(const uint32_t index, uint32_t value);
   void     setAll(uint32_t value);
-  uint32_t toggle(const uint16_t index);
+  //  returns the new value.
+  uint32_t toggle(const uint32_t index);
+
+
+  //  bulk copy to / from a native array e.g. uint16_t for 10 bit ADC values.
+  //  returns the number of elements copied, limited by capacity().
+  template <typename T>
+  uint32_t getRange(const uint32_t index, T * dest, uint32_t count)
+  {
+    count = _rangeCount(index, count);
+    uint32_t pos = index * _bits;
+    for (uint32_t i = 0; i < count; i++)
+    {
+      dest[i] = _read(pos);
+      pos += _bits;
+    }
+    return count;
+  };
+
+  template <typename T>
+  uint32_t setRange(const uint32_t index, const T * src, uint32_t count)
+  {
+    count = _rangeCount(index, count);
+    uint32_t pos = index * _bits;
+    for (uint32_t i = 0; i < count; i++)
+    {
+      _write(pos, src[i]);
+      pos += _bits;
+    }
+    return count;
+  };
 
-private:
-  uint8_t   _bitget(const uint16_t index);
-  void      _bitset(const uint16_t index, const uint8_t value);
-  uint8_t   _bittoggle(const uint16_t index);
 
-  uint16_t  _bytes = 0;
+private:
+  //  pos is the bit position of the element.
+  uint32_t    _read(const uint32_t pos);
+  void        _write(const uint32_t pos, uint32_t value);
+  ba_word_t & _word(const uint32_t w);
+  uint32_t    _rangeCount(const uint32_t index, uint32_t count);
+  void        _free();
+
+  uint32_t  _size  = 0;
+  uint32_t  _bytes = 0;
+  uint32_t  _words = 0;
+  uint32_t  _mask  = 0;
   uint8_t   _bits = 0;
   uint8_t   _segments = 0;
-  uint8_t * _ar[BA_MAX_SEGMENTS];
+#if BA_CONTIGUOUS
+  ba_word_t * _data = NULL;
+#else
+  ba_word_t * _ar[BA_MAX_SEGMENTS];
+#endif
   uint8_t   _error = BA_NO_MEMORY_ERR;
 };
 
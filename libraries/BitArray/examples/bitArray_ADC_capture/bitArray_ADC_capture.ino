@@ -0,0 +1,125 @@
+//
+//    FILE: bitArray_ADC_capture.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: store 10 / 12 bit ADC samples compact and compare access methods
+//     URL: https://github.com/RobTillaart/BitArray
+//
+//  compares
+//  - bit loop: sample packed bit by bit (as BitArray 0.2.x did)
+//  - element : get() / set() per element, shift and mask on words
+//  - range   : getRange() / setRange() to / from a uint16_t buffer
+
+
+#include "BitArray.h"
+
+#define SAMPLES     400
+
+BitArray ba;
+uint16_t samples[SAMPLES];
+uint16_t check[SAMPLES];
+uint8_t  packed[(SAMPLES * 12 + 7) / 8];
+
+uint32_t start, stop;
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.print("Start ");
+  Serial.println(__FILE__);
+  Serial.print("LIB VERSION:\t");
+  Serial.println(BITARRAY_LIB_VERSION);
+  Serial.println();
+
+  //  simulated capture, use analogRead(A0) for real data.
+  for (int i = 0; i < SAMPLES; i++)
+  {
+    samples[i] = random(4096);
+  }
+
+  test(10);
+  test(12);
+}
+
+
+void loop()
+{
+}
+
+
+void test(uint8_t bits)
+{
+  ba.begin(bits, SAMPLES);
+  Serial.print("BITS:\t");
+  Serial.print(bits);
+  Serial.print("\tMEMORY:\t");
+  Serial.print(ba.memory());
+  Serial.print(" bytes instead of ");
+  Serial.println(SAMPLES * 2);
+  uint16_t mask = (1 << bits) - 1;
+  delay(100);
+
+  //  BIT LOOP, packs into a plain byte buffer one bit at a time.
+  start = micros();
+  uint32_t pos = 0;
+  for (int i = 0; i < SAMPLES; i++)
+  {
+    for (uint8_t b = 0; b < bits; b++)
+    {
+      bitWrite(packed[pos >> 3], pos & 7, bitRead(samples[i], b));
+      pos++;
+    }
+  }
+  stop = micros();
+  Serial.print("bit loop set:\t");
+  Serial.println(stop - start);
+  delay(100);
+
+  //  ELEMENT
+  start = micros();
+  for (int i = 0; i < SAMPLES; i++)
+  {
+    ba.set(i, samples[i]);
+  }
+  stop = micros();
+  Serial.print("element set:\t");
+  Serial.println(stop - start);
+  delay(100);
+
+  start = micros();
+  for (int i = 0; i < SAMPLES; i++)
+  {
+    check[i] = ba.get(i);
+  }
+  stop = micros();
+  Serial.print("element get:\t");
+  Serial.println(stop - start);
+  delay(100);
+
+  //  RANGE
+  start = micros();
+  ba.setRange(0, samples, SAMPLES);
+  stop = micros();
+  Serial.print("range set:\t");
+  Serial.println(stop - start);
+  delay(100);
+
+  start = micros();
+  ba.getRange(0, check, SAMPLES);
+  stop = micros();
+  Serial.print("range get:\t");
+  Serial.println(stop - start);
+  delay(100);
+
+  int errors = 0;
+  for (int i = 0; i < SAMPLES; i++)
+  {
+    if (check[i] != (samples[i] & mask)) errors++;
+  }
+  Serial.print("errors:\t\t");
+  Serial.println(errors);
+  Serial.println();
+}
+
+
+//  -- END OF FILE --
@@ -66,11 +66,11 @@ unittest(test_set_get_toggle)
 
   fprintf(stderr, "\t1000x set(i, 0) -> sum += get(i)\n");
   int sum = 0;
-  for (int i = 0; i < ba.capacity(); i++)
+  for (uint32_t i = 0; i < ba.capacity(); i++)
   {
     ba.set(i, 0);
   }
-  for (int i = 0; i < ba.capacity(); i++)
+  for (uint32_t i = 0; i < ba.capacity(); i++)
   {
     sum += ba.get(i);
   }
@@ -78,11 +78,11 @@ unittest(test_set_get_toggle)
 
   fprintf(stderr, "\t1000x set(i, 1) -> sum += get(i)\n");
   sum = 0;
-  for (int i = 0; i < ba.capacity(); i++)
+  for (uint32_t i = 0; i < ba.capacity(); i++)
   {
     ba.set(i, 1);
   }
-  for (int i = 0; i < ba.capacity(); i++)
+  for (uint32_t i = 0; i < ba.capacity(); i++)
   {
     sum += ba.get(i);
   }
@@ -90,11 +90,11 @@ unittest(test_set_get_toggle)
 
   fprintf(stderr, "\t1000x toggle(i)\n");
   sum = 0;
-  for (int i = 0; i < ba.capacity(); i++)
+  for (uint32_t i = 0; i < ba.capacity(); i++)
   {
     ba.toggle(i);
   }
-  for (int i = 0; i < ba.capacity(); i++)
+  for (uint32_t i = 0; i < ba.capacity(); i++)
   {
     sum += ba.get(i);
   }
@@ -112,11 +112,11 @@ unittest(test_clear)
 
   fprintf(stderr, "\t1000x set(i, 1) -> clear() -> sum += get(i)\n");
   int sum = 0;
-  for (int i = 0; i < ba.capacity(); i++)
+  for (uint32_t i = 0; i < ba.capacity(); i++)
   {
     ba.set(i, 1);
   }
-  for (int i = 0; i < ba.capacity(); i++)
+  for (uint32_t i = 0; i < ba.capacity(); i++)
   {
     sum += ba.get(i);
   }
@@ -124,7 +124,7 @@ unittest(test_clear)
 
   ba.clear();
   sum = 0;
-  for (int i = 0; i < ba.capacity(); i++)
+  for (uint32_t i = 0; i < ba.capacity(); i++)
   {
     sum += ba.get(i);
   }
@@ -143,7 +143,7 @@ unittest(test_setAll)
   fprintf(stderr, "\tsetAll(17) -> sum += get(i)\n");
   ba.setAll(17);
   uint32_t sum = 0;
-  for (int i = 0; i < ba.capacity(); i++)
+  for (uint32_t i = 0; i < ba.capacity(); i++)
   {
     sum += ba.get(i);
   }
@@ -151,7 +151,7 @@ unittest(test_setAll)
 
   ba.clear();
   sum = 0;
-  for (int i = 0; i < ba.capacity(); i++)
+  for (uint32_t i = 0; i < ba.capacity(); i++)
   {
     sum += ba.get(i);
   }
@@ -159,6 +159,97 @@ unittest(test_setAll)
 }
 
 
+unittest(test_all_widths)
+{
+  BitArray ba;
+  uint32_t ref[200];
+
+  fprintf(stderr, "\tbits 1..32, 200 random values vs reference\n");
+  for (uint8_t bits = 1; bits <= 32; bits++)
+  {
+    ba.begin(bits, 200);
+    assertEqual(BA_OK, ba.getError());
+    assertEqual(200, ba.capacity());
+    uint32_t mask = (bits == 32) ? 0xFFFFFFFF : ((1UL << bits) - 1);
+
+    for (int i = 0; i < 200; i++) assertEqual(0, ba.get(i));
+
+    uint32_t x = 0x12345678UL + bits;
+    for (int i = 0; i < 200; i++)
+    {
+      x = x * 1664525UL + 1013904223UL;
+      ref[i] = x & mask;
+      ba.set(i, x);
+    }
+    bool ok = true;
+    for (int i = 0; i < 200; i++)
+    {
+      ok = ok && (ref[i] == ba.get(i));
+    }
+    assertTrue(ok);
+
+    //  toggle returns new value, neighbours unaffected.
+    assertEqual(ref[7] ^ mask, ba.toggle(7));
+    assertEqual(ref[7] ^ mask, ba.get(7));
+    assertEqual(ref[6], ba.get(6));
+    assertEqual(ref[8], ba.get(8));
+  }
+}
+
+
+unittest(test_range)
+{
+  BitArray ba;
+
+  ba.begin(10, 500);
+  assertEqual(BA_OK, ba.getError());
+
+  uint16_t src[100];
+  uint16_t dest[100];
+  for (int i = 0; i < 100; i++) src[i] = i * 7 + 5;
+
+  assertEqual(100, ba.setRange(123, src, 100));
+  ba.set(122, 1023);
+  ba.set(223, 1023);
+  for (int i = 0; i < 100; i++)
+  {
+    assertEqual(src[i], ba.get(123 + i));
+  }
+  assertEqual(100, ba.getRange(123, dest, 100));
+  for (int i = 0; i < 100; i++)
+  {
+    assertEqual(src[i], dest[i]);
+  }
+  assertEqual(1023, ba.get(122));
+  assertEqual(1023, ba.get(223));
+
+  //  clipped at capacity
+  assertEqual(10, ba.setRange(490, src, 100));
+  assertEqual(10, ba.getRange(490, dest, 100));
+  assertEqual(0, ba.getRange(500, dest, 100));
+  assertEqual(src[9], ba.get(499));
+}
+
+
+unittest(test_segment_boundaries)
+{
+  BitArray ba;
+
+  //  875 bytes, crosses several 200 byte segments when built with
+  //  BA_CONTIGUOUS 0 (default on AVR), on hosts one contiguous block.
+  ba.begin(7, 1000);
+  assertEqual(BA_OK, ba.getError());
+  assertEqual(875, ba.memory());
+  fprintf(stderr, "\tSEGMENTS:\t %d\n", ba.segments());
+
+  for (int i = 0; i < 1000; i++) ba.set(i, i * 13);
+  for (int i = 0; i < 1000; i++)
+  {
+    assertEqual((i * 13) & 0x7F, ba.get(i));
+  }
+}
+
+
 unittest_main()
 
 // --------
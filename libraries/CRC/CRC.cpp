@@ -1,7 +1,7 @@
 //
 //    FILE: CRC.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.3.2
+// VERSION: 0.4.4
 // PURPOSE: Arduino library for CRC8, CRC12, CRC16, CRC16-CCITT, CRC32, CRC64
 //     URL: https://github.com/RobTillaart/CRC
 //
@@ -65,7 +65,7 @@ uint64_t reverse64(uint64_t in)
 ///////////////////////////////////////////////////////////////////////////////////
 
 // CRC POLYNOME = x8 + x5 + x4 + 1 = 1001 1000 = 0x8C
-uint8_t crc8(const uint8_t *array, uint16_t length, const uint8_t polynome, 
+uint8_t crc8(const uint8_t *array, size_t length, const uint8_t polynome, 
              const uint8_t startmask, const uint8_t endmask, 
              const bool reverseIn, const bool reverseOut)
 {
@@ -96,7 +96,7 @@ uint8_t crc8(const uint8_t *array, uint16_t length, const uint8_t polynome,
 
 
 // CRC POLYNOME = x12 + x3 + x2 + 1 =  0000 1000 0000 1101 = 0x80D
-uint16_t crc12(const uint8_t *array, uint16_t length, const uint16_t polynome,
+uint16_t crc12(const uint8_t *array, size_t length, const uint16_t polynome,
                const uint16_t startmask, const uint16_t endmask, 
                const bool reverseIn, const bool reverseOut)
 {
@@ -129,7 +129,7 @@ uint16_t crc12(const uint8_t *array, uint16_t length, const uint16_t polynome,
 
 
 // CRC POLYNOME = x15 + 1 =  1000 0000 0000 0001 = 0x8001
-uint16_t crc16(const uint8_t *array, uint16_t length, const uint16_t polynome,
+uint16_t crc16(const uint8_t *array, size_t length, const uint16_t polynome,
                const uint16_t startmask, const uint16_t endmask, 
                const bool reverseIn, const bool reverseOut)
 {
@@ -160,14 +160,14 @@ uint16_t crc16(const uint8_t *array, uint16_t length, const uint16_t polynome,
 
 
 // CRC-CCITT POLYNOME = x13 + X5 + 1 =  0001 0000 0010 0001 = 0x1021
-uint16_t crc16_CCITT(uint8_t *array, uint16_t length)
+uint16_t crc16_CCITT(const uint8_t *array, size_t length)
 {
   return crc16(array, length, 0x1021, 0xFFFF);
 }
 
 
 // CRC-32 POLYNOME =  x32 + ..... + 1
-uint32_t crc32(const uint8_t *array, uint16_t length, const uint32_t polynome, 
+uint32_t crc32(const uint8_t *array, size_t length, const uint32_t polynome, 
                const uint32_t startmask, const uint32_t endmask, 
                const bool reverseIn, const bool reverseOut)
 {
@@ -199,7 +199,7 @@ uint32_t crc32(const uint8_t *array, uint16_t length, const uint32_t polynome,
 
 // CRC-CCITT POLYNOME =  x64 + ..... + 1
 // CRC_ECMA64 = 0x42F0E1EBA9EA3693
-uint64_t crc64(const uint8_t *array, uint16_t length, const uint64_t polynome, 
+uint64_t crc64(const uint8_t *array, size_t length, const uint64_t polynome, 
                const uint64_t startmask, const uint64_t endmask, 
                const bool reverseIn, const bool reverseOut)
 {
@@ -229,5 +229,145 @@ uint64_t crc64(const uint8_t *array, uint16_t length, const uint64_t polynome,
 }
 
 
-// -- END OF FILE
+///////////////////////////////////////////////////////////////////////////////////
+//
+// COMBINE
+//
+// R(A+B) = (R(A) ^ start) * x^(8 * lengthB) ^ R(B)    (mod polynome)
+// R = raw CRC register, so the end mask and reverseOut are undone first.
+//
+
+// a * b mod polynome, all width bits
+static uint64_t _crcMulMod(uint64_t a, uint64_t b, uint64_t polynome, uint8_t width)
+{
+  uint64_t topbit = 1ULL << (width - 1);
+  uint64_t mask   = (topbit << 1) - 1;
+  uint64_t r = 0;
+  for (uint64_t bit = topbit; bit; bit >>= 1)
+  {
+    bool carry = (r & topbit) != 0;
+    r = (r << 1) & mask;
+    if (carry) r ^= polynome;
+    if (b & bit) r ^= a;
+  }
+  return r;
+}
+
+
+uint64_t crcZeroExtend(uint64_t crc, uint64_t length, uint64_t polynome, uint8_t width)
+{
+  uint64_t topbit = 1ULL << (width - 1);
+  uint64_t mask   = (topbit << 1) - 1;
+  polynome &= mask;
+  crc      &= mask;
+
+  //  base = x^8 mod polynome
+  uint64_t base = 1;
+  for (uint8_t i = 8; i; i--)
+  {
+    bool carry = (base & topbit) != 0;
+    base = (base << 1) & mask;
+    if (carry) base ^= polynome;
+  }
+  //  square and multiply
+  while (length > 0)
+  {
+    if (length & 1) crc = _crcMulMod(crc, base, polynome, width);
+    base = _crcMulMod(base, base, polynome, width);
+    length >>= 1;
+  }
+  return crc;
+}
+
+
+uint8_t crc8_combine(uint8_t crcA, uint8_t crcB, uint64_t lengthB, const uint8_t polynome,
+                     const uint8_t startmask, const uint8_t endmask, const bool reverseOut)
+{
+  //  crc8() does endmask before reverse.
+  if (reverseOut)
+  {
+    crcA = reverse8(crcA);
+    crcB = reverse8(crcB);
+  }
+  crcA ^= endmask;
+  crcB ^= endmask;
+  uint8_t crc = crcZeroExtend(crcA ^ startmask, lengthB, polynome, 8) ^ crcB;
+  crc ^= endmask;
+  if (reverseOut) crc = reverse8(crc);
+  return crc;
+}
+
+
+uint16_t crc12_combine(uint16_t crcA, uint16_t crcB, uint64_t lengthB, const uint16_t polynome,
+                       const uint16_t startmask, const uint16_t endmask, const bool reverseOut)
+{
+  //  crc12() does reverse before endmask, only lower 12 bits are used.
+  crcA = (crcA ^ endmask) & 0x0FFF;
+  crcB = (crcB ^ endmask) & 0x0FFF;
+  if (reverseOut)
+  {
+    crcA = reverse12(crcA);
+    crcB = reverse12(crcB);
+  }
+  uint16_t crc = crcZeroExtend(crcA ^ startmask, lengthB, polynome, 12) ^ crcB;
+  if (reverseOut) crc = reverse12(crc);
+  crc ^= endmask;
+  return crc & 0x0FFF;
+}
+
 
+uint16_t crc16_combine(uint16_t crcA, uint16_t crcB, uint64_t lengthB, const uint16_t polynome,
+                       const uint16_t startmask, const uint16_t endmask, const bool reverseOut)
+{
+  //  crc16() does reverse before endmask.
+  crcA ^= endmask;
+  crcB ^= endmask;
+  if (reverseOut)
+  {
+    crcA = reverse16(crcA);
+    crcB = reverse16(crcB);
+  }
+  uint16_t crc = crcZeroExtend(crcA ^ startmask, lengthB, polynome, 16) ^ crcB;
+  if (reverseOut) crc = reverse16(crc);
+  crc ^= endmask;
+  return crc;
+}
+
+
+uint32_t crc32_combine(uint32_t crcA, uint32_t crcB, uint64_t lengthB, const uint32_t polynome,
+                       const uint32_t startmask, const uint32_t endmask, const bool reverseOut)
+{
+  //  crc32() does endmask before reverse.
+  if (reverseOut)
+  {
+    crcA = reverse32(crcA);
+    crcB = reverse32(crcB);
+  }
+  crcA ^= endmask;
+  crcB ^= endmask;
+  uint32_t crc = crcZeroExtend(crcA ^ startmask, lengthB, polynome, 32) ^ crcB;
+  crc ^= endmask;
+  if (reverseOut) crc = reverse32(crc);
+  return crc;
+}
+
+
+uint64_t crc64_combine(uint64_t crcA, uint64_t crcB, uint64_t lengthB, const uint64_t polynome,
+                       const uint64_t startmask, const uint64_t endmask, const bool reverseOut)
+{
+  //  crc64() does endmask before reverse.
+  if (reverseOut)
+  {
+    crcA = reverse64(crcA);
+    crcB = reverse64(crcB);
+  }
+  crcA ^= endmask;
+  crcB ^= endmask;
+  uint64_t crc = crcZeroExtend(crcA ^ startmask, lengthB, polynome, 64) ^ crcB;
+  crc ^= endmask;
+  if (reverseOut) crc = reverse64(crc);
+  return crc;
+}
+
+
+// -- END OF FILE
@@ -2,7 +2,7 @@
 //
 //    FILE: CRC.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.3.2
+// VERSION: 0.4.4
 // PURPOSE: Arduino library for CRC8, CRC12, CRC16, CRC16-CCITT, CRC32, CRC64
 //     URL: https://github.com/RobTillaart/CRC
 //
@@ -12,7 +12,7 @@
 
 #include "CRC_polynomes.h"
 
-#define CRC_LIB_VERSION       (F("0.3.2"))
+#define CRC_LIB_VERSION       (F("0.4.4"))
 
 
 ////////////////////////////////////////////////////////////////
@@ -32,23 +32,47 @@ uint64_t reverse64(uint64_t in);
 ///////////////////////////////////////////////////////////////////////////////////
 
 // CRC POLYNOME = x8 + x5 + x4 + 1 = 1001 1000 = 0x8C
-uint8_t crc8(const uint8_t *array, uint16_t length, const uint8_t polynome = 0xD5, const uint8_t startmask = 0x00, const uint8_t endmask = 0x00, const bool reverseIn = false, const bool reverseOut = false);
+uint8_t crc8(const uint8_t *array, size_t length, const uint8_t polynome = 0xD5, const uint8_t startmask = 0x00, const uint8_t endmask = 0x00, const bool reverseIn = false, const bool reverseOut = false);
 
 // CRC POLYNOME = x12 + x3 + x2 + 1 =  0000 1000 0000 1101 = 0x80D
-uint16_t crc12(const uint8_t *array, uint16_t length, const uint16_t polynome = 0x80D, const uint16_t startmask = 0x0000, const uint16_t endmask = 0x0000, const bool reverseIn = false, const bool reverseOut = false);
+uint16_t crc12(const uint8_t *array, size_t length, const uint16_t polynome = 0x80D, const uint16_t startmask = 0x0000, const uint16_t endmask = 0x0000, const bool reverseIn = false, const bool reverseOut = false);
 
 // CRC POLYNOME = x15 + 1 =  1000 0000 0000 0001 = 0x8001
-uint16_t crc16(const uint8_t *array, uint16_t length, const uint16_t polynome = 0x8001, const uint16_t startmask = 0x0000, const uint16_t endmask = 0x0000, const bool reverseIn = false, const bool reverseOut = false);
+uint16_t crc16(const uint8_t *array, size_t length, const uint16_t polynome = 0x8001, const uint16_t startmask = 0x0000, const uint16_t endmask = 0x0000, const bool reverseIn = false, const bool reverseOut = false);
 
 // CRC-CCITT POLYNOME = x13 + X5 + 1 =  0001 0000 0010 0001 = 0x1021
-uint16_t crc16_CCITT(uint8_t *array, uint16_t length);
+uint16_t crc16_CCITT(const uint8_t *array, size_t length);
 
 // CRC-32 POLYNOME =  x32 + ..... + 1
-uint32_t crc32(const uint8_t *array, uint16_t length, const uint32_t polynome = 0x04C11DB7, const uint32_t startmask = 0, const uint32_t endmask = 0, const bool reverseIn = false, const bool reverseOut = false);
+uint32_t crc32(const uint8_t *array, size_t length, const uint32_t polynome = 0x04C11DB7, const uint32_t startmask = 0, const uint32_t endmask = 0, const bool reverseIn = false, const bool reverseOut = false);
 
 // CRC-CCITT POLYNOME =  x64 + ..... + 1
 // CRC_ECMA64 = 0x42F0E1EBA9EA3693
-uint64_t crc64(const uint8_t *array, uint16_t length, const uint64_t polynome = 0x42F0E1EBA9EA3693, const uint64_t startmask = 0, const uint64_t endmask = 0, const bool reverseIn = false, const bool reverseOut = false);
+uint64_t crc64(const uint8_t *array, size_t length, const uint64_t polynome = 0x42F0E1EBA9EA3693, const uint64_t startmask = 0, const uint64_t endmask = 0, const bool reverseIn = false, const bool reverseOut = false);
+
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+// COMBINE
+//
+// returns CRC(A + B) from CRC(A), CRC(B) and the length of B in O(log n).
+// parameters must be the same as used for the crcN() calls, 
+// reverseIn is not needed as it does not affect the combine.
+//
+uint8_t  crc8_combine(uint8_t crcA, uint8_t crcB, uint64_t lengthB, const uint8_t polynome = 0xD5, const uint8_t startmask = 0x00, const uint8_t endmask = 0x00, const bool reverseOut = false);
+
+uint16_t crc12_combine(uint16_t crcA, uint16_t crcB, uint64_t lengthB, const uint16_t polynome = 0x80D, const uint16_t startmask = 0x0000, const uint16_t endmask = 0x0000, const bool reverseOut = false);
+
+uint16_t crc16_combine(uint16_t crcA, uint16_t crcB, uint64_t lengthB, const uint16_t polynome = 0x8001, const uint16_t startmask = 0x0000, const uint16_t endmask = 0x0000, const bool reverseOut = false);
+
+uint32_t crc32_combine(uint32_t crcA, uint32_t crcB, uint64_t lengthB, const uint32_t polynome = 0x04C11DB7, const uint32_t startmask = 0, const uint32_t endmask = 0, const bool reverseOut = false);
+
+uint64_t crc64_combine(uint64_t crcA, uint64_t crcB, uint64_t lengthB, const uint64_t polynome = 0x42F0E1EBA9EA3693, const uint64_t startmask = 0, const uint64_t endmask = 0, const bool reverseOut = false);
+
+// POWER USER
+// returns the raw CRC register after adding length zero bytes, 
+// i.e. crc * x^(8 * length) mod polynome, width = 1..64 bits.
+uint64_t crcZeroExtend(uint64_t crc, uint64_t length, uint64_t polynome, uint8_t width);
 
 
 // -- END OF FILE --
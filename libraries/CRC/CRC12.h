@@ -10,6 +10,7 @@
 #include "Arduino.h"
 
 #include "CRC_polynomes.h"
+#include "CRC_engines.h"
 
 
 class CRC12
@@ -17,16 +18,21 @@ class CRC12
 public:
   CRC12();
   CRC12(uint16_t polynome, uint16_t XORstart, uint16_t XORend, bool reverseIn, bool reverseOut);
+  ~CRC12();
+
+  //  a copy gets its own table, rebuilt on first use.
+  CRC12(const CRC12 &crc);
+  CRC12 & operator = (const CRC12 &crc);
 
   // set parameters to default
   void     reset();       // set all to constructor defaults
   void     restart();     // reset CRC with same parameters.
 
   // set parameters
-  void     setPolynome(uint16_t polynome) { _polynome = polynome; };
+  void     setPolynome(uint16_t polynome) { _polynome = polynome; _tableValid = false; };
   void     setStartXOR(uint16_t start)    { _startMask = start; };
   void     setEndXOR(uint16_t end)        { _endMask = end; };
-  void     setReverseIn(bool reverseIn)   { _reverseIn = reverseIn; };
+  void     setReverseIn(bool reverseIn)   { _reverseIn = reverseIn; _tableValid = false; };
   void     setReverseOut(bool reverseOut) { _reverseOut = reverseOut; };
 
   // get parameters
@@ -37,19 +43,30 @@ public:
   bool     getReverseOut() { return _reverseOut; };
 
   void     add(uint8_t value);
-  void     add(const uint8_t * array, uint16_t length);
+  void     add(const uint8_t * array, size_t length);
 
   uint16_t getCRC();       // returns CRC
   uint32_t count()         { return _count; };
 
+  //  append the CRC of a next block of length bytes,
+  //  calculated with the same parameters, e.g. by another thread.
+  void     append(uint16_t crc, uint32_t length);
+
   // POWER USER ONLY
   void     enableYield()   { _canYield = true; };
   void     disableYield()  { _canYield = false; };
 
+  //  ENGINE - trade RAM for speed, see CRC_engines.h
+  //  returns false if engine is not supported or allocation failed.
+  bool     setEngine(uint8_t engine);
+  uint8_t  getEngine()     { return _engine; };
+
 private:
   uint16_t _reverse(uint16_t value);
   uint8_t  _reverse8(uint8_t value);
   void     _update(uint8_t value);
+  void     _updateBlock(const uint8_t * array, uint16_t length);
+  void     _buildTable();
 
   uint16_t _polynome;
   uint16_t _startMask;
@@ -59,6 +76,9 @@ private:
   bool     _reverseOut;
   bool     _started;
   bool     _canYield;
+  uint8_t  _engine;
+  bool     _tableValid;
+  uint16_t * _table;
   uint32_t _count;
 };
 
@@ -6,10 +6,14 @@
 
 
 #include "CRC16.h"
+#include "CRC.h"
 
 
 CRC16::CRC16()
 {
+  _engine     = CRC_ENGINE_BITWISE;
+  _tableValid = false;
+  _table      = NULL;
   reset();
 }
 
@@ -25,6 +29,41 @@ CRC16::CRC16(uint16_t polynome, uint16_t XORstart, uint16_t XORend, bool reverse
   _started    = false;
   _count      = 0;
   _canYield   = true;
+  _engine     = CRC_ENGINE_BITWISE;
+  _tableValid = false;
+  _table      = NULL;
+}
+
+
+CRC16::~CRC16()
+{
+  if (_table != NULL) free(_table);
+}
+
+
+CRC16::CRC16(const CRC16 &crc)
+{
+  _engine = CRC_ENGINE_BITWISE;
+  _table  = NULL;
+  *this   = crc;
+}
+
+
+CRC16 & CRC16::operator = (const CRC16 &crc)
+{
+  if (this == &crc) return *this;
+  _polynome   = crc._polynome;
+  _startMask  = crc._startMask;
+  _endMask    = crc._endMask;
+  _crc        = crc._crc;
+  _reverseIn  = crc._reverseIn;
+  _reverseOut = crc._reverseOut;
+  _started    = crc._started;
+  _canYield   = crc._canYield;
+  _count      = crc._count;
+  //  never share the table, falls back to bitwise if allocation fails.
+  setEngine(crc._engine);
+  return *this;
 }
  
 
@@ -39,6 +78,7 @@ void CRC16::reset()
   _started    = false;
   _count      = 0;
   _canYield   = true;
+  _tableValid = false;
 }
 
 
@@ -52,18 +92,72 @@ void CRC16::restart()
 
 void CRC16::add(uint8_t value)
 {
+  if (!_started) restart();
   _count++;
   if (_canYield && ((_count & 0xFF) == 0)) yield();
-  _update(value);
+  if (_engine == CRC_ENGINE_BITWISE) _update(value);
+  else _updateBlock(&value, 1);
+}
+
+
+void CRC16::add(const uint8_t * array, size_t length)
+{
+  if (_engine == CRC_ENGINE_BITWISE)
+  {
+    while (length--)
+    {
+      add(*array++);
+    }
+    return;
+  }
+
+  if (!_started) restart();
+  //  process in chunks so yield() is still called every 256 bytes.
+  while (length > 0)
+  {
+    uint16_t n = 256 - (_count & 0xFF);
+    if (n > length) n = length;
+    _updateBlock(array, n);
+    array  += n;
+    length -= n;
+    _count += n;
+    if (_canYield && ((_count & 0xFF) == 0)) yield();
+  }
+}
+
+
+void CRC16::append(uint16_t crc, uint32_t length)
+{
+  if (!_started) restart();
+  //  undo getCRC() to get the raw register of the block.
+  crc ^= _endMask;
+  if (_reverseOut) crc = _reverse(crc);
+  _crc = crcZeroExtend(_crc ^ _startMask, length, _polynome, 16) ^ crc;
+  _count += length;
 }
 
 
-void CRC16::add(const uint8_t * array, uint16_t length)
+bool CRC16::setEngine(uint8_t engine)
 {
-  while (length--)
+  uint16_t entries = 0;
+  switch(engine)
+  {
+    case CRC_ENGINE_BITWISE: entries = 0;    break;
+    case CRC_ENGINE_NIBBLE:  entries = 16;   break;
+    case CRC_ENGINE_TABLE:   entries = 256;  break;
+    default: return false;
+  }
+  if (_table != NULL) free(_table);
+  _table      = NULL;
+  _tableValid = false;
+  _engine     = CRC_ENGINE_BITWISE;
+  if (entries > 0)
   {
-    add(*array++);
+    _table = (uint16_t *) malloc(entries * sizeof(uint16_t));
+    if (_table == NULL) return false;
   }
+  _engine = engine;
+  return true;
 }
 
 
@@ -96,6 +190,89 @@ void CRC16::_update(uint8_t value)
 }
 
 
+//  reverseIn uses a reflected table and a reflected CRC register.
+//  this removes the reverse of every input byte from the inner loop.
+void CRC16::_buildTable()
+{
+  uint8_t  bits    = (_engine == CRC_ENGINE_NIBBLE) ? 4 : 8;
+  uint16_t entries = 1 << bits;
+  uint16_t poly    = _reverseIn ? _reverse(_polynome) : _polynome;
+  for (uint16_t i = 0; i < entries; i++)
+  {
+    uint16_t crc;
+    if (_reverseIn)
+    {
+      crc = i;
+      for (uint8_t b = bits; b; b--)
+      {
+        if (crc & 1) crc = (crc >> 1) ^ poly;
+        else         crc >>= 1;
+      }
+    }
+    else
+    {
+      crc = i << (16 - bits);
+      for (uint8_t b = bits; b; b--)
+      {
+        if (crc & (1UL << 15)) crc = (crc << 1) ^ poly;
+        else                   crc <<= 1;
+      }
+    }
+    _table[i] = crc;
+  }
+  _tableValid = true;
+}
+
+
+void CRC16::_updateBlock(const uint8_t * array, uint16_t length)
+{
+  if (!_tableValid) _buildTable();
+  const uint16_t * T = _table;
+
+  if (_reverseIn)
+  {
+    uint16_t crc = _reverse(_crc);
+    if (_engine == CRC_ENGINE_NIBBLE)
+    {
+      while (length--)
+      {
+        uint8_t value = *array++;
+        crc = (crc >> 4) ^ T[(crc ^ value) & 0x0F];
+        crc = (crc >> 4) ^ T[(crc ^ (value >> 4)) & 0x0F];
+      }
+    }
+    else
+    {
+      while (length--)
+      {
+        crc = (crc >> 8) ^ T[(crc ^ *array++) & 0xFF];
+      }
+    }
+    _crc = _reverse(crc);
+    return;
+  }
+
+  uint16_t crc = _crc;
+  if (_engine == CRC_ENGINE_NIBBLE)
+  {
+    while (length--)
+    {
+      uint8_t value = *array++;
+      crc = (crc << 4) ^ T[(crc >> 12) ^ (value >> 4)];
+      crc = (crc << 4) ^ T[(crc >> 12) ^ (value & 0x0F)];
+    }
+  }
+  else
+  {
+    while (length--)
+    {
+      crc = (crc << 8) ^ T[(crc >> 8) ^ *array++];
+    }
+  }
+  _crc = crc;
+}
+
+
 uint16_t CRC16::_reverse(uint16_t in)
 {
   uint16_t x = in;
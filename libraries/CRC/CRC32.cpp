@@ -6,10 +6,14 @@
 
 
 #include "CRC32.h"
+#include "CRC.h"
 
 
 CRC32::CRC32()
 {
+  _engine     = CRC_ENGINE_BITWISE;
+  _tableValid = false;
+  _table      = NULL;
   reset();
 }
 
@@ -25,6 +29,41 @@ CRC32::CRC32(uint32_t polynome, uint32_t XORstart, uint32_t XORend, bool reverse
   _started    = false;
   _count      = 0;
   _canYield   = true;
+  _engine     = CRC_ENGINE_BITWISE;
+  _tableValid = false;
+  _table      = NULL;
+}
+
+
+CRC32::~CRC32()
+{
+  if (_table != NULL) free(_table);
+}
+
+
+CRC32::CRC32(const CRC32 &crc)
+{
+  _engine = CRC_ENGINE_BITWISE;
+  _table  = NULL;
+  *this   = crc;
+}
+
+
+CRC32 & CRC32::operator = (const CRC32 &crc)
+{
+  if (this == &crc) return *this;
+  _polynome   = crc._polynome;
+  _startMask  = crc._startMask;
+  _endMask    = crc._endMask;
+  _crc        = crc._crc;
+  _reverseIn  = crc._reverseIn;
+  _reverseOut = crc._reverseOut;
+  _started    = crc._started;
+  _canYield   = crc._canYield;
+  _count      = crc._count;
+  //  never share the table, falls back to bitwise if allocation fails.
+  setEngine(crc._engine);
+  return *this;
 }
 
 
@@ -39,6 +78,7 @@ void CRC32::reset()
   _started    = false;
   _count      = 0;
   _canYield   = true;
+  _tableValid = false;
 }
 
 
@@ -52,18 +92,74 @@ void CRC32::restart()
 
 void CRC32::add(uint8_t value)
 {
+  if (!_started) restart();
   _count++;
   if (_canYield && ((_count & 0xFF) == 0)) yield();
-  _update(value);
+  if (_engine == CRC_ENGINE_BITWISE) _update(value);
+  else _updateBlock(&value, 1);
+}
+
+
+void CRC32::add(const uint8_t * array, size_t length)
+{
+  if (_engine == CRC_ENGINE_BITWISE)
+  {
+    while (length--)
+    {
+      add(*array++);
+    }
+    return;
+  }
+
+  if (!_started) restart();
+  //  process in chunks so yield() is still called every 256 bytes.
+  while (length > 0)
+  {
+    uint16_t n = 256 - (_count & 0xFF);
+    if (n > length) n = length;
+    _updateBlock(array, n);
+    array  += n;
+    length -= n;
+    _count += n;
+    if (_canYield && ((_count & 0xFF) == 0)) yield();
+  }
+}
+
+
+void CRC32::append(uint32_t crc, uint32_t length)
+{
+  if (!_started) restart();
+  //  undo getCRC() to get the raw register of the block.
+  crc ^= _endMask;
+  if (_reverseOut) crc = _reverse(crc);
+  _crc = crcZeroExtend(_crc ^ _startMask, length, _polynome, 32) ^ crc;
+  _count += length;
 }
 
 
-void CRC32::add(const uint8_t * array, uint16_t length)
+bool CRC32::setEngine(uint8_t engine)
 {
-  while (length--)
+  uint16_t entries = 0;
+  switch(engine)
   {
-    add(*array++);
+    case CRC_ENGINE_BITWISE: entries = 0;    break;
+    case CRC_ENGINE_NIBBLE:  entries = 16;   break;
+    case CRC_ENGINE_TABLE:   entries = 256;  break;
+    case CRC_ENGINE_SLICE4:  entries = 1024; break;
+    case CRC_ENGINE_SLICE8:  entries = 2048; break;
+    default: return false;
   }
+  if (_table != NULL) free(_table);
+  _table      = NULL;
+  _tableValid = false;
+  _engine     = CRC_ENGINE_BITWISE;
+  if (entries > 0)
+  {
+    _table = (uint32_t *) malloc(entries * sizeof(uint32_t));
+    if (_table == NULL) return false;
+  }
+  _engine = engine;
+  return true;
 }
 
 
@@ -96,6 +192,152 @@ void CRC32::_update(uint8_t value)
 }
 
 
+//  reverseIn uses a reflected table and a reflected CRC register.
+//  this removes the reverse of every input byte from the inner loop.
+void CRC32::_buildTable()
+{
+  uint8_t  bits    = (_engine == CRC_ENGINE_NIBBLE) ? 4 : 8;
+  uint16_t entries = 1 << bits;
+  uint32_t poly    = _reverseIn ? _reverse(_polynome) : _polynome;
+  for (uint16_t i = 0; i < entries; i++)
+  {
+    uint32_t crc;
+    if (_reverseIn)
+    {
+      crc = i;
+      for (uint8_t b = bits; b; b--)
+      {
+        if (crc & 1) crc = (crc >> 1) ^ poly;
+        else         crc >>= 1;
+      }
+    }
+    else
+    {
+      crc = ((uint32_t)i) << (32 - bits);
+      for (uint8_t b = bits; b; b--)
+      {
+        if (crc & (1UL << 31)) crc = (crc << 1) ^ poly;
+        else                   crc <<= 1;
+      }
+    }
+    _table[i] = crc;
+  }
+
+  //  slicing tables: T[n][i] = T[n-1][i] extended with one zero byte.
+  uint16_t last = 0;
+  if (_engine == CRC_ENGINE_SLICE4) last = 1024;
+  if (_engine == CRC_ENGINE_SLICE8) last = 2048;
+  for (uint16_t i = 256; i < last; i++)
+  {
+    uint32_t prev = _table[i - 256];
+    if (_reverseIn) _table[i] = (prev >> 8) ^ _table[prev & 0xFF];
+    else            _table[i] = (prev << 8) ^ _table[prev >> 24];
+  }
+  _tableValid = true;
+}
+
+
+void CRC32::_updateBlock(const uint8_t * array, uint16_t length)
+{
+  if (!_tableValid) _buildTable();
+  const uint32_t * T = _table;
+
+  if (_reverseIn)
+  {
+    uint32_t crc = _reverse(_crc);
+    if (_engine == CRC_ENGINE_SLICE8)
+    {
+      while (length >= 8)
+      {
+        crc ^= ((uint32_t)array[0])       | ((uint32_t)array[1] << 8) |
+               ((uint32_t)array[2] << 16) | ((uint32_t)array[3] << 24);
+        crc = T[1792 + (crc & 0xFF)] ^ T[1536 + ((crc >> 8) & 0xFF)] ^
+              T[1280 + ((crc >> 16) & 0xFF)] ^ T[1024 + (crc >> 24)] ^
+              T[768 + array[4]] ^ T[512 + array[5]] ^
+              T[256 + array[6]] ^ T[array[7]];
+        array  += 8;
+        length -= 8;
+      }
+    }
+    else if (_engine == CRC_ENGINE_SLICE4)
+    {
+      while (length >= 4)
+      {
+        crc ^= ((uint32_t)array[0])       | ((uint32_t)array[1] << 8) |
+               ((uint32_t)array[2] << 16) | ((uint32_t)array[3] << 24);
+        crc = T[768 + (crc & 0xFF)] ^ T[512 + ((crc >> 8) & 0xFF)] ^
+              T[256 + ((crc >> 16) & 0xFF)] ^ T[crc >> 24];
+        array  += 4;
+        length -= 4;
+      }
+    }
+    if (_engine == CRC_ENGINE_NIBBLE)
+    {
+      while (length--)
+      {
+        uint8_t value = *array++;
+        crc = (crc >> 4) ^ T[(crc ^ value) & 0x0F];
+        crc = (crc >> 4) ^ T[(crc ^ (value >> 4)) & 0x0F];
+      }
+    }
+    else
+    {
+      while (length--)
+      {
+        crc = (crc >> 8) ^ T[(crc ^ *array++) & 0xFF];
+      }
+    }
+    _crc = _reverse(crc);
+    return;
+  }
+
+  uint32_t crc = _crc;
+  if (_engine == CRC_ENGINE_SLICE8)
+  {
+    while (length >= 8)
+    {
+      crc ^= ((uint32_t)array[0] << 24) | ((uint32_t)array[1] << 16) |
+             ((uint32_t)array[2] << 8)  | ((uint32_t)array[3]);
+      crc = T[1792 + (crc >> 24)] ^ T[1536 + ((crc >> 16) & 0xFF)] ^
+            T[1280 + ((crc >> 8) & 0xFF)] ^ T[1024 + (crc & 0xFF)] ^
+            T[768 + array[4]] ^ T[512 + array[5]] ^
+            T[256 + array[6]] ^ T[array[7]];
+      array  += 8;
+      length -= 8;
+    }
+  }
+  else if (_engine == CRC_ENGINE_SLICE4)
+  {
+    while (length >= 4)
+    {
+      crc ^= ((uint32_t)array[0] << 24) | ((uint32_t)array[1] << 16) |
+             ((uint32_t)array[2] << 8)  | ((uint32_t)array[3]);
+      crc = T[768 + (crc >> 24)] ^ T[512 + ((crc >> 16) & 0xFF)] ^
+            T[256 + ((crc >> 8) & 0xFF)] ^ T[crc & 0xFF];
+      array  += 4;
+      length -= 4;
+    }
+  }
+  if (_engine == CRC_ENGINE_NIBBLE)
+  {
+    while (length--)
+    {
+      uint8_t value = *array++;
+      crc = (crc << 4) ^ T[(crc >> 28) ^ (value >> 4)];
+      crc = (crc << 4) ^ T[(crc >> 28) ^ (value & 0x0F)];
+    }
+  }
+  else
+  {
+    while (length--)
+    {
+      crc = (crc << 8) ^ T[(crc >> 24) ^ *array++];
+    }
+  }
+  _crc = crc;
+}
+
+
 uint32_t CRC32::_reverse(uint32_t in)
 {
   uint32_t x = in;
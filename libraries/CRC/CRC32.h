@@ -9,6 +9,7 @@
 #include "Arduino.h"
 
 #include "CRC_polynomes.h"
+#include "CRC_engines.h"
 
 
 class CRC32
@@ -16,16 +17,21 @@ class CRC32
 public:
   CRC32();
   CRC32(uint32_t polynome, uint32_t XORstart, uint32_t XORend, bool reverseIn, bool reverseOut);
+  ~CRC32();
+
+  //  a copy gets its own table, rebuilt on first use.
+  CRC32(const CRC32 &crc);
+  CRC32 & operator = (const CRC32 &crc);
 
   // set parameters to default
   void     reset();       // set all to constructor defaults
   void     restart();     // reset crc with same parameters.
 
   // set parameters
-  void     setPolynome(uint32_t polynome) { _polynome = polynome; };
+  void     setPolynome(uint32_t polynome) { _polynome = polynome; _tableValid = false; };
   void     setStartXOR(uint32_t start)    { _startMask = start; };
   void     setEndXOR(uint32_t end)        { _endMask = end; };
-  void     setReverseIn(bool reverseIn)   { _reverseIn = reverseIn; };
+  void     setReverseIn(bool reverseIn)   { _reverseIn = reverseIn; _tableValid = false; };
   void     setReverseOut(bool reverseOut) { _reverseOut = reverseOut; };
 
   // get parameters
@@ -36,19 +42,30 @@ public:
   bool     getReverseOut() { return _reverseOut; };
   
   void     add(uint8_t value);
-  void     add(const uint8_t * array, uint16_t length);
+  void     add(const uint8_t * array, size_t length);
 
   uint32_t getCRC();       // returns CRC
   uint32_t count()         { return _count; };
 
+  //  append the CRC of a next block of length bytes,
+  //  calculated with the same parameters, e.g. by another thread.
+  void     append(uint32_t crc, uint32_t length);
+
   // POWER USER ONLY
   void     enableYield()   { _canYield = true; };
   void     disableYield()  { _canYield = false; };
 
+  //  ENGINE - trade RAM for speed, see CRC_engines.h
+  //  returns false if engine is not supported or allocation failed.
+  bool     setEngine(uint8_t engine);
+  uint8_t  getEngine()     { return _engine; };
+
 private:
   uint32_t _reverse(uint32_t value);
   uint8_t  _reverse8(uint8_t value);
   void     _update(uint8_t value);
+  void     _updateBlock(const uint8_t * array, uint16_t length);
+  void     _buildTable();
 
   uint32_t _polynome;
   uint32_t _startMask;
@@ -58,6 +75,9 @@ private:
   bool     _reverseOut;
   bool     _started;
   bool     _canYield;
+  uint8_t  _engine;
+  bool     _tableValid;
+  uint32_t * _table;
   uint32_t _count;
 };
 
@@ -6,10 +6,14 @@
 
 
 #include "CRC64.h"
+#include "CRC.h"
 
 
 CRC64::CRC64()
 {
+  _engine     = CRC_ENGINE_BITWISE;
+  _tableValid = false;
+  _table      = NULL;
   reset();
 }
 
@@ -25,6 +29,41 @@ CRC64::CRC64(uint64_t polynome, uint64_t XORstart, uint64_t XORend, bool reverse
   _started    = false;
   _count      = 0;
   _canYield   = true;
+  _engine     = CRC_ENGINE_BITWISE;
+  _tableValid = false;
+  _table      = NULL;
+}
+
+
+CRC64::~CRC64()
+{
+  if (_table != NULL) free(_table);
+}
+
+
+CRC64::CRC64(const CRC64 &crc)
+{
+  _engine = CRC_ENGINE_BITWISE;
+  _table  = NULL;
+  *this   = crc;
+}
+
+
+CRC64 & CRC64::operator = (const CRC64 &crc)
+{
+  if (this == &crc) return *this;
+  _polynome   = crc._polynome;
+  _startMask  = crc._startMask;
+  _endMask    = crc._endMask;
+  _crc        = crc._crc;
+  _reverseIn  = crc._reverseIn;
+  _reverseOut = crc._reverseOut;
+  _started    = crc._started;
+  _canYield   = crc._canYield;
+  _count      = crc._count;
+  //  never share the table, falls back to bitwise if allocation fails.
+  setEngine(crc._engine);
+  return *this;
 }
 
 
@@ -39,6 +78,7 @@ void CRC64::reset()
   _started    = false;
   _count      = 0;
   _canYield   = true;
+  _tableValid = false;
 }
 
 
@@ -52,18 +92,74 @@ void CRC64::restart()
 
 void CRC64::add(uint8_t value)
 {
+  if (!_started) restart();
   _count++;
   if (_canYield && ((_count & 0xFF) == 0)) yield();
-  _update(value);
+  if (_engine == CRC_ENGINE_BITWISE) _update(value);
+  else _updateBlock(&value, 1);
+}
+
+
+void CRC64::add(const uint8_t * array, size_t length)
+{
+  if (_engine == CRC_ENGINE_BITWISE)
+  {
+    while (length--)
+    {
+      add(*array++);
+    }
+    return;
+  }
+
+  if (!_started) restart();
+  //  process in chunks so yield() is still called every 256 bytes.
+  while (length > 0)
+  {
+    uint16_t n = 256 - (_count & 0xFF);
+    if (n > length) n = length;
+    _updateBlock(array, n);
+    array  += n;
+    length -= n;
+    _count += n;
+    if (_canYield && ((_count & 0xFF) == 0)) yield();
+  }
+}
+
+
+void CRC64::append(uint64_t crc, uint64_t length)
+{
+  if (!_started) restart();
+  //  undo getCRC() to get the raw register of the block.
+  crc ^= _endMask;
+  if (_reverseOut) crc = _reverse(crc);
+  _crc = crcZeroExtend(_crc ^ _startMask, length, _polynome, 64) ^ crc;
+  _count += length;
 }
 
 
-void CRC64::add(const uint8_t * array, uint16_t length)
+bool CRC64::setEngine(uint8_t engine)
 {
-  while (length--)
+  uint16_t entries = 0;
+  switch(engine)
   {
-    add(*array++);
+    case CRC_ENGINE_BITWISE: entries = 0;    break;
+    case CRC_ENGINE_NIBBLE:  entries = 16;   break;
+    case CRC_ENGINE_TABLE:   entries = 256;  break;
+    case CRC_ENGINE_SLICE4:  entries = 1024; break;
+    case CRC_ENGINE_SLICE8:  entries = 2048; break;
+    default: return false;
   }
+  if (_table != NULL) free(_table);
+  _table      = NULL;
+  _tableValid = false;
+  _engine     = CRC_ENGINE_BITWISE;
+  if (entries > 0)
+  {
+    _table = (uint64_t *) malloc(entries * sizeof(uint64_t));
+    if (_table == NULL) return false;
+  }
+  _engine = engine;
+  return true;
 }
 
 
@@ -96,6 +192,161 @@ void CRC64::_update(uint8_t value)
 }
 
 
+//  reverseIn uses a reflected table and a reflected CRC register.
+//  this removes the reverse of every input byte from the inner loop.
+void CRC64::_buildTable()
+{
+  uint8_t  bits    = (_engine == CRC_ENGINE_NIBBLE) ? 4 : 8;
+  uint16_t entries = 1 << bits;
+  uint64_t poly    = _reverseIn ? _reverse(_polynome) : _polynome;
+  for (uint16_t i = 0; i < entries; i++)
+  {
+    uint64_t crc;
+    if (_reverseIn)
+    {
+      crc = i;
+      for (uint8_t b = bits; b; b--)
+      {
+        if (crc & 1) crc = (crc >> 1) ^ poly;
+        else         crc >>= 1;
+      }
+    }
+    else
+    {
+      crc = ((uint64_t)i) << (64 - bits);
+      for (uint8_t b = bits; b; b--)
+      {
+        if (crc & (1ULL << 63)) crc = (crc << 1) ^ poly;
+        else                    crc <<= 1;
+      }
+    }
+    _table[i] = crc;
+  }
+
+  //  slicing tables: T[n][i] = T[n-1][i] extended with one zero byte.
+  uint16_t last = 0;
+  if (_engine == CRC_ENGINE_SLICE4) last = 1024;
+  if (_engine == CRC_ENGINE_SLICE8) last = 2048;
+  for (uint16_t i = 256; i < last; i++)
+  {
+    uint64_t prev = _table[i - 256];
+    if (_reverseIn) _table[i] = (prev >> 8) ^ _table[prev & 0xFF];
+    else            _table[i] = (prev << 8) ^ _table[prev >> 56];
+  }
+  _tableValid = true;
+}
+
+
+void CRC64::_updateBlock(const uint8_t * array, uint16_t length)
+{
+  if (!_tableValid) _buildTable();
+  const uint64_t * T = _table;
+
+  if (_reverseIn)
+  {
+    uint64_t crc = _reverse(_crc);
+    if (_engine == CRC_ENGINE_SLICE8)
+    {
+      while (length >= 8)
+      {
+        uint32_t lo = ((uint32_t)array[0])       | ((uint32_t)array[1] << 8) |
+                      ((uint32_t)array[2] << 16) | ((uint32_t)array[3] << 24);
+        uint32_t hi = ((uint32_t)array[4])       | ((uint32_t)array[5] << 8) |
+                      ((uint32_t)array[6] << 16) | ((uint32_t)array[7] << 24);
+        crc ^= (((uint64_t)hi) << 32) | lo;
+        crc = T[1792 + (crc & 0xFF)]         ^ T[1536 + ((crc >> 8) & 0xFF)]  ^
+              T[1280 + ((crc >> 16) & 0xFF)] ^ T[1024 + ((crc >> 24) & 0xFF)] ^
+              T[768 + ((crc >> 32) & 0xFF)]  ^ T[512 + ((crc >> 40) & 0xFF)]  ^
+              T[256 + ((crc >> 48) & 0xFF)]  ^ T[crc >> 56];
+        array  += 8;
+        length -= 8;
+      }
+    }
+    else if (_engine == CRC_ENGINE_SLICE4)
+    {
+      while (length >= 4)
+      {
+        crc ^= ((uint32_t)array[0])       | ((uint32_t)array[1] << 8) |
+               ((uint32_t)array[2] << 16) | ((uint32_t)array[3] << 24);
+        crc = (crc >> 32) ^
+              T[768 + (crc & 0xFF)] ^ T[512 + ((crc >> 8) & 0xFF)] ^
+              T[256 + ((crc >> 16) & 0xFF)] ^ T[(crc >> 24) & 0xFF];
+        array  += 4;
+        length -= 4;
+      }
+    }
+    if (_engine == CRC_ENGINE_NIBBLE)
+    {
+      while (length--)
+      {
+        uint8_t value = *array++;
+        crc = (crc >> 4) ^ T[(crc ^ value) & 0x0F];
+        crc = (crc >> 4) ^ T[(crc ^ (value >> 4)) & 0x0F];
+      }
+    }
+    else
+    {
+      while (length--)
+      {
+        crc = (crc >> 8) ^ T[(crc ^ *array++) & 0xFF];
+      }
+    }
+    _crc = _reverse(crc);
+    return;
+  }
+
+  uint64_t crc = _crc;
+  if (_engine == CRC_ENGINE_SLICE8)
+  {
+    while (length >= 8)
+    {
+      uint32_t hi = ((uint32_t)array[0] << 24) | ((uint32_t)array[1] << 16) |
+                    ((uint32_t)array[2] << 8)  | ((uint32_t)array[3]);
+      uint32_t lo = ((uint32_t)array[4] << 24) | ((uint32_t)array[5] << 16) |
+                    ((uint32_t)array[6] << 8)  | ((uint32_t)array[7]);
+      crc ^= (((uint64_t)hi) << 32) | lo;
+      crc = T[1792 + (crc >> 56)]          ^ T[1536 + ((crc >> 48) & 0xFF)] ^
+            T[1280 + ((crc >> 40) & 0xFF)] ^ T[1024 + ((crc >> 32) & 0xFF)] ^
+            T[768 + ((crc >> 24) & 0xFF)]  ^ T[512 + ((crc >> 16) & 0xFF)]  ^
+            T[256 + ((crc >> 8) & 0xFF)]   ^ T[crc & 0xFF];
+      array  += 8;
+      length -= 8;
+    }
+  }
+  else if (_engine == CRC_ENGINE_SLICE4)
+  {
+    while (length >= 4)
+    {
+      uint32_t hi = ((uint32_t)array[0] << 24) | ((uint32_t)array[1] << 16) |
+                    ((uint32_t)array[2] << 8)  | ((uint32_t)array[3]);
+      crc ^= ((uint64_t)hi) << 32;
+      crc = (crc << 32) ^
+            T[768 + (crc >> 56)] ^ T[512 + ((crc >> 48) & 0xFF)] ^
+            T[256 + ((crc >> 40) & 0xFF)] ^ T[(crc >> 32) & 0xFF];
+      array  += 4;
+      length -= 4;
+    }
+  }
+  if (_engine == CRC_ENGINE_NIBBLE)
+  {
+    while (length--)
+    {
+      uint8_t value = *array++;
+      crc = (crc << 4) ^ T[(crc >> 60) ^ (value >> 4)];
+      crc = (crc << 4) ^ T[(crc >> 60) ^ (value & 0x0F)];
+    }
+  }
+  else
+  {
+    while (length--)
+    {
+      crc = (crc << 8) ^ T[(crc >> 56) ^ *array++];
+    }
+  }
+  _crc = crc;
+}
+
+
 uint64_t CRC64::_reverse(uint64_t in)
 {
   uint64_t x = in;
@@ -9,6 +9,7 @@
 #include "Arduino.h"
 
 #include "CRC_polynomes.h"
+#include "CRC_engines.h"
 
 
 class CRC64
@@ -16,16 +17,21 @@ class CRC64
 public:
   CRC64();
   CRC64(uint64_t polynome, uint64_t XORstart, uint64_t XORend, bool reverseIn, bool reverseOut);
+  ~CRC64();
+
+  //  a copy gets its own table, rebuilt on first use.
+  CRC64(const CRC64 &crc);
+  CRC64 & operator = (const CRC64 &crc);
 
   // set parameters to default
   void     reset();       // set all to constructor defaults
   void     restart();     // reset crc with same parameters.
 
   // set parameters
-  void     setPolynome(uint64_t polynome) { _polynome = polynome; };
+  void     setPolynome(uint64_t polynome) { _polynome = polynome; _tableValid = false; };
   void     setStartXOR(uint64_t start)    { _startMask = start; };
   void     setEndXOR(uint64_t end)        { _endMask = end; };
-  void     setReverseIn(bool reverseIn)   { _reverseIn = reverseIn; };
+  void     setReverseIn(bool reverseIn)   { _reverseIn = reverseIn; _tableValid = false; };
   void     setReverseOut(bool reverseOut) { _reverseOut = reverseOut; };
 
   // get parameters
@@ -36,19 +42,30 @@ public:
   bool     getReverseOut() { return _reverseOut; };
 
   void     add(uint8_t value);
-  void     add(const uint8_t * array, uint16_t length);
+  void     add(const uint8_t * array, size_t length);
 
   uint64_t getCRC();       // returns CRC
   uint64_t count()         { return _count; };
 
+  //  append the CRC of a next block of length bytes,
+  //  calculated with the same parameters, e.g. by another thread.
+  void     append(uint64_t crc, uint64_t length);
+
   // POWER USER ONLY
   void     enableYield()   { _canYield = true; };
   void     disableYield()  { _canYield = false; };
 
+  //  ENGINE - trade RAM for speed, see CRC_engines.h
+  //  returns false if engine is not supported or allocation failed.
+  bool     setEngine(uint8_t engine);
+  uint8_t  getEngine()     { return _engine; };
+
 private:
   uint64_t _reverse(uint64_t value);
   uint8_t  _reverse8(uint8_t value);
   void     _update(uint8_t value);
+  void     _updateBlock(const uint8_t * array, uint16_t length);
+  void     _buildTable();
 
   uint64_t _polynome;
   uint64_t _startMask;
@@ -58,6 +75,9 @@ private:
   bool     _reverseOut;
   bool     _started;
   bool     _canYield;
+  uint8_t  _engine;
+  bool     _tableValid;
+  uint64_t * _table;
   uint64_t _count;
 };
 
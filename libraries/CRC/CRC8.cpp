@@ -6,10 +6,14 @@
 
 
 #include "CRC8.h"
+#include "CRC.h"
 
 
 CRC8::CRC8()
 {
+  _engine     = CRC_ENGINE_BITWISE;
+  _tableValid = false;
+  _table      = NULL;
   reset();
 }
 
@@ -25,6 +29,41 @@ CRC8::CRC8(uint8_t polynome, uint8_t XORstart, uint8_t XORend, bool reverseIn, b
   _started    = false;
   _count      = 0;
   _canYield   = true;
+  _engine     = CRC_ENGINE_BITWISE;
+  _tableValid = false;
+  _table      = NULL;
+}
+
+
+CRC8::~CRC8()
+{
+  if (_table != NULL) free(_table);
+}
+
+
+CRC8::CRC8(const CRC8 &crc)
+{
+  _engine = CRC_ENGINE_BITWISE;
+  _table  = NULL;
+  *this   = crc;
+}
+
+
+CRC8 & CRC8::operator = (const CRC8 &crc)
+{
+  if (this == &crc) return *this;
+  _polynome   = crc._polynome;
+  _startMask  = crc._startMask;
+  _endMask    = crc._endMask;
+  _crc        = crc._crc;
+  _reverseIn  = crc._reverseIn;
+  _reverseOut = crc._reverseOut;
+  _started    = crc._started;
+  _canYield   = crc._canYield;
+  _count      = crc._count;
+  //  never share the table, falls back to bitwise if allocation fails.
+  setEngine(crc._engine);
+  return *this;
 }
 
 
@@ -38,6 +77,8 @@ void CRC8::reset()
   _reverseOut = false;
   _started    = false;
   _count      = 0;
+  _canYield   = true;
+  _tableValid = false;
 }
 
 
@@ -51,18 +92,72 @@ void CRC8::restart()
 
 void CRC8::add(uint8_t value)
 {
+  if (!_started) restart();
   _count++;
   if (_canYield && ((_count & 0xFF) == 0)) yield();
-  _update(value);
+  if (_engine == CRC_ENGINE_BITWISE) _update(value);
+  else _updateBlock(&value, 1);
 }
 
 
-void CRC8::add(const uint8_t * array, uint16_t length)
+void CRC8::add(const uint8_t * array, size_t length)
 {
-  while (length--)
+  if (_engine == CRC_ENGINE_BITWISE)
+  {
+    while (length--)
+    {
+      add(*array++);
+    }
+    return;
+  }
+
+  if (!_started) restart();
+  //  process in chunks so yield() is still called every 256 bytes.
+  while (length > 0)
+  {
+    uint16_t n = 256 - (_count & 0xFF);
+    if (n > length) n = length;
+    _updateBlock(array, n);
+    array  += n;
+    length -= n;
+    _count += n;
+    if (_canYield && ((_count & 0xFF) == 0)) yield();
+  }
+}
+
+
+void CRC8::append(uint8_t crc, uint32_t length)
+{
+  if (!_started) restart();
+  //  undo getCRC() to get the raw register of the block.
+  crc ^= _endMask;
+  if (_reverseOut) crc = _reverse(crc);
+  _crc = crcZeroExtend(_crc ^ _startMask, length, _polynome, 8) ^ crc;
+  _count += length;
+}
+
+
+bool CRC8::setEngine(uint8_t engine)
+{
+  uint16_t entries = 0;
+  switch(engine)
+  {
+    case CRC_ENGINE_BITWISE: entries = 0;    break;
+    case CRC_ENGINE_NIBBLE:  entries = 16;   break;
+    case CRC_ENGINE_TABLE:   entries = 256;  break;
+    default: return false;
+  }
+  if (_table != NULL) free(_table);
+  _table      = NULL;
+  _tableValid = false;
+  _engine     = CRC_ENGINE_BITWISE;
+  if (entries > 0)
   {
-    add(*array++);
+    _table = (uint8_t *) malloc(entries * sizeof(uint8_t));
+    if (_table == NULL) return false;
   }
+  _engine = engine;
+  return true;
 }
 
 
@@ -95,6 +190,89 @@ void CRC8::_update(uint8_t value)
 }
 
 
+//  reverseIn uses a reflected table and a reflected CRC register.
+//  this removes the reverse of every input byte from the inner loop.
+void CRC8::_buildTable()
+{
+  uint8_t  bits    = (_engine == CRC_ENGINE_NIBBLE) ? 4 : 8;
+  uint16_t entries = 1 << bits;
+  uint8_t  poly    = _reverseIn ? _reverse(_polynome) : _polynome;
+  for (uint16_t i = 0; i < entries; i++)
+  {
+    uint8_t crc;
+    if (_reverseIn)
+    {
+      crc = i;
+      for (uint8_t b = bits; b; b--)
+      {
+        if (crc & 1) crc = (crc >> 1) ^ poly;
+        else         crc >>= 1;
+      }
+    }
+    else
+    {
+      crc = i << (8 - bits);
+      for (uint8_t b = bits; b; b--)
+      {
+        if (crc & (1 << 7)) crc = (crc << 1) ^ poly;
+        else                crc <<= 1;
+      }
+    }
+    _table[i] = crc;
+  }
+  _tableValid = true;
+}
+
+
+void CRC8::_updateBlock(const uint8_t * array, uint16_t length)
+{
+  if (!_tableValid) _buildTable();
+  const uint8_t * T = _table;
+
+  if (_reverseIn)
+  {
+    uint8_t crc = _reverse(_crc);
+    if (_engine == CRC_ENGINE_NIBBLE)
+    {
+      while (length--)
+      {
+        uint8_t value = *array++;
+        crc = (crc >> 4) ^ T[(crc ^ value) & 0x0F];
+        crc = (crc >> 4) ^ T[(crc ^ (value >> 4)) & 0x0F];
+      }
+    }
+    else
+    {
+      while (length--)
+      {
+        crc = T[crc ^ *array++];
+      }
+    }
+    _crc = _reverse(crc);
+    return;
+  }
+
+  uint8_t crc = _crc;
+  if (_engine == CRC_ENGINE_NIBBLE)
+  {
+    while (length--)
+    {
+      uint8_t value = *array++;
+      crc = (crc << 4) ^ T[(crc >> 4) ^ (value >> 4)];
+      crc = (crc << 4) ^ T[(crc >> 4) ^ (value & 0x0F)];
+    }
+  }
+  else
+  {
+    while (length--)
+    {
+      crc = T[crc ^ *array++];
+    }
+  }
+  _crc = crc;
+}
+
+
 uint8_t CRC8::_reverse(uint8_t in)
 {
   uint8_t x = in;
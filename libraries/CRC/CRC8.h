@@ -9,6 +9,7 @@
 #include "Arduino.h"
 
 #include "CRC_polynomes.h"
+#include "CRC_engines.h"
 
 
 class CRC8
@@ -16,16 +17,21 @@ class CRC8
 public:
   CRC8();
   CRC8(uint8_t polynome, uint8_t XORstart, uint8_t XORend, bool reverseIn, bool reverseOut);
+  ~CRC8();
+
+  //  a copy gets its own table, rebuilt on first use.
+  CRC8(const CRC8 &crc);
+  CRC8 & operator = (const CRC8 &crc);
 
   // set parameters to default
   void     reset();       // set all to constructor defaults
   void     restart();     // reset crc with same parameters.
 
   // set parameters
-  void     setPolynome(uint8_t polynome)  { _polynome = polynome; };
+  void     setPolynome(uint8_t polynome)  { _polynome = polynome; _tableValid = false; };
   void     setStartXOR(uint8_t start)     { _startMask = start; };
   void     setEndXOR(uint8_t end)         { _endMask = end; };
-  void     setReverseIn(bool reverseIn)   { _reverseIn = reverseIn; };
+  void     setReverseIn(bool reverseIn)   { _reverseIn = reverseIn; _tableValid = false; };
   void     setReverseOut(bool reverseOut) { _reverseOut = reverseOut; };
 
   // get parameters
@@ -36,18 +42,29 @@ public:
   bool     getReverseOut() { return _reverseOut; };
 
   void     add(uint8_t value);
-  void     add(const uint8_t * array, uint16_t length);
+  void     add(const uint8_t * array, size_t length);
 
   uint8_t  getCRC();       // returns CRC
   uint32_t count()         { return _count; };
 
+  //  append the CRC of a next block of length bytes,
+  //  calculated with the same parameters, e.g. by another thread.
+  void     append(uint8_t crc, uint32_t length);
+
   // POWER USER ONLY
   void     enableYield()   { _canYield = true; };
   void     disableYield()  { _canYield = false; };
 
+  //  ENGINE - trade RAM for speed, see CRC_engines.h
+  //  returns false if engine is not supported or allocation failed.
+  bool     setEngine(uint8_t engine);
+  uint8_t  getEngine()     { return _engine; };
+
 private:
   uint8_t  _reverse(uint8_t value);
   void     _update(uint8_t value);
+  void     _updateBlock(const uint8_t * array, uint16_t length);
+  void     _buildTable();
 
   uint8_t  _polynome;
   uint8_t  _startMask;
@@ -57,6 +74,9 @@ private:
   bool     _reverseOut;
   bool     _started;
   bool     _canYield;
+  uint8_t  _engine;
+  bool     _tableValid;
+  uint8_t  * _table;
   uint32_t _count;
 };
 
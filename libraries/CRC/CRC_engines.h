@@ -0,0 +1,25 @@
+#pragma once
+//
+//    FILE: CRC_engines.h
+//  AUTHOR: Rob Tillaart
+// PURPOSE: defines for the selectable calculation engines of the CRC classes
+//     URL: https://github.com/RobTillaart/CRC
+//
+//  ENGINE              TABLE ENTRIES   NOTES
+//  BITWISE                   0         default, smallest, slowest
+//  NIBBLE                   16         4 bits per lookup
+//  TABLE                   256         8 bits per lookup
+//  SLICE4                 1024         4 bytes per step, CRC32 + CRC64 only
+//  SLICE8                 2048         8 bytes per step, CRC32 + CRC64 only
+//
+//  RAM usage = entries x sizeof(CRC type), e.g. CRC32 + SLICE8 = 8 KB.
+
+
+#define CRC_ENGINE_BITWISE          0
+#define CRC_ENGINE_NIBBLE           1
+#define CRC_ENGINE_TABLE            2
+#define CRC_ENGINE_SLICE4           3
+#define CRC_ENGINE_SLICE8           4
+
+
+// -- END OF FILE --
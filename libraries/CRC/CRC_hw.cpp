@@ -0,0 +1,644 @@
+//
+//    FILE: CRC_hw.cpp
+//  AUTHOR: Rob Tillaart
+// PURPOSE: hardware accelerated crc32() and crc64() for x86-64 and ARMv8 hosts
+//     URL: https://github.com/RobTillaart/CRC
+//
+//  FOLDING
+//  The carry-less multiply backend folds the data 4 x 16 bytes per step.
+//  The remaining 16 byte "fold" and the tail are finished with the
+//  portable code, so no Barrett reduction is needed.
+//  Constants x^n mod P are calculated from the polynome and cached,
+//  so it works for any 32 or 64 bit polynome.
+//  Details - Intel white paper "Fast CRC Computation for Generic
+//  Polynomials Using PCLMULQDQ Instruction" (Gopal et al.)
+
+
+#include "CRC_hw.h"
+#include "CRC32.h"
+#include "CRC64.h"
+
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CRC_HW_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define CRC_HW_ARM_CRC
+#include <arm_acle.h>
+#endif
+
+#if defined(__aarch64__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#define CRC_HW_ARM_PMULL
+#include <arm_neon.h>
+#endif
+
+
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+#define CRC_HW_THREADS
+#include <thread>
+#endif
+
+
+//  the folding needs at least 64 bytes, with cached constants it beats
+//  the portable code from there (x86-64, ~250 ns fixed cost per call).
+#define CRC_HW_FOLD_MIN             64
+
+//  below this length building a slice8 table per call costs more than it gains,
+//  measured break-even with the bitwise code is ~400 bytes.
+#define CRC_HW_TABLE_MIN            512
+
+//  minimum bytes per thread and maximum number of threads.
+#define CRC_HW_THREAD_MIN           65536
+#define CRC_HW_THREAD_MAX           64
+
+
+static uint8_t _crcDetectFeatures()
+{
+  uint8_t features = CRC_HW_NONE;
+#if defined(CRC_HW_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse4.2")) features |= CRC_HW_CRC32C;
+  if (__builtin_cpu_supports("pclmul")) features |= CRC_HW_CLMUL;
+#endif
+#if defined(CRC_HW_ARM_CRC)
+  features |= (CRC_HW_CRC32C | CRC_HW_CRC32);
+#endif
+#if defined(CRC_HW_ARM_PMULL)
+  features |= CRC_HW_CLMUL;
+#endif
+  return features;
+}
+
+
+//  detected once, the features do not change at runtime.
+uint8_t crcHardwareFeatures()
+{
+  static const uint8_t features = _crcDetectFeatures();
+  return features;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+//  CRC INSTRUCTIONS
+//  registers are in the reflected domain, no pre or post inversion.
+//
+#if defined(CRC_HW_X86)
+
+__attribute__((target("sse4.2")))
+static uint32_t _crc32c_instr(uint32_t crc, const uint8_t *array, size_t length)
+{
+  uint64_t c = crc;
+  while (length >= 8)
+  {
+    uint64_t value;
+    memcpy(&value, array, 8);
+    c = _mm_crc32_u64(c, value);
+    array  += 8;
+    length -= 8;
+  }
+  crc = (uint32_t) c;
+  while (length--)
+  {
+    crc = _mm_crc32_u8(crc, *array++);
+  }
+  return crc;
+}
+
+#elif defined(CRC_HW_ARM_CRC)
+
+static uint32_t _crc32c_instr(uint32_t crc, const uint8_t *array, size_t length)
+{
+  while (length >= 8)
+  {
+    uint64_t value;
+    memcpy(&value, array, 8);
+    crc = __crc32cd(crc, value);
+    array  += 8;
+    length -= 8;
+  }
+  while (length--)
+  {
+    crc = __crc32cb(crc, *array++);
+  }
+  return crc;
+}
+
+
+static uint32_t _crc32_instr(uint32_t crc, const uint8_t *array, size_t length)
+{
+  while (length >= 8)
+  {
+    uint64_t value;
+    memcpy(&value, array, 8);
+    crc = __crc32d(crc, value);
+    array  += 8;
+    length -= 8;
+  }
+  while (length--)
+  {
+    crc = __crc32b(crc, *array++);
+  }
+  return crc;
+}
+
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+//  CARRY-LESS MULTIPLY FOLDING
+//
+//  k[0], k[1] = fold 64 bytes, k[2], k[3] = fold 16 bytes.
+//  returns bytes folded into out[16], 0 if not available.
+//
+#if defined(CRC_HW_X86)
+
+__attribute__((target("pclmul,ssse3")))
+static inline __m128i _load128(const uint8_t *array, bool reflected)
+{
+  __m128i x = _mm_loadu_si128((const __m128i *) array);
+  if (reflected) return x;
+  const __m128i swap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  return _mm_shuffle_epi8(x, swap);
+}
+
+
+__attribute__((target("pclmul,ssse3")))
+static inline __m128i _fold128(__m128i x, __m128i k, __m128i data)
+{
+  __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+  __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(lo, hi), data);
+}
+
+
+__attribute__((target("pclmul,ssse3")))
+static size_t _crcFoldX86(const uint8_t *array, size_t length, const uint64_t init[2],
+                          const uint64_t k[4], bool reflected, uint8_t *out)
+{
+  const __m128i k64 = _mm_set_epi64x(k[1], k[0]);
+  const __m128i k16 = _mm_set_epi64x(k[3], k[2]);
+  size_t done = 64;
+
+  __m128i x0 = _mm_xor_si128(_load128(array, reflected), _mm_set_epi64x(init[1], init[0]));
+  __m128i x1 = _load128(array + 16, reflected);
+  __m128i x2 = _load128(array + 32, reflected);
+  __m128i x3 = _load128(array + 48, reflected);
+  while (length - done >= 64)
+  {
+    const uint8_t *p = array + done;
+    x0 = _fold128(x0, k64, _load128(p, reflected));
+    x1 = _fold128(x1, k64, _load128(p + 16, reflected));
+    x2 = _fold128(x2, k64, _load128(p + 32, reflected));
+    x3 = _fold128(x3, k64, _load128(p + 48, reflected));
+    done += 64;
+  }
+  x0 = _fold128(x0, k16, x1);
+  x0 = _fold128(x0, k16, x2);
+  x0 = _fold128(x0, k16, x3);
+  while (length - done >= 16)
+  {
+    x0 = _fold128(x0, k16, _load128(array + done, reflected));
+    done += 16;
+  }
+  if (!reflected)
+  {
+    const __m128i swap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    x0 = _mm_shuffle_epi8(x0, swap);
+  }
+  _mm_storeu_si128((__m128i *) out, x0);
+  return done;
+}
+
+#endif
+
+
+#if defined(CRC_HW_ARM_PMULL)
+
+static inline uint64x2_t _load128(const uint8_t *array, bool reflected)
+{
+  uint8x16_t x = vld1q_u8(array);
+  if (!reflected)
+  {
+    x = vrev64q_u8(x);
+    x = vextq_u8(x, x, 8);
+  }
+  return vreinterpretq_u64_u8(x);
+}
+
+
+static inline uint64x2_t _fold128(uint64x2_t x, uint64x2_t k, uint64x2_t data)
+{
+  uint64x2_t lo = vreinterpretq_u64_p128(vmull_p64(vgetq_lane_u64(x, 0), vgetq_lane_u64(k, 0)));
+  uint64x2_t hi = vreinterpretq_u64_p128(vmull_high_p64(vreinterpretq_p64_u64(x), vreinterpretq_p64_u64(k)));
+  return veorq_u64(veorq_u64(lo, hi), data);
+}
+
+
+static size_t _crcFoldARM(const uint8_t *array, size_t length, const uint64_t init[2],
+                          const uint64_t k[4], bool reflected, uint8_t *out)
+{
+  const uint64x2_t k64 = vcombine_u64(vcreate_u64(k[0]), vcreate_u64(k[1]));
+  const uint64x2_t k16 = vcombine_u64(vcreate_u64(k[2]), vcreate_u64(k[3]));
+  size_t done = 64;
+
+  uint64x2_t x0 = veorq_u64(_load128(array, reflected), vcombine_u64(vcreate_u64(init[0]), vcreate_u64(init[1])));
+  uint64x2_t x1 = _load128(array + 16, reflected);
+  uint64x2_t x2 = _load128(array + 32, reflected);
+  uint64x2_t x3 = _load128(array + 48, reflected);
+  while (length - done >= 64)
+  {
+    const uint8_t *p = array + done;
+    x0 = _fold128(x0, k64, _load128(p, reflected));
+    x1 = _fold128(x1, k64, _load128(p + 16, reflected));
+    x2 = _fold128(x2, k64, _load128(p + 32, reflected));
+    x3 = _fold128(x3, k64, _load128(p + 48, reflected));
+    done += 64;
+  }
+  x0 = _fold128(x0, k16, x1);
+  x0 = _fold128(x0, k16, x2);
+  x0 = _fold128(x0, k16, x3);
+  while (length - done >= 16)
+  {
+    x0 = _fold128(x0, k16, _load128(array + done, reflected));
+    done += 16;
+  }
+  uint8x16_t y = vreinterpretq_u8_u64(x0);
+  if (!reflected)
+  {
+    y = vrev64q_u8(y);
+    y = vextq_u8(y, y, 8);
+  }
+  vst1q_u8(out, y);
+  return done;
+}
+
+#endif
+
+
+#if defined(CRC_HW_X86) || defined(CRC_HW_ARM_PMULL)
+
+//  x^n mod P, P = x^width + polynome
+static uint64_t _xpowmod(uint16_t n, uint64_t polynome, uint8_t width)
+{
+  uint64_t topbit = 1ULL << (width - 1);
+  uint64_t mask   = (width == 64) ? 0xFFFFFFFFFFFFFFFFULL : ((1ULL << width) - 1);
+  uint64_t r = 1;
+  while (n--)
+  {
+    bool carry = (r & topbit) != 0;
+    r = (r << 1) & mask;
+    if (carry) r ^= polynome;
+  }
+  return r;
+}
+
+
+static void _crcFoldConstants(uint64_t polynome, uint8_t width, bool reflected, uint64_t k[4])
+{
+  if (reflected)
+  {
+    //  reflected clmul gives the product shifted one bit, compensate with x^(n-1).
+    k[0] = reverse64(_xpowmod(512 + 63, polynome, width));
+    k[1] = reverse64(_xpowmod(512 - 1,  polynome, width));
+    k[2] = reverse64(_xpowmod(128 + 63, polynome, width));
+    k[3] = reverse64(_xpowmod(128 - 1,  polynome, width));
+  }
+  else
+  {
+    k[0] = _xpowmod(512,      polynome, width);
+    k[1] = _xpowmod(512 + 64, polynome, width);
+    k[2] = _xpowmod(128,      polynome, width);
+    k[3] = _xpowmod(128 + 64, polynome, width);
+  }
+}
+
+
+//  CONSTANTS CACHE
+//  calculating the constants takes ~2000 shift steps, so they are kept
+//  for the last CRC_HW_CACHE_SIZE polynomes used.
+//  Entries are written once, a slot is claimed with compare and swap,
+//  so concurrent callers (crc32_parallel) never see a half written entry.
+//  When all slots are used the constants are calculated per call.
+#define CRC_HW_CACHE_SIZE           8
+
+#define CRC_HW_SLOT_EMPTY           0
+#define CRC_HW_SLOT_WRITING         1
+#define CRC_HW_SLOT_READY           2
+
+struct _crcFoldEntry
+{
+  uint8_t  state;
+  uint8_t  width;
+  bool     reflected;
+  uint64_t polynome;
+  uint64_t k[4];
+};
+
+static _crcFoldEntry _crcFoldCache[CRC_HW_CACHE_SIZE];
+
+
+static void _crcFoldLookup(uint64_t polynome, uint8_t width, bool reflected, uint64_t k[4])
+{
+  for (uint8_t i = 0; i < CRC_HW_CACHE_SIZE; i++)
+  {
+    _crcFoldEntry &e = _crcFoldCache[i];
+    uint8_t state = __atomic_load_n(&e.state, __ATOMIC_ACQUIRE);
+    if (state == CRC_HW_SLOT_EMPTY) break;    //  slots are filled in order
+    if ((state == CRC_HW_SLOT_READY) && (e.polynome == polynome) &&
+        (e.width == width) && (e.reflected == reflected))
+    {
+      memcpy(k, e.k, sizeof(e.k));
+      return;
+    }
+  }
+
+  _crcFoldConstants(polynome, width, reflected, k);
+
+  for (uint8_t i = 0; i < CRC_HW_CACHE_SIZE; i++)
+  {
+    _crcFoldEntry &e = _crcFoldCache[i];
+    uint8_t expected = CRC_HW_SLOT_EMPTY;
+    if (__atomic_compare_exchange_n(&e.state, &expected, CRC_HW_SLOT_WRITING,
+                                    false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      e.polynome  = polynome;
+      e.width     = width;
+      e.reflected = reflected;
+      memcpy(e.k, k, sizeof(e.k));
+      __atomic_store_n(&e.state, CRC_HW_SLOT_READY, __ATOMIC_RELEASE);
+      return;
+    }
+  }
+}
+
+
+//  folds the crc register and the data into out[16].
+//  returns bytes consumed (multiple of 16), 0 if no carry-less multiply.
+static size_t _crcFold(uint64_t crc, const uint8_t *array, size_t length,
+                       uint64_t polynome, uint8_t width, bool reflected, uint8_t *out)
+{
+  if ((crcHardwareFeatures() & CRC_HW_CLMUL) == 0) return 0;
+
+  uint64_t k[4];
+  uint64_t init[2] = { 0, 0 };
+  _crcFoldLookup(polynome, width, reflected, k);
+  if (reflected)
+  {
+    init[0] = reverse64(crc) >> (64 - width);
+  }
+  else
+  {
+    init[1] = crc << (64 - width);
+  }
+
+#if defined(CRC_HW_X86)
+  return _crcFoldX86(array, length, init, k, reflected, out);
+#else
+  return _crcFoldARM(array, length, init, k, reflected, out);
+#endif
+}
+
+#else
+
+static size_t _crcFold(uint64_t crc, const uint8_t *array, size_t length,
+                       uint64_t polynome, uint8_t width, bool reflected, uint8_t *out)
+{
+  (void) crc;
+  (void) array;
+  (void) length;
+  (void) polynome;
+  (void) width;
+  (void) reflected;
+  (void) out;
+  return 0;
+}
+
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+//  CRC32
+//
+//  portable fallback, returns the CRC register.
+static uint32_t _crc32_portable(uint32_t crc, const uint8_t *array, size_t length,
+                                uint32_t polynome, bool reverseIn)
+{
+  if (length < CRC_HW_TABLE_MIN)
+  {
+    return crc32(array, length, polynome, crc, 0, reverseIn, false);
+  }
+  CRC32 engine(polynome, crc, 0, reverseIn, false);
+  engine.setEngine(CRC_ENGINE_SLICE8);  //  if it fails BITWISE is used.
+  engine.add(array, length);
+  return engine.getCRC();
+}
+
+
+uint32_t crc32_hw(const uint8_t *array, size_t length, const uint32_t polynome,
+                  const uint32_t startmask, const uint32_t endmask,
+                  const bool reverseIn, const bool reverseOut)
+{
+  uint32_t crc = startmask;
+  uint8_t features = crcHardwareFeatures();
+
+#if defined(CRC_HW_X86) || defined(CRC_HW_ARM_CRC)
+  if (reverseIn && (polynome == CRC32_CASTAGNOLI) && (features & CRC_HW_CRC32C))
+  {
+    crc = reverse32(_crc32c_instr(reverse32(crc), array, length));
+    length = 0;
+  }
+#endif
+#if defined(CRC_HW_ARM_CRC)
+  if (reverseIn && (polynome == CRC32_ISO3309) && (features & CRC_HW_CRC32))
+  {
+    crc = reverse32(_crc32_instr(reverse32(crc), array, length));
+    length = 0;
+  }
+#endif
+
+  if ((length >= CRC_HW_FOLD_MIN) && (features & CRC_HW_CLMUL))
+  {
+    uint8_t buffer[32];
+    size_t done = _crcFold(crc, array, length, polynome, 32, reverseIn, buffer);
+    if (done > 0)
+    {
+      size_t rest = length - done;
+      memcpy(buffer + 16, array + done, rest);
+      crc = crc32(buffer, 16 + rest, polynome, 0, 0, reverseIn, false);
+      length = 0;
+    }
+  }
+
+  if (length > 0)
+  {
+    crc = _crc32_portable(crc, array, length, polynome, reverseIn);
+  }
+
+  //  same order as crc32()
+  crc ^= endmask;
+  if (reverseOut) crc = reverse32(crc);
+  return crc;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+//  CRC64
+//
+//  portable fallback, returns the CRC register.
+static uint64_t _crc64_portable(uint64_t crc, const uint8_t *array, size_t length,
+                                uint64_t polynome, bool reverseIn)
+{
+  if (length < CRC_HW_TABLE_MIN)
+  {
+    return crc64(array, length, polynome, crc, 0, reverseIn, false);
+  }
+  CRC64 engine(polynome, crc, 0, reverseIn, false);
+  engine.setEngine(CRC_ENGINE_SLICE8);  //  if it fails BITWISE is used.
+  engine.add(array, length);
+  return engine.getCRC();
+}
+
+
+uint64_t crc64_hw(const uint8_t *array, size_t length, const uint64_t polynome,
+                  const uint64_t startmask, const uint64_t endmask,
+                  const bool reverseIn, const bool reverseOut)
+{
+  uint64_t crc = startmask;
+  uint8_t features = crcHardwareFeatures();
+
+  if ((length >= CRC_HW_FOLD_MIN) && (features & CRC_HW_CLMUL))
+  {
+    uint8_t buffer[32];
+    size_t done = _crcFold(crc, array, length, polynome, 64, reverseIn, buffer);
+    if (done > 0)
+    {
+      size_t rest = length - done;
+      memcpy(buffer + 16, array + done, rest);
+      crc = crc64(buffer, 16 + rest, polynome, 0, 0, reverseIn, false);
+      length = 0;
+    }
+  }
+
+  if (length > 0)
+  {
+    crc = _crc64_portable(crc, array, length, polynome, reverseIn);
+  }
+
+  //  same order as crc64()
+  crc ^= endmask;
+  if (reverseOut) crc = reverse64(crc);
+  return crc;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+//  MULTITHREADED
+//
+//  every thread calculates the raw register of its chunk with the same start mask,
+//  these are merged with crcZeroExtend(), see crc32_combine().
+//
+static uint8_t _threadCount(size_t length, uint8_t threads)
+{
+#if defined(CRC_HW_THREADS)
+  if (threads == 0)
+  {
+    unsigned int cores = std::thread::hardware_concurrency();
+    threads = (cores > CRC_HW_THREAD_MAX) ? CRC_HW_THREAD_MAX : cores;
+  }
+  if (threads > CRC_HW_THREAD_MAX) threads = CRC_HW_THREAD_MAX;
+  size_t maxThreads = length / CRC_HW_THREAD_MIN;
+  if (threads > maxThreads) threads = maxThreads;
+  if (threads == 0) threads = 1;
+  return threads;
+#else
+  (void) length;
+  (void) threads;
+  return 1;
+#endif
+}
+
+
+uint32_t crc32_parallel(const uint8_t *array, size_t length, const uint32_t polynome,
+                        const uint32_t startmask, const uint32_t endmask,
+                        const bool reverseIn, const bool reverseOut, uint8_t threads)
+{
+  threads = _threadCount(length, threads);
+#if defined(CRC_HW_THREADS)
+  if (threads > 1)
+  {
+    uint32_t reg[CRC_HW_THREAD_MAX];
+    size_t chunk = length / threads;
+    std::thread workers[CRC_HW_THREAD_MAX];
+    for (uint8_t i = 1; i < threads; i++)
+    {
+      size_t len = (i == threads - 1) ? (length - i * chunk) : chunk;
+      workers[i] = std::thread([=, &reg]()
+      {
+        reg[i] = crc32_hw(array + i * chunk, len, polynome, startmask, 0, reverseIn, false);
+      });
+    }
+    reg[0] = crc32_hw(array, chunk, polynome, startmask, 0, reverseIn, false);
+    for (uint8_t i = 1; i < threads; i++) workers[i].join();
+
+    uint32_t crc = reg[0];
+    for (uint8_t i = 1; i < threads; i++)
+    {
+      size_t len = (i == threads - 1) ? (length - i * chunk) : chunk;
+      crc = crcZeroExtend(crc ^ startmask, len, polynome, 32) ^ reg[i];
+    }
+    //  same order as crc32()
+    crc ^= endmask;
+    if (reverseOut) crc = reverse32(crc);
+    return crc;
+  }
+#endif
+  return crc32_hw(array, length, polynome, startmask, endmask, reverseIn, reverseOut);
+}
+
+
+uint64_t crc64_parallel(const uint8_t *array, size_t length, const uint64_t polynome,
+                        const uint64_t startmask, const uint64_t endmask,
+                        const bool reverseIn, const bool reverseOut, uint8_t threads)
+{
+  threads = _threadCount(length, threads);
+#if defined(CRC_HW_THREADS)
+  if (threads > 1)
+  {
+    uint64_t reg[CRC_HW_THREAD_MAX];
+    size_t chunk = length / threads;
+    std::thread workers[CRC_HW_THREAD_MAX];
+    for (uint8_t i = 1; i < threads; i++)
+    {
+      size_t len = (i == threads - 1) ? (length - i * chunk) : chunk;
+      workers[i] = std::thread([=, &reg]()
+      {
+        reg[i] = crc64_hw(array + i * chunk, len, polynome, startmask, 0, reverseIn, false);
+      });
+    }
+    reg[0] = crc64_hw(array, chunk, polynome, startmask, 0, reverseIn, false);
+    for (uint8_t i = 1; i < threads; i++) workers[i].join();
+
+    uint64_t crc = reg[0];
+    for (uint8_t i = 1; i < threads; i++)
+    {
+      size_t len = (i == threads - 1) ? (length - i * chunk) : chunk;
+      crc = crcZeroExtend(crc ^ startmask, len, polynome, 64) ^ reg[i];
+    }
+    //  same order as crc64()
+    crc ^= endmask;
+    if (reverseOut) crc = reverse64(crc);
+    return crc;
+  }
+#endif
+  return crc64_hw(array, length, polynome, startmask, endmask, reverseIn, reverseOut);
+}
+
+
+// -- END OF FILE --
@@ -0,0 +1,45 @@
+#pragma once
+//
+//    FILE: CRC_hw.h
+//  AUTHOR: Rob Tillaart
+// PURPOSE: hardware accelerated crc32() and crc64() for x86-64 and ARMv8 hosts
+//     URL: https://github.com/RobTillaart/CRC
+//
+//  x86-64 : runtime detection of SSE4.2 (CRC32C) and PCLMULQDQ.
+//  ARMv8  : compile time detection of the CRC32 and PMULL (crypto) extensions,
+//           e.g. -march=armv8-a+crc+crypto
+//  other  : falls back to the portable table code.
+//
+//  Results are identical to the crc32() and crc64() functions in CRC.h.
+
+
+#include "Arduino.h"
+
+#include "CRC.h"
+
+
+//  crcHardwareFeatures() bit mask
+#define CRC_HW_NONE                 0x00
+#define CRC_HW_CRC32C               0x01    //  CRC32C instruction, Castagnoli
+#define CRC_HW_CRC32                0x02    //  CRC32 instruction, ISO3309 (ARM only)
+#define CRC_HW_CLMUL                0x04    //  carry-less multiply, any polynome
+
+
+uint8_t  crcHardwareFeatures();
+
+
+//  same parameters and defaults as crc32() and crc64().
+uint32_t crc32_hw(const uint8_t *array, size_t length, const uint32_t polynome = 0x04C11DB7, const uint32_t startmask = 0, const uint32_t endmask = 0, const bool reverseIn = false, const bool reverseOut = false);
+
+uint64_t crc64_hw(const uint8_t *array, size_t length, const uint64_t polynome = 0x42F0E1EBA9EA3693, const uint64_t startmask = 0, const uint64_t endmask = 0, const bool reverseIn = false, const bool reverseOut = false);
+
+
+//  MULTITHREADED (Linux, macOS, Windows hosts)
+//  splits the array over threads and combines the partial CRC's.
+//  threads = 0 uses all cores. Other platforms run single threaded.
+uint32_t crc32_parallel(const uint8_t *array, size_t length, const uint32_t polynome = 0x04C11DB7, const uint32_t startmask = 0, const uint32_t endmask = 0, const bool reverseIn = false, const bool reverseOut = false, uint8_t threads = 0);
+
+uint64_t crc64_parallel(const uint8_t *array, size_t length, const uint64_t polynome = 0x42F0E1EBA9EA3693, const uint64_t startmask = 0, const uint64_t endmask = 0, const bool reverseIn = false, const bool reverseOut = false, uint8_t threads = 0);
+
+
+// -- END OF FILE --
@@ -0,0 +1,124 @@
+#pragma once
+//
+//    FILE: ChecksumPrint.h
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: Print wrapper that calculates a checksum over everything printed.
+//     URL: https://github.com/RobTillaart/CRC
+//
+//  Forwards all writes to an optional downstream Print (Serial, File,
+//  XMLWriter, ...) and feeds the bytes in blocks of BUFSIZE to the checksum.
+//
+//  T       = checksum class with an add(const W * array, size_t length),
+//            e.g. CRC16, CRC32, Adler32, Fletcher16.
+//  W       = word type of that add(), uint8_t for CRC and Adler,
+//            uint16_t for Fletcher32, uint32_t for Fletcher64.
+//  BUFSIZE = staging buffer in bytes, must be a multiple of sizeof(W).
+//
+//  For W wider than a byte the words are assembled in native byte order
+//  and a trailing incomplete word is not part of the checksum.
+
+
+#include "Arduino.h"
+
+
+template <class T, class W = uint8_t, uint8_t BUFSIZE = 32>
+class ChecksumPrint : public Print
+{
+public:
+  ChecksumPrint(Print * stream = NULL)
+  {
+    _stream = stream;
+    _index  = 0;
+    _count  = 0;
+  }
+
+
+  void     setStream(Print * stream) { _stream = stream; };
+  Print *  getStream()               { return _stream; };
+
+
+  size_t   write(uint8_t c)
+  {
+    if (_stream != NULL)
+    {
+      if (_stream->write(c) == 0) return 0;
+    }
+    _bytes()[_index++] = c;
+    _count++;
+    if (_index == BUFSIZE) _process();
+    return 1;
+  }
+
+
+  size_t   write(const uint8_t * buffer, size_t size)
+  {
+    //  only hash what actually went out.
+    if (_stream != NULL) size = _stream->write(buffer, size);
+    _count += size;
+
+    size_t len = size;
+    //  byte oriented checksums can skip the staging buffer.
+    if ((sizeof(W) == 1) && (_index == 0) && (len >= BUFSIZE))
+    {
+      _checksum.add((const W *) buffer, len);
+      return size;
+    }
+    while (len > 0)
+    {
+      uint8_t n = BUFSIZE - _index;
+      if (n > len) n = len;
+      memcpy(_bytes() + _index, buffer, n);
+      _index += n;
+      buffer += n;
+      len    -= n;
+      if (_index == BUFSIZE) _process();
+    }
+    return size;
+  }
+
+
+  void     flush()
+  {
+    if (_stream != NULL) _stream->flush();
+  }
+
+
+  //  adds all buffered complete words before returning the checksum object.
+  T &      checksum()
+  {
+    _process();
+    return _checksum;
+  };
+
+
+  //  number of bytes written
+  uint32_t count()  { return _count; };
+  //  clears buffer and count, the checksum object itself must be
+  //  reset by the user, e.g. checksum().reset() or checksum().begin()
+  void     reset()  { _index = 0; _count = 0; };
+
+
+private:
+  Print *  _stream;
+  T        _checksum;
+  W        _buffer[BUFSIZE / sizeof(W)];
+  uint8_t  _index;
+  uint32_t _count;
+
+  uint8_t * _bytes() { return (uint8_t *) _buffer; };
+
+  void     _process()
+  {
+    uint8_t words = _index / sizeof(W);
+    if (words == 0) return;
+    _checksum.add((const W *) _buffer, words);
+    //  keep incomplete word.
+    uint8_t rest = _index - words * sizeof(W);
+    if (rest > 0) memmove(_bytes(), _bytes() + words * sizeof(W), rest);
+    _index = rest;
+  }
+};
+
+
+// -- END OF FILE --
@@ -0,0 +1,62 @@
+//
+//    FILE: CRC32_append.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: demo update a stored CRC when data is appended, without rescanning.
+//    DATE: 2026-10-17
+//    (c) : MIT
+
+
+#include "CRC.h"
+#include "CRC32.h"
+
+
+char logPart1[] = "2026-10-17 12:00:00 sensor A = 21.5\n";
+char logPart2[] = "2026-10-17 12:01:00 sensor A = 21.7\n";
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.println();
+
+  uint16_t len1 = strlen(logPart1);
+  uint16_t len2 = strlen(logPart2);
+
+  //  stored CRC of the log so far
+  CRC32 crc(CRC32_ISO3309, 0xFFFFFFFF, 0xFFFFFFFF, true, true);
+  crc.add((uint8_t *)logPart1, len1);
+  uint32_t stored = crc.getCRC();
+  Serial.print("stored:\t\t");
+  Serial.println(stored, HEX);
+
+  //  CRC of the appended part only
+  uint32_t part = crc32((uint8_t *)logPart2, len2, CRC32_ISO3309, 0xFFFFFFFF, 0xFFFFFFFF, true, true);
+
+  //  combine with the function
+  uint32_t combined = crc32_combine(stored, part, len2, CRC32_ISO3309, 0xFFFFFFFF, 0xFFFFFFFF, true);
+  Serial.print("combined:\t");
+  Serial.println(combined, HEX);
+
+  //  or append with the class
+  crc.append(part, len2);
+  Serial.print("append:\t\t");
+  Serial.println(crc.getCRC(), HEX);
+
+  //  reference, full scan
+  crc.restart();
+  crc.add((uint8_t *)logPart1, len1);
+  crc.add((uint8_t *)logPart2, len2);
+  Serial.print("reference:\t");
+  Serial.println(crc.getCRC(), HEX);
+
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+// -- END OF FILE --
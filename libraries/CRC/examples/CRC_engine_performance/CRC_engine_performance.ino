@@ -0,0 +1,83 @@
+//
+//    FILE: CRC_engine_performance.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: compare the performance of the CRC32 engines
+//    DATE: 2026-10-17
+//    (c) : MIT
+
+
+#include "CRC32.h"
+
+
+char str[] = "Lorem ipsum dolor sit amet, \
+consectetuer adipiscing elit. Aenean commodo ligula eget dolor. \
+Aenean massa. Cum sociis natoque penatibus et magnis dis parturient \
+montes, nascetur ridiculus mus. Donec quam felis, ultricies nec, \
+pellentesque eu, pretium quis, sem. Nulla consequat massa quis enim. \
+Donec pede justo, fringilla vel, aliquet nec, vulputate eget, arcu. \
+In enim justo, rhoncus ut, imperdiet a, venenatis vitae, justo. \
+Nullam dictum felis eu pede mollis pretium. Integer tincidunt. \
+Cras dapibus. Vivamus elementum semper nisi. \
+Aenean vulputate eleifend tellus. Aenean leo ligula, porttitor eu, \
+consequat vitae, eleifend ac, enim. Aliquam lorem ante, dapibus in, \
+viverra quis, feugiat a, tellus. Phasellus viverra nulla ut metus \
+varius laoreet. Quisque rutrum. Aenean imperdiet. Etiam ultricies \
+nisi vel augue. Curabitur ullamcorper ultricies nisi. Nam eget dui.";
+
+const char * names[] = { "BITWISE", "NIBBLE", "TABLE", "SLICE4", "SLICE8" };
+
+CRC32 crc;
+
+uint32_t start, stop;
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.println();
+
+  uint16_t length = strlen(str);
+  Serial.print("DATA: \t");
+  Serial.println(length);
+  Serial.println();
+  Serial.println("ENGINE\tCRC\t\tTIME");
+
+  for (uint8_t engine = CRC_ENGINE_BITWISE; engine <= CRC_ENGINE_SLICE8; engine++)
+  {
+    if (crc.setEngine(engine) == false)
+    {
+      Serial.print(names[engine]);
+      Serial.println("\tnot enough RAM");
+      continue;
+    }
+    crc.reset();
+    crc.setPolynome(CRC32_ISO3309);
+    crc.setStartXOR(0xFFFFFFFF);
+    crc.setEndXOR(0xFFFFFFFF);
+    crc.setReverseIn(true);
+    crc.setReverseOut(true);
+    //  first call builds the table, so measure the second run.
+    crc.add((uint8_t*)str, length);
+    crc.restart();
+
+    start = micros();
+    crc.add((uint8_t*)str, length);
+    stop = micros();
+    Serial.print(names[engine]);
+    Serial.print("\t");
+    Serial.print(crc.getCRC(), HEX);
+    Serial.print("\t");
+    Serial.println(stop - start);
+    delay(100);
+  }
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+// -- END OF FILE --
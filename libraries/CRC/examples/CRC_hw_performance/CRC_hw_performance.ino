@@ -0,0 +1,76 @@
+//
+//    FILE: CRC_hw_performance.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: compare crc32() with crc32_hw() and crc64() with crc64_hw()
+//    DATE: 2026-10-17
+//    (c) : MIT
+//
+//  on boards without hardware support the portable fallback is used.
+
+
+#include "CRC.h"
+#include "CRC_hw.h"
+
+
+uint8_t buffer[1024];
+
+uint32_t start, stop;
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("CRC_LIB_VERSION: ");
+  Serial.println(CRC_LIB_VERSION);
+  Serial.print("HW features: ");
+  Serial.println(crcHardwareFeatures(), HEX);
+  Serial.println();
+
+  for (uint16_t i = 0; i < sizeof(buffer); i++) buffer[i] = random(256);
+
+  start = micros();
+  uint32_t c1 = crc32(buffer, sizeof(buffer), CRC32_CASTAGNOLI, 0xFFFFFFFF, 0xFFFFFFFF, true, true);
+  stop = micros();
+  Serial.print("crc32:\t\t");
+  Serial.print(c1, HEX);
+  Serial.print("\t");
+  Serial.println(stop - start);
+
+  start = micros();
+  uint32_t c2 = crc32_hw(buffer, sizeof(buffer), CRC32_CASTAGNOLI, 0xFFFFFFFF, 0xFFFFFFFF, true, true);
+  stop = micros();
+  Serial.print("crc32_hw:\t");
+  Serial.print(c2, HEX);
+  Serial.print("\t");
+  Serial.println(stop - start);
+  Serial.println();
+
+  start = micros();
+  uint64_t c3 = crc64(buffer, sizeof(buffer));
+  stop = micros();
+  Serial.print("crc64:\t\t");
+  Serial.print((uint32_t)(c3 >> 32), HEX);
+  Serial.print((uint32_t)(c3), HEX);
+  Serial.print("\t");
+  Serial.println(stop - start);
+
+  start = micros();
+  uint64_t c4 = crc64_hw(buffer, sizeof(buffer));
+  stop = micros();
+  Serial.print("crc64_hw:\t");
+  Serial.print((uint32_t)(c4 >> 32), HEX);
+  Serial.print((uint32_t)(c4), HEX);
+  Serial.print("\t");
+  Serial.println(stop - start);
+
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+// -- END OF FILE --
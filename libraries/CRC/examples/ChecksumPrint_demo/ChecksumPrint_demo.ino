@@ -0,0 +1,49 @@
+//
+//    FILE: ChecksumPrint_demo.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: demo CRC32 over everything printed to Serial.
+//    DATE: 2026-10-17
+//    (c) : MIT
+
+
+#include "CRC.h"
+#include "CRC32.h"
+#include "ChecksumPrint.h"
+
+
+ChecksumPrint<CRC32> cp(&Serial);
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("CRC_LIB_VERSION: ");
+  Serial.println(CRC_LIB_VERSION);
+  Serial.println();
+
+  //  same parameters as the crc32() call below.
+  cp.checksum().setPolynome(0x04C11DB7);
+  cp.checksum().setStartXOR(0xFFFFFFFF);
+  cp.checksum().setEndXOR(0xFFFFFFFF);
+  cp.checksum().setReverseIn(true);
+  cp.checksum().setReverseOut(true);
+
+  cp.print("123456789");
+  Serial.println();
+
+  Serial.print("ChecksumPrint:\t");
+  Serial.println(cp.checksum().getCRC(), HEX);
+  Serial.print("crc32():\t");
+  Serial.println(crc32((uint8_t *) "123456789", 9, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true), HEX);
+  Serial.print("count:\t\t");
+  Serial.println(cp.count());
+}
+
+
+void loop()
+{
+}
+
+
+// -- END OF FILE --
@@ -0,0 +1,26 @@
+#pragma once
+//
+//    FILE: Arduino.h
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: minimal Arduino.h to build the checksum libraries on a host.
+//     URL: https://github.com/RobTillaart/CRC
+//
+//  Only what CRC, Adler and Fletcher need, not a generic replacement.
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+typedef uint8_t byte;
+
+#define F(x)          (x)
+#define PROGMEM
+
+inline void yield() {}
+
+
+// -- END OF FILE --
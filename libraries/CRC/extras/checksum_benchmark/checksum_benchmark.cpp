@@ -0,0 +1,594 @@
+//
+//    FILE: checksum_benchmark.cpp
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: host benchmark for the CRC, Adler and Fletcher libraries.
+//     URL: https://github.com/RobTillaart/CRC
+//
+//  Measures MB/s and cycles/byte for every width and engine,
+//  over buffer sizes, alignments and cold / warm cache.
+//  Output as CSV or JSON, optional compare with a baseline CSV.
+//  See README.md in this folder for build and usage.
+
+
+#include "Arduino.h"
+
+#include "CRC.h"
+#include "CRC8.h"
+#include "CRC12.h"
+#include "CRC16.h"
+#include "CRC32.h"
+#include "CRC64.h"
+#include "CRC_hw.h"
+
+#include "Adler16.h"
+#include "Adler32.h"
+
+#include "Fletcher.h"
+#include "Fletcher16.h"
+#include "Fletcher32.h"
+#include "Fletcher64.h"
+
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC
+#endif
+
+
+#define BENCH_VERSION               "0.1.0"
+#define BENCH_MAX_SIZE              (16UL * 1024 * 1024)
+#define BENCH_MAX_ALIGN             64
+
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+//  ALGORITHMS
+//
+//  run() returns the checksum so the call can not be optimized away.
+//  wordSize is the size of the array elements, length is in bytes.
+//
+struct Algorithm
+{
+  const char * library;
+  const char * name;
+  const char * variant;
+  uint8_t      wordSize;
+  uint64_t     (*run)(const uint8_t * data, size_t length);
+};
+
+
+//  one object per class and engine, the table is built before timing.
+template <class T, uint8_t ENGINE>
+uint64_t runCRC(const uint8_t * data, size_t length)
+{
+  static T crc;
+  static bool engineSet = crc.setEngine(ENGINE);
+  (void) engineSet;
+  crc.restart();
+  crc.add(data, length);
+  return crc.getCRC();
+}
+
+
+uint64_t run_crc8(const uint8_t * d, size_t n)        { return crc8(d, n); }
+uint64_t run_crc12(const uint8_t * d, size_t n)       { return crc12(d, n); }
+uint64_t run_crc16(const uint8_t * d, size_t n)       { return crc16(d, n); }
+uint64_t run_crc16_CCITT(const uint8_t * d, size_t n) { return crc16_CCITT(d, n); }
+uint64_t run_crc32(const uint8_t * d, size_t n)       { return crc32(d, n); }
+uint64_t run_crc64(const uint8_t * d, size_t n)       { return crc64(d, n); }
+uint64_t run_crc32_hw(const uint8_t * d, size_t n)    { return crc32_hw(d, n); }
+uint64_t run_crc64_hw(const uint8_t * d, size_t n)    { return crc64_hw(d, n); }
+uint64_t run_crc32_par(const uint8_t * d, size_t n)   { return crc32_parallel(d, n); }
+uint64_t run_crc64_par(const uint8_t * d, size_t n)   { return crc64_parallel(d, n); }
+
+
+uint64_t run_adler16_add(const uint8_t * d, size_t n)
+{
+  Adler16 ad;
+  return ad.add(d, n);
+}
+
+uint64_t run_adler16_addFast(const uint8_t * d, size_t n)
+{
+  Adler16 ad;
+  return ad.addFast(d, n);
+}
+
+uint64_t run_adler32_add(const uint8_t * d, size_t n)
+{
+  Adler32 ad;
+  return ad.add(d, n);
+}
+
+uint64_t run_adler32_addFast(const uint8_t * d, size_t n)
+{
+  Adler32 ad;
+  return ad.addFast(d, n);
+}
+
+
+uint64_t run_fletcher16_class(const uint8_t * d, size_t n)
+{
+  Fletcher16 fl;
+  fl.add(d, n);
+  return fl.getFletcher();
+}
+
+uint64_t run_fletcher32_class(const uint8_t * d, size_t n)
+{
+  Fletcher32 fl;
+  fl.add((const uint16_t *) d, n / 2);
+  return fl.getFletcher();
+}
+
+uint64_t run_fletcher64_class(const uint8_t * d, size_t n)
+{
+  Fletcher64 fl;
+  fl.add((const uint32_t *) d, n / 4);
+  return fl.getFletcher();
+}
+
+uint64_t run_fletcher16(const uint8_t * d, size_t n) { return fletcher16(d, n); }
+uint64_t run_fletcher32(const uint8_t * d, size_t n) { return fletcher32((const uint16_t *) d, n / 2); }
+uint64_t run_fletcher64(const uint8_t * d, size_t n) { return fletcher64((const uint32_t *) d, n / 4); }
+
+
+const Algorithm algorithms[] =
+{
+  { "CRC", "CRC8",  "bitwise", 1, runCRC<CRC8,  CRC_ENGINE_BITWISE> },
+  { "CRC", "CRC8",  "nibble",  1, runCRC<CRC8,  CRC_ENGINE_NIBBLE> },
+  { "CRC", "CRC8",  "table",   1, runCRC<CRC8,  CRC_ENGINE_TABLE> },
+  { "CRC", "CRC12", "bitwise", 1, runCRC<CRC12, CRC_ENGINE_BITWISE> },
+  { "CRC", "CRC12", "nibble",  1, runCRC<CRC12, CRC_ENGINE_NIBBLE> },
+  { "CRC", "CRC12", "table",   1, runCRC<CRC12, CRC_ENGINE_TABLE> },
+  { "CRC", "CRC16", "bitwise", 1, runCRC<CRC16, CRC_ENGINE_BITWISE> },
+  { "CRC", "CRC16", "nibble",  1, runCRC<CRC16, CRC_ENGINE_NIBBLE> },
+  { "CRC", "CRC16", "table",   1, runCRC<CRC16, CRC_ENGINE_TABLE> },
+  { "CRC", "CRC32", "bitwise", 1, runCRC<CRC32, CRC_ENGINE_BITWISE> },
+  { "CRC", "CRC32", "nibble",  1, runCRC<CRC32, CRC_ENGINE_NIBBLE> },
+  { "CRC", "CRC32", "table",   1, runCRC<CRC32, CRC_ENGINE_TABLE> },
+  { "CRC", "CRC32", "slice4",  1, runCRC<CRC32, CRC_ENGINE_SLICE4> },
+  { "CRC", "CRC32", "slice8",  1, runCRC<CRC32, CRC_ENGINE_SLICE8> },
+  { "CRC", "CRC64", "bitwise", 1, runCRC<CRC64, CRC_ENGINE_BITWISE> },
+  { "CRC", "CRC64", "nibble",  1, runCRC<CRC64, CRC_ENGINE_NIBBLE> },
+  { "CRC", "CRC64", "table",   1, runCRC<CRC64, CRC_ENGINE_TABLE> },
+  { "CRC", "CRC64", "slice4",  1, runCRC<CRC64, CRC_ENGINE_SLICE4> },
+  { "CRC", "CRC64", "slice8",  1, runCRC<CRC64, CRC_ENGINE_SLICE8> },
+  { "CRC", "crc8()",        "static",   1, run_crc8 },
+  { "CRC", "crc12()",       "static",   1, run_crc12 },
+  { "CRC", "crc16()",       "static",   1, run_crc16 },
+  { "CRC", "crc16_CCITT()", "static",   1, run_crc16_CCITT },
+  { "CRC", "crc32()",       "static",   1, run_crc32 },
+  { "CRC", "crc64()",       "static",   1, run_crc64 },
+  { "CRC", "crc32()",       "hw",       1, run_crc32_hw },
+  { "CRC", "crc64()",       "hw",       1, run_crc64_hw },
+  { "CRC", "crc32()",       "parallel", 1, run_crc32_par },
+  { "CRC", "crc64()",       "parallel", 1, run_crc64_par },
+  { "Adler", "Adler16", "add",     1, run_adler16_add },
+  { "Adler", "Adler16", "addFast", 1, run_adler16_addFast },
+  { "Adler", "Adler32", "add",     1, run_adler32_add },
+  { "Adler", "Adler32", "addFast", 1, run_adler32_addFast },
+  { "Fletcher", "Fletcher16",   "class",  1, run_fletcher16_class },
+  { "Fletcher", "Fletcher32",   "class",  2, run_fletcher32_class },
+  { "Fletcher", "Fletcher64",   "class",  4, run_fletcher64_class },
+  { "Fletcher", "fletcher16()", "static", 1, run_fletcher16 },
+  { "Fletcher", "fletcher32()", "static", 2, run_fletcher32 },
+  { "Fletcher", "fletcher64()", "static", 4, run_fletcher64 },
+};
+
+const size_t nrAlgorithms = sizeof(algorithms) / sizeof(algorithms[0]);
+
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+//  SETTINGS
+//
+struct Settings
+{
+  std::vector<size_t>   sizes;
+  std::vector<size_t>   aligns;
+  bool                  warm        = true;
+  bool                  cold        = true;
+  bool                  json        = false;
+  const char *          filter      = NULL;
+  const char *          output      = NULL;
+  const char *          baseline    = NULL;
+  double                threshold   = 10.0;     //  percent
+  double                minTime     = 0.005;    //  seconds per warm batch
+  int                   repeat      = 5;
+  double                ghz         = 0;        //  cycles/byte without TSC
+  size_t                evictSize   = 64UL * 1024 * 1024;
+};
+
+
+struct Result
+{
+  const Algorithm * algo;
+  size_t   size;
+  size_t   align;
+  bool     cold;
+  uint64_t iterations;
+  double   nsPerCall;
+  double   MBps;
+  double   cyclesPerByte;       //  < 0 == unknown
+  uint64_t checksum;
+};
+
+
+static void usage()
+{
+  fprintf(stderr,
+    "checksum_benchmark " BENCH_VERSION "\n"
+    "  --list                 list algorithms and exit\n"
+    "  --filter=text          only algorithms whose library/name/variant contains text\n"
+    "  --sizes=1,64,4096      buffer sizes in bytes (default 1 .. 16M, x4 steps)\n"
+    "  --max-size=N           drop default sizes above N\n"
+    "  --align=0,1,8          byte offsets from a 64 byte aligned buffer (default 0,1,8)\n"
+    "  --cache=warm|cold|both default both\n"
+    "  --repeat=N             measurements per point, median is reported (default 5)\n"
+    "  --min-time=ms          minimum time of a warm measurement (default 5)\n"
+    "  --ghz=F                CPU clock, for cycles/byte on hosts without TSC\n"
+    "  --evict-mb=N           size of the buffer used to flush the caches (default 64)\n"
+    "  --quick                sizes 1,64,4K,256K,16M, align 0\n"
+    "  --json                 JSON output instead of CSV\n"
+    "  --output=file          write results to file instead of stdout\n"
+    "  --baseline=file.csv    compare MB/s with a previous CSV run\n"
+    "  --threshold=pct        allowed slowdown versus baseline (default 10)\n");
+}
+
+
+static std::vector<size_t> parseList(const char * s)
+{
+  std::vector<size_t> list;
+  while (*s)
+  {
+    char * end;
+    unsigned long long v = strtoull(s, &end, 10);
+    if (end == s) break;
+    if (*end == 'K' || *end == 'k') { v *= 1024; end++; }
+    else if (*end == 'M' || *end == 'm') { v *= 1024 * 1024; end++; }
+    list.push_back(v);
+    s = end;
+    if (*s == ',') s++;
+  }
+  return list;
+}
+
+
+static bool parseArgs(int argc, char * argv[], Settings & set)
+{
+  size_t maxSize = BENCH_MAX_SIZE;
+  for (int i = 1; i < argc; i++)
+  {
+    const char * a = argv[i];
+    const char * eq = strchr(a, '=');
+    const char * v = eq ? eq + 1 : "";
+    std::string key = eq ? std::string(a, eq - a) : std::string(a);
+
+    if      (key == "--list")
+    {
+      for (size_t j = 0; j < nrAlgorithms; j++)
+      {
+        printf("%-10s %-14s %s\n", algorithms[j].library, algorithms[j].name, algorithms[j].variant);
+      }
+      exit(0);
+    }
+    else if (key == "--filter")    set.filter = v;
+    else if (key == "--sizes")     set.sizes  = parseList(v);
+    else if (key == "--max-size")  maxSize    = parseList(v).empty() ? BENCH_MAX_SIZE : parseList(v)[0];
+    else if (key == "--align")     set.aligns = parseList(v);
+    else if (key == "--cache")
+    {
+      set.warm = (strcmp(v, "cold") != 0);
+      set.cold = (strcmp(v, "warm") != 0);
+    }
+    else if (key == "--repeat")    set.repeat    = std::max(1, atoi(v));
+    else if (key == "--min-time")  set.minTime   = atof(v) / 1000.0;
+    else if (key == "--ghz")       set.ghz       = atof(v);
+    else if (key == "--evict-mb")  set.evictSize = (size_t) atol(v) * 1024 * 1024;
+    else if (key == "--quick")
+    {
+      set.sizes  = parseList("1,64,4K,256K,16M");
+      set.aligns = parseList("0");
+    }
+    else if (key == "--json")      set.json      = true;
+    else if (key == "--output")    set.output    = v;
+    else if (key == "--baseline")  set.baseline  = v;
+    else if (key == "--threshold") set.threshold = atof(v);
+    else
+    {
+      usage();
+      return false;
+    }
+  }
+  if (set.sizes.empty())
+  {
+    for (size_t s = 1; s <= maxSize; s *= 4) set.sizes.push_back(s);
+  }
+  if (set.aligns.empty()) set.aligns = parseList("0,1,8");
+
+  //  keep within the allocated buffer.
+  set.sizes.erase(std::remove_if(set.sizes.begin(), set.sizes.end(),
+                  [](size_t s) { return s > BENCH_MAX_SIZE; }), set.sizes.end());
+  set.aligns.erase(std::remove_if(set.aligns.begin(), set.aligns.end(),
+                  [](size_t a) { return a >= BENCH_MAX_ALIGN; }), set.aligns.end());
+  return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+//  TIMING
+//
+static inline uint64_t ticks()
+{
+#if defined(BENCH_HAS_TSC)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+
+static inline double seconds()
+{
+  using namespace std::chrono;
+  return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+
+//  read and write a large buffer so the data is no longer in any cache.
+static volatile uint64_t sink;
+
+static void evictCaches(std::vector<uint8_t> & evict)
+{
+  uint64_t sum = 0;
+  for (size_t i = 0; i < evict.size(); i += 64)
+  {
+    evict[i]++;
+    sum += evict[i];
+  }
+  sink = sum;
+}
+
+
+static Result measure(const Algorithm & algo, const uint8_t * data, size_t size,
+                      bool cold, const Settings & set, std::vector<uint8_t> & evict)
+{
+  Result r;
+  r.algo  = &algo;
+  r.size  = size;
+  r.cold  = cold;
+
+  std::vector<double>   ns;
+  std::vector<double>   cycles;
+  uint64_t iterations = 0;
+
+  //  warm up, builds tables, starts threads, fills caches.
+  r.checksum = algo.run(data, size);
+
+  uint64_t batch = 1;
+  if (!cold)
+  {
+    //  find a batch size that runs at least minTime.
+    while (true)
+    {
+      double t0 = seconds();
+      for (uint64_t i = 0; i < batch; i++) sink = algo.run(data, size);
+      double t = seconds() - t0;
+      if (t >= set.minTime || batch >= (1ULL << 30)) break;
+      batch = (t <= 0) ? batch * 16 : std::max(batch * 2, (uint64_t)(batch * set.minTime / t * 1.2));
+    }
+  }
+
+  for (int rep = 0; rep < set.repeat; rep++)
+  {
+    if (cold) evictCaches(evict);
+    double   t0 = seconds();
+    uint64_t c0 = ticks();
+    for (uint64_t i = 0; i < batch; i++) sink = algo.run(data, size);
+    uint64_t c1 = ticks();
+    double   t1 = seconds();
+    ns.push_back((t1 - t0) * 1e9 / batch);
+    cycles.push_back((double)(c1 - c0) / batch);
+    iterations += batch;
+  }
+
+  std::sort(ns.begin(), ns.end());
+  std::sort(cycles.begin(), cycles.end());
+  r.iterations = iterations;
+  r.nsPerCall  = ns[ns.size() / 2];
+  r.MBps       = (size > 0 && r.nsPerCall > 0) ? size * 1e3 / r.nsPerCall : 0;
+#if defined(BENCH_HAS_TSC)
+  r.cyclesPerByte = (size > 0) ? cycles[cycles.size() / 2] / size : 0;
+#else
+  r.cyclesPerByte = (set.ghz > 0 && size > 0) ? r.nsPerCall * set.ghz / size : -1;
+#endif
+  return r;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+//  OUTPUT
+//
+static void printCSVHeader(FILE * f)
+{
+  fprintf(f, "library,algorithm,variant,size,align,cache,iterations,ns_per_call,mb_per_s,cycles_per_byte,checksum\n");
+}
+
+
+static void printCSV(FILE * f, const Result & r)
+{
+  fprintf(f, "%s,%s,%s,%zu,%zu,%s,%llu,%.1f,%.2f,",
+          r.algo->library, r.algo->name, r.algo->variant, r.size, r.align,
+          r.cold ? "cold" : "warm", (unsigned long long) r.iterations, r.nsPerCall, r.MBps);
+  if (r.cyclesPerByte >= 0) fprintf(f, "%.3f", r.cyclesPerByte);
+  fprintf(f, ",%llX\n", (unsigned long long) r.checksum);
+}
+
+
+static void printJSON(FILE * f, const Result & r, bool first)
+{
+  fprintf(f, "%s    { \"library\": \"%s\", \"algorithm\": \"%s\", \"variant\": \"%s\", "
+             "\"size\": %zu, \"align\": %zu, \"cache\": \"%s\", \"iterations\": %llu, "
+             "\"ns_per_call\": %.1f, \"mb_per_s\": %.2f, \"cycles_per_byte\": ",
+          first ? "" : ",\n",
+          r.algo->library, r.algo->name, r.algo->variant, r.size, r.align,
+          r.cold ? "cold" : "warm", (unsigned long long) r.iterations, r.nsPerCall, r.MBps);
+  if (r.cyclesPerByte >= 0) fprintf(f, "%.3f", r.cyclesPerByte);
+  else fprintf(f, "null");
+  fprintf(f, ", \"checksum\": \"%llX\" }", (unsigned long long) r.checksum);
+}
+
+
+static std::string key(const char * lib, const char * name, const char * variant,
+                       size_t size, size_t align, const char * cache)
+{
+  char buf[160];
+  snprintf(buf, sizeof(buf), "%s,%s,%s,%zu,%zu,%s", lib, name, variant, size, align, cache);
+  return buf;
+}
+
+
+//  returns the number of results slower than the baseline minus threshold.
+static int compareBaseline(const char * file, const std::vector<Result> & results, double threshold)
+{
+  FILE * f = fopen(file, "r");
+  if (f == NULL)
+  {
+    fprintf(stderr, "cannot open baseline %s\n", file);
+    return -1;
+  }
+  int  regressions = 0;
+  int  compared    = 0;
+  char line[512];
+  while (fgets(line, sizeof(line), f))
+  {
+    char lib[32], name[32], variant[32], cache[8];
+    size_t size, align;
+    unsigned long long iterations;
+    double ns, MBps;
+    if (sscanf(line, "%31[^,],%31[^,],%31[^,],%zu,%zu,%7[^,],%llu,%lf,%lf",
+               lib, name, variant, &size, &align, cache, &iterations, &ns, &MBps) != 9) continue;
+    std::string k = key(lib, name, variant, size, align, cache);
+    for (const Result & r : results)
+    {
+      if (k != key(r.algo->library, r.algo->name, r.algo->variant, r.size, r.align, r.cold ? "cold" : "warm")) continue;
+      compared++;
+      if (MBps > 0 && r.MBps < MBps * (1.0 - threshold / 100.0))
+      {
+        fprintf(stderr, "SLOWER  %-40s %10.2f -> %10.2f MB/s  (%+.1f%%)\n",
+                k.c_str(), MBps, r.MBps, (r.MBps / MBps - 1.0) * 100.0);
+        regressions++;
+      }
+    }
+  }
+  fclose(f);
+  fprintf(stderr, "baseline: %d compared, %d slower than %.1f%%\n", compared, regressions, threshold);
+  return regressions;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////
+//
+//  MAIN
+//
+int main(int argc, char * argv[])
+{
+  Settings set;
+  if (!parseArgs(argc, argv, set)) return 2;
+
+  FILE * out = stdout;
+  if (set.output != NULL)
+  {
+    out = fopen(set.output, "w");
+    if (out == NULL)
+    {
+      fprintf(stderr, "cannot open %s\n", set.output);
+      return 2;
+    }
+  }
+
+  //  random data, 64 byte aligned base.
+  std::vector<uint8_t> raw(BENCH_MAX_SIZE + 2 * BENCH_MAX_ALIGN);
+  uint8_t * base = raw.data() + (BENCH_MAX_ALIGN - ((uintptr_t) raw.data() % BENCH_MAX_ALIGN));
+  uint64_t x = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < raw.size(); i++)
+  {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    raw[i] = (uint8_t) x;
+  }
+  std::vector<uint8_t> evict(set.cold ? set.evictSize : 0);
+
+  fprintf(stderr, "checksum_benchmark %s, CRC %s, Adler %s, Fletcher %s, TSC %s\n",
+          BENCH_VERSION, CRC_LIB_VERSION, ADLER32_LIB_VERSION, FLETCHER_LIB_VERSION,
+#if defined(BENCH_HAS_TSC)
+          "yes");
+#else
+          "no");
+#endif
+
+  if (set.json)
+  {
+    fprintf(out, "{\n  \"benchmark\": \"checksum_benchmark\",\n  \"version\": \"%s\",\n", BENCH_VERSION);
+    fprintf(out, "  \"CRC\": \"%s\",\n  \"Adler\": \"%s\",\n  \"Fletcher\": \"%s\",\n",
+            CRC_LIB_VERSION, ADLER32_LIB_VERSION, FLETCHER_LIB_VERSION);
+    fprintf(out, "  \"results\": [\n");
+  }
+  else
+  {
+    printCSVHeader(out);
+  }
+
+  std::vector<Result> results;
+  for (size_t a = 0; a < nrAlgorithms; a++)
+  {
+    const Algorithm & algo = algorithms[a];
+    if (set.filter != NULL)
+    {
+      std::string id = std::string(algo.library) + "/" + algo.name + "/" + algo.variant;
+      if (id.find(set.filter) == std::string::npos) continue;
+    }
+    fprintf(stderr, "%s %s %s\n", algo.library, algo.name, algo.variant);
+    for (size_t size : set.sizes)
+    {
+      for (size_t align : set.aligns)
+      {
+        //  word based algorithms only get word aligned arrays.
+        if (align % algo.wordSize != 0) continue;
+        for (int c = 0; c < 2; c++)
+        {
+          bool cold = (c == 1);
+          if (cold ? !set.cold : !set.warm) continue;
+          Result r = measure(algo, base + align, size, cold, set, evict);
+          r.align = align;
+          if (set.json) printJSON(out, r, results.empty());
+          else printCSV(out, r);
+          fflush(out);
+          results.push_back(r);
+        }
+      }
+    }
+  }
+
+  if (set.json) fprintf(out, "\n  ]\n}\n");
+  if (out != stdout) fclose(out);
+
+  if (set.baseline != NULL)
+  {
+    return (compareBaseline(set.baseline, results, set.threshold) == 0) ? 0 : 1;
+  }
+  return 0;
+}
+
+
+// -- END OF FILE --
@@ -115,6 +115,46 @@ unittest(test_crc64)
 }
 
 
+unittest(test_crc_combine)
+{
+  uint8_t buffer[100];
+  for (int i = 0; i < 100; i++) buffer[i] = i * 37 + 11;
+
+  for (int r = 0; r < 2; r++)
+  {
+    bool rev = (r == 1);
+    for (int split = 0; split <= 100; split += 25)
+    {
+      uint16_t lenB = 100 - split;
+      uint8_t  c8  = crc8(buffer, 100, 0x31, 0xFF, 0x5A, rev, rev);
+      uint8_t  a8  = crc8(buffer, split, 0x31, 0xFF, 0x5A, rev, rev);
+      uint8_t  b8  = crc8(buffer + split, lenB, 0x31, 0xFF, 0x5A, rev, rev);
+      assertEqual(c8, crc8_combine(a8, b8, lenB, 0x31, 0xFF, 0x5A, rev));
+
+      uint16_t c12 = crc12(buffer, 100, 0x80F, 0xFFF, 0x123, rev, rev) & 0x0FFF;
+      uint16_t a12 = crc12(buffer, split, 0x80F, 0xFFF, 0x123, rev, rev);
+      uint16_t b12 = crc12(buffer + split, lenB, 0x80F, 0xFFF, 0x123, rev, rev);
+      assertEqual(c12, crc12_combine(a12, b12, lenB, 0x80F, 0xFFF, 0x123, rev));
+
+      uint16_t c16 = crc16(buffer, 100, 0x8005, 0xFFFF, 0x1234, rev, rev);
+      uint16_t a16 = crc16(buffer, split, 0x8005, 0xFFFF, 0x1234, rev, rev);
+      uint16_t b16 = crc16(buffer + split, lenB, 0x8005, 0xFFFF, 0x1234, rev, rev);
+      assertEqual(c16, crc16_combine(a16, b16, lenB, 0x8005, 0xFFFF, 0x1234, rev));
+
+      uint32_t c32 = crc32(buffer, 100, 0x1EDC6F41, 0xFFFFFFFF, 0x12345678, rev, rev);
+      uint32_t a32 = crc32(buffer, split, 0x1EDC6F41, 0xFFFFFFFF, 0x12345678, rev, rev);
+      uint32_t b32 = crc32(buffer + split, lenB, 0x1EDC6F41, 0xFFFFFFFF, 0x12345678, rev, rev);
+      assertEqual(c32, crc32_combine(a32, b32, lenB, 0x1EDC6F41, 0xFFFFFFFF, 0x12345678, rev));
+
+      uint64_t c64 = crc64(buffer, 100, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, 0x1234, rev, rev);
+      uint64_t a64 = crc64(buffer, split, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, 0x1234, rev, rev);
+      uint64_t b64 = crc64(buffer + split, lenB, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, 0x1234, rev, rev);
+      assertEqual(c64, crc64_combine(a64, b64, lenB, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, 0x1234, rev));
+    }
+  }
+}
+
+
 unittest_main()
 
 // --------
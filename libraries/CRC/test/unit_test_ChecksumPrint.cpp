@@ -0,0 +1,119 @@
+//
+//    FILE: unit_test_ChecksumPrint.cpp
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: unit tests for the ChecksumPrint wrapper
+//          https://github.com/RobTillaart/CRC
+//          https://github.com/Arduino-CI/arduino_ci/blob/master/REFERENCE.md
+//
+
+// supported assertions
+// ----------------------------
+// assertEqual(expected, actual);               // a == b
+// assertNotEqual(unwanted, actual);            // a != b
+// assertComparativeEquivalent(expected, actual);    // abs(a - b) == 0 or (!(a > b) && !(a < b))
+// assertComparativeNotEquivalent(unwanted, actual); // abs(a - b) > 0  or ((a > b) || (a < b))
+// assertLess(upperBound, actual);              // a < b
+// assertMore(lowerBound, actual);              // a > b
+// assertLessOrEqual(upperBound, actual);       // a <= b
+// assertMoreOrEqual(lowerBound, actual);       // a >= b
+// assertTrue(actual);
+// assertFalse(actual);
+// assertNull(actual);
+
+// // special cases for floats
+// assertEqualFloat(expected, actual, epsilon);    // fabs(a - b) <= epsilon
+// assertNotEqualFloat(unwanted, actual, epsilon); // fabs(a - b) >= epsilon
+// assertInfinity(actual);                         // isinf(a)
+// assertNotInfinity(actual);                      // !isinf(a)
+// assertNAN(arg);                                 // isnan(a)
+// assertNotNAN(arg);                              // !isnan(a)
+
+
+#include <ArduinoUnitTests.h>
+
+
+#include "Arduino.h"
+#include "CRC.h"
+#include "CRC16.h"
+#include "CRC32.h"
+#include "ChecksumPrint.h"
+
+
+//  downstream Print that keeps a copy of the output.
+class BufferPrint : public Print
+{
+public:
+  BufferPrint() { len = 0; };
+  size_t write(uint8_t c)
+  {
+    if (len >= sizeof(buf)) return 0;
+    buf[len++] = c;
+    return 1;
+  };
+  uint8_t buf[1000];
+  size_t  len;
+};
+
+
+unittest_setup()
+{
+  fprintf(stderr, "CRC_LIB_VERSION: %s\n", (char *) CRC_LIB_VERSION);
+}
+
+
+unittest_teardown()
+{
+}
+
+
+unittest(test_checksum_print_no_stream)
+{
+  ChecksumPrint<CRC32> cp;
+  assertEqual(0, cp.count());
+  assertEqual(9, cp.print("123456789"));
+  assertEqual(9, cp.count());
+  //  CRC32 class defaults, compare with the free function.
+  assertEqual(crc32((const uint8_t *) "123456789", 9), cp.checksum().getCRC());
+}
+
+
+unittest(test_checksum_print_forward)
+{
+  BufferPrint bp;
+  ChecksumPrint<CRC16, uint8_t, 16> cp(&bp);
+  assertTrue(cp.getStream() == &bp);
+
+  for (int i = 0; i < 40; i++)
+  {
+    cp.print(i);
+    cp.print(',');
+  }
+  cp.println("the quick brown fox jumps over the lazy dog");
+  cp.write((const uint8_t *) "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ", 36);
+
+  assertEqual(bp.len, cp.count());
+  assertEqual(crc16(bp.buf, bp.len, CRC16_DEFAULT_POLYNOME), cp.checksum().getCRC());
+
+  //  continue after checksum()
+  cp.print("more");
+  assertEqual(bp.len, cp.count());
+  assertEqual(crc16(bp.buf, bp.len, CRC16_DEFAULT_POLYNOME), cp.checksum().getCRC());
+}
+
+
+unittest(test_checksum_print_reset)
+{
+  ChecksumPrint<CRC32> cp;
+  cp.print("abc");
+  cp.reset();
+  cp.checksum().reset();
+  assertEqual(0, cp.count());
+  cp.print("123456789");
+  assertEqual(crc32((const uint8_t *) "123456789", 9), cp.checksum().getCRC());
+}
+
+
+unittest_main()
+
+// --------
@@ -98,6 +98,116 @@ unittest(test_crc12_param)
 }
 
 
+unittest(test_crc12_engines)
+{
+  fprintf(stderr, "TEST CRC12 ENGINES\n");
+
+  uint8_t buffer[300];
+  for (int i = 0; i < 300; i++) buffer[i] = (i * 7 + 13) ^ (i >> 3);
+
+  CRC12 ref;
+  CRC12 crc;
+  assertEqual(CRC_ENGINE_BITWISE, crc.getEngine());
+  assertFalse(crc.setEngine(42));
+  assertEqual(CRC_ENGINE_BITWISE, crc.getEngine());
+  assertFalse(crc.setEngine(CRC_ENGINE_SLICE8));
+
+  for (uint8_t engine = CRC_ENGINE_BITWISE; engine <= CRC_ENGINE_TABLE; engine++)
+  {
+    assertTrue(crc.setEngine(engine));
+    assertEqual(engine, crc.getEngine());
+    for (int rev = 0; rev < 2; rev++)
+    {
+      ref.reset();
+      ref.setPolynome(CRC12_CDMA2000);
+      ref.setStartXOR(0xFFF);
+      ref.setEndXOR(0x000);
+      ref.setReverseIn(rev == 1);
+      ref.setReverseOut(rev == 1);
+      ref.add(buffer, 300);
+
+      crc.reset();
+      crc.setPolynome(CRC12_CDMA2000);
+      crc.setStartXOR(0xFFF);
+      crc.setEndXOR(0x000);
+      crc.setReverseIn(rev == 1);
+      crc.setReverseOut(rev == 1);
+      //  mix single values and odd sized blocks.
+      crc.add(buffer[0]);
+      crc.add(buffer + 1, 13);
+      crc.add(buffer + 14, 286);
+      assertEqual(ref.getCRC(), crc.getCRC());
+      assertEqual(300, crc.count());
+    }
+  }
+}
+
+
+unittest(test_crc12_append)
+{
+  fprintf(stderr, "TEST CRC12 APPEND\n");
+
+  uint8_t buffer[200];
+  for (int i = 0; i < 200; i++) buffer[i] = i * 37 + 11;
+
+  for (int rev = 0; rev < 2; rev++)
+  {
+    CRC12 ref(CRC12_CCITT, 0xFFF, 0x0F0, rev == 1, rev == 1);
+    ref.add(buffer, 200);
+
+    CRC12 crcA(CRC12_CCITT, 0xFFF, 0x0F0, rev == 1, rev == 1);
+    CRC12 crcB(CRC12_CCITT, 0xFFF, 0x0F0, rev == 1, rev == 1);
+    crcA.add(buffer, 77);
+    crcB.add(buffer + 77, 123);
+    crcA.append(crcB.getCRC(), 123);
+    assertEqual(ref.getCRC(), crcA.getCRC());
+    assertEqual(200, crcA.count());
+
+    //  continue adding after append.
+    ref.add(buffer, 50);
+    crcA.add(buffer, 50);
+    assertEqual(ref.getCRC(), crcA.getCRC());
+  }
+}
+
+
+unittest(test_crc12_copy)
+{
+  fprintf(stderr, "TEST CRC12 COPY\n");
+
+  uint8_t buffer[100];
+  for (int i = 0; i < 100; i++) buffer[i] = i * 13 + 7;
+
+  CRC12 ref;
+  ref.add(buffer, 100);
+
+  CRC12 a;
+  assertTrue(a.setEngine(CRC_ENGINE_TABLE));
+  a.add(buffer, 50);
+
+  CRC12 b(a);
+  CRC12 c;
+  c = a;
+  c = c;
+  assertEqual(CRC_ENGINE_TABLE, b.getEngine());
+  assertEqual(CRC_ENGINE_TABLE, c.getEngine());
+  {
+    //  destroying a copy must not free the table of a.
+    CRC12 d = a;
+    d.add(buffer + 50, 50);
+    assertEqual(ref.getCRC(), d.getCRC());
+  }
+
+  a.add(buffer + 50, 50);
+  b.add(buffer + 50, 50);
+  c.add(buffer + 50, 50);
+  assertEqual(ref.getCRC(), a.getCRC());
+  assertEqual(ref.getCRC(), b.getCRC());
+  assertEqual(ref.getCRC(), c.getCRC());
+  assertEqual(100, b.count());
+}
+
+
 unittest_main()
 
 // --------
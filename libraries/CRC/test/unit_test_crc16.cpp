@@ -314,6 +314,116 @@ unittest(test_crc16_param)
 }
 
 
+unittest(test_crc16_engines)
+{
+  fprintf(stderr, "TEST CRC16 ENGINES\n");
+
+  uint8_t buffer[300];
+  for (int i = 0; i < 300; i++) buffer[i] = (i * 7 + 13) ^ (i >> 3);
+
+  CRC16 ref;
+  CRC16 crc;
+  assertEqual(CRC_ENGINE_BITWISE, crc.getEngine());
+  assertFalse(crc.setEngine(42));
+  assertEqual(CRC_ENGINE_BITWISE, crc.getEngine());
+  assertFalse(crc.setEngine(CRC_ENGINE_SLICE8));
+
+  for (uint8_t engine = CRC_ENGINE_BITWISE; engine <= CRC_ENGINE_TABLE; engine++)
+  {
+    assertTrue(crc.setEngine(engine));
+    assertEqual(engine, crc.getEngine());
+    for (int rev = 0; rev < 2; rev++)
+    {
+      ref.reset();
+      ref.setPolynome(CRC16_IBM);
+      ref.setStartXOR(0xFFFF);
+      ref.setEndXOR(0xFFFF);
+      ref.setReverseIn(rev == 1);
+      ref.setReverseOut(rev == 1);
+      ref.add(buffer, 300);
+
+      crc.reset();
+      crc.setPolynome(CRC16_IBM);
+      crc.setStartXOR(0xFFFF);
+      crc.setEndXOR(0xFFFF);
+      crc.setReverseIn(rev == 1);
+      crc.setReverseOut(rev == 1);
+      //  mix single values and odd sized blocks.
+      crc.add(buffer[0]);
+      crc.add(buffer + 1, 13);
+      crc.add(buffer + 14, 286);
+      assertEqual(ref.getCRC(), crc.getCRC());
+      assertEqual(300, crc.count());
+    }
+  }
+}
+
+
+unittest(test_crc16_append)
+{
+  fprintf(stderr, "TEST CRC16 APPEND\n");
+
+  uint8_t buffer[200];
+  for (int i = 0; i < 200; i++) buffer[i] = i * 37 + 11;
+
+  for (int rev = 0; rev < 2; rev++)
+  {
+    CRC16 ref(CRC16_IBM, 0xFFFF, 0x1234, rev == 1, rev == 1);
+    ref.add(buffer, 200);
+
+    CRC16 crcA(CRC16_IBM, 0xFFFF, 0x1234, rev == 1, rev == 1);
+    CRC16 crcB(CRC16_IBM, 0xFFFF, 0x1234, rev == 1, rev == 1);
+    crcA.add(buffer, 77);
+    crcB.add(buffer + 77, 123);
+    crcA.append(crcB.getCRC(), 123);
+    assertEqual(ref.getCRC(), crcA.getCRC());
+    assertEqual(200, crcA.count());
+
+    //  continue adding after append.
+    ref.add(buffer, 50);
+    crcA.add(buffer, 50);
+    assertEqual(ref.getCRC(), crcA.getCRC());
+  }
+}
+
+
+unittest(test_crc16_copy)
+{
+  fprintf(stderr, "TEST CRC16 COPY\n");
+
+  uint8_t buffer[100];
+  for (int i = 0; i < 100; i++) buffer[i] = i * 13 + 7;
+
+  CRC16 ref;
+  ref.add(buffer, 100);
+
+  CRC16 a;
+  assertTrue(a.setEngine(CRC_ENGINE_TABLE));
+  a.add(buffer, 50);
+
+  CRC16 b(a);
+  CRC16 c;
+  c = a;
+  c = c;
+  assertEqual(CRC_ENGINE_TABLE, b.getEngine());
+  assertEqual(CRC_ENGINE_TABLE, c.getEngine());
+  {
+    //  destroying a copy must not free the table of a.
+    CRC16 d = a;
+    d.add(buffer + 50, 50);
+    assertEqual(ref.getCRC(), d.getCRC());
+  }
+
+  a.add(buffer + 50, 50);
+  b.add(buffer + 50, 50);
+  c.add(buffer + 50, 50);
+  assertEqual(ref.getCRC(), a.getCRC());
+  assertEqual(ref.getCRC(), b.getCRC());
+  assertEqual(ref.getCRC(), c.getCRC());
+  assertEqual(100, b.count());
+}
+
+
 unittest_main()
 
 // --------
@@ -190,6 +190,125 @@ unittest(test_crc32_param)
 }
 
 
+unittest(test_crc32_engines)
+{
+  fprintf(stderr, "TEST CRC32 ENGINES\n");
+
+  uint8_t buffer[300];
+  for (int i = 0; i < 300; i++) buffer[i] = (i * 7 + 13) ^ (i >> 3);
+
+  CRC32 ref;
+  CRC32 crc;
+  assertEqual(CRC_ENGINE_BITWISE, crc.getEngine());
+  assertFalse(crc.setEngine(42));
+  assertEqual(CRC_ENGINE_BITWISE, crc.getEngine());
+
+  for (uint8_t engine = CRC_ENGINE_BITWISE; engine <= CRC_ENGINE_SLICE8; engine++)
+  {
+    assertTrue(crc.setEngine(engine));
+    assertEqual(engine, crc.getEngine());
+    for (int rev = 0; rev < 2; rev++)
+    {
+      ref.reset();
+      ref.setPolynome(CRC32_CASTAGNOLI);
+      ref.setStartXOR(0xFFFFFFFF);
+      ref.setEndXOR(0xFFFFFFFF);
+      ref.setReverseIn(rev == 1);
+      ref.setReverseOut(rev == 1);
+      ref.add(buffer, 300);
+
+      crc.reset();
+      crc.setPolynome(CRC32_CASTAGNOLI);
+      crc.setStartXOR(0xFFFFFFFF);
+      crc.setEndXOR(0xFFFFFFFF);
+      crc.setReverseIn(rev == 1);
+      crc.setReverseOut(rev == 1);
+      //  mix single values and odd sized blocks.
+      crc.add(buffer[0]);
+      crc.add(buffer + 1, 13);
+      crc.add(buffer + 14, 286);
+      assertEqual(ref.getCRC(), crc.getCRC());
+      assertEqual(300, crc.count());
+    }
+
+    //  check value
+    crc.reset();
+    crc.setPolynome(0x04C11DB7);
+    crc.setStartXOR(0xFFFFFFFF);
+    crc.setEndXOR(0xFFFFFFFF);
+    crc.setReverseIn(true);
+    crc.setReverseOut(true);
+    crc.add(data, 9);
+    assertEqual(0xCBF43926, crc.getCRC());
+  }
+}
+
+
+unittest(test_crc32_append)
+{
+  fprintf(stderr, "TEST CRC32 APPEND\n");
+
+  uint8_t buffer[200];
+  for (int i = 0; i < 200; i++) buffer[i] = i * 37 + 11;
+
+  for (int rev = 0; rev < 2; rev++)
+  {
+    CRC32 ref(CRC32_ISO3309, 0xFFFFFFFF, 0x12345678, rev == 1, rev == 1);
+    ref.add(buffer, 200);
+
+    CRC32 crcA(CRC32_ISO3309, 0xFFFFFFFF, 0x12345678, rev == 1, rev == 1);
+    CRC32 crcB(CRC32_ISO3309, 0xFFFFFFFF, 0x12345678, rev == 1, rev == 1);
+    crcA.add(buffer, 77);
+    crcB.add(buffer + 77, 123);
+    crcA.append(crcB.getCRC(), 123);
+    assertEqual(ref.getCRC(), crcA.getCRC());
+    assertEqual(200, crcA.count());
+
+    //  continue adding after append.
+    ref.add(buffer, 50);
+    crcA.add(buffer, 50);
+    assertEqual(ref.getCRC(), crcA.getCRC());
+  }
+}
+
+
+unittest(test_crc32_copy)
+{
+  fprintf(stderr, "TEST CRC32 COPY\n");
+
+  uint8_t buffer[100];
+  for (int i = 0; i < 100; i++) buffer[i] = i * 13 + 7;
+
+  CRC32 ref;
+  ref.add(buffer, 100);
+
+  CRC32 a;
+  assertTrue(a.setEngine(CRC_ENGINE_TABLE));
+  a.add(buffer, 50);
+
+  CRC32 b(a);
+  CRC32 c;
+  c = a;
+  c = c;
+  assertEqual(CRC_ENGINE_TABLE, b.getEngine());
+  assertEqual(CRC_ENGINE_TABLE, c.getEngine());
+  {
+    //  destroying a copy must not free the table of a.
+    CRC32 d = a;
+    d.add(buffer + 50, 50);
+    assertEqual(ref.getCRC(), d.getCRC());
+  }
+
+  a.add(buffer + 50, 50);
+  b.add(buffer + 50, 50);
+  c.add(buffer + 50, 50);
+  assertEqual(ref.getCRC(), a.getCRC());
+  assertEqual(ref.getCRC(), b.getCRC());
+  assertEqual(ref.getCRC(), c.getCRC());
+  assertEqual(100, b.count());
+}
+
+
 unittest_main()
 
 // --------
@@ -160,6 +160,116 @@ unittest(test_crc8_param)
 }
 
 
+unittest(test_crc8_engines)
+{
+  fprintf(stderr, "TEST CRC8 ENGINES\n");
+
+  uint8_t buffer[300];
+  for (int i = 0; i < 300; i++) buffer[i] = (i * 7 + 13) ^ (i >> 3);
+
+  CRC8 ref;
+  CRC8 crc;
+  assertEqual(CRC_ENGINE_BITWISE, crc.getEngine());
+  assertFalse(crc.setEngine(42));
+  assertEqual(CRC_ENGINE_BITWISE, crc.getEngine());
+  assertFalse(crc.setEngine(CRC_ENGINE_SLICE8));
+
+  for (uint8_t engine = CRC_ENGINE_BITWISE; engine <= CRC_ENGINE_TABLE; engine++)
+  {
+    assertTrue(crc.setEngine(engine));
+    assertEqual(engine, crc.getEngine());
+    for (int rev = 0; rev < 2; rev++)
+    {
+      ref.reset();
+      ref.setPolynome(CRC8_DALLAS_MAXIM);
+      ref.setStartXOR(0xFF);
+      ref.setEndXOR(0x00);
+      ref.setReverseIn(rev == 1);
+      ref.setReverseOut(rev == 1);
+      ref.add(buffer, 300);
+
+      crc.reset();
+      crc.setPolynome(CRC8_DALLAS_MAXIM);
+      crc.setStartXOR(0xFF);
+      crc.setEndXOR(0x00);
+      crc.setReverseIn(rev == 1);
+      crc.setReverseOut(rev == 1);
+      //  mix single values and odd sized blocks.
+      crc.add(buffer[0]);
+      crc.add(buffer + 1, 13);
+      crc.add(buffer + 14, 286);
+      assertEqual(ref.getCRC(), crc.getCRC());
+      assertEqual(300, crc.count());
+    }
+  }
+}
+
+
+unittest(test_crc8_append)
+{
+  fprintf(stderr, "TEST CRC8 APPEND\n");
+
+  uint8_t buffer[200];
+  for (int i = 0; i < 200; i++) buffer[i] = i * 37 + 11;
+
+  for (int rev = 0; rev < 2; rev++)
+  {
+    CRC8 ref(CRC8_DALLAS_MAXIM, 0xFF, 0x5A, rev == 1, rev == 1);
+    ref.add(buffer, 200);
+
+    CRC8 crcA(CRC8_DALLAS_MAXIM, 0xFF, 0x5A, rev == 1, rev == 1);
+    CRC8 crcB(CRC8_DALLAS_MAXIM, 0xFF, 0x5A, rev == 1, rev == 1);
+    crcA.add(buffer, 77);
+    crcB.add(buffer + 77, 123);
+    crcA.append(crcB.getCRC(), 123);
+    assertEqual(ref.getCRC(), crcA.getCRC());
+    assertEqual(200, crcA.count());
+
+    //  continue adding after append.
+    ref.add(buffer, 50);
+    crcA.add(buffer, 50);
+    assertEqual(ref.getCRC(), crcA.getCRC());
+  }
+}
+
+
+unittest(test_crc8_copy)
+{
+  fprintf(stderr, "TEST CRC8 COPY\n");
+
+  uint8_t buffer[100];
+  for (int i = 0; i < 100; i++) buffer[i] = i * 13 + 7;
+
+  CRC8 ref;
+  ref.add(buffer, 100);
+
+  CRC8 a;
+  assertTrue(a.setEngine(CRC_ENGINE_TABLE));
+  a.add(buffer, 50);
+
+  CRC8 b(a);
+  CRC8 c;
+  c = a;
+  c = c;
+  assertEqual(CRC_ENGINE_TABLE, b.getEngine());
+  assertEqual(CRC_ENGINE_TABLE, c.getEngine());
+  {
+    //  destroying a copy must not free the table of a.
+    CRC8 d = a;
+    d.add(buffer + 50, 50);
+    assertEqual(ref.getCRC(), d.getCRC());
+  }
+
+  a.add(buffer + 50, 50);
+  b.add(buffer + 50, 50);
+  c.add(buffer + 50, 50);
+  assertEqual(ref.getCRC(), a.getCRC());
+  assertEqual(ref.getCRC(), b.getCRC());
+  assertEqual(ref.getCRC(), c.getCRC());
+  assertEqual(100, b.count());
+}
+
+
 unittest_main()
 
 // --------
@@ -0,0 +1,178 @@
+//
+//    FILE: unit_test_crc_hw.cpp
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: unit tests for the CRC library
+//          https://github.com/RobTillaart/CRC
+//          https://github.com/Arduino-CI/arduino_ci/blob/master/REFERENCE.md
+//
+
+// supported assertions
+// ----------------------------
+// assertEqual(expected, actual);               // a == b
+// assertNotEqual(unwanted, actual);            // a != b
+// assertComparativeEquivalent(expected, actual);    // abs(a - b) == 0 or (!(a > b) && !(a < b))
+// assertComparativeNotEquivalent(unwanted, actual); // abs(a - b) > 0  or ((a > b) || (a < b))
+// assertLess(upperBound, actual);              // a < b
+// assertMore(lowerBound, actual);              // a > b
+// assertLessOrEqual(upperBound, actual);       // a <= b
+// assertMoreOrEqual(lowerBound, actual);       // a >= b
+// assertTrue(actual);
+// assertFalse(actual);
+// assertNull(actual);
+
+// // special cases for floats
+// assertEqualFloat(expected, actual, epsilon);    // fabs(a - b) <= epsilon
+// assertNotEqualFloat(unwanted, actual, epsilon); // fabs(a - b) >= epsilon
+// assertInfinity(actual);                         // isinf(a)
+// assertNotInfinity(actual);                      // !isinf(a)
+// assertNAN(arg);                                 // isnan(a)
+// assertNotNAN(arg);                              // !isnan(a)
+
+
+
+#include <ArduinoUnitTests.h>
+
+
+#include "Arduino.h"
+#include "CRC.h"
+#include "CRC_hw.h"
+#include "CRC32.h"
+#include "CRC64.h"
+
+
+char str[24] = "123456789";
+uint8_t * data = (uint8_t *) str;
+
+uint8_t buffer[5003];  //  tests use buffer + 3 with up to 4999 bytes
+
+
+unittest_setup()
+{
+  fprintf(stderr, "CRC_LIB_VERSION: %s\n", (char *) CRC_LIB_VERSION);
+  fprintf(stderr, "HW features: %02X\n", crcHardwareFeatures());
+  for (int i = 0; i < 5003; i++) buffer[i] = (i * 131 + 7) ^ (i >> 5);
+}
+
+
+unittest_teardown()
+{
+}
+
+
+unittest(test_crc32_hw_check)
+{
+  assertEqual(0xCBF43926, crc32_hw(data, 9, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true));
+  assertEqual(0xFC891918, crc32_hw(data, 9, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, false, false));
+  assertEqual(0xE3069283, crc32_hw(data, 9, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, true, true));
+  assertEqual(0x87315576, crc32_hw(data, 9, 0xA833982B, 0xFFFFFFFF, 0xFFFFFFFF, true, true));
+  assertEqual(0x340BC6D9, crc32_hw(data, 9, 0x04C11DB7, 0xFFFFFFFF, 0x00000000, true, true));
+}
+
+
+unittest(test_crc32_hw_compare)
+{
+  const uint32_t polynomes[4] = { CRC32_ISO3309, CRC32_CASTAGNOLI, CRC32_KOOPMAN, CRC32_Q };
+  const uint16_t lengths[10]  = { 0, 1, 63, 64, 79, 255, 256, 271, 1000, 4999 };
+
+  for (int p = 0; p < 4; p++)
+  {
+    for (int l = 0; l < 10; l++)
+    {
+      for (int r = 0; r < 4; r++)
+      {
+        bool rin  = (r & 1);
+        bool rout = (r & 2);
+        uint32_t ref = crc32(buffer + 1, lengths[l], polynomes[p], 0xFFFFFFFF, 0x5A5A5A5A, rin, rout);
+        uint32_t hw  = crc32_hw(buffer + 1, lengths[l], polynomes[p], 0xFFFFFFFF, 0x5A5A5A5A, rin, rout);
+        assertEqual(ref, hw);
+      }
+    }
+  }
+}
+
+
+unittest(test_crc64_hw_compare)
+{
+  const uint64_t polynomes[2] = { CRC64_ECMA64, CRC64_ISO64 };
+  const uint16_t lengths[10]  = { 0, 1, 63, 64, 79, 255, 256, 271, 1000, 4999 };
+
+  for (int p = 0; p < 2; p++)
+  {
+    for (int l = 0; l < 10; l++)
+    {
+      for (int r = 0; r < 4; r++)
+      {
+        bool rin  = (r & 1);
+        bool rout = (r & 2);
+        uint64_t ref = crc64(buffer + 3, lengths[l], polynomes[p], 0xFFFFFFFFFFFFFFFF, 0x1234, rin, rout);
+        uint64_t hw  = crc64_hw(buffer + 3, lengths[l], polynomes[p], 0xFFFFFFFFFFFFFFFF, 0x1234, rin, rout);
+        assertEqual(ref, hw);
+      }
+    }
+  }
+}
+
+
+//  more polynomes than the constants cache holds, every polynome twice.
+unittest(test_crc_hw_cache)
+{
+  const uint16_t lengths[3] = { 64, 200, 1000 };
+  uint32_t poly32 = 0x04C11DB7;
+  uint64_t poly64 = 0x42F0E1EBA9EA3693;
+
+  for (int p = 0; p < 12; p++)
+  {
+    poly32 = poly32 * 1103515245 + 12345;
+    poly64 = poly64 * 6364136223846793005ULL + 1442695040888963407ULL;
+    for (int pass = 0; pass < 2; pass++)
+    {
+      for (int l = 0; l < 3; l++)
+      {
+        bool rin = (l + pass) & 1;
+        assertEqual(crc32(buffer, lengths[l], poly32, 0xFFFFFFFF, 0, rin, false),
+                    crc32_hw(buffer, lengths[l], poly32, 0xFFFFFFFF, 0, rin, false));
+        assertEqual(crc64(buffer, lengths[l], poly64, 0, 0xFF, rin, rin),
+                    crc64_hw(buffer, lengths[l], poly64, 0, 0xFF, rin, rin));
+      }
+    }
+  }
+}
+
+
+unittest(test_crc_parallel)
+{
+  //  large buffer so multiple threads are used.
+  const size_t size = 300000;
+  uint8_t * big = (uint8_t *) malloc(size);
+  assertNotNull(big);
+  for (size_t i = 0; i < size; i++) big[i] = (i * 2654435761UL) >> 13;
+
+  //  serial reference with the class.
+  CRC32 crc(CRC32_ISO3309, 0xFFFFFFFF, 0xFFFFFFFF, true, true);
+  crc.setEngine(CRC_ENGINE_SLICE8);
+  for (size_t i = 0; i < size; i += 10000) crc.add(big + i, 10000);
+  uint32_t ref32 = crc.getCRC();
+  for (uint8_t threads = 0; threads < 6; threads++)
+  {
+    assertEqual(ref32, crc32_parallel(big, size, CRC32_ISO3309, 0xFFFFFFFF, 0xFFFFFFFF, true, true, threads));
+  }
+
+  //  non reflected polynome, all threads read the shared constants cache.
+  uint32_t refQ = crc32(big, size, CRC32_Q, 0, 0, false, false);
+  assertEqual(refQ, crc32_parallel(big, size, CRC32_Q, 0, 0, false, false, 4));
+
+  CRC64 crc64(CRC64_ECMA64, 0, 0, false, false);
+  for (size_t i = 0; i < size; i += 10000) crc64.add(big + i, 10000);
+  uint64_t ref64 = crc64.getCRC();
+  for (uint8_t threads = 0; threads < 6; threads++)
+  {
+    assertEqual(ref64, crc64_parallel(big, size, CRC64_ECMA64, 0, 0, false, false, threads));
+  }
+  free(big);
+}
+
+
+unittest_main()
+
+// --------
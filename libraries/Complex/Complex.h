@@ -2,7 +2,7 @@
 //
 //    FILE: Complex.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.3.2
+// VERSION: 0.4.0
 // PURPOSE: Arduino library for Complex math
 //     URL: https://github.com/RobTillaart/Complex
 //          http://arduino.cc/playground/Main/ComplexMath
@@ -12,7 +12,7 @@
 #include "Printable.h"
 
 
-#define COMPLEX_LIB_VERSION                 (F("0.3.2"))
+#define COMPLEX_LIB_VERSION                 (F("0.4.0"))
 
 
 class Complex: public Printable
@@ -99,6 +99,10 @@ public:
     Complex c_acoth() const;
 
 
+    //  direct access to re and im for the array kernels.
+    friend class ComplexFFT;
+
+
 protected:
     float re;
     float im;
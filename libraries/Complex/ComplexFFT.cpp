@@ -0,0 +1,452 @@
+//
+//    FILE: ComplexFFT.cpp
+//  AUTHOR: Rob Tillaart
+// VERSION: 0.4.0
+// PURPOSE: in place FFT for arrays of Complex, float arrays and real signals.
+//     URL: https://github.com/RobTillaart/Complex
+
+
+#include "ComplexFFT.h"
+
+
+//  ACCESSORS, one transform for all data layouts.
+struct ComplexFFT::_SoA
+{
+  float * _re;
+  float * _im;
+  inline float & r(uint32_t k) { return _re[k]; };
+  inline float & i(uint32_t k) { return _im[k]; };
+};
+
+
+struct ComplexFFT::_AoS
+{
+  Complex * _c;
+  inline float & r(uint32_t k) { return _c[k].re; };
+  inline float & i(uint32_t k) { return _c[k].im; };
+};
+
+
+struct ComplexFFT::_Interleaved
+{
+  float * _d;
+  inline float & r(uint32_t k) { return _d[2 * k]; };
+  inline float & i(uint32_t k) { return _d[2 * k + 1]; };
+};
+
+
+ComplexFFT::ComplexFFT(uint32_t size)
+{
+  _size  = 0;
+  _radix = 4;
+  _sin   = NULL;
+  if ((size == 0) || (size & (size - 1))) return;
+  if (size < 4) size = 4;
+
+  uint32_t q = size / 4;
+  _sin = (float *) malloc((q + 1) * sizeof(float));
+  if (_sin == NULL) return;
+  //  use cos for the upper half for accuracy.
+  for (uint32_t k = 0; k <= q; k++)
+  {
+    if (k <= q / 2) _sin[k] = sin((2.0 * PI * k) / size);
+    else            _sin[k] = cos((2.0 * PI * (q - k)) / size);
+  }
+  _size = size;
+}
+
+
+ComplexFFT::~ComplexFFT()
+{
+  if (_sin) free(_sin);
+}
+
+
+//////////////////////////////////////////////////////////////
+//
+//  TRANSFORMS
+//
+bool ComplexFFT::fft(float * re, float * im, uint32_t n)
+{
+  if (!_valid(n, 1)) return false;
+  _SoA a = { re, im };
+  _transform(a, n, false);
+  return true;
+}
+
+
+bool ComplexFFT::ifft(float * re, float * im, uint32_t n)
+{
+  if (!_valid(n, 1)) return false;
+  _SoA a = { re, im };
+  _transform(a, n, true);
+  _scale(a, n);
+  return true;
+}
+
+
+bool ComplexFFT::fft(Complex * data, uint32_t n)
+{
+  if (!_valid(n, 1)) return false;
+  _AoS a = { data };
+  _transform(a, n, false);
+  return true;
+}
+
+
+bool ComplexFFT::ifft(Complex * data, uint32_t n)
+{
+  if (!_valid(n, 1)) return false;
+  _AoS a = { data };
+  _transform(a, n, true);
+  _scale(a, n);
+  return true;
+}
+
+
+//  n real samples are treated as n/2 complex samples z[k] = x[2k] + i x[2k+1].
+//  with Z = FFT(z) the spectrum is
+//    X[k] = E - i W^k O,  E = (Z[k] + conj(Z[n/2-k])) / 2,
+//                         O = (Z[k] - conj(Z[n/2-k])) / 2,  W = exp(-2 PI i / n)
+//  and X[n/2-k] = conj(E + i W^k O), so k and n/2-k are done together.
+bool ComplexFFT::rfft(float * data, uint32_t n)
+{
+  if (!_valid(n, 4)) return false;
+  uint32_t h = n / 2;
+  _Interleaved a = { data };
+  _transform(a, h, false);
+
+  float r0 = data[0];
+  float i0 = data[1];
+  data[0] = r0 + i0;
+  data[1] = r0 - i0;
+
+  uint32_t stride = _size / n;
+  for (uint32_t k = 1; k <= h / 2; k++)
+  {
+    uint32_t k2 = h - k;
+    float ar = data[2 * k];
+    float ai = data[2 * k + 1];
+    float br = data[2 * k2];
+    float bi = -data[2 * k2 + 1];
+    float er = 0.5f * (ar + br);
+    float ei = 0.5f * (ai + bi);
+    float pr = 0.5f * (ar - br);
+    float pi = 0.5f * (ai - bi);
+    float c, s;
+    _twiddle(k * stride, c, s);
+    //  T = i * W^k * O
+    float tr = -(c * pi - s * pr);
+    float ti =   c * pr + s * pi;
+    data[2 * k]      = er - tr;
+    data[2 * k + 1]  = ei - ti;
+    data[2 * k2]     = er + tr;
+    data[2 * k2 + 1] = -(ei + ti);
+  }
+  return true;
+}
+
+
+bool ComplexFFT::irfft(float * data, uint32_t n)
+{
+  if (!_valid(n, 4)) return false;
+  uint32_t h = n / 2;
+
+  float x0 = data[0];
+  float xh = data[1];
+  data[0] = 0.5f * (x0 + xh);
+  data[1] = 0.5f * (x0 - xh);
+
+  uint32_t stride = _size / n;
+  for (uint32_t k = 1; k <= h / 2; k++)
+  {
+    uint32_t k2 = h - k;
+    float xr = data[2 * k];
+    float xi = data[2 * k + 1];
+    float yr = data[2 * k2];
+    float yi = -data[2 * k2 + 1];
+    float er = 0.5f * (xr + yr);
+    float ei = 0.5f * (xi + yi);
+    float tr = -0.5f * (xr - yr);
+    float ti = -0.5f * (xi - yi);
+    float c, s;
+    _twiddle(k * stride, c, s);
+    //  O = -i * conj(W^k) * T
+    float pr =   c * ti + s * tr;
+    float pi = -(c * tr - s * ti);
+    data[2 * k]      = er + pr;
+    data[2 * k + 1]  = ei + pi;
+    data[2 * k2]     = er - pr;
+    data[2 * k2 + 1] = -(ei - pi);
+  }
+
+  _Interleaved a = { data };
+  _transform(a, h, true);
+  _scale(a, h);
+  return true;
+}
+
+
+//////////////////////////////////////////////////////////////
+//
+//  ARRAY KERNELS
+//
+void ComplexFFT::toArrays(const Complex * data, float * re, float * im, uint32_t n)
+{
+  for (uint32_t k = 0; k < n; k++)
+  {
+    re[k] = data[k].re;
+    im[k] = data[k].im;
+  }
+}
+
+
+void ComplexFFT::fromArrays(const float * re, const float * im, Complex * data, uint32_t n)
+{
+  for (uint32_t k = 0; k < n; k++)
+  {
+    data[k].re = re[k];
+    data[k].im = im[k];
+  }
+}
+
+
+void ComplexFFT::magnitude(const float * re, const float * im, float * mag, uint32_t n)
+{
+  for (uint32_t k = 0; k < n; k++)
+  {
+    mag[k] = sqrt(re[k] * re[k] + im[k] * im[k]);
+  }
+}
+
+
+void ComplexFFT::multiply(Complex * a, const Complex * b, uint32_t n)
+{
+  for (uint32_t k = 0; k < n; k++)
+  {
+    float r = a[k].re * b[k].re - a[k].im * b[k].im;
+    float i = a[k].re * b[k].im + a[k].im * b[k].re;
+    a[k].re = r;
+    a[k].im = i;
+  }
+}
+
+
+void ComplexFFT::multiply(float * aRe, float * aIm, const float * bRe, const float * bIm, uint32_t n)
+{
+  for (uint32_t k = 0; k < n; k++)
+  {
+    float r = aRe[k] * bRe[k] - aIm[k] * bIm[k];
+    float i = aRe[k] * bIm[k] + aIm[k] * bRe[k];
+    aRe[k] = r;
+    aIm[k] = i;
+  }
+}
+
+
+void ComplexFFT::rfftMagnitude(const float * data, float * mag, uint32_t n)
+{
+  //  data[1] is needed last, mag may be data.
+  float xh = data[1];
+  mag[0] = fabs(data[0]);
+  for (uint32_t k = 1; k < n / 2; k++)
+  {
+    mag[k] = sqrt(data[2 * k] * data[2 * k] + data[2 * k + 1] * data[2 * k + 1]);
+  }
+  mag[n / 2] = fabs(xh);
+}
+
+
+void ComplexFFT::dft(const float * re, const float * im, float * outRe, float * outIm, uint32_t n, bool inverse)
+{
+  float sign = inverse ? 1 : -1;
+  for (uint32_t k = 0; k < n; k++)
+  {
+    float sr = 0;
+    float si = 0;
+    for (uint32_t j = 0; j < n; j++)
+    {
+      //  reduce k * j first to keep the angle accurate.
+      uint32_t t = ((uint64_t)k * j) % n;
+      float angle = sign * (2.0 * PI * t) / n;
+      float c = cos(angle);
+      float s = sin(angle);
+      sr += re[j] * c - im[j] * s;
+      si += re[j] * s + im[j] * c;
+    }
+    outRe[k] = inverse ? sr / n : sr;
+    outIm[k] = inverse ? si / n : si;
+  }
+}
+
+
+//////////////////////////////////////////////////////////////
+//
+//  PRIVATE
+//
+bool ComplexFFT::_valid(uint32_t n, uint32_t minimum)
+{
+  if (_sin == NULL) return false;
+  if ((n < minimum) || (n > _size)) return false;
+  return (n & (n - 1)) == 0;
+}
+
+
+void ComplexFFT::_twiddle(uint32_t t, float &c, float &s)
+{
+  uint32_t q = _size / 4;
+  if (t <= q)
+  {
+    c = _sin[q - t];
+    s = _sin[t];
+  }
+  else
+  {
+    c = -_sin[t - q];
+    s = _sin[2 * q - t];
+  }
+}
+
+
+template <class A>
+void ComplexFFT::_transform(A a, uint32_t n, bool inverse)
+{
+  if (n < 2) return;
+
+  //  bit reversal permutation
+  for (uint32_t i = 1, j = 0; i < n; i++)
+  {
+    uint32_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if (i < j)
+    {
+      float t = a.r(i); a.r(i) = a.r(j); a.r(j) = t;
+      t = a.i(i); a.i(i) = a.i(j); a.i(j) = t;
+    }
+  }
+
+  uint8_t log2n = 0;
+  while ((1UL << log2n) < n) log2n++;
+
+  //  first radix-2 stage has only twiddle 1,
+  //  radix-4 needs it for an odd number of stages.
+  uint32_t m = 1;
+  if ((_radix == 2) || (log2n & 1))
+  {
+    for (uint32_t i = 0; i < n; i += 2)
+    {
+      float tr = a.r(i + 1);
+      float ti = a.i(i + 1);
+      a.r(i + 1) = a.r(i) - tr;
+      a.i(i + 1) = a.i(i) - ti;
+      a.r(i) += tr;
+      a.i(i) += ti;
+    }
+    m = 2;
+  }
+
+  if (_radix == 2)
+  {
+    for (; m < n; m <<= 1)
+    {
+      uint32_t stride = _size / (2 * m);
+      for (uint32_t j = 0; j < m; j++)
+      {
+        float wr, wi;
+        _twiddle(j * stride, wr, wi);
+        if (!inverse) wi = -wi;
+        for (uint32_t i = j; i < n; i += 2 * m)
+        {
+          uint32_t k = i + m;
+          float tr = wr * a.r(k) - wi * a.i(k);
+          float ti = wr * a.i(k) + wi * a.r(k);
+          a.r(k) = a.r(i) - tr;
+          a.i(k) = a.i(i) - ti;
+          a.r(i) += tr;
+          a.i(i) += ti;
+        }
+      }
+    }
+    return;
+  }
+
+  //  radix-4, two radix-2 stages (size 2m and 4m) per pass.
+  //  stage 2m uses W1 = W(2m)^j for both pairs,
+  //  stage 4m uses W2 = W(4m)^j and W(4m)^(j+m) = W2 * -i (forward).
+  for (; m < n; m <<= 2)
+  {
+    uint32_t stride = _size / (4 * m);
+    for (uint32_t j = 0; j < m; j++)
+    {
+      float w1r, w1i, w2r, w2i;
+      _twiddle(2 * j * stride, w1r, w1i);
+      _twiddle(j * stride, w2r, w2i);
+      if (!inverse)
+      {
+        w1i = -w1i;
+        w2i = -w2i;
+      }
+      for (uint32_t i = j; i < n; i += 4 * m)
+      {
+        uint32_t i1 = i + m;
+        uint32_t i2 = i1 + m;
+        uint32_t i3 = i2 + m;
+
+        //  stage 2m
+        float br = w1r * a.r(i1) - w1i * a.i(i1);
+        float bi = w1r * a.i(i1) + w1i * a.r(i1);
+        float dr = w1r * a.r(i3) - w1i * a.i(i3);
+        float di = w1r * a.i(i3) + w1i * a.r(i3);
+        float a1r = a.r(i) + br;
+        float a1i = a.i(i) + bi;
+        float b1r = a.r(i) - br;
+        float b1i = a.i(i) - bi;
+        float c1r = a.r(i2) + dr;
+        float c1i = a.i(i2) + di;
+        float d1r = a.r(i2) - dr;
+        float d1i = a.i(i2) - di;
+
+        //  stage 4m
+        float cr = w2r * c1r - w2i * c1i;
+        float ci = w2r * c1i + w2i * c1r;
+        float er = w2r * d1r - w2i * d1i;
+        float ei = w2r * d1i + w2i * d1r;
+        //  times -i (forward) or +i (inverse)
+        if (inverse)
+        {
+          dr = -ei;
+          di = er;
+        }
+        else
+        {
+          dr = ei;
+          di = -er;
+        }
+        a.r(i)  = a1r + cr;
+        a.i(i)  = a1i + ci;
+        a.r(i2) = a1r - cr;
+        a.i(i2) = a1i - ci;
+        a.r(i1) = b1r + dr;
+        a.i(i1) = b1i + di;
+        a.r(i3) = b1r - dr;
+        a.i(i3) = b1i - di;
+      }
+    }
+  }
+}
+
+
+template <class A>
+void ComplexFFT::_scale(A a, uint32_t n)
+{
+  float f = 1.0f / n;
+  for (uint32_t k = 0; k < n; k++)
+  {
+    a.r(k) *= f;
+    a.i(k) *= f;
+  }
+}
+
+
+// -- END OF FILE --
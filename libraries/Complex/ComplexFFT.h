@@ -0,0 +1,91 @@
+#pragma once
+//
+//    FILE: ComplexFFT.h
+//  AUTHOR: Rob Tillaart
+// VERSION: 0.4.0
+// PURPOSE: in place FFT for arrays of Complex, float arrays and real signals.
+//     URL: https://github.com/RobTillaart/Complex
+//
+//  Iterative decimation in time, radix-2 or radix-4 (two radix-2 stages
+//  fused, so a quarter of the twiddle multiplications is free).
+//  Sizes are powers of 2 up to the size given in the constructor.
+//  The twiddles come from a quarter wave sine table of size / 4 + 1 floats.
+//
+//  Data layouts
+//  - Complex * data           array of Complex (Complex has a vtable
+//                              pointer, so 12 or 16 bytes per element)
+//  - float * re, float * im    structure of arrays, fastest, 8 bytes per point
+//  - float * data              real signal, packed spectrum (see rfft)
+//
+//  fft() is not scaled, ifft() scales by 1/n, so ifft(fft(x)) == x.
+
+
+#include "Complex.h"
+
+
+class ComplexFFT
+{
+public:
+  //  size = largest transform, power of 2.
+  ComplexFFT(uint32_t size);
+  ~ComplexFFT();
+
+  //  0 if the table could not be allocated or size is not a power of 2.
+  uint32_t size()   { return _size; };
+
+  //  2 or 4, default 4
+  void     setRadix(uint8_t radix) { _radix = (radix == 2) ? 2 : 4; };
+  uint8_t  getRadix()              { return _radix; };
+
+
+  //  all return false if n is not a power of 2 or larger than size.
+  //  structure of arrays
+  bool     fft(float * re, float * im, uint32_t n);
+  bool     ifft(float * re, float * im, uint32_t n);
+
+  //  array of Complex
+  bool     fft(Complex * data, uint32_t n);
+  bool     ifft(Complex * data, uint32_t n);
+
+  //  n real samples, n >= 4, result packed in place:
+  //    data[0] = X[0], data[1] = X[n/2]  (both real)
+  //    data[2k] + i * data[2k+1] = X[k]  for k = 1 .. n/2 - 1
+  bool     rfft(float * data, uint32_t n);
+  //  inverse of rfft, packed spectrum in, n real samples out.
+  bool     irfft(float * data, uint32_t n);
+
+
+  //  ARRAY KERNELS, no temporaries per element.
+  static void toArrays(const Complex * data, float * re, float * im, uint32_t n);
+  static void fromArrays(const float * re, const float * im, Complex * data, uint32_t n);
+  //  mag may be re or im (in place).
+  static void magnitude(const float * re, const float * im, float * mag, uint32_t n);
+  //  a[i] *= b[i]
+  static void multiply(Complex * a, const Complex * b, uint32_t n);
+  static void multiply(float * aRe, float * aIm, const float * bRe, const float * bIm, uint32_t n);
+  //  magnitudes of a packed rfft spectrum, n/2 + 1 values.
+  static void rfftMagnitude(const float * data, float * mag, uint32_t n);
+
+  //  reference O(n^2) discrete Fourier transform, not in place.
+  static void dft(const float * re, const float * im, float * outRe, float * outIm, uint32_t n, bool inverse = false);
+
+
+private:
+  uint32_t _size;
+  uint8_t  _radix;
+  float *  _sin;    //  _sin[k] = sin(2 PI k / _size), k = 0 .. _size / 4
+
+  struct _SoA;
+  struct _AoS;
+  struct _Interleaved;
+
+  bool     _valid(uint32_t n, uint32_t minimum);
+  //  W(t) = exp(-2 PI i t / _size), 0 <= t < _size / 2
+  void     _twiddle(uint32_t t, float &c, float &s);
+
+  template <class A> void _transform(A a, uint32_t n, bool inverse);
+  template <class A> void _scale(A a, uint32_t n);
+};
+
+
+// -- END OF FILE --
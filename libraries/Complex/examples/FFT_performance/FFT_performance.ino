@@ -0,0 +1,132 @@
+//
+//    FILE: FFT_performance.ino
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: compare naive DFT with radix-2 / radix-4 FFT and real FFT.
+//     URL: https://github.com/RobTillaart/Complex
+//
+//  times in microseconds per transform, error is max abs difference with DFT.
+
+
+#include "Complex.h"
+#include "ComplexFFT.h"
+
+
+#if defined(ARDUINO_ARCH_AVR)
+const uint32_t MAXN = 128;
+const uint32_t MAXDFT = 128;
+#else
+const uint32_t MAXN = 4096;
+const uint32_t MAXDFT = 1024;
+#endif
+
+
+uint32_t start, duration;
+float *re, *im, *dre, *dim;
+Complex *data;
+
+
+void fillSignal(uint32_t n)
+{
+  for (uint32_t k = 0; k < n; k++)
+  {
+    re[k] = sin(k * 0.37) + 0.5 * cos(k * 1.3);
+    im[k] = 0;
+  }
+}
+
+
+float maxError(uint32_t n)
+{
+  float e = 0;
+  for (uint32_t k = 0; k < n; k++)
+  {
+    e = max(e, (float)fabs(re[k] - dre[k]));
+    e = max(e, (float)fabs(im[k] - dim[k]));
+  }
+  return e;
+}
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("COMPLEX_LIB_VERSION: ");
+  Serial.println(COMPLEX_LIB_VERSION);
+  Serial.println();
+
+  re   = (float *) malloc(MAXN * sizeof(float));
+  im   = (float *) malloc(MAXN * sizeof(float));
+  dre  = (float *) malloc(MAXN * sizeof(float));
+  dim  = (float *) malloc(MAXN * sizeof(float));
+  data = new Complex[MAXN];
+  ComplexFFT FFT(MAXN);
+  if ((data == NULL) || (dim == NULL) || (FFT.size() == 0))
+  {
+    Serial.println("not enough memory");
+    return;
+  }
+
+  Serial.println("n\tDFT\tradix2\tradix4\tComplex\trfft\terror");
+  for (uint32_t n = 16; n <= MAXN; n *= 2)
+  {
+    Serial.print(n);
+    Serial.print("\t");
+
+    fillSignal(n);
+    if (n <= MAXDFT)
+    {
+      start = micros();
+      ComplexFFT::dft(re, im, dre, dim, n);
+      duration = micros() - start;
+      Serial.print(duration);
+    }
+    else Serial.print("-");
+    Serial.print("\t");
+
+    FFT.setRadix(2);
+    start = micros();
+    FFT.fft(re, im, n);
+    duration = micros() - start;
+    Serial.print(duration);
+    Serial.print("\t");
+
+    fillSignal(n);
+    FFT.setRadix(4);
+    start = micros();
+    FFT.fft(re, im, n);
+    duration = micros() - start;
+    Serial.print(duration);
+    Serial.print("\t");
+    float err = (n <= MAXDFT) ? maxError(n) : 0;
+
+    fillSignal(n);
+    ComplexFFT::fromArrays(re, im, data, n);
+    start = micros();
+    FFT.fft(data, n);
+    duration = micros() - start;
+    Serial.print(duration);
+    Serial.print("\t");
+
+    //  n real samples
+    fillSignal(n);
+    start = micros();
+    FFT.rfft(re, n);
+    duration = micros() - start;
+    Serial.print(duration);
+    Serial.print("\t");
+
+    Serial.println(err, 6);
+  }
+
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+// -- END OF FILE --
@@ -0,0 +1,60 @@
+//
+//    FILE: FFT_spectrum.ino
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: amplitude spectrum of a sampled vibration signal with the real FFT.
+//     URL: https://github.com/RobTillaart/Complex
+//
+//  replace the simulated signal with e.g. accelerometer samples.
+
+
+#include "Complex.h"
+#include "ComplexFFT.h"
+
+
+const uint32_t N = 256;
+const float SAMPLE_RATE = 1000;   //  Hz
+
+ComplexFFT FFT(N);
+float samples[N];
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("COMPLEX_LIB_VERSION: ");
+  Serial.println(COMPLEX_LIB_VERSION);
+  Serial.println();
+
+  //  50 Hz and 120 Hz components
+  for (uint32_t k = 0; k < N; k++)
+  {
+    float t = k / SAMPLE_RATE;
+    samples[k] = 1.0 * sin(2 * PI * 50 * t) + 0.5 * sin(2 * PI * 120 * t);
+  }
+
+  FFT.rfft(samples, N);
+  //  N/2 + 1 magnitudes, scaled to amplitude.
+  ComplexFFT::rfftMagnitude(samples, samples, N);
+
+  Serial.println("Hz\tamplitude");
+  for (uint32_t k = 0; k <= N / 2; k++)
+  {
+    float amplitude = samples[k] * 2 / N;
+    if (amplitude < 0.1) continue;
+    Serial.print(k * SAMPLE_RATE / N, 1);
+    Serial.print("\t");
+    Serial.println(amplitude, 3);
+  }
+
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+// -- END OF FILE --
@@ -0,0 +1,215 @@
+//
+//    FILE: unit_test_fft.cpp
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: unit tests for the ComplexFFT class
+//          https://github.com/RobTillaart/Complex
+//          https://github.com/Arduino-CI/arduino_ci/blob/master/REFERENCE.md
+//
+
+// supported assertions
+// ----------------------------
+// assertEqual(expected, actual)
+// assertNotEqual(expected, actual)
+// assertLess(expected, actual)
+// assertMore(expected, actual)
+// assertLessOrEqual(expected, actual)
+// assertMoreOrEqual(expected, actual)
+// assertTrue(actual)
+// assertFalse(actual)
+// assertNull(actual)
+// assertNotNull(actual)
+
+
+#include <ArduinoUnitTests.h>
+
+
+#include "Arduino.h"
+#include "Complex.h"
+#include "ComplexFFT.h"
+
+
+#define N   256
+
+float re[N], im[N], dre[N], dim[N];
+
+
+void fillSignal(uint32_t n)
+{
+  for (uint32_t k = 0; k < n; k++)
+  {
+    re[k] = sin(k * 0.37) + 0.5 * cos(k * 1.3) + (k % 7) * 0.1;
+    im[k] = cos(k * 0.11) - (k % 3) * 0.2;
+  }
+}
+
+
+float maxError(uint32_t n)
+{
+  float e = 0;
+  for (uint32_t k = 0; k < n; k++)
+  {
+    e = max(e, (float)fabs(re[k] - dre[k]));
+    e = max(e, (float)fabs(im[k] - dim[k]));
+  }
+  return e;
+}
+
+
+unittest_setup()
+{
+  fprintf(stderr, "COMPLEX_LIB_VERSION: %s\n", (char *) COMPLEX_LIB_VERSION);
+}
+
+
+unittest_teardown()
+{
+}
+
+
+unittest(test_constructor)
+{
+  ComplexFFT a(N);
+  assertEqual(N, a.size());
+  assertEqual(4, a.getRadix());
+  a.setRadix(2);
+  assertEqual(2, a.getRadix());
+  a.setRadix(3);
+  assertEqual(4, a.getRadix());
+
+  ComplexFFT b(100);
+  assertEqual(0, b.size());
+  assertFalse(b.fft(re, im, 64));
+
+  //  size checks
+  assertFalse(a.fft(re, im, N * 2));
+  assertFalse(a.fft(re, im, 48));
+  assertFalse(a.rfft(re, 2));
+}
+
+
+unittest(test_fft_versus_dft)
+{
+  ComplexFFT FFT(N);
+  for (uint8_t radix = 2; radix <= 4; radix += 2)
+  {
+    FFT.setRadix(radix);
+    for (uint32_t n = 1; n <= N; n *= 2)
+    {
+      fillSignal(n);
+      ComplexFFT::dft(re, im, dre, dim, n);
+      assertTrue(FFT.fft(re, im, n));
+      float err = maxError(n);
+      fprintf(stderr, "radix %d\tn %d\terror %e\n", radix, n, err);
+      assertLess(err, 1e-4 * n);
+    }
+  }
+}
+
+
+unittest(test_ifft_roundtrip)
+{
+  ComplexFFT FFT(N);
+  for (uint8_t radix = 2; radix <= 4; radix += 2)
+  {
+    FFT.setRadix(radix);
+    fillSignal(N);
+    memcpy(dre, re, sizeof(re));
+    memcpy(dim, im, sizeof(im));
+    FFT.fft(re, im, N);
+    FFT.ifft(re, im, N);
+    assertLess(maxError(N), 1e-5);
+
+    //  ifft equals the inverse dft
+    FFT.fft(re, im, N);
+    ComplexFFT::dft(re, im, dre, dim, N, true);
+    FFT.ifft(re, im, N);
+    assertLess(maxError(N), 1e-5);
+  }
+}
+
+
+unittest(test_fft_complex_array)
+{
+  ComplexFFT FFT(64);
+  Complex data[64];
+  fillSignal(64);
+  ComplexFFT::fromArrays(re, im, data, 64);
+  assertEqualFloat(re[5], data[5].real(), 0);
+  assertEqualFloat(im[5], data[5].imag(), 0);
+
+  FFT.fft(data, 64);
+  FFT.fft(re, im, 64);
+  ComplexFFT::toArrays(data, dre, dim, 64);
+  assertLess(maxError(64), 1e-6);
+
+  FFT.ifft(data, 64);
+  fillSignal(64);
+  ComplexFFT::toArrays(data, dre, dim, 64);
+  assertLess(maxError(64), 1e-5);
+}
+
+
+unittest(test_rfft)
+{
+  ComplexFFT FFT(N);
+  for (uint32_t n = 4; n <= N; n *= 2)
+  {
+    fillSignal(n);
+    for (uint32_t k = 0; k < n; k++) im[k] = 0;
+    ComplexFFT::dft(re, im, dre, dim, n);
+
+    float data[N];
+    memcpy(data, re, n * sizeof(float));
+    assertTrue(FFT.rfft(data, n));
+    float err = max(fabs(data[0] - dre[0]), fabs(data[1] - dre[n / 2]));
+    for (uint32_t k = 1; k < n / 2; k++)
+    {
+      err = max(err, (float)fabs(data[2 * k] - dre[k]));
+      err = max(err, (float)fabs(data[2 * k + 1] - dim[k]));
+    }
+    fprintf(stderr, "rfft\tn %d\terror %e\n", n, err);
+    assertLess(err, 1e-4 * n);
+
+    assertTrue(FFT.irfft(data, n));
+    err = 0;
+    for (uint32_t k = 0; k < n; k++) err = max(err, (float)fabs(data[k] - re[k]));
+    assertLess(err, 1e-5);
+  }
+}
+
+
+unittest(test_kernels)
+{
+  float a[4] = { 3, 0, 1, -6 };
+  float b[4] = { 4, 1, 0, 8 };
+  float m[4];
+  ComplexFFT::magnitude(a, b, m, 4);
+  assertEqualFloat(5, m[0], 1e-6);
+  assertEqualFloat(1, m[1], 1e-6);
+  assertEqualFloat(1, m[2], 1e-6);
+  assertEqualFloat(10, m[3], 1e-6);
+
+  Complex x[2] = { Complex(1, 2), Complex(0, 1) };
+  Complex y[2] = { Complex(3, -1), Complex(0, 1) };
+  ComplexFFT::multiply(x, y, 2);
+  assertTrue(x[0] == Complex(1, 2) * Complex(3, -1));
+  assertTrue(x[1] == Complex(-1, 0));
+
+  //  pure tone in bin 3
+  ComplexFFT FFT(32);
+  float data[32];
+  for (int k = 0; k < 32; k++) data[k] = cos(2 * PI * 3 * k / 32);
+  FFT.rfft(data, 32);
+  ComplexFFT::rfftMagnitude(data, data, 32);
+  for (int k = 0; k <= 16; k++)
+  {
+    assertEqualFloat((k == 3) ? 16 : 0, data[k], 1e-4);
+  }
+}
+
+
+unittest_main()
+
+
+// -- END OF FILE --
@@ -1,7 +1,7 @@
 //
 //    FILE: FastTrig.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.11
+// VERSION: 0.2.1
 // PURPOSE: Arduino library for a faster approximation of sin() and cos()
 //    DATE: 2011-08-18
 //     URL: https://github.com/RobTillaart/FastTrig
@@ -104,7 +104,7 @@ float isin(float f)
   {
     v = v + ((isinTable16[y + 1] - v) / 8 * r) /32;   //  == * r / 256
   }
-  float g = v * 0.0000152590219; // = /65535.0
+  float g = v * 0.0000152590219f; // = /65535.0
   if (pos) return g;
   return -g;
 }
@@ -113,7 +113,7 @@ float isin(float f)
 float icos(float x)
 {
   // prevent modulo math if x in 0..360
-  return isin(x - 270.0);  // better than x + 90;
+  return isin(x - 270.0f);  // better than x + 90;
 }
 
 
@@ -155,7 +155,8 @@ float itan(float f)
   else if (co == 0) return 0;
 
   float si = isinTable16[d];
-  if (rem != 0) si += rem * (isinTable16[d + 1]  - isinTable16[d]);
+  // mirrored the fraction runs the other way.
+  if (rem != 0) si += (mir ? 1 - rem : rem) * (isinTable16[d + 1]  - isinTable16[d]);
 
   float ta = si/co;
   if (neg) return -ta;
@@ -179,6 +180,359 @@ float icot(float f)
 // }
 
 
+///////////////////////////////////////////////////////
+//
+// BATCH GONIO LOOKUP
+//
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define FASTTRIG_SIMD   1
+#else
+#define FASTTRIG_SIMD   0
+#endif
+
+
+#if FASTTRIG_SIMD
+
+// GCC vector extensions, compiles to SSE2 / AVX2 / NEON.
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FASTTRIG_LANES  8
+#else
+#define FASTTRIG_LANES  4
+#endif
+
+typedef float   ft_vf __attribute__((vector_size(FASTTRIG_LANES * 4)));
+typedef int32_t ft_vi __attribute__((vector_size(FASTTRIG_LANES * 4)));
+
+
+static inline ft_vf ft_load(const float * p)
+{
+  ft_vf v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+
+static inline void ft_store(float * p, ft_vf v)
+{
+  memcpy(p, &v, sizeof(v));
+}
+
+
+// lo = table[idx], hi = table[idx + 1]
+static inline void ft_lookup(ft_vi idx, ft_vi &lo, ft_vi &hi)
+{
+#if defined(__AVX2__)
+  // one 32 bit gather reads both neighbours, idx <= 90 so stays within the 92 entries.
+  __m256i both = _mm256_i32gather_epi32((const int *) isinTable16, (__m256i) idx, 2);
+  lo = (ft_vi) _mm256_and_si256(both, _mm256_set1_epi32(0xFFFF));
+  hi = (ft_vi) _mm256_srli_epi32(both, 16);
+#else
+  for (int k = 0; k < FASTTRIG_LANES; k++)
+  {
+    lo[k] = isinTable16[idx[k]];
+    hi[k] = isinTable16[idx[k] + 1];
+  }
+#endif
+}
+
+
+// all lanes finite and below 2^24, so integer part and modulo are exact in float.
+static inline bool ft_inRange(ft_vf a)
+{
+  ft_vi ok = (a < 16777216.0f);
+  int32_t all = -1;
+  for (int k = 0; k < FASTTRIG_LANES; k++) all &= ok[k];
+  return all != 0;
+}
+
+
+// x % m for 0 <= x < 2^24
+static inline ft_vi ft_mod(ft_vi x, int32_t m)
+{
+  ft_vi q = __builtin_convertvector(__builtin_convertvector(x, ft_vf) * (1.0f / m), ft_vi);
+  ft_vi y = x - q * m;
+  y = (y < 0)  ? y + m : y;
+  y = (y >= m) ? y - m : y;
+  return y;
+}
+
+
+// branch free version of isin(), lanes are -1 (true) or 0 (false).
+static inline ft_vf ft_isin(ft_vf f)
+{
+  ft_vi neg = (f < 0);
+  ft_vf a   = neg ? -f : f;
+  ft_vi x   = __builtin_convertvector(a, ft_vi);
+  ft_vi r   = __builtin_convertvector((a - __builtin_convertvector(x, ft_vf)) * 256.0f, ft_vi);
+  ft_vi y   = ft_mod(x, 360);
+
+  ft_vi half = (y >= 180);
+  y    = half ? y - 180 : y;
+  neg ^= half;
+
+  ft_vi mir  = (y >= 90);
+  ft_vi rnz  = (r != 0);
+  y = mir ? 180 - y + rnz : y;          // rnz == -1 => y--
+  r = (mir & rnz) ? 255 - r : r;
+
+  ft_vi t0, t1;
+  ft_lookup(y, t0, t1);
+  ft_vi v = t0 + ((((t1 - t0) >> 3) * r) >> 5);
+  ft_vf g = __builtin_convertvector(v, ft_vf) * 0.0000152590219f;
+  return neg ? -g : g;
+}
+
+
+// branch free version of itan()
+static inline ft_vf ft_itan(ft_vf f)
+{
+  ft_vi neg = (f < 0);
+  ft_vf a   = neg ? -f : f;
+  ft_vi x   = __builtin_convertvector(a, ft_vi);
+  ft_vf rem = a - __builtin_convertvector(x, ft_vf);
+  ft_vf v   = rem + __builtin_convertvector(ft_mod(x, 180), ft_vf);
+
+  ft_vi mir = (v > 90);
+  v    = mir ? 180 - v : v;
+  neg ^= mir;
+  ft_vi d   = __builtin_convertvector(v, ft_vi);
+  ft_vi p   = 90 - d;
+  ft_vi rnz = (rem != 0);
+  ft_vf fr  = mir ? 1 - rem : rem;
+  fr = rnz ? fr : 0;
+
+  //  p == 0 (d == 90) lanes are set to zero below.
+  ft_vi tp, tpm1, td, td1;
+  ft_lookup((p > 0) ? p - 1 : 0, tpm1, tp);
+  ft_lookup(d, td, td1);
+  ft_vf co    = __builtin_convertvector(tp, ft_vf);
+  ft_vf delta = __builtin_convertvector(tp - tpm1, ft_vf);
+  ft_vf coi   = mir ? __builtin_convertvector(tpm1, ft_vf) + rem * delta : co - rem * delta;
+  co = rnz ? coi : co;
+  ft_vf si = __builtin_convertvector(td, ft_vf) + fr * __builtin_convertvector(td1 - td, ft_vf);
+
+  ft_vf ta = si / co;
+  ta = (d == 90) ? 0 : ta;
+  return neg ? -ta : ta;
+}
+
+#endif
+
+
+void isin_batch(const float * in, float * out, size_t n)
+{
+  size_t i = 0;
+#if FASTTRIG_SIMD
+  for (; i + FASTTRIG_LANES <= n; i += FASTTRIG_LANES)
+  {
+    ft_vf f = ft_load(in + i);
+    ft_vf a = (f < 0) ? -f : f;
+    if (ft_inRange(a))
+    {
+      ft_store(out + i, ft_isin(f));
+    }
+    else
+    {
+      for (int k = 0; k < FASTTRIG_LANES; k++) out[i + k] = isin(f[k]);
+    }
+  }
+#else
+  for (; i + 4 <= n; i += 4)
+  {
+    out[i]     = isin(in[i]);
+    out[i + 1] = isin(in[i + 1]);
+    out[i + 2] = isin(in[i + 2]);
+    out[i + 3] = isin(in[i + 3]);
+  }
+#endif
+  for (; i < n; i++) out[i] = isin(in[i]);
+}
+
+
+void icos_batch(const float * in, float * out, size_t n)
+{
+  size_t i = 0;
+#if FASTTRIG_SIMD
+  for (; i + FASTTRIG_LANES <= n; i += FASTTRIG_LANES)
+  {
+    ft_vf f = ft_load(in + i) - 270.0f;
+    ft_vf a = (f < 0) ? -f : f;
+    if (ft_inRange(a))
+    {
+      ft_store(out + i, ft_isin(f));
+    }
+    else
+    {
+      for (int k = 0; k < FASTTRIG_LANES; k++) out[i + k] = isin(f[k]);
+    }
+  }
+#else
+  for (; i + 4 <= n; i += 4)
+  {
+    out[i]     = icos(in[i]);
+    out[i + 1] = icos(in[i + 1]);
+    out[i + 2] = icos(in[i + 2]);
+    out[i + 3] = icos(in[i + 3]);
+  }
+#endif
+  for (; i < n; i++) out[i] = icos(in[i]);
+}
+
+
+void itan_batch(const float * in, float * out, size_t n)
+{
+  size_t i = 0;
+#if FASTTRIG_SIMD
+  for (; i + FASTTRIG_LANES <= n; i += FASTTRIG_LANES)
+  {
+    ft_vf f = ft_load(in + i);
+    ft_vf a = (f < 0) ? -f : f;
+    if (ft_inRange(a))
+    {
+      ft_store(out + i, ft_itan(f));
+    }
+    else
+    {
+      for (int k = 0; k < FASTTRIG_LANES; k++) out[i + k] = itan(f[k]);
+    }
+  }
+#else
+  for (; i + 4 <= n; i += 4)
+  {
+    out[i]     = itan(in[i]);
+    out[i + 1] = itan(in[i + 1]);
+    out[i + 2] = itan(in[i + 2]);
+    out[i + 3] = itan(in[i + 3]);
+  }
+#endif
+  for (; i < n; i++) out[i] = itan(in[i]);
+}
+
+
+void isincos_batch(const float * in, float * sinOut, float * cosOut, size_t n)
+{
+  size_t i = 0;
+#if FASTTRIG_SIMD
+  for (; i + FASTTRIG_LANES <= n; i += FASTTRIG_LANES)
+  {
+    ft_vf f = ft_load(in + i);
+    ft_vf c = f - 270.0f;
+    ft_vf a = (c < 0) ? -c : c;
+    //  |f - 270| in range implies |f| in range.
+    if (ft_inRange(a + 270.0f))
+    {
+      ft_store(sinOut + i, ft_isin(f));
+      ft_store(cosOut + i, ft_isin(c));
+    }
+    else
+    {
+      for (int k = 0; k < FASTTRIG_LANES; k++)
+      {
+        sinOut[i + k] = isin(f[k]);
+        cosOut[i + k] = isin(c[k]);
+      }
+    }
+  }
+#endif
+  for (; i < n; i++)
+  {
+    //  read first, in may be sinOut or cosOut.
+    float f = in[i];
+    sinOut[i] = isin(f);
+    cosOut[i] = icos(f);
+  }
+}
+
+
+///////////////////////////////////////////////////////
+//
+// FIXED POINT GONIO LOOKUP
+//
+// 0..90 degrees in BAM == 0..16384
+static int16_t isinQuarter16(uint16_t a)
+{
+  // degrees in 8.8 fixed point, 90 / 16384 * 256 == 45 / 32
+  uint16_t deg = ((uint32_t)a * 45) >> 5;
+  uint8_t  y = deg >> 8;
+  uint8_t  r = deg & 0xFF;
+  uint16_t v = isinTable16[y];
+  if (r > 0)
+  {
+    v += ((uint32_t)(isinTable16[y + 1] - v) * r) >> 8;
+  }
+  return v >> 1;  // Q16 => Q15
+}
+
+
+int16_t isin16(uint16_t angle)
+{
+  uint16_t a = angle & 0x3FFF;
+  // 2nd and 4th quarter mirror
+  if (angle & 0x4000) a = FASTTRIG_BAM_90 - a;
+  int16_t v = isinQuarter16(a);
+  if (angle & 0x8000) return -v;
+  return v;
+}
+
+
+int16_t icos16(uint16_t angle)
+{
+  return isin16(angle + FASTTRIG_BAM_90);
+}
+
+
+void isincos16(uint16_t angle, int16_t &sinValue, int16_t &cosValue)
+{
+  // cos of the same quarter is the mirrored sin.
+  uint16_t a = angle & 0x3FFF;
+  int16_t s = isinQuarter16(a);
+  int16_t c = isinQuarter16(FASTTRIG_BAM_90 - a);
+  switch (angle >> 14)
+  {
+    case 0: sinValue =  s; cosValue =  c; break;
+    case 1: sinValue =  c; cosValue = -s; break;
+    case 2: sinValue = -s; cosValue = -c; break;
+    case 3: sinValue = -c; cosValue =  s; break;
+  }
+}
+
+
+// atan(i / 32) for i = 0..32 in BAM, 66 bytes
+static const uint16_t iatanTable16[33] = {
+  0, 326, 651, 975, 1297, 1617, 1933, 2246, 2555, 2860,
+  3159, 3453, 3742, 4025, 4302, 4572, 4836, 5094, 5344, 5589,
+  5826, 6058, 6282, 6500, 6712, 6917, 7117, 7310, 7498, 7679,
+  7856, 8026, 8192
+};
+
+
+uint16_t iatan2_16(int16_t y, int16_t x)
+{
+  uint16_t ax = (x < 0) ? -(int32_t)x : x;
+  uint16_t ay = (y < 0) ? -(int32_t)y : y;
+  if ((ax == 0) && (ay == 0)) return 0;
+
+  // fold to the first octant, ratio in Q16
+  bool swap = (ay > ax);
+  uint32_t ratio = swap ? ((uint32_t)ax << 16) / ay : ((uint32_t)ay << 16) / ax;
+  uint16_t a;
+  if (ratio >= 65536UL) a = iatanTable16[32];
+  else
+  {
+    uint8_t  idx  = ratio >> 11;
+    uint16_t frac = ratio & 0x07FF;
+    a = iatanTable16[idx];
+    a += ((uint32_t)(iatanTable16[idx + 1] - a) * frac) >> 11;
+  }
+
+  if (swap)  a = FASTTRIG_BAM_90 - a;
+  if (x < 0) a = FASTTRIG_BAM_180 - a;
+  if (y < 0) a = -a;
+  return a;
+}
+
+
 ///////////////////////////////////////////////////////
 //
 // INVERSE GONIO LOOKUP
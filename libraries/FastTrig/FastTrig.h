@@ -2,7 +2,7 @@
 //
 //    FILE: FastTrig.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.11
+// VERSION: 0.2.1
 // PURPOSE: Arduino library for a faster approximation of sin() and cos()
 //    DATE: 2011-08-18
 //     URL: https://github.com/RobTillaart/FastTrig
@@ -14,7 +14,7 @@
 #include "Arduino.h"
 
 
-#define FAST_TRIG_LIB_VERSION             (F("0.1.11"))
+#define FAST_TRIG_LIB_VERSION             (F("0.2.1"))
 
 
 extern uint16_t isinTable16[];
@@ -37,6 +37,41 @@ float icot(float f);
 // float cot(float f);
 
 
+///////////////////////////////////////////////////////
+//
+// BATCH GONIO LOOKUP
+//
+// same results as the single value functions, in and out may be the same array.
+// uses SIMD (SSE2 / AVX2 / NEON) if available, otherwise an unrolled loop.
+void isin_batch(const float * in, float * out, size_t n);
+
+void icos_batch(const float * in, float * out, size_t n);
+
+void itan_batch(const float * in, float * out, size_t n);
+
+void isincos_batch(const float * in, float * sinOut, float * cosOut, size_t n);
+
+
+///////////////////////////////////////////////////////
+//
+// FIXED POINT GONIO LOOKUP
+//
+// angle in binary angle units (BAM), 65536 == 360 degrees, so it wraps for free.
+// values in Q15, 32767 == 1.0, no float math.
+#define FASTTRIG_BAM_90         16384
+#define FASTTRIG_BAM_180        32768U
+#define FASTTRIG_Q15_ONE        32767
+
+int16_t isin16(uint16_t angle);
+
+int16_t icos16(uint16_t angle);
+
+void isincos16(uint16_t angle, int16_t &sinValue, int16_t &cosValue);
+
+// returns BAM angle of vector (x, y), atan2(0, 0) returns 0.
+uint16_t iatan2_16(int16_t y, int16_t x);
+
+
 ///////////////////////////////////////////////////////
 //
 // INVERSE GONIO LOOKUP
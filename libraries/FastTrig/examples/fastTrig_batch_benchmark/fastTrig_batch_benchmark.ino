@@ -0,0 +1,195 @@
+//
+//    FILE: fastTrig_batch_benchmark.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: compare sin() isin() and isin_batch(), speed and accuracy
+//    DATE: 2026-10-17
+//    (c) : MIT
+//
+
+
+#include "FastTrig.h"
+
+
+#if defined(__AVR__)
+const int SIZE = 90;
+#else
+const int SIZE = 1000;
+#endif
+
+float angle[SIZE];
+float result[SIZE];
+float result2[SIZE];
+
+uint32_t start, duration;
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println();
+  Serial.println(__FILE__);
+  Serial.print("FAST_TRIG_LIB_VERSION: ");
+  Serial.println(FAST_TRIG_LIB_VERSION);
+  Serial.println();
+
+  //  -720 .. 720 degrees, not whole degrees so all calls interpolate.
+  for (int i = 0; i < SIZE; i++)
+  {
+    angle[i] = -720 + i * (1440.0 / SIZE) + 0.123;
+  }
+
+  Serial.println("PERFORMANCE (us per call)");
+  Serial.println("func\tsin()\tisin()\tbatch\t");
+  test_sin();
+  test_cos();
+  test_tan();
+  test_sincos();
+  Serial.println();
+
+  Serial.println("ACCURACY (max abs error vs sin() / cos() / tan())");
+  test_accuracy();
+  Serial.println();
+
+  Serial.println("done...");
+}
+
+
+void loop()
+{
+}
+
+
+void report(uint32_t us, int calls)
+{
+  Serial.print(1.0 * us / calls, 4);
+  Serial.print('\t');
+}
+
+
+void test_sin()
+{
+  Serial.print("sin\t");
+  delay(10);
+  start = micros();
+  for (int i = 0; i < SIZE; i++) result[i] = sin(angle[i] * DEG_TO_RAD);
+  report(micros() - start, SIZE);
+  delay(10);
+  start = micros();
+  for (int i = 0; i < SIZE; i++) result[i] = isin(angle[i]);
+  report(micros() - start, SIZE);
+  delay(10);
+  start = micros();
+  isin_batch(angle, result2, SIZE);
+  report(micros() - start, SIZE);
+  Serial.println(compare() ? "" : "MISMATCH");
+}
+
+
+void test_cos()
+{
+  Serial.print("cos\t");
+  delay(10);
+  start = micros();
+  for (int i = 0; i < SIZE; i++) result[i] = cos(angle[i] * DEG_TO_RAD);
+  report(micros() - start, SIZE);
+  delay(10);
+  start = micros();
+  for (int i = 0; i < SIZE; i++) result[i] = icos(angle[i]);
+  report(micros() - start, SIZE);
+  delay(10);
+  start = micros();
+  icos_batch(angle, result2, SIZE);
+  report(micros() - start, SIZE);
+  Serial.println(compare() ? "" : "MISMATCH");
+}
+
+
+void test_tan()
+{
+  Serial.print("tan\t");
+  delay(10);
+  start = micros();
+  for (int i = 0; i < SIZE; i++) result[i] = tan(angle[i] * DEG_TO_RAD);
+  report(micros() - start, SIZE);
+  delay(10);
+  start = micros();
+  for (int i = 0; i < SIZE; i++) result[i] = itan(angle[i]);
+  report(micros() - start, SIZE);
+  delay(10);
+  start = micros();
+  itan_batch(angle, result2, SIZE);
+  report(micros() - start, SIZE);
+  Serial.println(compare() ? "" : "MISMATCH");
+}
+
+
+//  sin + cos in one call
+void test_sincos()
+{
+  Serial.print("sincos\t");
+  delay(10);
+  start = micros();
+  for (int i = 0; i < SIZE; i++)
+  {
+    result[i]  = sin(angle[i] * DEG_TO_RAD);
+    result2[i] = cos(angle[i] * DEG_TO_RAD);
+  }
+  report(micros() - start, SIZE);
+  delay(10);
+  start = micros();
+  for (int i = 0; i < SIZE; i++)
+  {
+    result[i]  = isin(angle[i]);
+    result2[i] = icos(angle[i]);
+  }
+  report(micros() - start, SIZE);
+  delay(10);
+  start = micros();
+  isincos_batch(angle, result, result2, SIZE);
+  report(micros() - start, SIZE);
+  Serial.println();
+}
+
+
+//  batch must give the same values as the single value function.
+//  itan() may differ in the last bits if the compiler fuses multiply-add.
+bool compare()
+{
+  for (int i = 0; i < SIZE; i++)
+  {
+    float diff = abs(result[i] - result2[i]);
+    if (diff > 1e-6 * abs(result[i])) return false;
+  }
+  return true;
+}
+
+
+void test_accuracy()
+{
+  float maxSin = 0, maxCos = 0, maxTan = 0;
+  isincos_batch(angle, result, result2, SIZE);
+  for (int i = 0; i < SIZE; i++)
+  {
+    float e = abs(result[i] - sin(angle[i] * DEG_TO_RAD));
+    if (e > maxSin) maxSin = e;
+    e = abs(result2[i] - cos(angle[i] * DEG_TO_RAD));
+    if (e > maxCos) maxCos = e;
+  }
+  itan_batch(angle, result, SIZE);
+  for (int i = 0; i < SIZE; i++)
+  {
+    //  skip the poles
+    if (abs(cos(angle[i] * DEG_TO_RAD)) < 0.01) continue;
+    float e = abs(result[i] - tan(angle[i] * DEG_TO_RAD));
+    if (e > maxTan) maxTan = e;
+  }
+  Serial.print("isin_batch\t");
+  Serial.println(maxSin, 6);
+  Serial.print("icos_batch\t");
+  Serial.println(maxCos, 6);
+  Serial.print("itan_batch\t");
+  Serial.println(maxTan, 6);
+}
+
+
+//  -- END OF FILE --
@@ -0,0 +1,108 @@
+//
+//    FILE: fastTrig_fixed_point.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: compare fixed point isin16() iatan2_16() with the float versions
+//    DATE: 2026-10-17
+//    (c) : MIT
+//
+//  angle in BAM, 65536 == 360 degrees, values in Q15, 32767 == 1.0
+
+
+#include "FastTrig.h"
+
+
+const uint16_t CALLS = 1000;
+
+uint32_t start, duration;
+volatile float   f;
+volatile int16_t q;
+volatile uint16_t b;
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println();
+  Serial.println(__FILE__);
+  Serial.print("FAST_TRIG_LIB_VERSION: ");
+  Serial.println(FAST_TRIG_LIB_VERSION);
+  Serial.println();
+
+  Serial.println("func\tus/call\tcycles/call");
+
+  //  the float versions get the same angles in degrees / radians.
+  start = micros();
+  for (uint16_t i = 0; i < CALLS; i++) f = sin(i * 65.0 * (TWO_PI / 65536));
+  report("sin", micros() - start);
+
+  start = micros();
+  for (uint16_t i = 0; i < CALLS; i++) f = isin(i * 65.0 * (360.0 / 65536));
+  report("isin", micros() - start);
+
+  start = micros();
+  for (uint16_t i = 0; i < CALLS; i++) q = isin16(i * 65);
+  report("isin16", micros() - start);
+
+  int16_t s, c;
+  start = micros();
+  for (uint16_t i = 0; i < CALLS; i++)
+  {
+    isincos16(i * 65, s, c);
+    q = s + c;
+  }
+  report("sincos16", micros() - start);
+
+  start = micros();
+  for (uint16_t i = 0; i < CALLS; i++) f = atan2(i - 500, 300);
+  report("atan2", micros() - start);
+
+  start = micros();
+  for (uint16_t i = 0; i < CALLS; i++) b = iatan2_16(i - 500, 300);
+  report("iatan2_16", micros() - start);
+  Serial.println();
+
+  //  accuracy, full circle
+  int16_t maxSin = 0;
+  for (uint32_t a = 0; a < 65536; a += 7)
+  {
+    int16_t e = abs(isin16(a) - (int16_t)round(sin(a * (TWO_PI / 65536)) * 32767));
+    if (e > maxSin) maxSin = e;
+  }
+  Serial.print("isin16 max error LSB:\t");
+  Serial.println(maxSin);
+
+  int16_t maxAtan = 0;
+  for (int32_t y = -32000; y <= 32000; y += 1000)
+  {
+    for (int32_t x = -32000; x <= 32000; x += 1000)
+    {
+      int32_t ref = round(atan2(y, x) * (65536 / TWO_PI));
+      int16_t e = abs((int16_t)(iatan2_16(y, x) - (uint16_t)ref));
+      if (e > maxAtan) maxAtan = e;
+    }
+  }
+  Serial.print("iatan2_16 max error BAM:\t");
+  Serial.println(maxAtan);
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+void report(const char * name, uint32_t us)
+{
+  Serial.print(name);
+  Serial.print('\t');
+  Serial.print(1.0 * us / CALLS, 3);
+  Serial.print('\t');
+#ifdef F_CPU
+  Serial.print(1.0 * us / CALLS * (F_CPU / 1000000UL), 1);
+#endif
+  Serial.println();
+}
+
+
+//  -- END OF FILE --
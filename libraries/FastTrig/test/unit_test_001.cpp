@@ -91,6 +91,116 @@ unittest(test_max_error_table8)
 }
 
 
+unittest(test_itan_mirror)
+{
+  //  0.2.0 fixed interpolation for 90..180 degrees
+  const float degrees2radians = PI/180.0;
+  assertEqualFloat(tan(135.3 * degrees2radians), itan(135.3), 0.0001);
+  assertEqualFloat(tan(150.7 * degrees2radians), itan(150.7), 0.0001);
+  assertEqualFloat(tan(-120.2 * degrees2radians), itan(-120.2), 0.0001);
+}
+
+
+unittest(test_batch)
+{
+  //  odd size to test the tail.
+  const int SIZE = 1003;
+  float in[SIZE], out[SIZE], out2[SIZE];
+  for (int i = 0; i < SIZE; i++) in[i] = (i - 500) * 1.37;
+  in[3] = 0;
+  in[4] = -0.0;
+  in[5] = 90;
+  in[6] = 1e9;     //  out of SIMD range
+
+  isin_batch(in, out, SIZE);
+  for (int i = 0; i < SIZE; i++) assertEqual(isin(in[i]), out[i]);
+
+  icos_batch(in, out, SIZE);
+  for (int i = 0; i < SIZE; i++) assertEqual(icos(in[i]), out[i]);
+
+  isincos_batch(in, out, out2, SIZE);
+  for (int i = 0; i < SIZE; i++)
+  {
+    assertEqual(isin(in[i]), out[i]);
+    assertEqual(icos(in[i]), out2[i]);
+  }
+
+  //  fused multiply add may change the last bits.
+  itan_batch(in, out, SIZE);
+  for (int i = 0; i < SIZE; i++)
+  {
+    assertEqualFloat(itan(in[i]), out[i], 1e-6 * abs(out[i]) + 1e-7);
+  }
+
+  //  in place
+  for (int i = 0; i < SIZE; i++) out[i] = in[i];
+  isin_batch(out, out, SIZE);
+  for (int i = 0; i < SIZE; i++) assertEqual(isin(in[i]), out[i]);
+}
+
+
+unittest(test_isin16)
+{
+  //  Q15 versus float, all angles
+  const float bam2radians = 2 * PI / 65536.0;
+  int16_t maxError = 0;
+  for (uint32_t a = 0; a < 65536; a++)
+  {
+    int16_t s = isin16(a);
+    int16_t e = abs(s - (int16_t)round(sin(a * bam2radians) * 32767));
+    if (e > maxError) maxError = e;
+
+    int16_t si, co;
+    isincos16(a, si, co);
+    assertEqual(s, si);
+    assertEqual(icos16(a), co);
+  }
+  fprintf(stderr, "isin16 max error: %d LSB\n", maxError);
+  assertLessOrEqual(maxError, 4);
+
+  assertEqual(0, isin16(0));
+  assertEqual(32767, isin16(FASTTRIG_BAM_90));
+  assertEqual(0, isin16(FASTTRIG_BAM_180));
+  assertEqual(-32767, isin16(3 * FASTTRIG_BAM_90));
+  assertEqual(32767, icos16(0));
+}
+
+
+unittest(test_iatan2_16)
+{
+  assertEqual(0,     iatan2_16(0, 0));
+  assertEqual(0,     iatan2_16(0, 100));
+  assertEqual(16384, iatan2_16(100, 0));
+  assertEqual(32768, iatan2_16(0, -100));
+  assertEqual(49152, iatan2_16(-100, 0));
+  assertEqual(8192,  iatan2_16(32767, 32767));
+  assertEqual(40960, iatan2_16(-32768, -32768));
+
+  int16_t maxError = 0;
+  for (int32_t y = -32768; y < 32768; y += 997)
+  {
+    for (int32_t x = -32768; x < 32768; x += 991)
+    {
+      uint16_t a = iatan2_16(y, x);
+      int32_t ref = round(atan2(y, x) * 65536 / (2 * PI));
+      int16_t e = abs((int16_t)(a - (uint16_t)ref));
+      if (e > maxError) maxError = e;
+    }
+  }
+  fprintf(stderr, "iatan2_16 max error: %d BAM\n", maxError);
+  assertLessOrEqual(maxError, 2);
+
+  //  round trip
+  for (uint32_t a = 0; a < 65536; a += 61)
+  {
+    int16_t s, c;
+    isincos16(a, s, c);
+    int16_t e = iatan2_16(s, c) - a;
+    assertLessOrEqual(abs(e), 4);
+  }
+}
+
+
 unittest_main()
 
 // --------
@@ -1,7 +1,7 @@
 //
 //    FILE: Fletcher.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.7
+// VERSION: 0.1.9
 //    DATE: 2022-01-25
 // PURPOSE: Arduino Library for calculating Fletcher's checksum
 //     URL: https://github.com/RobTillaart/Fletcher
@@ -14,14 +14,14 @@
 
 
 //  straightforward implementation.
-//  max length buffer 65534.
+//  length is a size_t, no 64 KB limit.
 //  Wikipedia shows optimizations.
 //
-uint16_t fletcher16(uint8_t *data, uint16_t length)
+uint16_t fletcher16(const uint8_t *data, size_t length)
 {
   uint32_t s1 = 0;
   uint32_t s2 = 0;
-  for (uint16_t i = 0; i < length;)
+  for (size_t i = 0; i < length;)
   {
     // if S2 is halfway it is time to do modulo
     while ((i < length) && (s2 < 2147483648ULL))
@@ -39,11 +39,11 @@ uint16_t fletcher16(uint8_t *data, uint16_t length)
 }
 
 
-uint32_t fletcher32(uint16_t *data, uint16_t length)
+uint32_t fletcher32(const uint16_t *data, size_t length)
 {
   uint32_t s1 = 0;
   uint32_t s2 = 0;
-  for (uint16_t i = 0; i < length;)
+  for (size_t i = 0; i < length;)
   {
     // if S2 is halfway it is time to do modulo
     while ((i < length) && (s2 < 2147483648ULL))
@@ -58,11 +58,11 @@ uint32_t fletcher32(uint16_t *data, uint16_t length)
 }
 
 
-uint64_t fletcher64(uint32_t *data, uint16_t length)
+uint64_t fletcher64(const uint32_t *data, size_t length)
 {
   uint64_t s1 = 0;
   uint64_t s2 = 0;
-  for (uint16_t i = 0; i < length;)
+  for (size_t i = 0; i < length;)
   {
     // if S2 is halfway it is time to do modulo
     while ((i < length) && (s2 < 9223372036854775808ULL))
@@ -2,7 +2,7 @@
 //
 //    FILE: Fletcher.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.7
+// VERSION: 0.1.9
 //    DATE: 2022-01-25
 // PURPOSE: Arduino Library for calculating Fletcher's checksum
 //     URL: https://github.com/RobTillaart/Fletcher
@@ -12,7 +12,7 @@
 #include "Arduino.h"
 
 
-#define FLETCHER_LIB_VERSION              (F("0.1.7"))
+#define FLETCHER_LIB_VERSION              (F("0.1.9"))
 
 #define FLETCHER_16                       255
 #define FLETCHER_32                       65535UL
@@ -24,11 +24,11 @@
 //  max length buffer 65534.
 //  Wikipedia shows optimizations.
 //
-uint16_t fletcher16(uint8_t *data, uint16_t length);
+uint16_t fletcher16(const uint8_t *data, size_t length);
 
-uint32_t fletcher32(uint16_t *data, uint16_t length);
+uint32_t fletcher32(const uint16_t *data, size_t length);
 
-uint64_t fletcher64(uint32_t *data, uint16_t length);
+uint64_t fletcher64(const uint32_t *data, size_t length);
 
 
 // -- END OF FILE --
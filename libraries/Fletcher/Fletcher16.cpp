@@ -53,7 +53,7 @@ void Fletcher16::add(uint8_t value)
 }
 
 
-void Fletcher16::add(const uint8_t * array, uint16_t length)
+void Fletcher16::add(const uint8_t * array, size_t length)
 {
   while (length--)
   {
@@ -18,7 +18,7 @@ public:
   void     begin(uint8_t s1 = 0, uint8_t s2 = 0);
 
   void     add(uint8_t value);
-  void     add(const uint8_t * array, uint16_t length);
+  void     add(const uint8_t * array, size_t length);
 
   uint16_t getFletcher();
   uint32_t count();
@@ -11,6 +11,25 @@
 #define FLETCHER_32 UINT16_MAX
 
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#define FLETCHER32_SSE2
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FLETCHER32_NEON
+#include <arm_neon.h>
+#endif
+
+
+//  largest n such that 65535 (1 + n + n(n+1)/2) < 2^32
+//  so s2 can not overflow within a block of n words.
+#define FLETCHER32_NMAX             360
+//  the SIMD kernels combine the sums in 64 bit,
+//  limit is the 32 bit lanes of the prefix sum.
+#define FLETCHER32_NMAX_SIMD        2040
+
+
 Fletcher32::Fletcher32()
 {
   begin();
@@ -53,14 +72,217 @@ void Fletcher32::add(uint16_t value)
 #endif
 }
 
+//////////////////////////////////////////////////////////////
+//
+//  BLOCK KERNELS
+//
+//  s1 and s2 are < FLETCHER_32 on entry and on exit.
+//  modulo is only done at the end of a block.
+//
+//  The SIMD versions process K chunks of L words using
+//    s1 += sum(x[i])
+//    s2 += L * K * s1 + L * sum(s1 before chunk k) + sum((L - i) * x[i])
+//
+#if !defined(ARDUINO_ARCH_AVR)
+
+//  length <= FLETCHER32_NMAX
+static void _fletcher32_block(uint32_t &s1, uint32_t &s2, const uint16_t * array, size_t length)
+{
+  uint32_t a = s1;
+  uint32_t b = s2;
+  //  unrolled, no multiplications needed.
+  while (length >= 4)
+  {
+    a += array[0]; b += a;
+    a += array[1]; b += a;
+    a += array[2]; b += a;
+    a += array[3]; b += a;
+    array  += 4;
+    length -= 4;
+  }
+  while (length--)
+  {
+    a += *array++;
+    b += a;
+  }
+  s1 = a % FLETCHER_32;
+  s2 = b % FLETCHER_32;
+}
+
+#endif
+
+
+#if defined(FLETCHER32_SSE2)
+
+static uint64_t _hsum32(__m128i v)
+{
+  uint32_t t[4];
+  _mm_storeu_si128((__m128i *) t, v);
+  return (uint64_t)t[0] + t[1] + t[2] + t[3];
+}
+
+
+//  madd_epi16() is signed, so the words are split in a low and a high byte.
+//  length <= FLETCHER32_NMAX_SIMD
+static void _fletcher32_sse2(uint32_t &s1, uint32_t &s2, const uint16_t * array, size_t length)
+{
+  const size_t  chunks = length / 8;
+  const __m128i mask = _mm_set1_epi16(0x00FF);
+  const __m128i ones = _mm_set1_epi16(1);
+  const __m128i w    = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+  __m128i vs1 = _mm_setzero_si128();
+  __m128i vps = _mm_setzero_si128();
+  __m128i vs2 = _mm_setzero_si128();
+  for (size_t k = 0; k < chunks; k++)
+  {
+    __m128i v  = _mm_loadu_si128((const __m128i *) array);
+    array += 8;
+    __m128i lo = _mm_and_si128(v, mask);
+    __m128i hi = _mm_srli_epi16(v, 8);
+    vps = _mm_add_epi32(vps, vs1);
+    vs1 = _mm_add_epi32(vs1, _mm_madd_epi16(lo, ones));
+    vs1 = _mm_add_epi32(vs1, _mm_slli_epi32(_mm_madd_epi16(hi, ones), 8));
+    vs2 = _mm_add_epi32(vs2, _mm_madd_epi16(lo, w));
+    vs2 = _mm_add_epi32(vs2, _mm_slli_epi32(_mm_madd_epi16(hi, w), 8));
+  }
+  uint64_t a = s1 + _hsum32(vs1);
+  uint64_t b = s2 + (uint64_t)s1 * chunks * 8 + 8 * _hsum32(vps) + _hsum32(vs2);
+  length -= chunks * 8;
+  while (length--)
+  {
+    a += *array++;
+    b += a;
+  }
+  s1 = a % FLETCHER_32;
+  s2 = b % FLETCHER_32;
+}
+
+
+__attribute__((target("avx2")))
+static void _fletcher32_avx2(uint32_t &s1, uint32_t &s2, const uint16_t * array, size_t length)
+{
+  const size_t  chunks = length / 16;
+  const __m256i mask = _mm256_set1_epi16(0x00FF);
+  const __m256i ones = _mm256_set1_epi16(1);
+  const __m256i w    = _mm256_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9,
+                                          8,  7,  6,  5,  4,  3,  2, 1);
+  __m256i vs1 = _mm256_setzero_si256();
+  __m256i vps = _mm256_setzero_si256();
+  __m256i vs2 = _mm256_setzero_si256();
+  for (size_t k = 0; k < chunks; k++)
+  {
+    __m256i v  = _mm256_loadu_si256((const __m256i *) array);
+    array += 16;
+    __m256i lo = _mm256_and_si256(v, mask);
+    __m256i hi = _mm256_srli_epi16(v, 8);
+    vps = _mm256_add_epi32(vps, vs1);
+    vs1 = _mm256_add_epi32(vs1, _mm256_madd_epi16(lo, ones));
+    vs1 = _mm256_add_epi32(vs1, _mm256_slli_epi32(_mm256_madd_epi16(hi, ones), 8));
+    vs2 = _mm256_add_epi32(vs2, _mm256_madd_epi16(lo, w));
+    vs2 = _mm256_add_epi32(vs2, _mm256_slli_epi32(_mm256_madd_epi16(hi, w), 8));
+  }
+  uint64_t S1 = _hsum32(_mm256_castsi256_si128(vs1)) + _hsum32(_mm256_extracti128_si256(vs1, 1));
+  uint64_t PS = _hsum32(_mm256_castsi256_si128(vps)) + _hsum32(_mm256_extracti128_si256(vps, 1));
+  uint64_t S2 = _hsum32(_mm256_castsi256_si128(vs2)) + _hsum32(_mm256_extracti128_si256(vs2, 1));
+  uint64_t a = s1 + S1;
+  uint64_t b = s2 + (uint64_t)s1 * chunks * 16 + 16 * PS + S2;
+  length -= chunks * 16;
+  while (length--)
+  {
+    a += *array++;
+    b += a;
+  }
+  s1 = a % FLETCHER_32;
+  s2 = b % FLETCHER_32;
+}
+
+
+static bool _fletcher32_hasAVX2()
+{
+  static int8_t avx2 = -1;
+  if (avx2 < 0)
+  {
+    __builtin_cpu_init();
+    avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+  }
+  return avx2 == 1;
+}
+
+#endif  //  FLETCHER32_SSE2
+
+
+#if defined(FLETCHER32_NEON)
+
+//  length <= FLETCHER32_NMAX_SIMD
+static void _fletcher32_neon(uint32_t &s1, uint32_t &s2, const uint16_t * array, size_t length)
+{
+  static const uint16_t weights[8] = { 8, 7, 6, 5, 4, 3, 2, 1 };
+  const size_t     chunks = length / 8;
+  const uint16x4_t wlo = vld1_u16(weights);
+  const uint16x4_t whi = vld1_u16(weights + 4);
+  uint32x4_t vs1 = vdupq_n_u32(0);
+  uint32x4_t vps = vdupq_n_u32(0);
+  uint32x4_t vs2 = vdupq_n_u32(0);
+  for (size_t k = 0; k < chunks; k++)
+  {
+    uint16x8_t v = vld1q_u16(array);
+    array += 8;
+    vps = vaddq_u32(vps, vs1);
+    vs1 = vpadalq_u16(vs1, v);
+    vs2 = vmlal_u16(vs2, vget_low_u16(v), wlo);
+    vs2 = vmlal_u16(vs2, vget_high_u16(v), whi);
+  }
+  uint64_t a = s1 + vaddlvq_u32(vs1);
+  uint64_t b = s2 + (uint64_t)s1 * chunks * 8 + 8 * vaddlvq_u32(vps) + vaddlvq_u32(vs2);
+  length -= chunks * 8;
+  while (length--)
+  {
+    a += *array++;
+    b += a;
+  }
+  s1 = a % FLETCHER_32;
+  s2 = b % FLETCHER_32;
+}
+
+#endif  //  FLETCHER32_NEON
+
+
 //  NOTE: padding with zero's error
-//  
-void Fletcher32::add(const uint16_t * array, uint16_t length)
+//
+void Fletcher32::add(const uint16_t * array, size_t length)
 {
+#if defined(ARDUINO_ARCH_AVR)
   while (length--)
   {
     add(*array++);
   }
+#else
+  _count += length;
+  uint32_t s1 = _s1 % FLETCHER_32;
+  uint32_t s2 = _s2 % FLETCHER_32;
+  while (length > 0)
+  {
+#if defined(FLETCHER32_SSE2) || defined(FLETCHER32_NEON)
+    size_t n = (length > FLETCHER32_NMAX_SIMD) ? FLETCHER32_NMAX_SIMD : length;
+#else
+    size_t n = (length > FLETCHER32_NMAX) ? FLETCHER32_NMAX : length;
+#endif
+#if defined(FLETCHER32_SSE2)
+    if ((n >= 32) && _fletcher32_hasAVX2()) _fletcher32_avx2(s1, s2, array, n);
+    else if (n >= 8)                        _fletcher32_sse2(s1, s2, array, n);
+    else                                    _fletcher32_block(s1, s2, array, n);
+#elif defined(FLETCHER32_NEON)
+    if (n >= 8) _fletcher32_neon(s1, s2, array, n);
+    else        _fletcher32_block(s1, s2, array, n);
+#else
+    _fletcher32_block(s1, s2, array, n);
+#endif
+    array  += n;
+    length -= n;
+  }
+  _s1 = s1;
+  _s2 = s2;
+#endif
 }
 
 uint32_t Fletcher32::getFletcher() 
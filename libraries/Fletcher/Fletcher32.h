@@ -18,7 +18,7 @@ public:
   void     begin(uint16_t s1 = 0, uint16_t s2 = 0);
 
   void     add(uint16_t value);
-  void     add(const uint16_t * array, uint16_t length);
+  void     add(const uint16_t * array, size_t length);
 
   uint32_t getFletcher();
   uint32_t count();
@@ -10,6 +10,22 @@
 // UINT32_MAX = 4294967295ULL = ((((uint64_t) 1) << 32) - 1)
 #define FLETCHER_64 UINT32_MAX
 
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define FLETCHER64_SSE2
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FLETCHER64_NEON
+#include <arm_neon.h>
+#endif
+
+
+//  s2 < (2^32 - 1) (1 + n + n(n+1)/2) < 2^64 for n = 65536.
+//  the SIMD prefix sums in 64 bit lanes need a smaller block.
+#define FLETCHER64_NMAX             32768
+
 Fletcher64::Fletcher64()
 {
   begin();
@@ -49,12 +65,203 @@ void Fletcher64::add(uint32_t value)
 }
 
 
-void Fletcher64::add(const uint32_t * array, uint16_t length)
+//////////////////////////////////////////////////////////////
+//
+//  BLOCK KERNELS
+//
+//  s1 and s2 are < FLETCHER_64 on entry and on exit.
+//  length <= FLETCHER64_NMAX, modulo is only done at the end of a block.
+//
+//  The SIMD versions process K chunks of L words using
+//    s1 += sum(x[i])
+//    s2 += L * K * s1 + L * sum(s1 before chunk k) + sum((L - i) * x[i])
+//
+#if !defined(ARDUINO_ARCH_AVR)
+
+static void _fletcher64_block(uint64_t &s1, uint64_t &s2, const uint32_t * array, size_t length)
+{
+  uint64_t a = s1;
+  uint64_t b = s2;
+  //  unrolled, no multiplications needed.
+  while (length >= 4)
+  {
+    a += array[0]; b += a;
+    a += array[1]; b += a;
+    a += array[2]; b += a;
+    a += array[3]; b += a;
+    array  += 4;
+    length -= 4;
+  }
+  while (length--)
+  {
+    a += *array++;
+    b += a;
+  }
+  s1 = a % FLETCHER_64;
+  s2 = b % FLETCHER_64;
+}
+
+#endif
+
+
+#if defined(FLETCHER64_SSE2)
+
+static uint64_t _hsum64(__m128i v)
+{
+  uint64_t t[2];
+  _mm_storeu_si128((__m128i *) t, v);
+  return t[0] + t[1];
+}
+
+
+//  mul_epu32() multiplies the even 32 bit lanes into 64 bit.
+static void _fletcher64_sse2(uint64_t &s1, uint64_t &s2, const uint32_t * array, size_t length)
+{
+  const size_t  chunks = length / 4;
+  const __m128i zero  = _mm_setzero_si128();
+  const __m128i weven = _mm_setr_epi32(4, 0, 2, 0);
+  const __m128i wodd  = _mm_setr_epi32(3, 0, 1, 0);
+  __m128i vs1 = zero;
+  __m128i vps = zero;
+  __m128i vs2 = zero;
+  for (size_t k = 0; k < chunks; k++)
+  {
+    __m128i v = _mm_loadu_si128((const __m128i *) array);
+    array += 4;
+    vps = _mm_add_epi64(vps, vs1);
+    vs1 = _mm_add_epi64(vs1, _mm_unpacklo_epi32(v, zero));
+    vs1 = _mm_add_epi64(vs1, _mm_unpackhi_epi32(v, zero));
+    vs2 = _mm_add_epi64(vs2, _mm_mul_epu32(v, weven));
+    vs2 = _mm_add_epi64(vs2, _mm_mul_epu32(_mm_srli_epi64(v, 32), wodd));
+  }
+  uint64_t a = s1 + _hsum64(vs1);
+  uint64_t b = s2 + s1 * chunks * 4 + 4 * _hsum64(vps) + _hsum64(vs2);
+  length -= chunks * 4;
+  while (length--)
+  {
+    a += *array++;
+    b += a;
+  }
+  s1 = a % FLETCHER_64;
+  s2 = b % FLETCHER_64;
+}
+
+
+__attribute__((target("avx2")))
+static void _fletcher64_avx2(uint64_t &s1, uint64_t &s2, const uint32_t * array, size_t length)
 {
+  const size_t  chunks = length / 8;
+  const __m256i zero  = _mm256_setzero_si256();
+  const __m256i weven = _mm256_setr_epi32(8, 0, 6, 0, 4, 0, 2, 0);
+  const __m256i wodd  = _mm256_setr_epi32(7, 0, 5, 0, 3, 0, 1, 0);
+  __m256i vs1 = zero;
+  __m256i vps = zero;
+  __m256i vs2 = zero;
+  for (size_t k = 0; k < chunks; k++)
+  {
+    __m256i v = _mm256_loadu_si256((const __m256i *) array);
+    array += 8;
+    vps = _mm256_add_epi64(vps, vs1);
+    vs1 = _mm256_add_epi64(vs1, _mm256_unpacklo_epi32(v, zero));
+    vs1 = _mm256_add_epi64(vs1, _mm256_unpackhi_epi32(v, zero));
+    vs2 = _mm256_add_epi64(vs2, _mm256_mul_epu32(v, weven));
+    vs2 = _mm256_add_epi64(vs2, _mm256_mul_epu32(_mm256_srli_epi64(v, 32), wodd));
+  }
+  uint64_t S1 = _hsum64(_mm256_castsi256_si128(vs1)) + _hsum64(_mm256_extracti128_si256(vs1, 1));
+  uint64_t PS = _hsum64(_mm256_castsi256_si128(vps)) + _hsum64(_mm256_extracti128_si256(vps, 1));
+  uint64_t S2 = _hsum64(_mm256_castsi256_si128(vs2)) + _hsum64(_mm256_extracti128_si256(vs2, 1));
+  uint64_t a = s1 + S1;
+  uint64_t b = s2 + s1 * chunks * 8 + 8 * PS + S2;
+  length -= chunks * 8;
+  while (length--)
+  {
+    a += *array++;
+    b += a;
+  }
+  s1 = a % FLETCHER_64;
+  s2 = b % FLETCHER_64;
+}
+
+
+static bool _fletcher64_hasAVX2()
+{
+  static int8_t avx2 = -1;
+  if (avx2 < 0)
+  {
+    __builtin_cpu_init();
+    avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+  }
+  return avx2 == 1;
+}
+
+#endif  //  FLETCHER64_SSE2
+
+
+#if defined(FLETCHER64_NEON)
+
+static void _fletcher64_neon(uint64_t &s1, uint64_t &s2, const uint32_t * array, size_t length)
+{
+  static const uint32_t weights[4] = { 4, 3, 2, 1 };
+  const size_t     chunks = length / 4;
+  const uint32x2_t wlo = vld1_u32(weights);
+  const uint32x2_t whi = vld1_u32(weights + 2);
+  uint64x2_t vs1 = vdupq_n_u64(0);
+  uint64x2_t vps = vdupq_n_u64(0);
+  uint64x2_t vs2 = vdupq_n_u64(0);
+  for (size_t k = 0; k < chunks; k++)
+  {
+    uint32x4_t v = vld1q_u32(array);
+    array += 4;
+    vps = vaddq_u64(vps, vs1);
+    vs1 = vpadalq_u32(vs1, v);
+    vs2 = vmlal_u32(vs2, vget_low_u32(v), wlo);
+    vs2 = vmlal_u32(vs2, vget_high_u32(v), whi);
+  }
+  uint64_t a = s1 + vaddvq_u64(vs1);
+  uint64_t b = s2 + s1 * chunks * 4 + 4 * vaddvq_u64(vps) + vaddvq_u64(vs2);
+  length -= chunks * 4;
+  while (length--)
+  {
+    a += *array++;
+    b += a;
+  }
+  s1 = a % FLETCHER_64;
+  s2 = b % FLETCHER_64;
+}
+
+#endif  //  FLETCHER64_NEON
+
+
+void Fletcher64::add(const uint32_t * array, size_t length)
+{
+#if defined(ARDUINO_ARCH_AVR)
   while (length--)
   {
     add(*array++);
   }
+#else
+  _count += length;
+  uint64_t s1 = _s1 % FLETCHER_64;
+  uint64_t s2 = _s2 % FLETCHER_64;
+  while (length > 0)
+  {
+    size_t n = (length > FLETCHER64_NMAX) ? FLETCHER64_NMAX : length;
+#if defined(FLETCHER64_SSE2)
+    if ((n >= 16) && _fletcher64_hasAVX2()) _fletcher64_avx2(s1, s2, array, n);
+    else if (n >= 4)                        _fletcher64_sse2(s1, s2, array, n);
+    else                                    _fletcher64_block(s1, s2, array, n);
+#elif defined(FLETCHER64_NEON)
+    if (n >= 4) _fletcher64_neon(s1, s2, array, n);
+    else        _fletcher64_block(s1, s2, array, n);
+#else
+    _fletcher64_block(s1, s2, array, n);
+#endif
+    array  += n;
+    length -= n;
+  }
+  _s1 = s1;
+  _s2 = s2;
+#endif
 }
 
 
@@ -18,7 +18,7 @@ public:
   void     begin(uint32_t s1 = 0, uint32_t s2 = 0);
 
   void     add(uint32_t value);
-  void     add(const uint32_t * array, uint16_t length);
+  void     add(const uint32_t * array, size_t length);
 
   uint64_t getFletcher();
   uint32_t count();
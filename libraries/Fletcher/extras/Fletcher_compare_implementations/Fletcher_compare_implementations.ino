@@ -31,7 +31,7 @@ union main_value_storage {
 
 #define DO_N 23
 
-#define n_implementations 9
+#define n_implementations 10
 
 uint16_t checksum16[n_implementations];
 uint32_t checksum32[n_implementations];
@@ -144,6 +144,15 @@ void test_fletcher16() {
       if (checksum16[index] != checksum16[0]) {
         checksum_correct16[index] = false;
       }
+      /* block */
+      index = 9;
+      t0 = micros();
+      checksum16[index] = fletcher16_block(values.uint8, max_len);
+      t1 = micros();
+      totaltime16[index] += t1 - t0;
+      if (checksum16[index] != checksum16[0]) {
+        checksum_correct16[index] = false;
+      }
     }
   }
   n16 += DO_N;
@@ -242,6 +251,15 @@ void test_fletcher32() {
         checksum_correct32[1] = false;
       }
 #endif
+      /* block */
+      index = 9;
+      t0 = micros();
+      checksum32[index] = fletcher32_block(values.uint16, max_len);
+      t1 = micros();
+      totaltime32[index] += t1 - t0;
+      if (checksum32[index] != checksum32[0]) {
+        checksum_correct32[index] = false;
+      }
     }
   }
   n32 += DO_N;
@@ -338,6 +356,15 @@ void test_fletcher64() {
       if (checksum64[index] != checksum64[0]) {
         checksum_correct64[1] = false;
       }
+      /* block */
+      index = 9;
+      t0 = micros();
+      checksum64[index] = fletcher64_block(values.uint32, max_len);
+      t1 = micros();
+      totaltime64[index] += t1 - t0;
+      if (checksum64[index] != checksum64[0]) {
+        checksum_correct64[index] = false;
+      }
     }
   }
   n64 += DO_N;
@@ -376,31 +403,31 @@ void loop() {
   test_fletcher64();
   // generate output
   Serial.println("data rate in us/kByte:");
-  Serial.println("+------------+----------+----------+----------+----------+----------+----------+----------+----------+----------+");
-  Serial.println("| alg        | basic    | 0.1.3    | 0.1.4    | 0.1.5    | 0.1.6    | next     | if       | shift    | overflow |");
-  Serial.println("+------------+----------+----------+----------+----------+----------+----------+----------+----------+----------+");
+  Serial.println("+------------+----------+----------+----------+----------+----------+----------+----------+----------+----------+----------+");
+  Serial.println("| alg        | basic    | 0.1.3    | 0.1.4    | 0.1.5    | 0.1.6    | next     | if       | shift    | overflow | block    |");
+  Serial.println("+------------+----------+----------+----------+----------+----------+----------+----------+----------+----------+----------+");
   Serial.print("| fletcher16 | ");
   for (uint16_t i = 0; i < n_implementations; i++) {
     Serial.print(float2strn(1024.0 * totaltime16[i] / float(n16 * MAX_LEN), 8));
     Serial.print(" | ");
   }
-  Serial.println("\n+------------+----------+----------+----------+----------+----------+----------+----------+----------+----------+");
+  Serial.println("\n+------------+----------+----------+----------+----------+----------+----------+----------+----------+----------+----------+");
   Serial.print("| fletcher32 | ");
   for (uint16_t i = 0; i < n_implementations; i++) {
     Serial.print(float2strn(1024.0 * totaltime32[i] / float(n32 * MAX_LEN), 8));
     Serial.print(" | ");
   }
-  Serial.println("\n+------------+----------+----------+----------+----------+----------+----------+----------+----------+----------+");
+  Serial.println("\n+------------+----------+----------+----------+----------+----------+----------+----------+----------+----------+----------+");
   Serial.print("| fletcher64 | ");
   for (uint16_t i = 0; i < n_implementations; i++) {
     Serial.print(float2strn(1024.0 * totaltime64[i] / float(n64 * MAX_LEN), 8));
     Serial.print(" | ");
   }
-  Serial.println("\n+------------+----------+----------+----------+----------+----------+----------+----------+----------+----------+\n");
+  Serial.println("\n+------------+----------+----------+----------+----------+----------+----------+----------+----------+----------+----------+\n");
   Serial.println("checksum always OK?");
-  Serial.println("+------------+-------+-------+-------+-------+-------+-------+-------+-------+-------+");
-  Serial.println("| alg        | basic | 0.1.3 | 0.1.4 | 0.1.5 | 0.1.6 | next  | if    | shift | overf |");
-  Serial.println("+------------+-------+-------+-------+-------+-------+-------+-------+-------+-------+");
+  Serial.println("+------------+-------+-------+-------+-------+-------+-------+-------+-------+-------+-------+");
+  Serial.println("| alg        | basic | 0.1.3 | 0.1.4 | 0.1.5 | 0.1.6 | next  | if    | shift | overf | block |");
+  Serial.println("+------------+-------+-------+-------+-------+-------+-------+-------+-------+-------+-------+");
   Serial.print("| fletcher16 | ");
   for (uint16_t i = 0; i < n_implementations; i++) {
     if (checksum_correct16[i]) {
@@ -410,7 +437,7 @@ void loop() {
     }
     Serial.print(" | ");
   }
-  Serial.println("\n+------------+-------+-------+-------+-------+-------+-------+-------+-------+-------+");
+  Serial.println("\n+------------+-------+-------+-------+-------+-------+-------+-------+-------+-------+-------+");
   Serial.print("| fletcher32 | ");
   for (uint16_t i = 0; i < n_implementations; i++) {
     //Serial.print(checksum_correct32[i]);
@@ -421,7 +448,7 @@ void loop() {
     }
     Serial.print(" | ");
   }
-  Serial.println("\n+------------+-------+-------+-------+-------+-------+-------+-------+-------+-------+");
+  Serial.println("\n+------------+-------+-------+-------+-------+-------+-------+-------+-------+-------+-------+");
   Serial.print("| fletcher64 | ");
   for (uint16_t i = 0; i < n_implementations; i++) {
     //Serial.print(checksum_correct64[i]);
@@ -432,6 +459,6 @@ void loop() {
     }
     Serial.print(" | ");
   }
-  Serial.println("\n+------------+-------+-------+-------+-------+-------+-------+-------+-------+-------+\n");
+  Serial.println("\n+------------+-------+-------+-------+-------+-------+-------+-------+-------+-------+-------+\n");
   Serial.println("");
 }
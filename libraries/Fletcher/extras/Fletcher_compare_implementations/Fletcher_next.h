@@ -46,3 +46,26 @@ uint64_t fletcher64_next(uint32_t *data, const size_t length)
     }
   return checksum_instance.getFletcher();
 }
+
+
+//  block versions, add(array, length) uses the block kernels.
+uint16_t fletcher16_block(uint8_t *data, const size_t length)
+{
+  Fletcher16 checksum_instance;
+  checksum_instance.add(data, length);
+  return checksum_instance.getFletcher();
+}
+
+uint32_t fletcher32_block(uint16_t *data, const size_t length)
+{
+  Fletcher32 checksum_instance;
+  checksum_instance.add(data, length);
+  return checksum_instance.getFletcher();
+}
+
+uint64_t fletcher64_block(uint32_t *data, const size_t length)
+{
+  Fletcher64 checksum_instance;
+  checksum_instance.add(data, length);
+  return checksum_instance.getFletcher();
+}
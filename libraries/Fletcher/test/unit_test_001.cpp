@@ -136,6 +136,73 @@ unittest(test_FF_2)
 }
 
 
+unittest(test_size_t_length)
+{
+  //  more than 64 KB, exceeds the former uint16_t length.
+  static uint32_t buffer[20000];
+  for (uint32_t i = 0; i < 20000; i++) buffer[i] = i * 2654435761UL;
+  uint8_t  * b8  = (uint8_t *)  buffer;
+  uint16_t * b16 = (uint16_t *) buffer;
+
+  Fletcher16 FL16;
+  FL16.begin();
+  for (uint32_t i = 0; i < 80000UL; i++) FL16.add(b8[i]);
+  assertEqual(FL16.getFletcher(), fletcher16(b8, 80000UL));
+  FL16.begin();
+  FL16.add(b8, 80000UL);
+  assertEqual(FL16.getFletcher(), fletcher16(b8, 80000UL));
+
+  Fletcher32 FL32;
+  FL32.begin();
+  FL32.add(b16, 40000UL);
+  assertEqual(FL32.getFletcher(), fletcher32(b16, 40000UL));
+
+  Fletcher64 FL64;
+  FL64.begin();
+  FL64.add(buffer, 20000UL);
+  assertEqual(FL64.getFletcher(), fletcher64(buffer, 20000UL));
+}
+
+
+unittest(test_block_kernels)
+{
+  //  block add() must match the single value add() for all lengths,
+  //  including worst case data and around the block sizes.
+  static uint32_t buffer[4200];
+  uint16_t * b16 = (uint16_t *) buffer;
+  const uint16_t lengths[10] = { 1, 3, 7, 8, 33, 359, 360, 361, 2041, 8300 };
+
+  for (int m = 0; m < 2; m++)
+  {
+    for (uint32_t i = 0; i < 4200; i++)
+    {
+      buffer[i] = (m == 0) ? 0xFFFFFFFF : i * 2654435761UL;
+    }
+    for (int l = 0; l < 10; l++)
+    {
+      uint16_t len = lengths[l];
+      Fletcher32 A, B;
+      A.begin(65534, 65533);
+      B.begin(65534, 65533);
+      //  odd offset, unaligned for SIMD loads.
+      for (uint16_t i = 0; i < len; i++) A.add(b16[i + 1]);
+      B.add(b16 + 1, len);
+      assertEqual(A.getFletcher(), B.getFletcher());
+      assertEqual(A.count(), B.count());
+
+      if (len > 4190) continue;
+      Fletcher64 C, D;
+      C.begin(0xFFFFFFFE, 0xFFFFFFFD);
+      D.begin(0xFFFFFFFE, 0xFFFFFFFD);
+      for (uint16_t i = 0; i < len; i++) C.add(buffer[i + 1]);
+      D.add(buffer + 1, len);
+      assertEqual(C.getFletcher(), D.getFletcher());
+      assertEqual(C.count(), D.count());
+    }
+  }
+}
+
+
 unittest_main()
 
 // --------
@@ -0,0 +1,80 @@
+//
+//    FILE: Fraction64_gears.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: exact gear train ratios with Fraction64.
+//    DATE: 2026-10-17
+//     URL: https://github.com/RobTillaart/Fraction
+//
+//  The ratio of a chain of gears is the product of driven / driving teeth,
+//  with prime tooth counts the denominator grows with every stage.
+//  Fraction64 keeps that product exact, bestApproximation() finds
+//  the best single gear pair for a ratio with a limited number of teeth.
+
+
+#include "fraction.h"
+
+
+//  driving, driven teeth per stage
+int64_t gears[][2] =
+{
+  { 17, 60 },
+  { 23, 64 },
+  { 29, 36 },
+  { 31, 83 },
+  { 37, 91 },
+  { 41, 97 },
+  { 43, 89 },
+};
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.print(__FILE__);
+  Serial.println();
+  Serial.print("FRACTION_LIB_VERSION: ");
+  Serial.println(FRACTION_LIB_VERSION);
+  Serial.println();
+
+  Fraction64 ratio(1);
+  for (uint8_t i = 0; i < sizeof(gears) / sizeof(gears[0]); i++)
+  {
+    ratio *= Fraction64(gears[i][1], gears[i][0]);
+    Serial.print("stage ");
+    Serial.print(i);
+    Serial.print("\t");
+    Serial.println(ratio);
+  }
+  Serial.println();
+
+  //  sidereal versus solar day, 366.2422 / 365.2422
+  Fraction64 sidereal(3662422, 3652422);
+  Serial.print("sidereal:\t");
+  Serial.println(sidereal);
+  for (int64_t teeth = 100; teeth <= 100000; teeth *= 10)
+  {
+    Fraction64 pair = sidereal.limitDenominator(teeth);
+    Serial.print(teeth);
+    Serial.print("\t");
+    Serial.print(pair);
+    Serial.print("\t");
+    Serial.println((pair - sidereal).toDouble(), 12);
+  }
+  Serial.println();
+
+  //  best approximation of a double
+  Serial.println(Fraction64::bestApproximation(PI, 1000));
+  Serial.println(Fraction64::bestApproximation(PI));
+  Serial.println(Fraction64::bestApproximation(0.1));
+  Serial.println();
+
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+// -- END OF FILE --
@@ -1,7 +1,7 @@
 //
 //    FILE: fraction.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.14
+// VERSION: 0.2.0
 // PURPOSE: Arduino library to implement a Fraction datatype
 //     URL: https://github.com/RobTillaart/Fraction
 //
@@ -316,15 +316,10 @@ Fraction Fraction::setDenominator(const Fraction &a, uint16_t b)
 // PRIVATE
 // http://en.wikipedia.org/wiki/Binary_GCD_algorithm
 //
+// Stein's binary GCD, no divisions
 int32_t Fraction::gcd(int32_t a , int32_t b)
 {
-    while ( a != 0 )
-    {
-        int32_t c = a;
-        a = b % a;
-        b = c;
-    }
-    return b;
+    return FractionT<int32_t>::gcd(a, b);
 }
 
 
@@ -345,14 +340,12 @@ void Fraction::simplify()
 
     // denominator max 4 digits keeps mul and div simple
     // in preventing overflow
-    while (q > 10000)
+    // best approximation instead of rounding both by 10
+    if (q > 10000)
     {
-        // rounding might need improvement
-        p = (p + 5)/10;
-        q = (q + 5)/10;
-        x = gcd(p, q);
-        p = p / x;
-        q = q / x;
+        Fraction32 f = Fraction32(p, q).limitDenominator(10000);
+        p = f.nominator();
+        q = f.denominator();
     }
     n = (neg) ? -p : p;
     d = q;
@@ -2,15 +2,16 @@
 //
 //    FILE: fraction.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.14
+// VERSION: 0.2.0
 // PURPOSE: Arduino library to implement a Fraction datatype
 //     URL: https://github.com/RobTillaart/Fraction
 //
 
 
 #include "Arduino.h"
+#include <float.h>
 
-#define FRACTION_LIB_VERSION            (F("0.1.14"))
+#define FRACTION_LIB_VERSION            (F("0.2.0"))
 
 
 class Fraction: public Printable
@@ -83,4 +84,440 @@ protected:
 };
 
 
+/////////////////////////////////////////////////////////////////////////////
+//
+//  TEMPLATE VERSION
+//
+//  FractionT<T> with T = int16_t, int32_t or int64_t.
+//  - exact, all intermediate products use a type twice as wide,
+//    for int64_t __int128 or fraction_int128 if the compiler has none.
+//  - results are always in lowest terms (Stein's binary GCD).
+//  - a result that does not fit in T is replaced by the best
+//    rational approximation that does (continued fractions).
+//  - the minimum value of T is not used so negation never overflows.
+//
+
+//  minimal 128 bit signed integer, two's complement.
+class fraction_int128
+{
+public:
+  uint64_t hi, lo;
+
+  fraction_int128() : hi(0), lo(0) {}
+  fraction_int128(int64_t v) : hi(v < 0 ? ~0ULL : 0), lo(v) {}
+  fraction_int128(uint64_t h, uint64_t l) : hi(h), lo(l) {}
+
+  explicit operator int64_t() const { return (int64_t)lo; }
+
+  fraction_int128 operator - () const
+  {
+    uint64_t l = ~lo + 1;
+    return fraction_int128(~hi + (l == 0), l);
+  }
+  fraction_int128 operator + (const fraction_int128 &b) const
+  {
+    uint64_t l = lo + b.lo;
+    return fraction_int128(hi + b.hi + (l < lo), l);
+  }
+  fraction_int128 operator - (const fraction_int128 &b) const
+  {
+    return *this + (-b);
+  }
+  fraction_int128 operator * (const fraction_int128 &b) const
+  {
+    //  full 64 x 64 bit product of the low words.
+    uint64_t a0 = lo & 0xFFFFFFFF, a1 = lo >> 32;
+    uint64_t b0 = b.lo & 0xFFFFFFFF, b1 = b.lo >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFF) + (p10 & 0xFFFFFFFF);
+    uint64_t l = (mid << 32) | (p00 & 0xFFFFFFFF);
+    uint64_t h = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return fraction_int128(h + hi * b.lo + lo * b.hi, l);
+  }
+  fraction_int128 operator / (const fraction_int128 &b) const
+  {
+    bool neg = isNegative() != b.isNegative();
+    fraction_int128 q = _udiv(abs(), b.abs(), NULL);
+    return neg ? -q : q;
+  }
+  fraction_int128 operator % (const fraction_int128 &b) const
+  {
+    fraction_int128 r;
+    _udiv(abs(), b.abs(), &r);
+    return isNegative() ? -r : r;
+  }
+  fraction_int128 operator << (uint8_t s) const
+  {
+    if (s == 0) return *this;
+    if (s >= 64) return fraction_int128(lo << (s - 64), 0);
+    return fraction_int128((hi << s) | (lo >> (64 - s)), lo << s);
+  }
+  //  logical shift, only used for positive values.
+  fraction_int128 operator >> (uint8_t s) const
+  {
+    if (s == 0) return *this;
+    if (s >= 64) return fraction_int128(0, hi >> (s - 64));
+    return fraction_int128(hi >> s, (lo >> s) | (hi << (64 - s)));
+  }
+  fraction_int128 & operator >>= (uint8_t s) { *this = *this >> s; return *this; }
+
+  bool operator == (const fraction_int128 &b) const { return (hi == b.hi) && (lo == b.lo); }
+  bool operator != (const fraction_int128 &b) const { return !(*this == b); }
+  bool operator <  (const fraction_int128 &b) const
+  {
+    if (hi != b.hi) return (int64_t)hi < (int64_t)b.hi;
+    return lo < b.lo;
+  }
+  bool operator >  (const fraction_int128 &b) const { return b < *this; }
+  bool operator <= (const fraction_int128 &b) const { return !(b < *this); }
+  bool operator >= (const fraction_int128 &b) const { return !(*this < b); }
+
+  bool isNegative() const { return (int64_t)hi < 0; }
+  fraction_int128 abs() const { return isNegative() ? -(*this) : *this; }
+
+private:
+  //  shift and subtract, native division if both fit in 64 bits.
+  static fraction_int128 _udiv(fraction_int128 a, const fraction_int128 &b, fraction_int128 * rem)
+  {
+    if ((a.hi == 0) && (b.hi == 0))
+    {
+      if (rem) *rem = fraction_int128(0, a.lo % b.lo);
+      return fraction_int128(0, a.lo / b.lo);
+    }
+    fraction_int128 q, r;
+    for (int i = 127; i >= 0; i--)
+    {
+      r = r << 1;
+      if (i >= 64) r.lo |= (a.hi >> (i - 64)) & 1;
+      else         r.lo |= (a.lo >> i) & 1;
+      if (!(r < b))
+      {
+        r = r - b;
+        if (i >= 64) q.hi |= 1ULL << (i - 64);
+        else         q.lo |= 1ULL << i;
+      }
+    }
+    if (rem) *rem = r;
+    return q;
+  }
+};
+
+
+template <typename T> struct FractionWide;
+template <> struct FractionWide<int16_t> { typedef int32_t type; };
+template <> struct FractionWide<int32_t> { typedef int64_t type; };
+#if defined(__SIZEOF_INT128__) && !defined(FRACTION_SOFT_INT128)
+template <> struct FractionWide<int64_t> { typedef __int128 type; };
+#else
+template <> struct FractionWide<int64_t> { typedef fraction_int128 type; };
+#endif
+
+
+//  count trailing zeros, x != 0
+inline uint8_t fraction_ctz(int32_t x) { return __builtin_ctzl((uint32_t)x); }
+inline uint8_t fraction_ctz(int64_t x) { return __builtin_ctzll((uint64_t)x); }
+#if defined(__SIZEOF_INT128__)
+inline uint8_t fraction_ctz(__int128 x)
+{
+  uint64_t lo = (uint64_t)x;
+  return lo ? __builtin_ctzll(lo) : 64 + __builtin_ctzll((uint64_t)(x >> 64));
+}
+#endif
+inline uint8_t fraction_ctz(const fraction_int128 &x)
+{
+  return x.lo ? __builtin_ctzll(x.lo) : 64 + __builtin_ctzll(x.hi);
+}
+
+
+template <typename T>
+class FractionT : public Printable
+{
+  typedef typename FractionWide<T>::type W;
+
+public:
+  FractionT() : n(0), d(1) {}
+  explicit FractionT(T p) : n(p), d(1) { if (p < -maxValue()) n = -maxValue(); }
+  FractionT(T p, T q) { _set(W(p), W(q)); }
+
+  //  largest nominator and denominator.
+  static T maxValue() { return (T)((((uint64_t)1) << (8 * sizeof(T) - 1)) - 1); }
+
+
+  size_t printTo(Print& p) const
+  {
+    size_t s = _print(p, n);
+    s += p.print('/');
+    s += _print(p, d);
+    return s;
+  }
+
+
+  //  equalities, exact
+  bool operator == (const FractionT &c) const { return (n == c.n) && (d == c.d); }
+  bool operator != (const FractionT &c) const { return (n != c.n) || (d != c.d); }
+  bool operator >  (const FractionT &c) const { return W(n) * W(c.d) >  W(c.n) * W(d); }
+  bool operator >= (const FractionT &c) const { return W(n) * W(c.d) >= W(c.n) * W(d); }
+  bool operator <  (const FractionT &c) const { return W(n) * W(c.d) <  W(c.n) * W(d); }
+  bool operator <= (const FractionT &c) const { return W(n) * W(c.d) <= W(c.n) * W(d); }
+
+
+  //  negation
+  FractionT operator - () const { FractionT r; r.n = -n; r.d = d; return r; }
+
+
+  //  basic maths, division by zero returns 0
+  FractionT operator + (const FractionT &c) const
+  {
+    FractionT r;
+    r._set(W(n) * W(c.d) + W(c.n) * W(d), W(d) * W(c.d));
+    return r;
+  }
+  FractionT operator - (const FractionT &c) const
+  {
+    FractionT r;
+    r._set(W(n) * W(c.d) - W(c.n) * W(d), W(d) * W(c.d));
+    return r;
+  }
+  FractionT operator * (const FractionT &c) const
+  {
+    FractionT r;
+    r._set(W(n) * W(c.n), W(d) * W(c.d));
+    return r;
+  }
+  FractionT operator / (const FractionT &c) const
+  {
+    FractionT r;
+    r._set(W(n) * W(c.d), W(d) * W(c.n));
+    return r;
+  }
+
+  FractionT& operator += (const FractionT &c) { *this = *this + c; return *this; }
+  FractionT& operator -= (const FractionT &c) { *this = *this - c; return *this; }
+  FractionT& operator *= (const FractionT &c) { *this = *this * c; return *this; }
+  FractionT& operator /= (const FractionT &c) { *this = *this / c; return *this; }
+
+
+  double  toDouble() const { return (1.0 * n) / d; };
+  float   toFloat()  const { return toDouble(); };
+  bool    isProper() const { return (n < 0 ? -n : n) < d; };
+
+  T       nominator()   const { return n; };
+  T       denominator() const { return d; };
+
+
+  static FractionT mediant(const FractionT &a, const FractionT &b)
+  {
+    FractionT r;
+    r._set(W(a.n) + W(b.n), W(a.d) + W(b.d));
+    return r;
+  }
+  static FractionT middle(const FractionT &a, const FractionT &b)
+  {
+    FractionT r;
+    r._set(W(a.n) * W(b.d) + W(b.n) * W(a.d), W(2) * W(a.d) * W(b.d));
+    return r;
+  }
+
+
+  //  best rational approximation with denominator <= maxDenominator.
+  FractionT limitDenominator(T maxDenominator) const
+  {
+    if (maxDenominator < 1) maxDenominator = 1;
+    if (d <= maxDenominator) return *this;
+    FractionT r;
+    r._approximate(W(n), W(d), W(maxValue()), W(maxDenominator), 0, false);
+    return r;
+  }
+
+  //  best rational approximation of a double with denominator <= maxDenominator,
+  //  stops at the first fraction that equals value within double precision.
+  static FractionT bestApproximation(double value, T maxDenominator = maxValue())
+  {
+    FractionT r;
+    if (maxDenominator < 1) maxDenominator = 1;
+    double a = fabs(value);
+    if (!(a < maxValue()))          //  also NaN
+    {
+      if (a == a) r.n = (value < 0) ? -maxValue() : maxValue();
+      return r;
+    }
+    //  exact binary value as num / 2^e, den limited to 2^(2 * bits - 3)
+    int e;
+    double m = frexp(a, &e);
+    const int mbits = (sizeof(double) == 8) ? 53 : 24;
+    W num = W((int64_t)ldexp(m, mbits));
+    e -= mbits;
+    int maxShift = 16 * sizeof(T) - 3;
+    W den = W(1);
+    if (e >= 0) num = num << e;
+    else
+    {
+      int s = -e;
+      if (s > maxShift)
+      {
+        //  tiny values lose their lowest bits.
+        num = num >> (s - maxShift);
+        s = maxShift;
+      }
+      den = den << s;
+    }
+    if (value < 0) num = -num;
+    r._approximate(num, den, W(maxValue()), W(maxDenominator), value, true);
+    return r;
+  }
+
+
+  //  Stein's binary GCD
+  static T gcd(T a, T b)
+  {
+    if (a < 0) a = -a;
+    if (b < 0) b = -b;
+    return (T) _gcd(W(a), W(b));
+  }
+
+
+protected:
+  T n;
+  T d;
+
+
+  //  a, b >= 0
+  static W _gcd(W a, W b)
+  {
+    if (a == W(0)) return b;
+    if (b == W(0)) return a;
+    uint8_t za = fraction_ctz(a);
+    uint8_t zb = fraction_ctz(b);
+    uint8_t shift = (za < zb) ? za : zb;
+    a >>= za;
+    do
+    {
+      b >>= fraction_ctz(b);
+      if (a > b)
+      {
+        W t = a;
+        a = b;
+        b = t;
+      }
+      b = b - a;
+    }
+    while (b != W(0));
+    return a << shift;
+  }
+
+
+  //  normalize, reduce, approximate if it does not fit.
+  void _set(W num, W den)
+  {
+    if (den == W(0) || num == W(0))
+    {
+      n = 0;
+      d = 1;
+      return;
+    }
+    if (den < W(0))
+    {
+      num = -num;
+      den = -den;
+    }
+    W g = _gcd(num < W(0) ? -num : num, den);
+    num = num / g;
+    den = den / g;
+    W maxT = W(maxValue());
+    if ((den <= maxT) && (num <= maxT) && (num >= -maxT))
+    {
+      n = (T) num;
+      d = (T) den;
+      return;
+    }
+    _approximate(num, den, maxT, maxT, 0, false);
+  }
+
+
+  //  continued fraction expansion of num / den, den > 0,
+  //  best approximation with nominator <= maxNum and denominator <= maxDen.
+  void _approximate(W num, W den, W maxNum, W maxDen, double value, bool usePrecision)
+  {
+    bool neg = num < W(0);
+    if (neg) num = -num;
+
+    W p0 = W(0), q0 = W(1), p1 = W(1), q1 = W(0);
+    while (den != W(0))
+    {
+      W a = num / den;
+      if ((q1 != W(0)) && (a > (maxDen - q0) / q1)) break;
+      if ((p1 != W(0)) && (a > (maxNum - p0) / p1)) break;
+      W p2 = p0 + a * p1;
+      W q2 = q0 + a * q1;
+      p0 = p1;
+      q0 = q1;
+      p1 = p2;
+      q1 = q2;
+      W r = num - a * den;
+      num = den;
+      den = r;
+      if (usePrecision)
+      {
+        double f = (double)(T)p1 / (double)(T)q1;
+        if (fabs(f - fabs(value)) <= fabs(value) * DBL_EPSILON) den = W(0);
+      }
+    }
+    if ((den != W(0)) && (q1 == W(0)))
+    {
+      //  too large, saturate
+      p1 = maxNum;
+      q1 = W(1);
+    }
+    else if (den != W(0))
+    {
+      //  semiconvergent (p0 + k p1) / (q0 + k q1) is the other candidate.
+      //  it is closer iff q1 * x' < q0 + 2 k q1 with x' = num / den,
+      //  all products stay below the original denominator.
+      W k  = (maxDen - q0) / q1;
+      if (p1 != W(0))
+      {
+        W kp = (maxNum - p0) / p1;
+        if (kp < k) k = kp;
+      }
+      if (k > W(0))
+      {
+        W kq = k * q1;
+        W lhs = q1 * num - kq * den;
+        W rhs = q0 * den + kq * den;
+        if (lhs < rhs)
+        {
+          p1 = p0 + k * p1;
+          q1 = q0 + kq;
+        }
+      }
+    }
+    n = neg ? -(T)p1 : (T)p1;
+    d = (T)q1;
+  }
+
+
+  static size_t _print(Print &p, T v)
+  {
+    //  Print does not support 64 bit integers on all platforms.
+    char buf[21];
+    char * s = &buf[20];
+    *s = 0;
+    bool neg = v < 0;
+    uint64_t u = neg ? -(int64_t)v : v;
+    do
+    {
+      *--s = '0' + u % 10;
+      u /= 10;
+    }
+    while (u != 0);
+    if (neg) *--s = '-';
+    return p.print(s);
+  }
+};
+
+
+typedef FractionT<int32_t> Fraction32;
+typedef FractionT<int64_t> Fraction64;
+
+
 // -- END OF FILE --
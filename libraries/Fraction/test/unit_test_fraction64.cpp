@@ -0,0 +1,187 @@
+//
+//    FILE: unit_test_fraction64.cpp
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: unit tests for the FractionT template
+//          https://github.com/RobTillaart/Fraction
+//          https://github.com/Arduino-CI/arduino_ci/blob/master/REFERENCE.md
+//
+
+// supported assertions
+// https://github.com/Arduino-CI/arduino_ci/blob/master/cpp/unittest/Assertion.h#L33-L42
+// ----------------------------
+// assertEqual(expected, actual)
+// assertNotEqual(expected, actual)
+// assertLess(expected, actual)
+// assertMore(expected, actual)
+// assertLessOrEqual(expected, actual)
+// assertMoreOrEqual(expected, actual)
+// assertTrue(actual)
+// assertFalse(actual)
+// assertNull(actual)
+// assertNotNull(actual)
+
+
+#include <ArduinoUnitTests.h>
+
+
+#include "Arduino.h"
+#include "fraction.h"
+
+
+
+unittest_setup()
+{
+  fprintf(stderr, "FRACTION_LIB_VERSION: %s\n", (char*) FRACTION_LIB_VERSION);
+}
+
+unittest_teardown()
+{
+}
+
+
+unittest(test_gcd)
+{
+  assertEqual(12, Fraction64::gcd(48, 180));
+  assertEqual(12, Fraction64::gcd(-48, 180));
+  assertEqual(7,  Fraction64::gcd(0, 7));
+  assertEqual(1,  Fraction64::gcd(1000000007LL, 998244353LL));
+  assertEqual(1LL << 40, Fraction64::gcd(3LL << 40, 5LL << 41));
+  assertEqual(12, Fraction32::gcd(48, 180));
+}
+
+
+unittest(test_constructor)
+{
+  Fraction64 a(6, -4);
+  assertEqual(-3, a.nominator());
+  assertEqual(2, a.denominator());
+
+  Fraction64 b(0, -5);
+  assertEqual(0, b.nominator());
+  assertEqual(1, b.denominator());
+
+  Fraction64 c(5);
+  assertEqual(5, c.nominator());
+  assertEqual(1, c.denominator());
+
+  //  division by zero returns 0
+  Fraction64 z(5, 0);
+  assertEqual(0, z.nominator());
+  assertEqual(1, z.denominator());
+}
+
+
+unittest(test_math_no_overflow)
+{
+  int64_t big = 1000000000000LL;
+  Fraction64 a(big + 1, big);
+  Fraction64 b(big, big + 1);
+  Fraction64 p = a * b;
+  assertEqual(1, p.nominator());
+  assertEqual(1, p.denominator());
+
+  Fraction64 q = a / a;
+  assertEqual(1, q.nominator());
+  assertEqual(1, q.denominator());
+
+  Fraction64 s = a - a;
+  assertEqual(0, s.nominator());
+
+  //  large common denominator reduces back
+  Fraction64 x(1, 3 * big);
+  Fraction64 y(2, 3 * big);
+  Fraction64 sum = x + y;
+  assertEqual(1, sum.nominator());
+  assertEqual(big, sum.denominator());
+
+  //  result does not fit, best approximation
+  Fraction64 r = Fraction64(1, big) + Fraction64(1, big + 1);
+  assertLessOrEqual(r.denominator(), Fraction64::maxValue());
+  assertEqualFloat(1.999999999999e-12, r.toDouble(), 1e-24);
+
+  //  exact comparisons near the limits
+  int64_t m = Fraction64::maxValue();
+  assertTrue(Fraction64(m, m - 1) < Fraction64(m - 1, m - 2));
+  assertTrue(Fraction64(m - 1, m) > Fraction64(m - 2, m - 1));
+
+  //  compound
+  Fraction64 t(1, 2);
+  t += Fraction64(1, 3);
+  t *= Fraction64(6, 5);
+  assertEqual(1, t.nominator());
+  assertEqual(1, t.denominator());
+}
+
+
+unittest(test_best_approximation)
+{
+  Fraction64 pi = Fraction64::bestApproximation(PI, 1000);
+  assertEqual(355, pi.nominator());
+  assertEqual(113, pi.denominator());
+
+  //  semiconvergent
+  pi = Fraction64::bestApproximation(PI, 100);
+  assertEqual(311, pi.nominator());
+  assertEqual(99, pi.denominator());
+
+  pi = Fraction64::bestApproximation(PI, 10);
+  assertEqual(22, pi.nominator());
+  assertEqual(7, pi.denominator());
+
+  Fraction64 e = Fraction64::bestApproximation(EULER, 1000000);
+  assertEqual(1084483, e.nominator());
+  assertEqual(398959, e.denominator());
+
+  Fraction64 f = Fraction64::bestApproximation(0.1);
+  assertEqual(1, f.nominator());
+  assertEqual(10, f.denominator());
+
+  f = Fraction64::bestApproximation(-0.75);
+  assertEqual(-3, f.nominator());
+  assertEqual(4, f.denominator());
+
+  Fraction64 g(3141592653589793LL, 1000000000000000LL);
+  Fraction64 h = g.limitDenominator(1000);
+  assertEqual(355, h.nominator());
+  assertEqual(113, h.denominator());
+  h = g.limitDenominator(100);
+  assertEqual(311, h.nominator());
+  assertEqual(99, h.denominator());
+
+  Fraction32 k = Fraction32::bestApproximation(PI, 1000);
+  assertEqual(355, k.nominator());
+  assertEqual(113, k.denominator());
+}
+
+
+unittest(test_fraction_simplify)
+{
+  //  denominator > 10000 uses the best approximation
+  Fraction a(314159, 100000);
+  assertEqual(9563, a.nominator());
+  assertEqual(3044, a.denominator());
+}
+
+
+unittest(test_int128)
+{
+  fraction_int128 a(1000000000000LL);
+  fraction_int128 b(-999999999989LL);
+  fraction_int128 p = a * b;
+  fraction_int128 q = p / b;
+  assertTrue(q == a);
+  assertTrue(p < fraction_int128(0LL));
+  assertTrue((p % a) == fraction_int128(0LL));
+  fraction_int128 r = (-p + fraction_int128(7LL)) % a;
+  assertEqual(7, (int64_t) r);
+  assertEqual(40, fraction_ctz(fraction_int128(1LL << 40)));
+  assertEqual(100, fraction_ctz(fraction_int128(1LL) << 100));
+}
+
+
+unittest_main()
+
+
+// -- END OF FILE --
+
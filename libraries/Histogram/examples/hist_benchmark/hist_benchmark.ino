@@ -0,0 +1,108 @@
+//
+//    FILE: hist_benchmark.ino
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PUPROSE: compare linear, binary and uniform find() and CDF() / VAL() with Fenwick tree
+//     URL: https://github.com/RobTillaart/Histogram
+//
+//  times are average microseconds per call.
+
+
+#include "histogram.h"
+
+
+#if defined(ARDUINO_ARCH_AVR)
+const uint16_t sizes[] = { 20, 200 };
+#define MAX_BOUNDS    200
+#else
+const uint16_t sizes[] = { 20, 200, 2000 };
+#define MAX_BOUNDS    2000
+#endif
+
+#define RUNS          1000
+
+float bounds[MAX_BOUNDS];
+float values[RUNS];
+
+volatile uint16_t sink;
+volatile float fsink;
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("\nHistogram version: ");
+  Serial.println(HISTOGRAM_LIB_VERSION);
+  Serial.println();
+
+  Serial.println("buckets\tlinear\tbinary\tuniform\tfind\tadd\tCDF\tVAL\tFW_add\tFW_CDF\tFW_VAL");
+  for (uint8_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+  {
+    benchmark(sizes[s]);
+  }
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+void benchmark(uint16_t length)
+{
+  //  equidistant bounds 0, 10, 20 ...
+  for (uint16_t i = 0; i < length; i++) bounds[i] = i * 10.0;
+  for (uint16_t i = 0; i < RUNS; i++) values[i] = random(0, length * 10L);
+
+  Histogram hist(length, bounds);
+
+  Serial.print(length);
+  Serial.print("\t");
+
+  uint32_t start = micros();
+  for (uint16_t i = 0; i < RUNS; i++) sink = hist.findLinear(values[i]);
+  printTime(micros() - start);
+
+  start = micros();
+  for (uint16_t i = 0; i < RUNS; i++) sink = hist.findBinary(values[i]);
+  printTime(micros() - start);
+
+  start = micros();
+  for (uint16_t i = 0; i < RUNS; i++) sink = hist.findUniform(values[i]);
+  printTime(micros() - start);
+
+  start = micros();
+  for (uint16_t i = 0; i < RUNS; i++) sink = hist.find(values[i]);
+  printTime(micros() - start);
+
+  for (uint8_t fw = 0; fw < 2; fw++)
+  {
+    hist.setFenwick(fw == 1);
+    hist.clear();
+
+    start = micros();
+    for (uint16_t i = 0; i < RUNS; i++) hist.add(values[i]);
+    printTime(micros() - start);
+
+    start = micros();
+    for (uint16_t i = 0; i < RUNS; i++) fsink = hist.CDF(values[i]);
+    printTime(micros() - start);
+
+    start = micros();
+    for (uint16_t i = 0; i < RUNS; i++) fsink = hist.VAL(i * (1.0 / RUNS));
+    printTime(micros() - start);
+  }
+  Serial.println();
+}
+
+
+void printTime(uint32_t duration)
+{
+  Serial.print(1.0 * duration / RUNS, 3);
+  Serial.print("\t");
+}
+
+
+// -- END OF FILE --
@@ -0,0 +1,67 @@
+//
+//    FILE: loghist_latency.ino
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PUPROSE: track p50 / p99 / p999 of the loop() duration with a LogHistogram
+//     URL: https://github.com/RobTillaart/Histogram
+
+
+#include "loghistogram.h"
+
+
+//  1 us .. 10 s, 1% relative error
+LogHistogram latency(1, 1e7, 0.01);
+
+uint32_t lastLoop = 0;
+uint32_t lastReport = 0;
+
+uint8_t buffer[512];
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("LogHistogram version: ");
+  Serial.println(LOGHISTOGRAM_LIB_VERSION);
+  Serial.print("buckets: ");
+  Serial.println(latency.size());
+  Serial.print("rel.err: ");
+  Serial.println(latency.getRelativeError(), 4);
+  Serial.println();
+  Serial.println("count\tp50\tp99\tp999\tmax\tbytes");
+  lastLoop = micros();
+}
+
+
+void loop()
+{
+  uint32_t now = micros();
+  latency.add(now - lastLoop);
+  lastLoop = now;
+
+  //  simulate some work
+  if (random(100) == 0) delayMicroseconds(random(1000));
+
+  if (millis() - lastReport >= 5000)
+  {
+    lastReport = millis();
+    Serial.print(latency.count());
+    Serial.print("\t");
+    Serial.print(latency.quantile(0.5));
+    Serial.print("\t");
+    Serial.print(latency.quantile(0.99));
+    Serial.print("\t");
+    Serial.print(latency.quantile(0.999));
+    Serial.print("\t");
+    Serial.print(latency.maximum());
+    Serial.print("\t");
+    //  compact form e.g. to send to a host that merges the sketches.
+    Serial.println(latency.serialize(buffer, sizeof(buffer)));
+    latency.clear();
+    lastLoop = micros();
+  }
+}
+
+
+// -- END OF FILE --
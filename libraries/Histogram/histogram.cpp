@@ -1,7 +1,7 @@
 //
 //    FILE: Histogram.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.3.2
+// VERSION: 0.3.3
 // PURPOSE: Histogram library for Arduino
 //    DATE: 2012-11-10
 //
@@ -25,20 +25,24 @@ Histogram::Histogram(const uint16_t length, float *bounds)
 Histogram::~Histogram()
 {
   if (_data) free(_data);
+  if (_tree) free(_tree);
 }
 
 
 //  resets all counters to value (default 0)
+//  the bounds may have changed so check them again.
 void Histogram::clear(int32_t value)
 {
   for (uint16_t i = 0; i < _length; i++) _data[i] = value;
   _count = 0;
+  _checkUniform();
+  if (_tree) _buildTree();
 }
 
 
 void Histogram::setBucket(const uint16_t index, int32_t value)
 { 
-  _data[index] = value; 
+  _update(index, value - _data[index]);
 };
 
 
@@ -48,7 +52,7 @@ void Histogram::add(const float value)
   if (_length > 0)
   {
     uint16_t index = find(value);
-    _data[index]++;
+    _update(index, 1);
     _count++;
   }
   //  return index or count.
@@ -61,7 +65,7 @@ void Histogram::sub(const float value)
   if (_length > 0)
   {
     uint16_t index = find(value);
-    _data[index]--;
+    _update(index, -1);
     _count++;
   }
   //  return index or count.
@@ -118,8 +122,9 @@ float Histogram::CDF(const float value)
 {
   if ((_count == 0) || (_length == 0)) return NAN;
 
-  //  TODO: could be done in one loop?
   uint16_t index = find(value);
+  if (_tree) return (1.0 * _prefixSum(index)) / _count;
+
   int32_t  sum = 0;
   for (uint16_t i = 0; i <= index; i++)
   {
@@ -141,6 +146,26 @@ float Histogram::VAL(const float prob)
   if (p > 1.0) p = 1.0;
 
   float probability = p * _count;
+
+  //  descend the Fenwick tree, only valid if prefix sums are increasing.
+  if ((_tree != NULL) && (_negatives == 0))
+  {
+    uint16_t pos = 0;
+    uint16_t step = 1;
+    while (step <= _length / 2) step <<= 1;
+    for (; step > 0; step >>= 1)
+    {
+      if ((pos + step <= _length) && (_tree[pos + step] < probability))
+      {
+        pos += step;
+        probability -= _tree[pos];
+      }
+    }
+    //  pos == first bucket with prefix sum >= probability
+    if (pos < (_length - 1)) return _bounds[pos];
+    return INFINITY;
+  }
+
   int32_t sum = 0;
   for (uint16_t i = 0; i < _length; i++)
   {
@@ -154,36 +179,22 @@ float Histogram::VAL(const float prob)
 }
 
 
-// returns the bucket number for value 
-// - binary search, more memory ;  faster for #buckets > 20 ?
-// uint16_t Histogram::find(const float value)
-// {
-  // if (_length <= 0) return -1;
-
-  // uint16_t low = 0, high = _length;
-  // uint16_t mid;
-  // while (high - low > 1)
-  // {
-    // mid = (low + high)/2;
-    // if (_bounds[mid] > value)
-    // {
-      // high = mid;
-    // }
-    // else
-    // {
-      // low = mid;
-    // }
-  // }
-  // if (_bounds[mid] > value) return mid;
-  // return _length - 1;
-// }
-
-
 //  returns the bucket number for value
+//  bucket i holds values in (_bounds[i-1], _bounds[i]]
 uint16_t Histogram::find(const float value)
 {
   if (_length <= 0) return -1;
 
+  if (_uniform) return findUniform(value);
+  if (_length > HISTOGRAM_LINEAR_SEARCH_MAX + 1) return findBinary(value);
+  return findLinear(value);
+}
+
+
+uint16_t Histogram::findLinear(const float value)
+{
+  if (_length <= 0) return -1;
+
   for (uint16_t i = 0; i < (_length - 1); i++)
   {
     if (_bounds[i] >= value)
@@ -195,6 +206,46 @@ uint16_t Histogram::find(const float value)
 }
 
 
+//  first bound >= value, faster for #buckets > 20 (AVR).
+uint16_t Histogram::findBinary(const float value)
+{
+  if (_length <= 0) return -1;
+
+  uint16_t low  = 0;
+  uint16_t high = _length - 1;   //  number of bounds
+  while (low < high)
+  {
+    uint16_t mid = low + (high - low) / 2;
+    //  written as not >= so NAN ends in the last bucket, like findLinear().
+    if (!(_bounds[mid] >= value)) low = mid + 1;
+    else high = mid;
+  }
+  return low;
+}
+
+
+//  calculates the bucket from the first bound and the step size,
+//  then corrects for rounding by checking the neighbouring bounds.
+//  so the result is always exact, for non uniform bounds it is just slower.
+uint16_t Histogram::findUniform(const float value)
+{
+  if (_length <= 0) return -1;
+
+  if (_length < 2) return 0;
+  uint16_t last = _length - 2;   //  index of last bound
+  if (value <= _bounds[0]) return 0;
+  if (!(value <= _bounds[last])) return _length - 1;   //  includes NAN
+
+  //  _bounds[0] < value <= _bounds[last]  ==>  1 <= index <= last
+  float f = (value - _bounds[0]) * _invStep;
+  uint16_t index = last;
+  if (f < last) index = 1 + (uint16_t)f;
+  while (_bounds[index - 1] >= value) index--;
+  while (_bounds[index] < value) index++;
+  return index;
+}
+
+
 //  returns the (first) index of the bucket with minimum value.
 uint16_t Histogram::findMin()
 {
@@ -265,6 +316,97 @@ uint16_t Histogram::countBelow(const int32_t level)
 }
 
 
+bool Histogram::setFenwick(bool enable)
+{
+  if (enable == false)
+  {
+    if (_tree) free(_tree);
+    _tree = NULL;
+    return true;
+  }
+  if (_tree != NULL) return true;
+  if (_length == 0) return false;
+  _tree = (int32_t *) malloc((_length + 1) * sizeof(int32_t));
+  if (_tree == NULL) return false;
+  _buildTree();
+  return true;
+}
+
+
+//////////////////////////////////////////////////////////////
+//
+//  PROTECTED
+//
+//  equidistant within 1% of the step, exact match is not needed
+//  as findUniform() corrects the estimate.
+void Histogram::_checkUniform()
+{
+  _uniform = false;
+  _invStep = 0;
+  if (_length < 3) return;
+
+  uint16_t last = _length - 2;
+  float step = (_bounds[last] - _bounds[0]) / last;
+  if (!(step > 0)) return;
+  _invStep = 1.0 / step;
+
+  for (uint16_t i = 1; i <= last; i++)
+  {
+    float expected = _bounds[0] + i * step;
+    if (fabs(_bounds[i] - expected) > step * 0.01) return;
+  }
+  _uniform = true;
+}
+
+
+void Histogram::_update(const uint16_t index, const int32_t delta)
+{
+  int32_t old = _data[index];
+  _data[index] += delta;
+  if (_tree == NULL) return;
+
+  if ((old < 0) != (_data[index] < 0))
+  {
+    if (old < 0) _negatives--;
+    else _negatives++;
+  }
+  //  uint32_t to prevent overflow for large histograms
+  for (uint32_t i = index + 1; i <= _length; i += (i & -i))
+  {
+    _tree[i] += delta;
+  }
+}
+
+
+//  O(n) build of the tree.
+void Histogram::_buildTree()
+{
+  _negatives = 0;
+  for (uint16_t i = 1; i <= _length; i++)
+  {
+    _tree[i] = _data[i - 1];
+    if (_data[i - 1] < 0) _negatives++;
+  }
+  for (uint16_t i = 1; i <= _length; i++)
+  {
+    uint32_t parent = (uint32_t)i + (i & -i);
+    if (parent <= _length) _tree[parent] += _tree[i];
+  }
+}
+
+
+//  sum of buckets 0..index
+int32_t Histogram::_prefixSum(const uint16_t index)
+{
+  int32_t sum = 0;
+  for (uint16_t i = index + 1; i > 0; i -= (i & -i))
+  {
+    sum += _tree[i];
+  }
+  return sum;
+}
+
+
 //////////////////////////////////////////////////////////////
 //
 //  DERIVED CLASS
@@ -2,7 +2,7 @@
 //
 //    FILE: Histogram.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.3.2
+// VERSION: 0.3.3
 // PURPOSE: Histogram library for Arduino
 //    DATE: 2012-11-10
 //
@@ -10,7 +10,13 @@
 
 #include "Arduino.h"
 
-#define HISTOGRAM_LIB_VERSION       (F("0.3.2"))
+#define HISTOGRAM_LIB_VERSION       (F("0.3.3"))
+
+//  find() uses a linear search up to this number of bounds,
+//  binary search above, unless the bounds are equidistant.
+#ifndef HISTOGRAM_LINEAR_SEARCH_MAX
+#define HISTOGRAM_LINEAR_SEARCH_MAX 16
+#endif
 
 
 class Histogram
@@ -38,19 +44,45 @@ public:
   float    CDF(const float value);
   float    VAL(const float prob);
 
+  //  selects the fastest of the three below.
   uint16_t find(const float value);
+  //  O(n), O(log n), O(1) for equidistant bounds, same result.
+  uint16_t findLinear(const float value);
+  uint16_t findBinary(const float value);
+  uint16_t findUniform(const float value);
+  //  true if the bounds are equidistant, checked in constructor and clear().
+  bool     isUniform() { return _uniform; };
   uint16_t findMin();
   uint16_t findMax();
   uint16_t countLevel(const int32_t level);
   uint16_t countAbove(const int32_t level);
   uint16_t countBelow(const int32_t level);
 
+  //  Fenwick tree (binary indexed tree) with prefix sums of the buckets.
+  //  add(), sub() and setBucket() become O(log n), CDF() and VAL() too.
+  //  uses an extra 4 bytes per bucket, returns false if allocation failed.
+  bool     setFenwick(bool enable = true);
+  bool     getFenwick() { return _tree != NULL; };
+
 
 protected:
   float *   _bounds;
   int32_t * _data;
   uint16_t  _length;
   uint32_t  _count;
+
+  //  equidistant bounds
+  bool      _uniform = false;
+  float     _invStep = 0;
+
+  //  Fenwick tree, _tree[1.._length]
+  int32_t * _tree = NULL;
+  uint16_t  _negatives = 0;     //  number of buckets < 0
+
+  void      _checkUniform();
+  void      _update(const uint16_t index, const int32_t delta);
+  void      _buildTree();
+  int32_t   _prefixSum(const uint16_t index);
 };
 
 
@@ -0,0 +1,348 @@
+//
+//    FILE: loghistogram.cpp
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: Log-linear histogram for streaming quantiles, e.g. latency.
+//     URL: https://github.com/RobTillaart/Histogram
+
+
+#include "loghistogram.h"
+
+
+LogHistogram::LogHistogram(const float minValue, const float maxValue, const float relativeError)
+{
+  //  bucket width 2^-bits ==> error of midpoint 2^-(bits+1)
+  _bits = 0;
+  while ((_bits < LOGHISTOGRAM_MAX_BITS) && (ldexp(1.0, -(_bits + 1)) > relativeError))
+  {
+    _bits++;
+  }
+
+  float low = minValue;
+  if (!(low >= 1e-30)) low = 1e-30;   //  positive, normal float
+  float high = maxValue;
+  if (!(high >= low)) high = low;
+  if (high > 1e30) high = 1e30;
+
+  _firstKey = _key(low);
+  uint32_t n = _key(high) - _firstKey + 1;
+  if (n > 65535) n = 0;
+  _length = n;
+  _data = NULL;
+  if (_length > 0) _data = (uint32_t *) malloc(_length * sizeof(uint32_t));
+  if (_data == NULL) _length = 0;
+  clear();
+}
+
+
+LogHistogram::~LogHistogram()
+{
+  if (_data) free(_data);
+}
+
+
+void LogHistogram::clear()
+{
+  for (uint16_t i = 0; i < _length; i++) _data[i] = 0;
+  _count     = 0;
+  _underflow = 0;
+  _overflow  = 0;
+  _min = 0;
+  _max = 0;
+}
+
+
+void LogHistogram::add(const float value, const uint32_t count)
+{
+  if ((_length == 0) || (count == 0) || isnan(value)) return;
+
+  if (_count == 0)
+  {
+    _min = value;
+    _max = value;
+  }
+  else
+  {
+    if (value < _min) _min = value;
+    if (value > _max) _max = value;
+  }
+  _count += count;
+
+  //  also catches zero and negative values.
+  if (!(value >= _value(_firstKey)))
+  {
+    _underflow += count;
+    return;
+  }
+  uint32_t index = _key(value) - _firstKey;
+  if (index >= _length)
+  {
+    _overflow += count;
+    return;
+  }
+  _data[index] += count;
+}
+
+
+bool LogHistogram::merge(const LogHistogram & other)
+{
+  if ((other._bits != _bits) || (other._firstKey != _firstKey) || (other._length != _length))
+  {
+    return false;
+  }
+  if (other._count == 0) return true;
+
+  for (uint16_t i = 0; i < _length; i++) _data[i] += other._data[i];
+  if ((_count == 0) || (other._min < _min)) _min = other._min;
+  if ((_count == 0) || (other._max > _max)) _max = other._max;
+  _count     += other._count;
+  _underflow += other._underflow;
+  _overflow  += other._overflow;
+  return true;
+}
+
+
+float LogHistogram::quantile(const float q)
+{
+  if (_count == 0) return NAN;
+
+  float p = q;
+  if (p < 0.0) p = 0.0;
+  if (p > 1.0) p = 1.0;
+  if (p == 0.0) return _min;
+  if (p == 1.0) return _max;
+
+  //  0 based rank of the value
+  uint32_t rank = p * (_count - 1) + 0.5;
+  uint32_t sum = _underflow;
+  if (rank < sum) return _min;
+
+  for (uint16_t i = 0; i < _length; i++)
+  {
+    sum += _data[i];
+    if (rank < sum)
+    {
+      //  midpoint of the bucket, within the observed range.
+      float value = (_value(_firstKey + i) + _value(_firstKey + i + 1)) * 0.5;
+      if (value < _min) return _min;
+      if (value > _max) return _max;
+      return value;
+    }
+  }
+  return _max;
+}
+
+
+float LogHistogram::getRelativeError()
+{
+  return ldexp(1.0, -(_bits + 1));
+}
+
+
+////////////////////////////////////////////////////////////
+//
+//  SERIALIZE
+//
+//  format, all multi byte values little endian
+//    magic, format, bits        3 bytes
+//    firstKey                   4 bytes
+//    length                     2 bytes
+//    min, max                   2 x 4 bytes float
+//    count, underflow, overflow varint
+//    #non zero buckets          varint
+//    per non zero bucket        varint gap since previous, varint count
+//
+
+static uint8_t * _putVarint(uint8_t * p, uint32_t value)
+{
+  while (value >= 0x80)
+  {
+    *p++ = (value & 0x7F) | 0x80;
+    value >>= 7;
+  }
+  *p++ = value;
+  return p;
+}
+
+
+static const uint8_t * _getVarint(const uint8_t * p, const uint8_t * end, uint32_t & value)
+{
+  value = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7)
+  {
+    if (p >= end) return NULL;
+    uint8_t b = *p++;
+    value |= (uint32_t)(b & 0x7F) << shift;
+    if ((b & 0x80) == 0) return p;
+  }
+  return NULL;
+}
+
+
+static uint8_t * _put32(uint8_t * p, uint32_t value)
+{
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    *p++ = value & 0xFF;
+    value >>= 8;
+  }
+  return p;
+}
+
+
+static uint32_t _get32(const uint8_t * p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+
+static uint8_t _varintSize(uint32_t value)
+{
+  uint8_t n = 1;
+  while (value >= 0x80)
+  {
+    value >>= 7;
+    n++;
+  }
+  return n;
+}
+
+
+size_t LogHistogram::serializedSize()
+{
+  size_t size = 17;
+  size += _varintSize(_count) + _varintSize(_underflow) + _varintSize(_overflow);
+  uint16_t nonZero = 0;
+  uint16_t last = 0;
+  for (uint16_t i = 0; i < _length; i++)
+  {
+    if (_data[i] == 0) continue;
+    nonZero++;
+    size += _varintSize(i - last) + _varintSize(_data[i]);
+    last = i;
+  }
+  return size + _varintSize(nonZero);
+}
+
+
+size_t LogHistogram::serialize(uint8_t * buffer, const size_t size)
+{
+  if (size < serializedSize()) return 0;
+
+  uint8_t * p = buffer;
+  *p++ = LOGHISTOGRAM_MAGIC;
+  *p++ = LOGHISTOGRAM_FORMAT;
+  *p++ = _bits;
+  p = _put32(p, _firstKey);
+  *p++ = _length & 0xFF;
+  *p++ = _length >> 8;
+  uint32_t raw;
+  memcpy(&raw, &_min, 4);
+  p = _put32(p, raw);
+  memcpy(&raw, &_max, 4);
+  p = _put32(p, raw);
+  p = _putVarint(p, _count);
+  p = _putVarint(p, _underflow);
+  p = _putVarint(p, _overflow);
+
+  uint16_t nonZero = 0;
+  for (uint16_t i = 0; i < _length; i++)
+  {
+    if (_data[i] != 0) nonZero++;
+  }
+  p = _putVarint(p, nonZero);
+  uint16_t last = 0;
+  for (uint16_t i = 0; i < _length; i++)
+  {
+    if (_data[i] == 0) continue;
+    p = _putVarint(p, i - last);
+    p = _putVarint(p, _data[i]);
+    last = i;
+  }
+  return p - buffer;
+}
+
+
+bool LogHistogram::deserialize(const uint8_t * buffer, const size_t size)
+{
+  const uint8_t * end = buffer + size;
+  if (size < 17) return false;
+  if (buffer[0] != LOGHISTOGRAM_MAGIC) return false;
+  if (buffer[1] != LOGHISTOGRAM_FORMAT) return false;
+  if (buffer[2] != _bits) return false;
+  if (_get32(buffer + 3) != _firstKey) return false;
+  if ((buffer[7] | (buffer[8] << 8)) != _length) return false;
+
+  float mn, mx;
+  uint32_t raw = _get32(buffer + 9);
+  memcpy(&mn, &raw, 4);
+  raw = _get32(buffer + 13);
+  memcpy(&mx, &raw, 4);
+
+  const uint8_t * p = buffer + 17;
+  uint32_t cnt, under, over, nonZero;
+  if ((p = _getVarint(p, end, cnt)) == NULL) return false;
+  if ((p = _getVarint(p, end, under)) == NULL) return false;
+  if ((p = _getVarint(p, end, over)) == NULL) return false;
+  if ((p = _getVarint(p, end, nonZero)) == NULL) return false;
+
+  //  validate all buckets before changing anything.
+  const uint8_t * start = p;
+  uint32_t index = 0;
+  for (uint32_t i = 0; i < nonZero; i++)
+  {
+    uint32_t gap, value;
+    if ((p = _getVarint(p, end, gap)) == NULL) return false;
+    if ((p = _getVarint(p, end, value)) == NULL) return false;
+    index += gap;
+    if (index >= _length) return false;
+  }
+
+  p = start;
+  index = 0;
+  for (uint32_t i = 0; i < nonZero; i++)
+  {
+    uint32_t gap, value;
+    p = _getVarint(p, end, gap);
+    p = _getVarint(p, end, value);
+    index += gap;
+    _data[index] += value;
+  }
+  if (cnt > 0)
+  {
+    if ((_count == 0) || (mn < _min)) _min = mn;
+    if ((_count == 0) || (mx > _max)) _max = mx;
+  }
+  _count     += cnt;
+  _underflow += under;
+  _overflow  += over;
+  return true;
+}
+
+
+////////////////////////////////////////////////////////////
+//
+//  PROTECTED
+//
+//  key = exponent and top _bits of the mantissa of a positive float.
+//  keys are increasing with the value.
+uint32_t LogHistogram::_key(const float value)
+{
+  uint32_t raw;
+  memcpy(&raw, &value, 4);
+  return raw >> (23 - _bits);
+}
+
+
+//  lower bound of the bucket with key.
+float LogHistogram::_value(const uint32_t key)
+{
+  uint32_t raw = key << (23 - _bits);
+  float value;
+  memcpy(&value, &raw, 4);
+  return value;
+}
+
+
+// -- END OF FILE --
+
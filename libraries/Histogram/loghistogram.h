@@ -0,0 +1,89 @@
+#pragma once
+//
+//    FILE: loghistogram.h
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: Log-linear histogram for streaming quantiles, e.g. latency.
+//     URL: https://github.com/RobTillaart/Histogram
+//
+//  The bucket of a value is its float exponent plus the top mantissa bits,
+//  like HDR histogram / DDSketch. All buckets have the same relative width
+//  so the quantiles have a bounded relative error over the whole range.
+//  Memory is fixed by the range and precision set in the constructor.
+
+
+#include "Arduino.h"
+
+
+#define LOGHISTOGRAM_LIB_VERSION        (F("0.1.0"))
+
+//  max mantissa bits, relative error 2^-11 ~ 0.05%
+#define LOGHISTOGRAM_MAX_BITS           10
+
+//  serialize() format
+#define LOGHISTOGRAM_MAGIC              0x4C
+#define LOGHISTOGRAM_FORMAT             1
+
+
+class LogHistogram
+{
+public:
+  //  values below minValue or above maxValue go into an under/overflow bucket.
+  //  relativeError is the max relative error of quantile(), default 1%.
+  LogHistogram(const float minValue, const float maxValue, const float relativeError = 0.01);
+  ~LogHistogram();
+
+  void     clear();
+  void     add(const float value, const uint32_t count = 1);
+
+  //  merge all values of other into this one,
+  //  returns false if range or precision differ.
+  bool     merge(const LogHistogram & other);
+
+  //  number of values added
+  uint32_t count()     { return _count; };
+  //  exact minimum and maximum added, NAN if empty.
+  float    minimum()   { return _count ? _min : NAN; };
+  float    maximum()   { return _count ? _max : NAN; };
+  uint32_t underflow() { return _underflow; };
+  uint32_t overflow()  { return _overflow; };
+
+  //  value for which a fraction q of the values is lower, 0.0 <= q <= 1.0
+  //  e.g. quantile(0.5) = median, quantile(0.99) = p99.
+  //  NAN if empty.
+  float    quantile(const float q);
+
+  //  configuration
+  uint16_t size()      { return _length; };   //  number of buckets
+  uint8_t  getBits()   { return _bits; };
+  float    getRelativeError();
+
+  //  compact binary form, zero buckets are skipped, counts as varint.
+  //  size in bytes needed.
+  size_t   serializedSize();
+  //  returns bytes written, 0 if buffer too small.
+  size_t   serialize(uint8_t * buffer, const size_t size);
+  //  adds the serialized histogram to this one (merge),
+  //  returns false if the format, range or precision differ.
+  bool     deserialize(const uint8_t * buffer, const size_t size);
+
+
+protected:
+  uint32_t * _data;
+  uint16_t   _length;
+  uint8_t    _bits;
+  uint32_t   _firstKey;
+
+  uint32_t   _count;
+  uint32_t   _underflow;
+  uint32_t   _overflow;
+  float      _min;
+  float      _max;
+
+  uint32_t   _key(const float value);
+  float      _value(const uint32_t key);
+};
+
+
+// -- END OF FILE --
+
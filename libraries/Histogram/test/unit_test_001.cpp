@@ -87,6 +87,100 @@ unittest(test_dice)
 }
 
 
+unittest(test_find)
+{
+  float uniform[200];
+  float random[200];
+  float x = 0;
+  uint32_t seed = 3;
+  for (int i = 0; i < 200; i++)
+  {
+    uniform[i] = -10 + i * 0.1;
+    seed = seed * 1103515245 + 12345;
+    x += 0.01 + (seed >> 16) / 65536.0;
+    random[i] = x;
+  }
+  Histogram histU(200, uniform);
+  Histogram histR(200, random);
+  assertTrue(histU.isUniform());
+  assertFalse(histR.isUniform());
+
+  for (int i = 0; i < 5000; i++)
+  {
+    seed = seed * 1103515245 + 12345;
+    float v = -12 + (seed >> 8) * (24.0 / 16777216.0);
+    if (i % 10 == 0) v = uniform[(seed >> 16) % 200];   //  exact on bound
+    uint16_t expect = histU.findLinear(v);
+    assertEqual(expect, histU.find(v));
+    assertEqual(expect, histU.findBinary(v));
+    assertEqual(expect, histU.findUniform(v));
+
+    v = -1 + (seed >> 8) * (x + 2) / 16777216.0;
+    if (i % 10 == 0) v = random[(seed >> 16) % 200];
+    expect = histR.findLinear(v);
+    assertEqual(expect, histR.find(v));
+    assertEqual(expect, histR.findBinary(v));
+    assertEqual(expect, histR.findUniform(v));
+  }
+  //  NAN ends in the last bucket
+  assertEqual(200, histU.findBinary(NAN));
+  assertEqual(200, histU.findUniform(NAN));
+}
+
+
+unittest(test_fenwick)
+{
+  float bounds[100];
+  for (int i = 0; i < 100; i++) bounds[i] = i * i;   //  not uniform
+  Histogram hist(100, bounds);
+  Histogram ref(100, bounds);
+  assertFalse(hist.getFenwick());
+  assertTrue(hist.setFenwick());
+  assertTrue(hist.getFenwick());
+
+  uint32_t seed = 5;
+  for (int i = 0; i < 3000; i++)
+  {
+    seed = seed * 1103515245 + 12345;
+    float v = (seed >> 16) % 10500;
+    hist.add(v);
+    ref.add(v);
+  }
+  hist.setBucket(3, 7);
+  ref.setBucket(3, 7);
+  for (int i = 0; i < 100; i++)
+  {
+    float v = i * 100;
+    assertEqualFloat(ref.CDF(v), hist.CDF(v), 1e-6);
+    float p = i * 0.01;
+    assertEqual(ref.VAL(p), hist.VAL(p));
+  }
+  assertInfinity(hist.VAL(1.0));
+
+  //  negative buckets fall back to linear VAL()
+  hist.sub(50);
+  hist.sub(50);
+  ref.sub(50);
+  ref.sub(50);
+  hist.setBucket(5, -3);
+  ref.setBucket(5, -3);
+  for (int i = 0; i <= 100; i++)
+  {
+    float p = i * 0.01;
+    assertEqualFloat(ref.CDF(p * 10000), hist.CDF(p * 10000), 1e-6);
+    assertEqual(ref.VAL(p), hist.VAL(p));
+  }
+
+  hist.clear(2);
+  ref.clear(2);
+  hist.add(1000);
+  ref.add(1000);
+  assertEqual(ref.VAL(0.5), hist.VAL(0.5));
+  assertTrue(hist.setFenwick(false));
+  assertFalse(hist.getFenwick());
+}
+
+
 unittest_main()
 
 // --------
@@ -0,0 +1,162 @@
+//
+//    FILE: unit_test_loghistogram.cpp
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: unit tests for the LogHistogram
+//          https://github.com/RobTillaart/Histogram
+//          https://github.com/Arduino-CI/arduino_ci/blob/master/REFERENCE.md
+//
+
+// supported assertions
+// ----------------------------
+// assertEqual(expected, actual)
+// assertNotEqual(expected, actual)
+// assertLess(expected, actual)
+// assertMore(expected, actual)
+// assertLessOrEqual(expected, actual)
+// assertMoreOrEqual(expected, actual)
+// assertTrue(actual)
+// assertFalse(actual)
+// assertNull(actual)
+// assertNotNull(actual)
+
+#include <ArduinoUnitTests.h>
+
+
+#include "Arduino.h"
+#include "loghistogram.h"
+
+
+unittest_setup()
+{
+  fprintf(stderr, "LOGHISTOGRAM_LIB_VERSION: %s\n", (char *) LOGHISTOGRAM_LIB_VERSION);
+}
+
+unittest_teardown()
+{
+}
+
+
+static int compareFloat(const void * a, const void * b)
+{
+  float fa = *(const float *) a;
+  float fb = *(const float *) b;
+  return (fa > fb) - (fa < fb);
+}
+
+
+//  log uniform 1 .. 1e6
+static float testValue(uint32_t & seed)
+{
+  seed = seed * 1103515245 + 12345;
+  return pow(10, 6.0 * (seed >> 8) / 16777216.0);
+}
+
+
+unittest(test_constructor)
+{
+  LogHistogram hist(1, 1e6, 0.01);
+  assertEqual(6, hist.getBits());
+  assertEqualFloat(1.0 / 128, hist.getRelativeError(), 1e-7);
+  //  1e6 ~ 2^19.93 ==> 19 binary orders of magnitude * 64 + 59
+  assertEqual(19 * 64 + 59, hist.size());
+  assertEqual(0, hist.count());
+  assertNAN(hist.quantile(0.5));
+  assertNAN(hist.minimum());
+}
+
+
+unittest(test_quantile)
+{
+  const int N = 5000;
+  static float values[N];
+  LogHistogram hist(1, 1e6, 0.01);
+  uint32_t seed = 1;
+  for (int i = 0; i < N; i++)
+  {
+    values[i] = testValue(seed);
+    hist.add(values[i]);
+  }
+  qsort(values, N, sizeof(float), compareFloat);
+
+  assertEqual(N, hist.count());
+  assertEqualFloat(values[0], hist.minimum(), 0);
+  assertEqualFloat(values[N - 1], hist.maximum(), 0);
+  float q[] = { 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999 };
+  for (int i = 0; i < 8; i++)
+  {
+    float exact = values[(int)(q[i] * (N - 1) + 0.5)];
+    float approx = hist.quantile(q[i]);
+    assertLessOrEqual(fabs(approx - exact) / exact, hist.getRelativeError());
+  }
+
+  //  under and overflow
+  hist.add(0);
+  hist.add(-5);
+  hist.add(1e7, 3);
+  assertEqual(2, hist.underflow());
+  assertEqual(3, hist.overflow());
+  assertEqualFloat(-5, hist.quantile(0.0), 0);
+  assertEqualFloat(1e7, hist.quantile(1.0), 1);
+
+  hist.clear();
+  assertEqual(0, hist.count());
+}
+
+
+unittest(test_merge_serialize)
+{
+  LogHistogram serial(0.001, 1000, 0.005);
+  LogHistogram part1(0.001, 1000, 0.005);
+  LogHistogram part2(0.001, 1000, 0.005);
+  LogHistogram other(0.001, 1000, 0.05);
+
+  uint32_t seed = 9;
+  for (int i = 0; i < 2000; i++)
+  {
+    float v = testValue(seed) * 0.001;
+    serial.add(v);
+    if (i & 1) part1.add(v);
+    else part2.add(v);
+  }
+  assertFalse(part1.merge(other));
+  assertTrue(part1.merge(part2));
+  assertEqual(serial.count(), part1.count());
+  assertEqual(serial.overflow(), part1.overflow());
+  for (int i = 0; i <= 100; i++)
+  {
+    assertEqual(serial.quantile(i * 0.01), part1.quantile(i * 0.01));
+  }
+
+  //  round trip
+  static uint8_t buffer[4096];
+  assertEqual(0, serial.serialize(buffer, 10));
+  size_t len = serial.serialize(buffer, sizeof(buffer));
+  assertMore(len, 17);
+  assertEqual(len, serial.serializedSize());
+  fprintf(stderr, "%d buckets, %d bytes\n", serial.size(), (int)len);
+
+  LogHistogram copy(0.001, 1000, 0.005);
+  assertTrue(copy.deserialize(buffer, len));
+  assertEqual(serial.count(), copy.count());
+  assertEqual(serial.minimum(), copy.minimum());
+  assertEqual(serial.maximum(), copy.maximum());
+  for (int i = 0; i <= 100; i++)
+  {
+    assertEqual(serial.quantile(i * 0.01), copy.quantile(i * 0.01));
+  }
+  //  deserialize adds
+  assertTrue(copy.deserialize(buffer, len));
+  assertEqual(2 * serial.count(), copy.count());
+
+  //  errors
+  assertFalse(other.deserialize(buffer, len));
+  assertFalse(copy.deserialize(buffer, len - 1));
+  buffer[0] = 0;
+  assertFalse(copy.deserialize(buffer, len));
+}
+
+
+unittest_main()
+
+// --------
@@ -1,7 +1,7 @@
 //
 //    FILE: Prandom.cpp
 //  AUTHOR: Rob dot Tillaart at gmail dot com
-// VERSION: 0.1.5
+// VERSION: 0.2.0
 // PURPOSE: Arduino library for random number generation with Python random interface
 //     URL: https://github.com/RobTillaart/Prandom
 //
@@ -31,6 +31,25 @@ void Prandom::seed()
 }
 
 
+//  SplitMix64 step, also used to expand the seed for the other engines.
+static uint64_t splitmix64(uint64_t &x)
+{
+  uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+
+static inline uint64_t rotl64(const uint64_t x, int k)
+{
+  return (x << k) | (x >> (64 - k));
+}
+
+
+#define PRANDOM_PCG_MULT      6364136223846793005ULL
+
+
 void Prandom::seed(uint32_t s, uint32_t t)
 {
   //  set Marsaglia constants, prevent 0 as value
@@ -38,13 +57,108 @@ void Prandom::seed(uint32_t s, uint32_t t)
   if (t == 0) t = 2;
   _m_w = s;
   _m_z = t;
+  _seed1 = s;
+  _seed2 = t;
+  _gaussNext = false;
+
+  uint64_t x = ((uint64_t)t << 32) | s;
+  switch(_engine)
+  {
+    case PRANDOM_XOSHIRO256SS:
+      //  state may not be all zero, SplitMix64 output never is.
+      for (uint8_t i = 0; i < 4; i++) _s[i] = splitmix64(x);
+      break;
+    case PRANDOM_PCG32:
+      //  pcg32_srandom()
+      _s[0] = 0;
+      _s[1] = (splitmix64(x) << 1) | 1;
+      _pcg32();
+      _s[0] += splitmix64(x);
+      _pcg32();
+      break;
+    case PRANDOM_SPLITMIX64:
+      _s[0] = x;
+      break;
+  }
+}
+
+
+void Prandom::setEngine(uint8_t engine)
+{
+  if (engine > PRANDOM_SPLITMIX64) engine = PRANDOM_MARSAGLIA;
+  _engine = engine;
+  seed(_seed1, _seed2);
+}
+
+
+bool Prandom::jump()
+{
+  if (_engine == PRANDOM_XOSHIRO256SS)
+  {
+    static const uint64_t JUMP[] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                                     0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+      for (uint8_t b = 0; b < 64; b++)
+      {
+        if (JUMP[i] & (1ULL << b))
+        {
+          s0 ^= _s[0];
+          s1 ^= _s[1];
+          s2 ^= _s[2];
+          s3 ^= _s[3];
+        }
+        _xoshiro();
+      }
+    }
+    _s[0] = s0;
+    _s[1] = s1;
+    _s[2] = s2;
+    _s[3] = s3;
+    return true;
+  }
+  return advance(1ULL << 48);
+}
+
+
+bool Prandom::advance(uint64_t delta)
+{
+  if (_engine == PRANDOM_SPLITMIX64)
+  {
+    _s[0] += delta * 0x9E3779B97F4A7C15ULL;
+    return true;
+  }
+  if (_engine == PRANDOM_PCG32)
+  {
+    //  Brown, "Random Number Generation with Arbitrary Stride", O(log delta)
+    uint64_t curMult = PRANDOM_PCG_MULT;
+    uint64_t curPlus = _s[1];
+    uint64_t accMult = 1;
+    uint64_t accPlus = 0;
+    while (delta > 0)
+    {
+      if (delta & 1)
+      {
+        accMult *= curMult;
+        accPlus = accPlus * curMult + curPlus;
+      }
+      curPlus = (curMult + 1) * curPlus;
+      curMult *= curMult;
+      delta >>= 1;
+    }
+    _s[0] = accMult * _s[0] + accPlus;
+    return true;
+  }
+  return false;
 }
 
 
 uint32_t Prandom::getrandbits(uint8_t n)
 {
-  uint8_t shift = min(31, n - 1);
-  return _rnd(1UL << shift);
+  if (n == 0) return 0;
+  if (n >= 32) return __random();
+  return __random() >> (32 - n);
 }
 
 
@@ -123,23 +237,22 @@ float Prandom::lognormvariate(float mu, float sigma)
 
 
 //  implemented slightly differently
+//  the second value is cached per instance.
 float Prandom::gauss(float mu, float sigma)
 {
-  static bool generate = false;
-  static float next = 0;
   float z = 0;
 
-  generate = !generate;
-  if (generate == false)
+  _gaussNext = !_gaussNext;
+  if (_gaussNext == false)
   {
-    z = next;
+    z = _gaussValue;
   }
   else
   {
     float x2pi = random(TWO_PI);
     float g2rad = sqrt( -2.0 * log(1.0 - random()));
     z = cos(x2pi) * g2rad;
-    next = sin(x2pi) * g2rad;
+    _gaussValue = sin(x2pi) * g2rad;
   }
   return z * sigma + mu;
 };
@@ -271,6 +384,166 @@ float Prandom::vonmisesvariate(float mu, float kappa)
 }
 
 
+////////////////////////////////////////////////////////////////////////////
+//
+//  ZIGGURAT
+//
+//  Marsaglia & Tsang, "The Ziggurat Method for Generating Random Variables",
+//  Journal of Statistical Software, 2000, 128 layers normal, 256 exponential.
+//  The tables are shared by all instances and build on first use.
+#if PRANDOM_ZIGGURAT
+
+struct PrandomZiggurat
+{
+  uint32_t kn[128];
+  float    wn[128], fn[128];
+  uint32_t ke[256];
+  float    we[256], fe[256];
+
+  PrandomZiggurat()
+  {
+    const double m1 = 2147483648.0;
+    const double m2 = 4294967296.0;
+    double dn = 3.442619855899, tn = dn, vn = 9.91256303526217e-3;
+    double de = 7.697117470131487, te = de, ve = 3.949659822581572e-3;
+
+    double q = vn / exp(-0.5 * dn * dn);
+    kn[0] = (dn / q) * m1;
+    kn[1] = 0;
+    wn[0] = q / m1;
+    wn[127] = dn / m1;
+    fn[0] = 1.0;
+    fn[127] = exp(-0.5 * dn * dn);
+    for (int i = 126; i >= 1; i--)
+    {
+      dn = sqrt(-2.0 * log(vn / dn + exp(-0.5 * dn * dn)));
+      kn[i + 1] = (dn / tn) * m1;
+      tn = dn;
+      fn[i] = exp(-0.5 * dn * dn);
+      wn[i] = dn / m1;
+    }
+
+    q = ve / exp(-de);
+    ke[0] = (de / q) * m2;
+    ke[1] = 0;
+    we[0] = q / m2;
+    we[255] = de / m2;
+    fe[0] = 1.0;
+    fe[255] = exp(-de);
+    for (int i = 254; i >= 1; i--)
+    {
+      de = -log(ve / de + exp(-de));
+      ke[i + 1] = (de / te) * m2;
+      te = de;
+      fe[i] = exp(-de);
+      we[i] = de / m2;
+    }
+  }
+};
+
+
+static const PrandomZiggurat & zigTables()
+{
+  static const PrandomZiggurat zig;
+  return zig;
+}
+
+#endif
+
+
+float Prandom::zignormal(float mu, float sigma)
+{
+#if PRANDOM_ZIGGURAT
+  const PrandomZiggurat & z = zigTables();
+  const float R = 3.442620f;   //  start of the tail
+  float x, y;
+  while (true)
+  {
+    int32_t  hz  = (int32_t) __random();
+    uint32_t ahz = (hz < 0) ? -(uint32_t)hz : hz;
+    uint8_t  iz  = hz & 127;
+    x = hz * z.wn[iz];
+    //  fast path, inside the rectangle ~99%
+    if (ahz < z.kn[iz]) break;
+    if (iz == 0)
+    {
+      //  tail
+      do
+      {
+        x = -log(_uni()) * (1.0f / R);
+        y = -log(_uni());
+      }
+      while (y + y < x * x);
+      x = (hz > 0) ? R + x : -R - x;
+      break;
+    }
+    //  wedge
+    if (z.fn[iz] + _uni() * (z.fn[iz - 1] - z.fn[iz]) < exp(-0.5f * x * x)) break;
+  }
+  return x * sigma + mu;
+#else
+  return normalvariate(mu, sigma);
+#endif
+}
+
+
+float Prandom::zigexpo(float lambda)
+{
+#if PRANDOM_ZIGGURAT
+  const PrandomZiggurat & z = zigTables();
+  float x;
+  while (true)
+  {
+    uint32_t jz = __random();
+    uint8_t  iz = jz & 255;
+    x = jz * z.we[iz];
+    //  fast path
+    if (jz < z.ke[iz]) break;
+    if (iz == 0)
+    {
+      //  tail
+      x = 7.69711f - log(_uni());
+      break;
+    }
+    //  wedge
+    if (z.fe[iz] + _uni() * (z.fe[iz - 1] - z.fe[iz]) < exp(-x)) break;
+  }
+  return x / lambda;
+#else
+  return expovariate(lambda);
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////
+//
+//  BATCH
+//
+void Prandom::fill(uint32_t * array, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; i++) array[i] = __random();
+}
+
+
+void Prandom::fill(float * array, uint32_t count, float lo, float hi)
+{
+  const float scale = (hi - lo) * (1.0f / 4294967296.0f);
+  for (uint32_t i = 0; i < count; i++) array[i] = lo + __random() * scale;
+}
+
+
+void Prandom::fillNormal(float * array, uint32_t count, float mu, float sigma)
+{
+  for (uint32_t i = 0; i < count; i++) array[i] = zignormal(mu, sigma);
+}
+
+
+void Prandom::fillExpo(float * array, uint32_t count, float lambda)
+{
+  for (uint32_t i = 0; i < count; i++) array[i] = zigexpo(lambda);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////
 //
 //  PRIVATE
@@ -281,27 +554,85 @@ uint32_t Prandom::_rndTime()
 }
 
 
-//  TODO how to guarantee it uniform between 0 .. n-1
+//  uniform 0 .. n-1
+//  Lemire, "Fast Random Integer Generation in an Interval", 2019.
+//  multiply instead of divide, rejects the few biased values.
 uint32_t Prandom::_rnd(uint32_t n)
 {
-  //  float formula works fastest but it looses precision for large values of n
-  //  as floats have only 23 bit mantissa
-  uint32_t val = __random();
-  if (n > 0x003FFFFF) return val % n;     //  distribution will fail here
-  return (n * 1.0 * val) / 0xFFFFFFFF;
+  if (n == 0) return 0;
+  uint64_t m = (uint64_t)__random() * n;
+  uint32_t low = (uint32_t)m;
+  if (low < n)
+  {
+    uint32_t threshold = (0 - n) % n;
+    while (low < threshold)
+    {
+      m = (uint64_t)__random() * n;
+      low = (uint32_t)m;
+    }
+  }
+  return m >> 32;
+}
+
+
+//  uniform 0 .. 1 exclusive both, 24 bits
+float Prandom::_uni()
+{
+  return ((__random() >> 8) + 0.5f) * (1.0f / 16777216.0f);
 }
 
 
-//  An example of a simple pseudo-random number generator is the
-//  Multiply-with-carry method invented by George Marsaglia.
-//  two initializers (not null)
 uint32_t Prandom::__random()
 {
+  switch(_engine)
+  {
+    case PRANDOM_XOSHIRO256SS: return _xoshiro();
+    case PRANDOM_PCG32:        return _pcg32();
+    case PRANDOM_SPLITMIX64:   return _splitmix();
+  }
+  //  An example of a simple pseudo-random number generator is the
+  //  Multiply-with-carry method invented by George Marsaglia.
+  //  two initializers (not null)
   _m_z = 36969L * (_m_z & 65535L) + (_m_z >> 16);
   _m_w = 18000L * (_m_w & 65535L) + (_m_w >> 16);
   return (_m_z << 16) + _m_w;  /* 32-bit result */
 }
 
 
+//  Blackman & Vigna, xoshiro256**, upper 32 bits
+//  https://prng.di.unimi.it/
+uint32_t Prandom::_xoshiro()
+{
+  const uint64_t result = rotl64(_s[1] * 5, 7) * 9;
+  const uint64_t t = _s[1] << 17;
+  _s[2] ^= _s[0];
+  _s[3] ^= _s[1];
+  _s[1] ^= _s[2];
+  _s[0] ^= _s[3];
+  _s[2] ^= t;
+  _s[3] = rotl64(_s[3], 45);
+  return result >> 32;
+}
+
+
+//  O'Neill, PCG32 XSH RR
+//  https://www.pcg-random.org/
+uint32_t Prandom::_pcg32()
+{
+  uint64_t old = _s[0];
+  _s[0] = old * PRANDOM_PCG_MULT + _s[1];
+  uint32_t xorshifted = ((old >> 18) ^ old) >> 27;
+  uint32_t rot = old >> 59;
+  return (xorshifted >> rot) | (xorshifted << ((0 - rot) & 31));
+}
+
+
+//  Steele, Lea & Flood, SplitMix64, upper 32 bits
+uint32_t Prandom::_splitmix()
+{
+  return splitmix64(_s[0]) >> 32;
+}
+
+
 //  -- END OF FILE --
 
@@ -2,10 +2,11 @@
 //
 //    FILE: Prandom.h
 //  AUTHOR: Rob dot Tillaart at gmail dot com
-// VERSION: 0.1.5
+// VERSION: 0.2.0
 // PURPOSE: Arduino library for random numbers with Python Random interface
-//          The underlying pseudo-random number generator is a
+//          The default pseudo-random number generator is a
 //          Multiply-with-carry method invented by George Marsaglia.
+//          Optional engines xoshiro256**, PCG32 and SplitMix64.
 //     URL: https://github.com/RobTillaart/Prandom
 //          https://docs.python.org/3/library/random.html
 //          https://www.pcg-random.org/
@@ -13,7 +14,25 @@
 
 #include "Arduino.h"
 
-#define PRANDOM_LIB_VERSION                 (F("0.1.5"))
+#define PRANDOM_LIB_VERSION                 (F("0.2.0"))
+
+
+//  ENGINES
+#define PRANDOM_MARSAGLIA                   0
+#define PRANDOM_XOSHIRO256SS                1
+#define PRANDOM_PCG32                       2
+#define PRANDOM_SPLITMIX64                  3
+
+
+//  ziggurat tables use ~4.5 KB RAM, too much for AVR.
+//  zignormal() and zigexpo() fall back to normalvariate() and expovariate().
+#ifndef PRANDOM_ZIGGURAT
+#if defined(__AVR__)
+#define PRANDOM_ZIGGURAT                    0
+#else
+#define PRANDOM_ZIGGURAT                    1
+#endif
+#endif
 
 
 class Prandom
@@ -26,6 +45,17 @@ public:
   void seed(uint32_t s, uint32_t t = 2);  //  Marsaglia need 2 seeds, but 1 will work too
 
 
+  //  ENGINE
+  //  setEngine() reseeds with the last seed values.
+  void    setEngine(uint8_t engine = PRANDOM_MARSAGLIA);
+  uint8_t getEngine() { return _engine; };
+  //  next independent stream, for parallel runs, returns false for Marsaglia.
+  //  xoshiro256** jumps 2^128 numbers, PCG32 and SplitMix64 2^48 numbers.
+  bool    jump();
+  //  skip delta numbers, PCG32 and SplitMix64 only.
+  bool    advance(uint64_t delta);
+
+
   //  integer methods
   //
   uint32_t getrandbits(uint8_t n);
@@ -57,15 +87,45 @@ public:
   float vonmisesvariate(float mu, float kappa = 0);
 
 
+  //  Ziggurat distributions (Marsaglia & Tsang), faster, not in Python.
+  //
+  float zignormal(float mu = 0, float sigma = 1.0);
+  float zigexpo(float lambda = 1.0);
+
+
+  //  batch methods
+  //
+  void  fill(uint32_t * array, uint32_t count);
+  void  fill(float * array, uint32_t count, float lo = 0, float hi = 1.0);
+  void  fillNormal(float * array, uint32_t count, float mu = 0, float sigma = 1.0);
+  void  fillExpo(float * array, uint32_t count, float lambda = 1.0);
+
+
 private:
 
   uint32_t _rndTime();
   uint32_t _rnd(uint32_t n);
+  float    _uni();
+
+  uint8_t  _engine = PRANDOM_MARSAGLIA;
+  uint32_t _seed1  = 1;
+  uint32_t _seed2  = 2;
 
   //  Marsaglia 'constants'
   uint32_t _m_w = 1;
   uint32_t _m_z = 2;
+  //  xoshiro256** state, PCG32 uses [0] state and [1] increment,
+  //  SplitMix64 uses [0].
+  uint64_t _s[4];
   uint32_t __random();
+
+  uint32_t _xoshiro();
+  uint32_t _pcg32();
+  uint32_t _splitmix();
+
+  //  gauss() generates two values per call.
+  bool     _gaussNext  = false;
+  float    _gaussValue = 0;
 };
 
 
@@ -0,0 +1,105 @@
+//
+//    FILE: prandom_engines.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: compare engines and ziggurat samplers
+//    DATE: 2026-10-17
+//     URL: https://github.com/RobTillaart/Prandom
+
+
+#include "Prandom.h"
+
+const uint32_t runs = 10000;
+
+Prandom R;
+
+uint32_t start, stop;
+volatile float    f;
+volatile uint32_t x;
+
+float buffer[100];
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("PRANDOM_LIB_VERSION: ");
+  Serial.println(PRANDOM_LIB_VERSION);
+  Serial.println();
+
+  const char * names[4] = { "Marsaglia", "xoshiro256**", "PCG32", "SplitMix64" };
+
+  Serial.println(F("us per 10000 calls"));
+  Serial.println(F("ENGINE\t\tbits\trange\tnormal\tzignorm\texpo\tzigexpo\tfill"));
+  for (uint8_t e = PRANDOM_MARSAGLIA; e <= PRANDOM_SPLITMIX64; e++)
+  {
+    R.setEngine(e);
+    Serial.print(names[e]);
+    Serial.print(strlen(names[e]) < 8 ? "\t\t" : "\t");
+
+    start = micros();
+    for (uint32_t i = 0; i < runs; i++) x = R.getrandbits(32);
+    stop = micros();
+    Serial.print(stop - start);
+    Serial.print("\t");
+
+    start = micros();
+    for (uint32_t i = 0; i < runs; i++) x = R.randrange(1000);
+    stop = micros();
+    Serial.print(stop - start);
+    Serial.print("\t");
+
+    start = micros();
+    for (uint32_t i = 0; i < runs; i++) f = R.normalvariate();
+    stop = micros();
+    Serial.print(stop - start);
+    Serial.print("\t");
+
+    start = micros();
+    for (uint32_t i = 0; i < runs; i++) f = R.zignormal();
+    stop = micros();
+    Serial.print(stop - start);
+    Serial.print("\t");
+
+    start = micros();
+    for (uint32_t i = 0; i < runs; i++) f = R.expovariate(1);
+    stop = micros();
+    Serial.print(stop - start);
+    Serial.print("\t");
+
+    start = micros();
+    for (uint32_t i = 0; i < runs; i++) f = R.zigexpo(1);
+    stop = micros();
+    Serial.print(stop - start);
+    Serial.print("\t");
+
+    start = micros();
+    for (uint32_t i = 0; i < runs; i += 100) R.fillNormal(buffer, 100);
+    stop = micros();
+    Serial.println(stop - start);
+  }
+
+  //  independent streams, e.g. one per thread / task.
+  Serial.println();
+  Serial.println(F("xoshiro256** streams after jump()"));
+  Prandom stream[4];
+  for (int s = 0; s < 4; s++)
+  {
+    stream[s].seed(42);
+    stream[s].setEngine(PRANDOM_XOSHIRO256SS);
+    for (int j = 0; j < s; j++) stream[s].jump();
+    Serial.print(s);
+    Serial.print("\t");
+    Serial.println(stream[s].getrandbits(32), HEX);
+  }
+
+  Serial.println("\nDone...");
+}
+
+
+void loop()
+{
+}
+
+
+//  -- END OF FILE --
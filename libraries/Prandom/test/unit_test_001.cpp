@@ -69,6 +69,180 @@ unittest(test_constructor)
 }
 
 
+unittest(test_engines)
+{
+  Prandom R(42);
+  Prandom S(42);
+
+  assertEqual(PRANDOM_MARSAGLIA, R.getEngine());
+  for (uint8_t e = PRANDOM_MARSAGLIA; e <= PRANDOM_SPLITMIX64; e++)
+  {
+    R.setEngine(e);
+    S.setEngine(e);
+    assertEqual(e, R.getEngine());
+    //  same seed, same sequence
+    for (int i = 0; i < 100; i++)
+    {
+      assertEqual(S.getrandbits(32), R.getrandbits(32));
+    }
+  }
+  R.setEngine(42);
+  assertEqual(PRANDOM_MARSAGLIA, R.getEngine());
+}
+
+
+unittest(test_advance_jump)
+{
+  Prandom R;
+  Prandom S;
+  R.seed(355, 113);
+  S.seed(355, 113);
+
+  R.setEngine(PRANDOM_MARSAGLIA);
+  assertFalse(R.jump());
+  assertFalse(R.advance(10));
+
+  uint8_t engines[2] = { PRANDOM_PCG32, PRANDOM_SPLITMIX64 };
+  for (int e = 0; e < 2; e++)
+  {
+    R.setEngine(engines[e]);
+    S.setEngine(engines[e]);
+    for (int i = 0; i < 1000; i++) R.getrandbits(32);
+    assertTrue(S.advance(1000));
+    for (int i = 0; i < 10; i++)
+    {
+      assertEqual(R.getrandbits(32), S.getrandbits(32));
+    }
+  }
+
+  //  jumped streams differ
+  R.setEngine(PRANDOM_XOSHIRO256SS);
+  S.setEngine(PRANDOM_XOSHIRO256SS);
+  assertTrue(S.jump());
+  int same = 0;
+  for (int i = 0; i < 100; i++)
+  {
+    if (R.getrandbits(32) == S.getrandbits(32)) same++;
+  }
+  assertEqual(0, same);
+}
+
+
+unittest(test_randrange_uniform)
+{
+  Prandom R(12345);
+  R.setEngine(PRANDOM_PCG32);
+
+  //  Lemire bounded integer
+  uint32_t hist[10] = {0};
+  for (int i = 0; i < 100000; i++)
+  {
+    uint32_t v = R.randrange(10);
+    assertLess(v, 10);
+    hist[v]++;
+  }
+  for (int i = 0; i < 10; i++)
+  {
+    //  expected 10000, sigma ~95
+    assertLess(9500, hist[i]);
+    assertMore(10500, hist[i]);
+  }
+  assertEqual(0, R.randrange(0));
+  uint32_t big = R.randrange(0xF0000000);
+  assertLess(big, 0xF0000000);
+
+  for (int i = 0; i < 100; i++)
+  {
+    assertLess(R.getrandbits(7), 128);
+  }
+}
+
+
+unittest(test_ziggurat)
+{
+  Prandom R(42);
+  R.setEngine(PRANDOM_XOSHIRO256SS);
+
+  const int N = 100000;
+  double sum = 0, sum2 = 0;
+  for (int i = 0; i < N; i++)
+  {
+    float x = R.zignormal(2, 3);
+    sum += x;
+    sum2 += x * x;
+  }
+  double mean = sum / N;
+  double var  = sum2 / N - mean * mean;
+  assertEqualFloat(2.0, mean, 0.05);
+  assertEqualFloat(9.0, var, 0.2);
+
+  sum = 0;
+  sum2 = 0;
+  for (int i = 0; i < N; i++)
+  {
+    float x = R.zigexpo(2);
+    assertMoreOrEqual(x, 0);
+    sum += x;
+    sum2 += x * x;
+  }
+  mean = sum / N;
+  var  = sum2 / N - mean * mean;
+  assertEqualFloat(0.5, mean, 0.01);
+  assertEqualFloat(0.25, var, 0.01);
+}
+
+
+unittest(test_fill)
+{
+  Prandom R(7);
+  Prandom S(7);
+  uint32_t a[64];
+  float    f[64];
+
+  R.fill(a, 64);
+  for (int i = 0; i < 64; i++)
+  {
+    assertEqual(S.getrandbits(32), a[i]);
+  }
+
+  R.fill(f, 64, 10, 20);
+  for (int i = 0; i < 64; i++)
+  {
+    assertMoreOrEqual(f[i], 10);
+    assertLessOrEqual(f[i], 20);
+  }
+
+  R.fillNormal(f, 64, 100, 1);
+  for (int i = 0; i < 64; i++)
+  {
+    assertEqualFloat(100, f[i], 10);
+  }
+
+  R.fillExpo(f, 64, 1);
+  for (int i = 0; i < 64; i++)
+  {
+    assertMoreOrEqual(f[i], 0);
+  }
+}
+
+
+unittest(test_gauss_per_instance)
+{
+  Prandom R(1);
+  Prandom S(1);
+  Prandom T(1);
+
+  //  interleaved calls on another instance do not change the sequence.
+  float r1 = R.gauss();
+  float r2 = R.gauss();
+  float s1 = S.gauss();
+  T.gauss();
+  float s2 = S.gauss();
+  assertEqual(r1, s1);
+  assertEqual(r2, s2);
+}
+
+
 unittest_main()
 
 // --------
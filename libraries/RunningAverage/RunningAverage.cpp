@@ -1,7 +1,7 @@
 //
 //    FILE: RunningAverage.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.4.3
+// VERSION: 0.4.5
 //    DATE: 2015-July-10
 // PURPOSE: Arduino library to calculate the running average by means of a circular buffer
 //     URL: https://github.com/RobTillaart/RunningAverage
@@ -35,6 +35,7 @@ void RunningAverage::clear()
   _count = 0;
   _index = 0;
   _sum = 0.0;
+  _sumError = 0.0;
   _min = NAN;
   _max = NAN;
   for (uint16_t i = _size; i > 0; )
@@ -52,9 +53,9 @@ void RunningAverage::addValue(const float value)
     return;
   }
 
-  _sum -= _array[_index];
+  _addToSum(-_array[_index]);
   _array[_index] = value;
-  _sum += _array[_index];
+  _addToSum(value);
   _index++;
 
   if (_index == _partial) _index = 0;  // faster than %
@@ -78,11 +79,12 @@ float RunningAverage::getAverage()
   }
   //  OPTIMIZE local variable for sum.
   _sum = 0;
+  _sumError = 0;
   for (uint16_t i = 0; i < _count; i++)
   {
-    _sum += _array[i];
+    _addToSum(_array[i]);
   }
-  return _sum / _count;   // multiplication is faster ==> extra admin
+  return (_sum + _sumError) / _count;   // multiplication is faster ==> extra admin
 }
 
 
@@ -95,7 +97,7 @@ float RunningAverage::getFastAverage() const
     return NAN;
   }
 
-  return _sum / _count;   //  multiplication is faster ==> extra admin
+  return (_sum + _sumError) / _count;   //  multiplication is faster ==> extra admin
 }
 
 
@@ -334,5 +336,27 @@ float RunningAverage::getAverageSubset(uint16_t start, uint16_t count)
 }
 
 
+////////////////////////////////////////////////////////////////
+//
+//  PROTECTED
+//
+//  Neumaier summation, collects the rounding error of every
+//  addition in _sumError and folds it back into _sum so the
+//  error term stays small. Does not work with -ffast-math.
+void RunningAverage::_addToSum(const float value)
+{
+  if (_compensation == false)
+  {
+    _sum += value;
+    return;
+  }
+  float t = _sum + value;
+  if (fabs(_sum) >= fabs(value)) _sumError += (_sum - t) + value;
+  else                           _sumError += (value - t) + _sum;
+  _sum = t + _sumError;
+  _sumError -= _sum - t;
+}
+
+
 // -- END OF FILE --
 
@@ -2,7 +2,7 @@
 //
 //    FILE: RunningAverage.h
 //  AUTHOR: Rob.Tillaart@gmail.com
-// VERSION: 0.4.3
+// VERSION: 0.4.5
 //    DATE: 2016-dec-01
 // PURPOSE: Arduino library to calculate the running average by means of a circular buffer
 //     URL: https://github.com/RobTillaart/RunningAverage
@@ -11,16 +11,18 @@
 #include "Arduino.h"
 
 
-#define RUNNINGAVERAGE_LIB_VERSION    (F("0.4.3"))
+#define RUNNINGAVERAGE_LIB_VERSION    (F("0.4.5"))
 
 
 class RunningAverage
 {
 public:
   explicit RunningAverage(const uint16_t size);
-  ~RunningAverage();
+  virtual ~RunningAverage();
 
-  void     clear();
+  //  virtual so RunningAverageSPSC also resets its queue
+  //  when called through a RunningAverage reference.
+  virtual void clear();
   void     add(const float value)    { addValue(value); };
   void     addValue(const float value);
   void     fillValue(const float value, const uint16_t number);
@@ -64,15 +66,26 @@ public:
   float    getAverageSubset(uint16_t start, uint16_t count);
 
 
+  //  compensated (Neumaier) summation keeps getFastAverage() drift free
+  //  so getAverage() does not need to be called periodically.
+  //  costs a few float operations per addValue().
+  void     setCompensation(bool compensation = true) { _compensation = compensation; _sumError = 0; };
+  bool     getCompensation() { return _compensation; };
+
+
 protected:
   uint16_t _size;
   uint16_t _count;
   uint16_t _index;
   uint16_t _partial;
   float    _sum;
+  float    _sumError;     //  rounding error of _sum if compensation is used
+  bool     _compensation = false;
   float*   _array;
   float    _min;
   float    _max;
+
+  void     _addToSum(const float value);
 };
 
 
@@ -0,0 +1,288 @@
+//
+//    FILE: RunningAverageSPSC.cpp
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: RunningAverage with a lock free queue for samples from an ISR or other core.
+//     URL: https://github.com/RobTillaart/RunningAverage
+
+
+#include "RunningAverageSPSC.h"
+
+
+//  AVR is single core, only the compiler must not reorder.
+#if defined(ARDUINO_ARCH_AVR)
+#define RA_FENCE()      __asm__ __volatile__ ("" ::: "memory")
+#else
+#define RA_FENCE()      __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+
+RunningAverageSPSC::RunningAverageSPSC(const uint16_t size, const uint8_t queueSize) : RunningAverage(size)
+{
+  _queueSize = 2;
+  while ((_queueSize < queueSize) && (_queueSize < RUNNINGAVERAGE_SPSC_MAX_QUEUE))
+  {
+    _queueSize <<= 1;
+  }
+  _mask  = _queueSize - 1;
+  _queue = (float *) malloc(_queueSize * sizeof(float));
+  if (_queue == NULL) _queueSize = 0;
+  _head      = 0;
+  _tail      = 0;
+  _dropCount = 0;
+  _dropSeen  = 0;
+  _dropped   = 0;
+  _seq       = 0;
+}
+
+
+RunningAverageSPSC::~RunningAverageSPSC()
+{
+  if (_queue != NULL) free(_queue);
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//  PRODUCER
+//
+bool RunningAverageSPSC::push(const float value)
+{
+  uint8_t head = _head;
+  //  free running 8 bit indices, difference is the fill level.
+  if ((uint8_t)(head - _tail) >= _queueSize)
+  {
+    _dropCount = _dropCount + 1;
+    return false;
+  }
+  _queue[head & _mask] = value;
+  RA_FENCE();   //  value must be visible before head.
+  _head = head + 1;
+  return true;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//  CONSUMER
+//
+uint8_t RunningAverageSPSC::process(uint8_t maxCount)
+{
+  uint8_t tail = _tail;
+  uint8_t n = _head - tail;
+  RA_FENCE();   //  read head before the values.
+  if (n > maxCount) n = maxCount;
+
+  //  fold the drops, the 8 bit counter may wrap between calls.
+  uint8_t drops = _dropCount;
+  _dropped += (uint8_t)(drops - _dropSeen);
+  _dropSeen = drops;
+
+  if (n == 0) return 0;
+
+  _writeBegin();
+  for (uint8_t i = 0; i < n; i++)
+  {
+    addValue(_queue[(tail + i) & _mask]);
+  }
+  _writeEnd();
+
+  RA_FENCE();   //  values read before the slots are released.
+  _tail = tail + n;
+  return n;
+}
+
+
+void RunningAverageSPSC::clear()
+{
+  _writeBegin();
+  RunningAverage::clear();
+  _writeEnd();
+  _tail = _head;
+  _dropSeen = _dropCount;
+  _dropped = 0;
+}
+
+
+uint8_t RunningAverageSPSC::available() const
+{
+  return _head - _tail;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//  READERS
+//
+float RunningAverageSPSC::getFastAverage() const
+{
+  float value;
+  ra_seq_t seq;
+  do
+  {
+    seq = _readBegin();
+    value = RunningAverage::getFastAverage();
+  }
+  while (_readRetry(seq));
+  return value;
+}
+
+
+float RunningAverageSPSC::getStandardDeviation() const
+{
+  float value;
+  ra_seq_t seq;
+  do
+  {
+    seq = _readBegin();
+    value = RunningAverage::getStandardDeviation();
+  }
+  while (_readRetry(seq));
+  return value;
+}
+
+
+float RunningAverageSPSC::getStandardError() const
+{
+  float value;
+  ra_seq_t seq;
+  do
+  {
+    seq = _readBegin();
+    value = RunningAverage::getStandardError();
+  }
+  while (_readRetry(seq));
+  return value;
+}
+
+
+float RunningAverageSPSC::getMin() const
+{
+  float value;
+  ra_seq_t seq;
+  do
+  {
+    seq = _readBegin();
+    value = _min;
+  }
+  while (_readRetry(seq));
+  return value;
+}
+
+
+float RunningAverageSPSC::getMax() const
+{
+  float value;
+  ra_seq_t seq;
+  do
+  {
+    seq = _readBegin();
+    value = _max;
+  }
+  while (_readRetry(seq));
+  return value;
+}
+
+
+float RunningAverageSPSC::getMinInBuffer() const
+{
+  float value;
+  ra_seq_t seq;
+  do
+  {
+    seq = _readBegin();
+    value = RunningAverage::getMinInBuffer();
+  }
+  while (_readRetry(seq));
+  return value;
+}
+
+
+float RunningAverageSPSC::getMaxInBuffer() const
+{
+  float value;
+  ra_seq_t seq;
+  do
+  {
+    seq = _readBegin();
+    value = RunningAverage::getMaxInBuffer();
+  }
+  while (_readRetry(seq));
+  return value;
+}
+
+
+uint16_t RunningAverageSPSC::getCount() const
+{
+  uint16_t value;
+  ra_seq_t seq;
+  do
+  {
+    seq = _readBegin();
+    value = _count;
+  }
+  while (_readRetry(seq));
+  return value;
+}
+
+
+uint16_t RunningAverageSPSC::getSnapshot(float &average, float &minimum, float &maximum) const
+{
+  uint16_t count;
+  ra_seq_t seq;
+  do
+  {
+    seq = _readBegin();
+    count   = _count;
+    average = RunningAverage::getFastAverage();
+    minimum = _min;
+    maximum = _max;
+  }
+  while (_readRetry(seq));
+  return count;
+}
+
+
+////////////////////////////////////////////////////////////////
+//
+//  SEQUENCE LOCK
+//
+//  The consumer makes _seq odd before and even after an update.
+//  A reader retries if _seq was odd or changed during the read.
+//
+void RunningAverageSPSC::_writeBegin()
+{
+  _seq = _seq + 1;
+  RA_FENCE();
+}
+
+
+void RunningAverageSPSC::_writeEnd()
+{
+  RA_FENCE();
+  _seq = _seq + 1;
+}
+
+
+ra_seq_t RunningAverageSPSC::_readBegin() const
+{
+  ra_seq_t seq;
+  do
+  {
+    seq = _seq;
+  }
+  while (seq & 1);
+  RA_FENCE();
+  return seq;
+}
+
+
+bool RunningAverageSPSC::_readRetry(ra_seq_t seq) const
+{
+  RA_FENCE();
+  return (seq != _seq);
+}
+
+
+// -- END OF FILE --
+
@@ -0,0 +1,87 @@
+#pragma once
+//
+//    FILE: RunningAverageSPSC.h
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: RunningAverage with a lock free queue for samples from an ISR or other core.
+//     URL: https://github.com/RobTillaart/RunningAverage
+//
+//  One producer (ISR, DMA callback, second core) calls push(),
+//  one consumer (typically loop()) calls process() to fold the
+//  queued samples into the running average.
+//  The getters below retry until they have read a consistent snapshot
+//  (sequence lock). They may be called from the consumer, another thread
+//  or another core, but NOT from an ISR (or higher priority task on the
+//  same core) that can preempt process(), that reader would spin forever.
+
+
+#include "RunningAverage.h"
+
+
+//  max queue size, queue indices are 8 bit so they are atomic on every platform.
+#define RUNNINGAVERAGE_SPSC_MAX_QUEUE     128
+
+
+//  sequence counter, 8 bit on AVR (single core), 32 bit otherwise.
+#if defined(ARDUINO_ARCH_AVR)
+typedef uint8_t  ra_seq_t;
+#else
+typedef uint32_t ra_seq_t;
+#endif
+
+
+class RunningAverageSPSC : public RunningAverage
+{
+public:
+  //  queueSize is rounded up to a power of 2, 2..128
+  explicit RunningAverageSPSC(const uint16_t size, const uint8_t queueSize = 16);
+  ~RunningAverageSPSC();
+
+  //  PRODUCER - wait free, no critical section.
+  //  returns false if the queue is full, the sample is dropped.
+  bool     push(const float value);
+
+  //  CONSUMER - folds at most maxCount queued samples into the average.
+  //  returns the number of samples folded.
+  uint8_t  process(uint8_t maxCount = 255);
+  //  discards the queue and clears the running average.
+  void     clear() override;
+  //  number of samples waiting in the queue.
+  uint8_t  available() const;
+  uint8_t  getQueueSize() const { return _queueSize; };
+  //  number of samples dropped because the queue was full, updated by process().
+  uint32_t getDropped() const   { return _dropped; };
+
+  //  READERS - consistent snapshot, not from an ISR that can preempt process().
+  float    getFastAverage() const;
+  float    getStandardDeviation() const;
+  float    getStandardError() const;
+  float    getMin() const;
+  float    getMax() const;
+  float    getMinInBuffer() const;
+  float    getMaxInBuffer() const;
+  uint16_t getCount() const;
+  //  average, min and max in one snapshot, returns count.
+  uint16_t getSnapshot(float &average, float &minimum, float &maximum) const;
+
+
+protected:
+  float *           _queue;
+  uint8_t           _queueSize;
+  uint8_t           _mask;
+  volatile uint8_t  _head;       //  written by producer only
+  volatile uint8_t  _tail;       //  written by consumer only
+  volatile uint8_t  _dropCount;  //  written by producer only, wraps
+  uint8_t           _dropSeen;
+  uint32_t          _dropped;
+  volatile ra_seq_t _seq;        //  odd while the consumer updates
+
+  void     _writeBegin();
+  void     _writeEnd();
+  ra_seq_t _readBegin() const;
+  bool     _readRetry(ra_seq_t seq) const;
+};
+
+
+// -- END OF FILE --
+
@@ -0,0 +1,66 @@
+//
+//    FILE: ra_spsc_isr.ino
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PUPROSE: show RunningAverageSPSC with samples pushed from an ISR
+//     URL: https://github.com/RobTillaart/RunningAverage
+//
+//  connect a pulse source to pin 2,
+//  the ISR pushes the time between pulses, no noInterrupts() needed.
+
+
+#include "RunningAverageSPSC.h"
+
+
+RunningAverageSPSC RA(50, 32);
+
+volatile uint32_t lastPulse = 0;
+
+const uint8_t PULSE_PIN = 2;
+
+
+void pulseISR()
+{
+  uint32_t now = micros();
+  RA.push(now - lastPulse);
+  lastPulse = now;
+}
+
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("Version: ");
+  Serial.println(RUNNINGAVERAGE_LIB_VERSION);
+
+  pinMode(PULSE_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(PULSE_PIN), pulseISR, RISING);
+}
+
+
+void loop(void)
+{
+  //  fold all queued samples into the average.
+  RA.process();
+
+  static uint32_t lastPrint = 0;
+  if (millis() - lastPrint >= 1000)
+  {
+    lastPrint = millis();
+    float average, minimum, maximum;
+    uint16_t count = RA.getSnapshot(average, minimum, maximum);
+    Serial.print(count);
+    Serial.print("\t");
+    Serial.print(average);
+    Serial.print("\t");
+    Serial.print(minimum);
+    Serial.print("\t");
+    Serial.print(maximum);
+    Serial.print("\t");
+    Serial.println(RA.getDropped());
+  }
+}
+
+
+// -- END OF FILE --
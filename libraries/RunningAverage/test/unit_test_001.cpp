@@ -34,6 +34,10 @@
 
 #include "Arduino.h"
 #include "RunningAverage.h"
+#include "RunningAverageSPSC.h"
+
+#include <atomic>
+#include <thread>
 
 
 unittest_setup()
@@ -173,6 +177,178 @@ unittest(test_last)
 }
 
 
+unittest(test_compensation)
+{
+  RunningAverage myRA(100);
+  assertFalse(myRA.getCompensation());
+  myRA.setCompensation();
+  assertTrue(myRA.getCompensation());
+
+  //  large offset, small noise, many removals.
+  uint32_t seed = 42;
+  for (uint32_t i = 0; i < 200000; i++)
+  {
+    seed = seed * 1103515245 + 12345;
+    myRA.add(10000.0 + (seed >> 16) * 0.0001);
+  }
+  double sum = 0;
+  for (uint16_t i = 0; i < 100; i++) sum += myRA.getElement(i);
+  assertEqualFloat(sum / 100, myRA.getFastAverage(), 0.002);
+  assertEqualFloat(myRA.getAverage(), myRA.getFastAverage(), 0.002);
+}
+
+
+unittest(test_spsc_queue)
+{
+  RunningAverageSPSC myRA(10, 12);
+  assertEqual(16, myRA.getQueueSize());
+  assertEqual(0, myRA.available());
+  assertEqual(0, myRA.process());
+  assertNAN(myRA.getFastAverage());
+
+  for (int i = 0; i < 16; i++)
+  {
+    assertTrue(myRA.push(i));
+  }
+  assertEqual(16, myRA.available());
+  //  queue full, samples are dropped.
+  assertFalse(myRA.push(100));
+  assertFalse(myRA.push(100));
+  assertEqual(0, myRA.getCount());
+
+  //  fold in two batches
+  assertEqual(4, myRA.process(4));
+  assertEqual(12, myRA.available());
+  assertEqual(2, myRA.getDropped());
+  assertEqual(12, myRA.process());
+  assertEqual(0, myRA.available());
+
+  //  same result as adding directly.
+  RunningAverage ref(10);
+  for (int i = 0; i < 16; i++) ref.add(i);
+  assertEqual(ref.getCount(), myRA.getCount());
+  assertEqualFloat(ref.getFastAverage(), myRA.getFastAverage(), 0.0001);
+  assertEqualFloat(ref.getStandardDeviation(), myRA.getStandardDeviation(), 0.0001);
+  assertEqualFloat(0, myRA.getMin(), 0.0001);
+  assertEqualFloat(15, myRA.getMax(), 0.0001);
+  assertEqualFloat(6, myRA.getMinInBuffer(), 0.0001);
+  assertEqualFloat(15, myRA.getMaxInBuffer(), 0.0001);
+
+  float avg, mi, ma;
+  assertEqual(10, myRA.getSnapshot(avg, mi, ma));
+  assertEqualFloat(10.5, avg, 0.0001);
+  assertEqualFloat(0, mi, 0.0001);
+  assertEqualFloat(15, ma, 0.0001);
+
+  myRA.push(1);
+  myRA.clear();
+  assertEqual(0, myRA.available());
+  assertEqual(0, myRA.getCount());
+  assertEqual(0, myRA.getDropped());
+}
+
+
+unittest(test_spsc_wrap)
+{
+  RunningAverageSPSC myRA(100, 128);
+  assertEqual(128, myRA.getQueueSize());
+
+  //  indices wrap many times.
+  float sum = 0;
+  for (int i = 0; i < 1000; i++)
+  {
+    assertTrue(myRA.push(i));
+    if (i >= 900) sum += i;
+    if (i % 7 == 0) myRA.process();
+  }
+  myRA.process();
+  assertEqual(100, myRA.getCount());
+  assertEqualFloat(sum / 100, myRA.getFastAverage(), 0.01);
+  assertEqual(0, myRA.getDropped());
+}
+
+
+unittest(test_spsc_clear_base)
+{
+  RunningAverageSPSC myRA(10, 16);
+  myRA.push(1);
+  myRA.push(2);
+  myRA.process(1);
+  assertEqual(1, myRA.available());
+
+  //  clear() is virtual, the queue is discarded too.
+  RunningAverage &base = myRA;
+  base.clear();
+  assertEqual(0, myRA.available());
+  assertEqual(0, myRA.getCount());
+}
+
+
+unittest(test_spsc_threads)
+{
+  //  producer, consumer and reader each in their own thread.
+  const uint32_t N = 20000;
+  RunningAverageSPSC myRA(10, 16);
+  std::atomic<bool> done(false);
+  std::atomic<uint32_t> errors(0);
+  std::atomic<uint32_t> snapshots(0);
+  uint32_t retries = 0;
+
+  std::thread producer([&]()
+  {
+    for (uint32_t i = 1; i <= N; i++)
+    {
+      //  a full queue counts as dropped, retry until accepted.
+      while (!myRA.push(i))
+      {
+        retries++;
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::thread consumer([&]()
+  {
+    uint32_t folded = 0;
+    while (folded < N)
+    {
+      uint8_t n = myRA.process();
+      if (n == 0) std::this_thread::yield();
+      folded += n;
+    }
+    done = true;
+  });
+
+  //  values arrive in order 1..N, so every consistent snapshot
+  //  holds the last count values, min 1 and max == newest.
+  std::thread reader([&]()
+  {
+    while (!done)
+    {
+      float avg, mi, ma;
+      uint16_t count = myRA.getSnapshot(avg, mi, ma);
+      if ((++snapshots & 63) == 0) std::this_thread::yield();
+      if (count == 0) continue;
+      if (count > 10) errors++;
+      if (mi != 1) errors++;
+      if (fabs(avg - (ma - (count - 1) * 0.5)) > 0.01) errors++;
+    }
+  });
+
+  producer.join();
+  consumer.join();
+  reader.join();
+
+  fprintf(stderr, "snapshots: %u\tretries: %u\n", (unsigned) snapshots, (unsigned) retries);
+  assertEqual(0, (uint32_t) errors);
+  assertEqual(0, myRA.available());
+  assertEqual(retries, myRA.getDropped());
+  assertEqual(10, myRA.getCount());
+  assertEqualFloat(N, myRA.getMax(), 0.0001);
+  assertEqualFloat(N - 4.5, myRA.getFastAverage(), 0.01);
+}
+
+
 unittest_main()
 
 
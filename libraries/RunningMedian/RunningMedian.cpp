@@ -1,7 +1,7 @@
 //
 //    FILE: RunningMedian.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.3.7
+// VERSION: 0.4.0
 // PURPOSE: RunningMedian library for Arduino
 //
 //  HISTORY: see changelog.md
@@ -10,17 +10,17 @@
 #include "RunningMedian.h"
 
 
-RunningMedian::RunningMedian(const uint8_t size)
+RunningMedian::RunningMedian(const median_index_t size)
 {
   _size = size;
   if (_size < MEDIAN_MIN_SIZE) _size = MEDIAN_MIN_SIZE;
-#if !RUNNING_MEDIAN_USE_MALLOC
   if (_size > MEDIAN_MAX_SIZE) _size = MEDIAN_MAX_SIZE;
-#endif
 
 #if RUNNING_MEDIAN_USE_MALLOC
-  _values = (float *) malloc(_size * sizeof(float));
-  _sortIdx  = (uint8_t *) malloc(_size * sizeof(uint8_t));
+  _values  = (float *) malloc(_size * sizeof(float));
+  _left    = (median_index_t *) malloc(_size * sizeof(median_index_t));
+  _right   = (median_index_t *) malloc(_size * sizeof(median_index_t));
+  _subSize = (median_index_t *) malloc(_size * sizeof(median_index_t));
 #endif
   clear();
 }
@@ -30,7 +30,9 @@ RunningMedian::~RunningMedian()
 {
   #if RUNNING_MEDIAN_USE_MALLOC
   free(_values);
-  free(_sortIdx);
+  free(_left);
+  free(_right);
+  free(_subSize);
   #endif
 }
 
@@ -40,22 +42,33 @@ void RunningMedian::clear()
 {
   _count = 0;
   _index = 0;
-  _sorted = false;
-  for (uint8_t i = 0; i < _size; i++)
-  {
-    _sortIdx[i] = i;
-  }
+  _root  = MEDIAN_NIL;
+  _medianValid = false;
 }
 
 
 //  adds a new value to the data-set
 //  or overwrites the oldest if full.
+//  the oldest is removed from the tree before its value is overwritten.
 void RunningMedian::add(float value)
 {
-  _values[_index++] = value;
-  if (_index >= _size) _index = 0; //  wrap around
-  if (_count < _size) _count++;
-  _sorted = false;
+  if (_count == _size)
+  {
+    _root = _erase(_root, _index);
+  }
+  else
+  {
+    _count++;
+  }
+  _values[_index] = value;
+  _left[_index]    = MEDIAN_NIL;
+  _right[_index]   = MEDIAN_NIL;
+  _subSize[_index] = 1;
+  _root = _insert(_root, _index);
+
+  _index++;
+  if (_index >= _size) _index = 0;  //  wrap around
+  _medianValid = false;
 }
 
 
@@ -63,13 +76,19 @@ float RunningMedian::getMedian()
 {
   if (_count == 0) return NAN;
 
-  if (_sorted == false) sort();
-
-  if (_count & 0x01)  //  is it odd sized?
+  if (_medianValid == false)
   {
-    return _values[_sortIdx[_count / 2]];
+    if (_count & 0x01)  //  is it odd sized?
+    {
+      _median = _kth(_count / 2);
+    }
+    else
+    {
+      _median = (_kth(_count / 2) + _kth(_count / 2 - 1)) / 2;
+    }
+    _medianValid = true;
   }
-  return (_values[_sortIdx[_count / 2]] + _values[_sortIdx[_count / 2 - 1]]) / 2;
+  return _median;
 }
 
 
@@ -79,15 +98,14 @@ float RunningMedian::getQuantile(float quantile)
 
   if ((quantile < 0) || (quantile > 1)) return NAN;
 
-  if (_sorted == false) sort();
-
   const float index = (_count - 1) * quantile;
-  const uint8_t lo  = floor(index);
-  const uint8_t hi  = ceil(index);
-  const float qs    = _values[_sortIdx[lo]];
+  const median_index_t lo = floor(index);
+  const median_index_t hi = ceil(index);
+  const float qs    = _kth(lo);
   const float h     = (index - lo);
 
-  return (1.0 - h) * qs + h * _values[_sortIdx[hi]];
+  if (hi == lo) return qs;
+  return (1.0 - h) * qs + h * _kth(hi);
 }
 
 
@@ -96,7 +114,7 @@ float RunningMedian::getAverage()
   if (_count == 0) return NAN;
 
   float sum = 0;
-  for (uint8_t i = 0; i < _count; i++)
+  for (median_index_t i = 0; i < _count; i++)
   {
     sum += _values[i];
   }
@@ -104,32 +122,30 @@ float RunningMedian::getAverage()
 }
 
 
-float RunningMedian::getAverage(uint8_t nMedians)
+float RunningMedian::getAverage(median_index_t nMedians)
 {
   if ((_count == 0) || (nMedians == 0)) return NAN;
 
 //  when filling the array for first time
   if (_count < nMedians) nMedians = _count;
 
-  uint8_t start = ((_count - nMedians) / 2);
-  uint8_t stop = start + nMedians;
-
-  if (_sorted == false) sort();
+  median_index_t start = ((_count - nMedians) / 2);
+  median_index_t stop = start + nMedians;
 
   float sum = 0;
-  for (uint8_t i = start; i < stop; i++)
+  for (median_index_t i = start; i < stop; i++)
   {
-    sum += _values[_sortIdx[i]];
+    sum += _kth(i);
   }
   return sum / nMedians;
 }
 
 
-float RunningMedian::getElement(const uint8_t n)
+float RunningMedian::getElement(const median_index_t n)
 {
   if ((_count == 0) || (n >= _count)) return NAN;
 
-  uint8_t pos = _index + n;
+  median_index_t pos = _index + n;
   if (pos >= _count)  //  faster than %
   {
     pos -= _count;
@@ -138,29 +154,28 @@ float RunningMedian::getElement(const uint8_t n)
 }
 
 
-float RunningMedian::getSortedElement(const uint8_t n)
+float RunningMedian::getSortedElement(const median_index_t n)
 {
   if ((_count == 0) || (n >= _count)) return NAN;
 
-  if (_sorted == false) sort();
-  return _values[_sortIdx[n]];
+  return _kth(n);
 }
 
 
 //  n can be max <= half the (filled) size
-float RunningMedian::predict(const uint8_t n)
+float RunningMedian::predict(const median_index_t n)
 {
-  uint8_t mid = _count / 2;
+  median_index_t mid = _count / 2;
   if ((_count == 0) || (n >= mid)) return NAN;
 
-  float med = getMedian();  //  takes care of sorting !
+  float med = getMedian();
   if (_count & 0x01)        //  odd # elements
   {
-    return max(med - _values[_sortIdx[mid - n]], _values[_sortIdx[mid + n]] - med);
+    return max(med - _kth(mid - n), _kth(mid + n) - med);
   }
   //  even # elements
-  float f1 = (_values[_sortIdx[mid - n]] + _values[_sortIdx[mid - n - 1]]) / 2;
-  float f2 = (_values[_sortIdx[mid + n]] + _values[_sortIdx[mid + n - 1]]) / 2;
+  float f1 = (_kth(mid - n) + _kth(mid - n - 1)) / 2;
+  float f2 = (_kth(mid + n) + _kth(mid + n - 1)) / 2;
   return max(med - f1, f2 - med) / 2;
 }
 
@@ -182,152 +197,149 @@ uint8_t RunningMedian::getSearchMode()
 //
 //  PRIVATE
 //
+//  The elements are kept sorted in a treap, a binary search tree
+//  that is balanced by a pseudo random priority per node.
+//  Every slot of the ring buffer is a node, so no extra allocation
+//  is needed and the oldest element is found by its slot _index.
+//  Expected depth is O(log n) so add() and _kth() are O(log n).
+//
 
-//  insertion sort - _searchMode = linear or binary.
+//  fixed pseudo random priority per slot (murmur3 finalizer).
+static uint32_t _priority(uint32_t x)
+{
+  x ^= x >> 16;
+  x *= 0x85EBCA6B;
+  x ^= x >> 13;
+  x *= 0xC2B2AE35;
+  x ^= x >> 16;
+  return x;
+}
 
-void RunningMedian::sort()
+
+//  strict ordering on value, NAN sorts above all numbers,
+//  equal values are ordered by slot to make every node unique.
+bool RunningMedian::_less(median_index_t a, median_index_t b)
 {
-  uint16_t lo   = 0;
-  uint16_t hi   = 0;
-  uint16_t mi   = 0;
-  uint16_t temp = 0;
+  float fa = _values[a];
+  float fb = _values[b];
+  if (fa < fb) return true;
+  if (fb < fa) return false;
+  bool na = isnan(fa);
+  bool nb = isnan(fb);
+  if (na != nb) return nb;
+  return a < b;
+}
 
-  for (uint16_t i = 1; i < _count; i++)
-  {
-    temp = _sortIdx[i];
-    float f = _values[temp];
 
-    //  handle special case f is smaller than all elements first.
-    //  only one compare needed, improves linear search too.
-    if (f <= _values[_sortIdx[0]])
-    {
-      hi = 0;
-    }
-    else
-    {
-      if (_searchMode == 0)
-      {
-        hi = i;
-        //  find insertion point with linear search
-        while ((hi > 0) && (f < _values[_sortIdx[hi - 1]]))
-        {
-          hi--;
-        }
-      }
-      else if (_searchMode == 1)
-      {
-        //  find insertion point with binary search
-        lo = 0;
-        hi = i;
-        //  be aware there might be duplicates
-        while (hi - lo > 1)
-        {
-          mi = (lo + hi) / 2;
-          if (f < _values[_sortIdx[mi]])
-          {
-            hi = mi;
-          }
-          else
-          {
-            lo = mi;
-          }
-        }
-      }
-    }
+void RunningMedian::_updateSize(median_index_t tree)
+{
+  median_index_t sz = 1;
+  if (_left[tree]  != MEDIAN_NIL) sz += _subSize[_left[tree]];
+  if (_right[tree] != MEDIAN_NIL) sz += _subSize[_right[tree]];
+  _subSize[tree] = sz;
+}
 
-    //  move elements to make space
-    uint16_t k = i;
-    while (k > hi)
-    {
-      _sortIdx[k] = _sortIdx[k - 1];
-      k--;
-    }
 
-    //  insert at right spot.
-    _sortIdx[k] = temp;
+median_index_t RunningMedian::_rotateLeft(median_index_t tree)
+{
+  median_index_t r = _right[tree];
+  _right[tree] = _left[r];
+  _left[r] = tree;
+  _updateSize(tree);
+  _updateSize(r);
+  return r;
+}
 
-  }
-  _sorted = true;
-
-  // //  verify sorted
-  // for (int i = 0; i < _count; i++)
-  // {
-    // if (i%5 == 0) Serial.println();
-    // Serial.print("\t");
-    // Serial.print(_values[_sortIdx[i]]);
-  // }
-  // Serial.println("\n");
+
+median_index_t RunningMedian::_rotateRight(median_index_t tree)
+{
+  median_index_t l = _left[tree];
+  _left[tree] = _right[l];
+  _right[l] = tree;
+  _updateSize(tree);
+  _updateSize(l);
+  return l;
 }
 
 
+median_index_t RunningMedian::_insert(median_index_t tree, median_index_t node)
+{
+  if (tree == MEDIAN_NIL) return node;
 
-/*
- split version of pre-0.3.7 sort - bit faster
+  _subSize[tree]++;
+  if (_less(node, tree))
+  {
+    _left[tree] = _insert(_left[tree], node);
+    if (_priority(_left[tree]) > _priority(tree)) tree = _rotateRight(tree);
+  }
+  else
+  {
+    _right[tree] = _insert(_right[tree], node);
+    if (_priority(_right[tree]) > _priority(tree)) tree = _rotateLeft(tree);
+  }
+  return tree;
+}
 
-void RunningMedian::sort()
+
+//  joins two trees, all nodes of a are less than all nodes of b.
+median_index_t RunningMedian::_merge(median_index_t a, median_index_t b)
 {
-  // insertSort
-  for (uint16_t i = 1; i < _count; i++)
+  if (a == MEDIAN_NIL) return b;
+  if (b == MEDIAN_NIL) return a;
+  if (_priority(a) > _priority(b))
   {
-    uint16_t hi = i;
-    uint16_t temp = _sortIdx[hi];
-    float f = _values[temp];
-    while ((hi > 0) && (f < _values[_sortIdx[hi - 1]]))
-    {
-      hi--;
-    }
+    _right[a] = _merge(_right[a], b);
+    _updateSize(a);
+    return a;
+  }
+  _left[b] = _merge(a, _left[b]);
+  _updateSize(b);
+  return b;
+}
 
-    //  move elements to make space
-    uint16_t k = i;
-    while (k > hi)
-    {
-      _sortIdx[k] = _sortIdx[k - 1];
-      k--;
-    }
 
-    //  insert at right spot.
-    _sortIdx[k] = temp;
+//  node must be in the tree.
+median_index_t RunningMedian::_erase(median_index_t tree, median_index_t node)
+{
+  if (tree == node)
+  {
+    return _merge(_left[node], _right[node]);
+  }
+  _subSize[tree]--;
+  if (_less(node, tree))
+  {
+    _left[tree] = _erase(_left[tree], node);
+  }
+  else
+  {
+    _right[tree] = _erase(_right[tree], node);
   }
-  _sorted = true;
-  //  //  verify sorted
-  // for (int i = 0; i < _count; i++)
-  // {
-    // if (i%5 == 0) Serial.println();
-    // Serial.print("\t");
-    // Serial.print(_values[_sortIdx[i]]);
-  // }
-  // Serial.println("\n");
+  return tree;
 }
-*/
 
 
-/*
-//  straightforward insertion sort - PRE-0.3.7
-void RunningMedian::sort()
+//  value of the k-th smallest element, 0 based, k < _count.
+float RunningMedian::_kth(median_index_t k)
 {
-  for (uint16_t i = 1; i < _count; i++)
+  median_index_t t = _root;
+  while (true)
   {
-    uint16_t z = i;
-    uint16_t temp = _sortIdx[z];
-    while ((z > 0) && (_values[temp] < _values[_sortIdx[z - 1]]))
+    median_index_t ls = (_left[t] == MEDIAN_NIL) ? 0 : _subSize[_left[t]];
+    if (k < ls)
     {
-      _sortIdx[z] = _sortIdx[z - 1];
-      z--;
+      t = _left[t];
+    }
+    else if (k == ls)
+    {
+      return _values[t];
+    }
+    else
+    {
+      k -= ls + 1;
+      t = _right[t];
     }
-    _sortIdx[z] = temp;
   }
-  _sorted = true;
-
-  //  //  verify sorted
-  // for (int i = 0; i < _count; i++)
-  // {
-    // if (i%5 == 0) Serial.println();
-    // Serial.print("\t");
-    // Serial.print(_values[_sortIdx[i]]);
-  // }
-  // Serial.println("\n");
 }
-*/
 
-// -- END OF FILE --
 
+// -- END OF FILE --
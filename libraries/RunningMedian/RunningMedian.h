@@ -3,7 +3,7 @@
 //    FILE: RunningMedian.h
 //  AUTHOR: Rob Tillaart
 // PURPOSE: RunningMedian library for Arduino
-// VERSION: 0.3.7
+// VERSION: 0.4.0
 //     URL: https://github.com/RobTillaart/RunningMedian
 //     URL: http://arduino.cc/playground/Main/RunningMedian
 // HISTORY: See RunningMedian.cpp
@@ -12,7 +12,7 @@
 
 #include "Arduino.h"
 
-#define RUNNING_MEDIAN_VERSION        (F("0.3.7"))
+#define RUNNING_MEDIAN_VERSION        (F("0.4.0"))
 
 
 //  fall back to fixed storage for dynamic version => remove true
@@ -27,10 +27,20 @@
 #endif
 
 
+//  index type, 16 bit on AVR to save RAM, 32 bit otherwise.
+#if defined(ARDUINO_ARCH_AVR)
+typedef uint16_t median_index_t;
+#else
+typedef uint32_t median_index_t;
+#endif
+
+#define MEDIAN_NIL                    ((median_index_t) -1)
+
+
 #ifndef MEDIAN_MAX_SIZE
-#ifdef RUNNING_MEDIAN_USE_MALLOC
-//  max 250 to not overflow uint8_t internal variables
-#define MEDIAN_MAX_SIZE               255
+#if RUNNING_MEDIAN_USE_MALLOC
+//  limited by median_index_t, the largest value is reserved.
+#define MEDIAN_MAX_SIZE               (MEDIAN_NIL - 1)
 #else
 //  using fixed memory will be limited to 19 elements.
 #define MEDIAN_MAX_SIZE               19
@@ -44,65 +54,80 @@ public:
   //  # elements in the internal buffer
   //  odd sizes results in a 'real' middle element and will be a bit faster.
   //  even sizes takes the average of the two middle elements as median
-  explicit RunningMedian(const uint8_t size);
+  explicit RunningMedian(const median_index_t size);
   ~RunningMedian();
 
   //  resets internal buffer and variables
   void    clear();
   //  adds a new value to internal buffer, optionally replacing the oldest element.
+  //  O(log n)
   void    add(const float value);
   //  returns the median == middle element
+  //  O(log n) after add(), O(1) when called again.
   float   getMedian();
 
-  //  returns the Quantile
+  //  returns the Quantile, O(log n)
   float   getQuantile(const float quantile);
 
   //  returns average of the values in the internal buffer
   float   getAverage();
   //  returns average of the middle nMedian values, removes noise from outliers
-  float   getAverage(uint8_t nMedian);
+  float   getAverage(median_index_t nMedian);
 
   float   getHighest() { return getSortedElement(_count - 1); };
   float   getLowest()  { return getSortedElement(0); };
 
   //  get n-th element from the values in time order
-  float   getElement(const uint8_t n);
-  //  get n-th element from the values in size order
-  float   getSortedElement(const uint8_t n);
+  float   getElement(const median_index_t n);
+  //  get n-th element from the values in size order, O(log n)
+  float   getSortedElement(const median_index_t n);
   //  predict the max change of median after n additions
-  float   predict(const uint8_t n);
+  float   predict(const median_index_t n);
 
-  uint8_t getSize()    { return _size; };
+  median_index_t getSize()    { return _size; };
   //  returns current used elements, getCount() <= getSize()
-  uint8_t getCount()   { return _count; };
+  median_index_t getCount()   { return _count; };
   bool    isFull()     { return (_count == _size); }
 
-  //  EXPERIMENTAL  (might change in the future)
-  //  searchMode defines how the internal insertionSort works
-  //  can be used to optimize performance.
-  //  0 = LINEAR_SEARCH   1 = BINARY_SEARCH
+  //  OBSOLETE since 0.4.0, the elements are kept sorted incrementally.
+  //  kept for backwards compatibility, searchMode has no effect.
   void    setSearchMode(uint8_t searchMode = 0);
   uint8_t getSearchMode();
 
 
 protected:
-  boolean   _sorted;    //  _sortIdx{} is up to date
-  uint8_t   _size;      //  max number of values
-  uint8_t   _count;     //  current number of values <= size
-  uint8_t   _index;     //  next index to add
+  boolean        _medianValid;  //  _median is up to date
+  float          _median;
+  median_index_t _size;         //  max number of values
+  median_index_t _count;        //  current number of values <= size
+  median_index_t _index;        //  next index to add
+  median_index_t _root;         //  root of the order statistic tree
 
 
-  //  _values holds the elements themself
-  //  _sortIdx holds the index for sorted
+  //  _values holds the elements themself in time order.
+  //  element i is also node i of a treap ordered by value,
+  //  _subSize holds the number of nodes in the subtree of node i.
 #if RUNNING_MEDIAN_USE_MALLOC
-  float *   _values;
-  uint8_t * _sortIdx;
+  float *          _values;
+  median_index_t * _left;
+  median_index_t * _right;
+  median_index_t * _subSize;
 #else
-  float   _values[MEDIAN_MAX_SIZE];
-  uint8_t _sortIdx[MEDIAN_MAX_SIZE];
+  float          _values[MEDIAN_MAX_SIZE];
+  median_index_t _left[MEDIAN_MAX_SIZE];
+  median_index_t _right[MEDIAN_MAX_SIZE];
+  median_index_t _subSize[MEDIAN_MAX_SIZE];
 #endif
-  void      sort();
   uint8_t   _searchMode = 0;
+
+  bool           _less(median_index_t a, median_index_t b);
+  median_index_t _insert(median_index_t tree, median_index_t node);
+  median_index_t _erase(median_index_t tree, median_index_t node);
+  median_index_t _merge(median_index_t a, median_index_t b);
+  median_index_t _rotateLeft(median_index_t tree);
+  median_index_t _rotateRight(median_index_t tree);
+  void           _updateSize(median_index_t tree);
+  float          _kth(median_index_t k);
 };
 
 
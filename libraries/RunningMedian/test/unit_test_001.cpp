@@ -51,7 +51,8 @@ unittest_teardown()
 unittest(test_constants)
 {
   assertEqual(true, RUNNING_MEDIAN_USE_MALLOC);
-  assertEqual(255, MEDIAN_MAX_SIZE);
+  assertEqual(MEDIAN_NIL - 1, MEDIAN_MAX_SIZE);
+  assertEqual(4, sizeof(median_index_t));
   assertEqual(  3, MEDIAN_MIN_SIZE);
 }
 
@@ -70,8 +71,8 @@ unittest(test_basic_add)
 {
   RunningMedian samples = RunningMedian(5);
 
-  int cnt = 0;
-  for (int i = 0, cnt = 0; i < 50; i+=10)
+  median_index_t cnt = 0;
+  for (int i = 0; i < 50; i+=10)
   {
     samples.add(i);
     cnt++;
@@ -122,6 +123,80 @@ unittest(test_big)
 }
 
 
+//  reference: sort a copy of the window.
+static int compareFloat(const void * a, const void * b)
+{
+  float fa = *(const float *) a;
+  float fb = *(const float *) b;
+  return (fa > fb) - (fa < fb);
+}
+
+
+unittest(test_large_window_random)
+{
+  const int size = 1001;
+  RunningMedian samples = RunningMedian(size);
+  assertEqual(size, samples.getSize());
+
+  static float window[size];
+  static float sorted[size];
+  uint32_t seed = 12345;
+  int idx = 0;
+  median_index_t cnt = 0;
+  for (int i = 0; i < 5000; i++)
+  {
+    seed = seed * 1103515245 + 12345;
+    //  small range to force many duplicates
+    float value = (seed >> 16) % 200;
+    samples.add(value);
+    window[idx++] = value;
+    if (idx == size) idx = 0;
+    if (cnt < size) cnt++;
+
+    if ((i % 97 == 0) || (i == 4999))
+    {
+      memcpy(sorted, window, cnt * sizeof(float));
+      qsort(sorted, cnt, sizeof(float), compareFloat);
+      assertEqual(cnt, samples.getCount());
+
+      float median = (cnt & 1) ? sorted[cnt / 2] : (sorted[cnt / 2] + sorted[cnt / 2 - 1]) / 2;
+      assertEqualFloat(median, samples.getMedian(), 0.0001);
+      assertEqualFloat(sorted[0], samples.getLowest(), 0.0001);
+      assertEqualFloat(sorted[cnt - 1], samples.getHighest(), 0.0001);
+      for (median_index_t k = 0; k < cnt; k += 37)
+      {
+        assertEqualFloat(sorted[k], samples.getSortedElement(k), 0.0001);
+      }
+    }
+  }
+}
+
+
+unittest(test_quantile)
+{
+  RunningMedian samples = RunningMedian(2000);
+
+  //  add 3000 values in descending order, the window keeps
+  //  the last 2000 added, 1999 down to 0.
+  for (int i = 2999; i >= 0; i--)
+  {
+    samples.add(i);
+  }
+  assertEqual(2000, samples.getCount());
+  assertEqualFloat(   0, samples.getQuantile(0.0), 0.0001);
+  assertEqualFloat(999.5, samples.getMedian(), 0.0001);
+  assertEqualFloat(999.5, samples.getQuantile(0.5), 0.0001);
+  assertEqualFloat(1999, samples.getQuantile(1.0), 0.0001);
+  assertEqualFloat(1999 * 0.25, samples.getQuantile(0.25), 0.0001);
+  assertEqualFloat(999.5, samples.getAverage(10), 0.0001);
+  assertNAN(samples.getQuantile(1.1));
+
+  //  oldest element in time is the first in the window
+  assertEqualFloat(1999, samples.getElement(0), 0.0001);
+  assertEqualFloat(0, samples.getElement(1999), 0.0001);
+}
+
+
 unittest_main()
 
 // --------
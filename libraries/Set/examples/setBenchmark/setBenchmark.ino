@@ -0,0 +1,179 @@
+//
+//    FILE: setBenchmark.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: compare word based Set (0.3.0) with the byte based 0.2.x code
+//    DATE: 2026-10-17
+//     URL: https://github.com/RobTillaart/SET
+//
+//  The 0.2.x algorithms are copied below as reference,
+//  they work on a uint8_t[32] one byte / bit at a time.
+
+
+#include "set.h"
+
+
+//  0.2.x reference
+uint8_t oldA[32], oldB[32], oldC[32];
+
+uint16_t oldCount(uint8_t * mem)
+{
+  uint16_t cnt = 0;
+  for (uint8_t i = 0; i < 32; i++)
+  {
+    uint8_t b = mem[i];
+    for (; b; cnt++) b &= b - 1;
+  }
+  return cnt;
+}
+
+int oldFindNext(uint8_t * mem, uint16_t cur)
+{
+  uint8_t q = cur & 7;
+  for (uint8_t i = cur / 8; i < 32; i++)
+  {
+    uint8_t b = mem[i];
+    if (b != 0)
+    {
+      uint8_t mask = 1 << q;
+      for (uint8_t j = q; j < 8; j++)
+      {
+        if (b & mask) return i * 8 + j;
+        mask <<= 1;
+      }
+    }
+    q = 0;
+  }
+  return -1;
+}
+
+
+Set A, B, C;
+SetN<4096> tagsA, tagsB;
+
+uint32_t start, stop;
+volatile int32_t x;
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.print("Start ");
+  Serial.println(__FILE__);
+  Serial.print("SET_LIB_VERSION: ");
+  Serial.println(SET_LIB_VERSION);
+  Serial.println();
+
+  //  half filled random sets
+  for (int i = 0; i < 128; i++)
+  {
+    uint8_t a = random(256);
+    uint8_t b = random(256);
+    A.add(a);
+    B.add(b);
+    oldA[a / 8] |= 1 << (a & 7);
+    oldB[b / 8] |= 1 << (b & 7);
+  }
+
+  Serial.println("operation\t0.2.x\t0.3.0\t(us, 1000x)");
+
+  start = micros();
+  for (int r = 0; r < 1000; r++) x += oldCount(oldA);
+  stop = micros();
+  Serial.print("count()\t\t");
+  Serial.print(stop - start);
+  start = micros();
+  for (int r = 0; r < 1000; r++) x += A.count();
+  stop = micros();
+  Serial.print("\t");
+  Serial.println(stop - start);
+
+  start = micros();
+  for (int r = 0; r < 1000; r++)
+  {
+    for (uint8_t i = 0; i < 32; i++) oldC[i] = oldA[i] | oldB[i];
+    x += oldC[r & 31];
+  }
+  stop = micros();
+  Serial.print("union\t\t");
+  Serial.print(stop - start);
+  start = micros();
+  for (int r = 0; r < 1000; r++)
+  {
+    C = A + B;
+    x += C.has(r & 255);
+  }
+  stop = micros();
+  Serial.print("\t");
+  Serial.println(stop - start);
+
+  start = micros();
+  for (int r = 0; r < 1000; r++)
+  {
+    for (int v = oldFindNext(oldA, 0); v >= 0; v = oldFindNext(oldA, v + 1)) x += v;
+  }
+  stop = micros();
+  Serial.print("iterate\t\t");
+  Serial.print(stop - start);
+  start = micros();
+  for (int r = 0; r < 1000; r++)
+  {
+    for (int v = A.first(); v >= 0; v = A.next()) x += v;
+  }
+  stop = micros();
+  Serial.print("\t");
+  Serial.println(stop - start);
+
+  //  sparse set, 8 elements
+  A.clear();
+  memset(oldA, 0, 32);
+  for (int i = 0; i < 8; i++)
+  {
+    uint8_t a = i * 31 + 7;
+    A.add(a);
+    oldA[a / 8] |= 1 << (a & 7);
+  }
+  start = micros();
+  for (int r = 0; r < 1000; r++)
+  {
+    for (int v = oldFindNext(oldA, 0); v >= 0; v = oldFindNext(oldA, v + 1)) x += v;
+  }
+  stop = micros();
+  Serial.print("iterate sparse\t");
+  Serial.print(stop - start);
+  start = micros();
+  for (int r = 0; r < 1000; r++)
+  {
+    for (int v = A.first(); v >= 0; v = A.next()) x += v;
+  }
+  stop = micros();
+  Serial.print("\t");
+  Serial.println(stop - start);
+  Serial.println();
+
+  //  tag IDs in the thousands
+  for (int i = 0; i < 500; i++)
+  {
+    tagsA.add(random(4096));
+    tagsB.add(random(4096));
+  }
+  start = micros();
+  SetN<4096> both = tagsA * tagsB;
+  uint16_t cnt = both.count();
+  stop = micros();
+  Serial.print("SetN<4096> intersection + count:\t");
+  Serial.print(stop - start);
+  Serial.print(" us, common tags: ");
+  Serial.println(cnt);
+  Serial.print("first common tag: ");
+  Serial.println(both.first());
+
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+//  -- END OF FILE --
@@ -0,0 +1,315 @@
+#pragma once
+//
+//    FILE: set.h
+//  AUTHOR: Rob Tillaart
+// VERSION: 0.3.0
+//    DATE: 2014-09-11
+// PURPOSE: SET library for Arduino
+//     URL: https://github.com/RobTillaart/SET
+//
+//  Since 0.3.0 the members are stored in words (32 or 64 bit) and
+//  count() and the iterators use popcount / count trailing zeros.
+//  SetN<N> supports universes larger than 256 elements.
+
+
+#include "Arduino.h"
+
+
+#define SET_LIB_VERSION               (F("0.3.0"))
+
+
+//  storage word, native size of the processor.
+#if UINTPTR_MAX > 0xFFFFFFFFUL
+typedef uint64_t set_word_t;
+#else
+typedef uint32_t set_word_t;
+#endif
+#define SET_WORD_BITS                 (8 * sizeof(set_word_t))
+
+
+//  N = size of the universe, elements 0 .. N-1
+//  T = type of the element, uint8_t for N = 256.
+//  iterators return an int, so N is limited to 32768.
+template <uint32_t N, typename T = uint16_t>
+class SetN
+{
+    static_assert((N > 0) && (N <= 32768), "SetN: N must be 1 .. 32768");
+
+public:
+    explicit SetN(const bool clear = true)   //  create empty Set
+    {
+        if (clear) this->clear();
+        _current = -1;
+    }
+
+    SetN(const SetN &t)                      //  create copy Set
+    {
+        memcpy(_mem, t._mem, sizeof(_mem));
+        _current = -1;
+    }
+
+    SetN & operator = (const SetN &t)       //  assign, resets iterator
+    {
+        if (this != &t) memcpy(_mem, t._mem, sizeof(_mem));
+        _current = -1;
+        return *this;
+    }
+
+
+    void     clear()  { memset(_mem, 0, sizeof(_mem)); };   //  clear the Set
+    void     clr()    { clear(); };          //  will become obsolete
+    uint32_t size()   { return N; };         //  size of the universe
+    //  flip all elements in the Set
+    void     invert()
+    {
+        for (uint16_t i = 0; i < WORDS; i++) _mem[i] = ~_mem[i];
+        _mem[WORDS - 1] &= _lastMask();
+    }
+    //  add all elements
+    void     addAll()
+    {
+        memset(_mem, 0xFF, sizeof(_mem));
+        _mem[WORDS - 1] &= _lastMask();
+    }
+    //  return the #elements
+    uint16_t count() const
+    {
+        uint16_t cnt = 0;
+        for (uint16_t i = 0; i < WORDS; i++) cnt += _popcount(_mem[i]);
+        return cnt;
+    }
+    bool     isEmpty()
+    {
+        for (uint16_t i = 0; i < WORDS; i++)
+        {
+            if (_mem[i] != 0) return false;
+        }
+        return true;
+    }
+    bool     isFull()
+    {
+        for (uint16_t i = 0; i < WORDS - 1; i++)
+        {
+            if (_mem[i] != (set_word_t)~0) return false;
+        }
+        return _mem[WORDS - 1] == _lastMask();
+    }
+
+
+    //  values >= N are ignored
+    void add(const T value)     //  add element to the Set
+    {
+        if (value < N) _mem[value / SET_WORD_BITS] |= _bit(value);
+    }
+    void sub(const T value)     //  remove element from Set
+    {
+        if (value < N) _mem[value / SET_WORD_BITS] &= ~_bit(value);
+    }
+    void invert(const T value)  //  flip element in Set
+    {
+        if (value < N) _mem[value / SET_WORD_BITS] ^= _bit(value);
+    }
+    bool has(const T value)     //  element is in Set
+    {
+        if (value >= N) return false;
+        return (_mem[value / SET_WORD_BITS] & _bit(value)) != 0;
+    }
+
+
+    SetN operator + (const SetN &t)     //  union
+    {
+        SetN s(false);
+        for (uint16_t i = 0; i < WORDS; i++) s._mem[i] = _mem[i] | t._mem[i];
+        return s;
+    }
+    SetN operator - (const SetN &t)     //  diff
+    {
+        SetN s(false);
+        for (uint16_t i = 0; i < WORDS; i++) s._mem[i] = _mem[i] & ~t._mem[i];
+        return s;
+    }
+    SetN operator * (const SetN &t)     //  intersection
+    {
+        SetN s(false);
+        for (uint16_t i = 0; i < WORDS; i++) s._mem[i] = _mem[i] & t._mem[i];
+        return s;
+    }
+
+    void operator += (const SetN &t)    //  union
+    {
+        for (uint16_t i = 0; i < WORDS; i++) _mem[i] |= t._mem[i];
+    }
+    void operator -= (const SetN &t)    //  diff
+    {
+        for (uint16_t i = 0; i < WORDS; i++) _mem[i] &= ~t._mem[i];
+    }
+    void operator *= (const SetN &t)    //  intersection
+    {
+        for (uint16_t i = 0; i < WORDS; i++) _mem[i] &= t._mem[i];
+    }
+
+
+    bool operator == (const SetN &t) const   //  equal
+    {
+        return memcmp(_mem, t._mem, sizeof(_mem)) == 0;
+    }
+    bool operator != (const SetN &t) const   //  not equal
+    {
+        return memcmp(_mem, t._mem, sizeof(_mem)) != 0;
+    }
+    bool operator <= (const SetN &t) const   //  is subSet,
+    {
+        //  a superSet b is not implemented as one could
+        //  say b subSet a (b <= a)
+        for (uint16_t i = 0; i < WORDS; i++)
+        {
+            if ((_mem[i] & ~t._mem[i]) != 0) return false;
+        }
+        return true;
+    }
+
+
+    //  iterating through the Set
+    //  returns value or -1 if not exist
+    int setCurrent(const T current)         //  set element as current
+    {
+        _current = has(current) ? current : -1;
+        return _current;
+    }
+    int first()                             //  find first element
+    {
+        return findNext(0);
+    }
+    int next()                              //  find next element
+    {
+        if (_current < 0) return -1;
+        return findNext(_current + 1);
+    }
+    int prev()                              //  find previous element
+    {
+        if (_current < 0) return -1;
+        return findPrev(_current - 1);
+    }
+    int last()                              //  find last element
+    {
+        return findPrev(N - 1);
+    }
+    int getNth(const T n)                   //  find Nth element in a set (from start)
+    {
+        _current = -1;
+        if (n == 0) return -1;
+        uint16_t left = n;
+        for (uint16_t i = 0; i < WORDS; i++)
+        {
+            uint8_t cnt = _popcount(_mem[i]);
+            if (left > cnt)
+            {
+                left -= cnt;
+                continue;
+            }
+            //  drop the lowest left-1 bits.
+            set_word_t w = _mem[i];
+            while (--left) w &= w - 1;
+            _current = i * SET_WORD_BITS + _ctz(w);
+            break;
+        }
+        return _current;
+    }
+
+
+private:
+    static const uint16_t WORDS = (N + SET_WORD_BITS - 1) / SET_WORD_BITS;
+
+    set_word_t _mem[WORDS];
+    int        _current = -1;
+
+
+    static set_word_t _bit(const T value)
+    {
+        return ((set_word_t)1) << (value % SET_WORD_BITS);
+    }
+
+    //  valid bits of the last word.
+    static set_word_t _lastMask()
+    {
+        uint8_t rest = N % SET_WORD_BITS;
+        return (rest == 0) ? (set_word_t)~0 : (((set_word_t)1) << rest) - 1;
+    }
+
+    static uint8_t _popcount(const set_word_t w)
+    {
+        if (sizeof(set_word_t) == 8) return __builtin_popcountll(w);
+        return __builtin_popcountl(w);
+    }
+
+    //  w != 0
+    static uint8_t _ctz(const set_word_t w)
+    {
+        if (sizeof(set_word_t) == 8) return __builtin_ctzll(w);
+        return __builtin_ctzl(w);
+    }
+
+    //  w != 0
+    static uint8_t _clz(const set_word_t w)
+    {
+        if (sizeof(set_word_t) == 8) return __builtin_clzll(w);
+        //  correct for long larger than 32 bit.
+        return __builtin_clzl(w) - (8 * sizeof(long) - SET_WORD_BITS);
+    }
+
+    //  helper for first, next
+    int findNext(const uint32_t pos)
+    {
+        if (pos < N)
+        {
+            uint16_t i = pos / SET_WORD_BITS;
+            //  mask bits below pos
+            set_word_t w = _mem[i] & ((set_word_t)~0 << (pos % SET_WORD_BITS));
+            while (true)
+            {
+                if (w != 0)
+                {
+                    _current = i * SET_WORD_BITS + _ctz(w);
+                    return _current;
+                }
+                if (++i == WORDS) break;
+                w = _mem[i];
+            }
+        }
+        _current = -1;
+        return _current;
+    }
+
+    //  helper for last, prev
+    int findPrev(const int32_t pos)
+    {
+        _current = -1;
+        if (pos < 0) return -1;
+        int16_t i = pos / SET_WORD_BITS;
+        //  mask bits above pos
+        set_word_t w = _mem[i] & ((set_word_t)~0 >> (SET_WORD_BITS - 1 - (pos % SET_WORD_BITS)));
+        while (w == 0)
+        {
+            if (--i < 0) return -1;
+            w = _mem[i];
+        }
+        _current = i * SET_WORD_BITS + (SET_WORD_BITS - 1 - _clz(w));
+        return _current;
+    }
+};
+
+
+/////////////////////////////////////////////////////
+//
+//  SET 0..255
+//
+class Set : public SetN<256, uint8_t>
+{
+public:
+    explicit Set(const bool clear = true) : SetN<256, uint8_t>(clear) {};
+    Set(const SetN<256, uint8_t> &t) : SetN<256, uint8_t>(t) {};
+};
+
+
+// -- END OF FILE --
+
@@ -35,7 +35,6 @@
 #include "set.h"
 
 
-
 unittest_setup()
 {
   fprintf(stderr, "SET_LIB_VERSION: %s\n", (char *) SET_LIB_VERSION);
@@ -180,7 +179,108 @@ unittest(test_iterator)
   assertEqual(15, A.getNth(6));
   assertEqual(18, A.getNth(7));
   assertEqual(21, A.getNth(8));
+  assertEqual(57, A.getNth(20));
+  assertEqual(-1, A.getNth(21));
+
+  fprintf(stderr, "\nno wrap around\n");
+  assertEqual(57, A.last());
+  assertEqual(-1, A.next());
+  assertEqual(0, A.first());
+  assertEqual(-1, A.prev());
+
+  A.add(255);
+  assertEqual(255, A.last());
+  assertEqual(-1, A.next());
+
+}
+
+
+unittest(test_setN)
+{
+  SetN<1000> A;
+  SetN<1000> B;
+  bool ref[1000];
+
+  assertEqual(1000, A.size());
+  A.addAll();
+  assertTrue(A.isFull());
+  assertEqual(1000, A.count());
+  A.invert();
+  assertTrue(A.isEmpty());
+
+  //  random add / sub / invert against a reference
+  for (int i = 0; i < 1000; i++) ref[i] = false;
+  uint32_t x = 12345;
+  for (int i = 0; i < 5000; i++)
+  {
+    x = x * 1664525UL + 1013904223UL;
+    uint16_t v = (x >> 8) % 1000;
+    switch ((x >> 28) % 3)
+    {
+      case 0: A.add(v);    ref[v] = true;    break;
+      case 1: A.sub(v);    ref[v] = false;   break;
+      case 2: A.invert(v); ref[v] = !ref[v]; break;
+    }
+  }
+  uint16_t cnt = 0;
+  bool ok = true;
+  for (int i = 0; i < 1000; i++)
+  {
+    ok = ok && (A.has(i) == ref[i]);
+    if (ref[i]) cnt++;
+  }
+  assertTrue(ok);
+  assertEqual(cnt, A.count());
+
+  //  iteration matches reference, both directions.
+  int cur = A.first();
+  for (int i = 0; i < 1000; i++)
+  {
+    if (ref[i])
+    {
+      ok = ok && (cur == i);
+      cur = A.next();
+    }
+  }
+  assertTrue(ok);
+  assertEqual(-1, cur);
+
+  cur = A.last();
+  for (int i = 999; i >= 0; i--)
+  {
+    if (ref[i])
+    {
+      ok = ok && (cur == i);
+      cur = A.prev();
+    }
+  }
+  assertTrue(ok);
+  assertEqual(-1, cur);
+
+  int n = 0;
+  for (int i = 0; i < 1000; i++)
+  {
+    if (ref[i]) ok = ok && (A.getNth(++n) == i);
+  }
+  assertTrue(ok);
+
+  //  operators
+  B.clear();
+  B.add(999);
+  B.add(0);
+  SetN<1000> C = A + B;
+  assertTrue(B <= C);
+  assertTrue(A <= C);
+  assertEqual(999, C.last());
+  C = A - B;
+  assertFalse(C.has(999));
+  C *= B;
+  assertTrue(C.isEmpty());
 
+  //  out of range values are ignored
+  A.add(1000);
+  assertFalse(A.has(1000));
+  assertEqual(cnt, A.count());
 }
 
 
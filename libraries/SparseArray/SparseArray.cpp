@@ -1,7 +1,7 @@
 //
 //    FILE: SparseArray.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.1
+// VERSION: 0.2.0
 //    DATE: 2022-07-17
 // PURPOSE: Arduino library for sparse arrays of floats
 //     URL: https://github.com/RobTillaart/SparseArray
@@ -10,20 +10,40 @@
 #include "SparseArray.h"
 
 
-SparseArray::SparseArray(uint16_t sz)
+#define SPARSEARRAY_EMPTY              0xFFFF
+
+
+SparseArray::SparseArray(uint16_t sz, uint8_t mode)
 {
   _count = 0;
   _size  = sz;
+  _mode  = mode;
+  if (_mode > SPARSEARRAY_HASHED) _mode = SPARSEARRAY_LINEAR;
   if ( _size > SPARSEARRAY_MAX_SIZE)
   {
     _size = SPARSEARRAY_MAX_SIZE;
   }
-  _x     = (uint16_t *) malloc(sz * sizeof(uint16_t));
-  _value = (float *)    malloc(sz * sizeof(float));
+  _x     = (uint16_t *) malloc(_size * sizeof(uint16_t));
+  _value = (float *)    malloc(_size * sizeof(float));
+  if (_mode == SPARSEARRAY_HASHED)
+  {
+    uint32_t tableSize = 2;
+    _shift = 15;
+    while (tableSize < 2UL * _size)
+    {
+      tableSize <<= 1;
+      _shift--;
+    }
+    _mask  = tableSize - 1;
+    _table = (uint16_t *) malloc(tableSize * sizeof(uint16_t));
+  }
+  clear();
   //  catch malloc error
-  if (_x && _value) return;
+  bool tableOK = (_mode != SPARSEARRAY_HASHED) || (_table != NULL);
+  if (_x && _value && tableOK) return;
   //  if malloc error set size to zero.
   _size = 0;
+  _mode = SPARSEARRAY_LINEAR;
 }
 
 
@@ -31,6 +51,7 @@ SparseArray::~SparseArray()
 {
   if (_x) free(_x);
   if (_value) free(_value);
+  if (_table) free(_table);
 }
 
 
@@ -40,6 +61,12 @@ uint16_t SparseArray::size()
 }
 
 
+uint8_t SparseArray::getMode()
+{
+  return _mode;
+}
+
+
 uint16_t SparseArray::count()
 {
   return _count;
@@ -49,6 +76,10 @@ uint16_t SparseArray::count()
 void SparseArray::clear()
 {
   _count = 0;
+  if (_table)
+  {
+    for (uint32_t i = 0; i <= _mask; i++) _table[i] = SPARSEARRAY_EMPTY;
+  }
 }
 
 
@@ -119,12 +150,54 @@ void SparseArray::boundingSegment(uint16_t &minX, uint16_t &maxX)
 }
 
 
+bool SparseArray::first(uint16_t &x, float &value)
+{
+  _iter = 0;
+  return next(x, value);
+}
+
+
+bool SparseArray::next(uint16_t &x, float &value)
+{
+  if (_iter >= _count) return false;
+  x     = _x[_iter];
+  value = _value[_iter];
+  _iter++;
+  return true;
+}
+
+
 //////////////////////////////////////////////////////
 //
 //  PRIVATE
 //
 int32_t SparseArray::findPos(uint16_t x)
 {
+  if (_mode == SPARSEARRAY_SORTED)
+  {
+    uint16_t pos = lowerBound(x);
+    if ((pos < _count) && (_x[pos] == x))
+    {
+      return (int32_t)pos;
+    }
+    return -1;
+  }
+
+  if (_mode == SPARSEARRAY_HASHED)
+  {
+    uint16_t slot = hashSlot(x);
+    while (_table[slot] != SPARSEARRAY_EMPTY)
+    {
+      uint16_t i = _table[slot];
+      if (_x[i] == x)
+      {
+        return (int32_t)i;
+      }
+      slot = (slot + 1) & _mask;
+    }
+    return -1;
+  }
+
   //  linear search - not optimized.
   for (uint16_t i = 0; i < _count; i++)
   {
@@ -139,7 +212,45 @@ int32_t SparseArray::findPos(uint16_t x)
 
 void SparseArray::removeElement(uint16_t pos)
 {
-  _count--;
+  if (_mode == SPARSEARRAY_SORTED)
+  {
+    //  keep sorted, shift the tail one place down.
+    _count--;
+    uint16_t n = _count - pos;
+    memmove(&_x[pos],     &_x[pos + 1],     n * sizeof(uint16_t));
+    memmove(&_value[pos], &_value[pos + 1], n * sizeof(float));
+    return;
+  }
+
+  if (_mode == SPARSEARRAY_HASHED)
+  {
+    //  remove pos from the table, backward shift deletion,
+    //  moves entries back that would be unreachable otherwise.
+    uint16_t hole = findSlot(pos);
+    uint16_t slot = hole;
+    while (true)
+    {
+      slot = (slot + 1) & _mask;
+      uint16_t i = _table[slot];
+      if (i == SPARSEARRAY_EMPTY) break;
+      uint16_t home = hashSlot(_x[i]);
+      //  move if home is not cyclically in (hole, slot]
+      if (((slot - home) & _mask) >= ((slot - hole) & _mask))
+      {
+        _table[hole] = i;
+        hole = slot;
+      }
+    }
+    _table[hole] = SPARSEARRAY_EMPTY;
+    //  last element moves to pos, update its table entry.
+    _count--;
+    if (pos == _count) return;
+    _table[findSlot(_count)] = pos;
+  }
+  else
+  {
+    _count--;
+  }
   //  move last element
   //  efficiency (keep sorted) is no requirement.
   if (pos == _count) return;
@@ -152,12 +263,58 @@ bool SparseArray::newElement(uint16_t x, float value)
 {
   if (value == 0.0) return true;
   if (_count >= _size) return false;
-  _x[_count]     = x;
-  _value[_count] = value;
+
+  uint16_t pos = _count;
+  if (_mode == SPARSEARRAY_SORTED)
+  {
+    //  make room at the insertion point.
+    pos = lowerBound(x);
+    uint16_t n = _count - pos;
+    memmove(&_x[pos + 1],     &_x[pos],     n * sizeof(uint16_t));
+    memmove(&_value[pos + 1], &_value[pos], n * sizeof(float));
+  }
+  else if (_mode == SPARSEARRAY_HASHED)
+  {
+    uint16_t slot = hashSlot(x);
+    while (_table[slot] != SPARSEARRAY_EMPTY) slot = (slot + 1) & _mask;
+    _table[slot] = pos;
+  }
+  _x[pos]     = x;
+  _value[pos] = value;
   _count++;
   return true;
 }
 
 
+uint16_t SparseArray::lowerBound(uint16_t x)
+{
+  uint16_t low  = 0;
+  uint16_t high = _count;
+  while (low < high)
+  {
+    uint16_t mid = low + (high - low) / 2;
+    if (_x[mid] < x) low = mid + 1;
+    else high = mid;
+  }
+  return low;
+}
+
+
+//  Fibonacci hashing, 40503 = 2^16 / golden ratio, uses the top bits.
+uint16_t SparseArray::hashSlot(uint16_t x)
+{
+  return (uint16_t)(x * 40503U) >> _shift;
+}
+
+
+//  table slot holding element pos, pos must be in the table.
+uint16_t SparseArray::findSlot(uint16_t pos)
+{
+  uint16_t slot = hashSlot(_x[pos]);
+  while (_table[slot] != pos) slot = (slot + 1) & _mask;
+  return slot;
+}
+
+
 // -- END OF FILE --
 
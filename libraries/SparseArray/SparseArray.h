@@ -2,7 +2,7 @@
 //
 //    FILE: SparseArray.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.1
+// VERSION: 0.2.0
 //    DATE: 2022-07-17
 // PURPOSE: Arduino library for sparse arrays of floats
 //     URL: https://github.com/RobTillaart/SparseArray
@@ -11,20 +11,29 @@
 
 #include "Arduino.h"
 
-#define SPARSEARRAY_LIB_VERSION        (F("0.1.1"))
+#define SPARSEARRAY_LIB_VERSION        (F("0.2.0"))
 
 #ifndef SPARSEARRAY_MAX_SIZE
 #define SPARSEARRAY_MAX_SIZE           1000
 #endif
 
+//  storage modes
+//  LINEAR  unsorted, linear search, no extra memory (pre 0.2.0)
+//  SORTED  sorted on x, binary search, no extra memory
+//  HASHED  unsorted, open addressing hash table, 4 bytes per element extra
+#define SPARSEARRAY_LINEAR             0
+#define SPARSEARRAY_SORTED             1
+#define SPARSEARRAY_HASHED             2
+
 
 class SparseArray
 {
 public:
-  SparseArray(uint16_t sz);
+  SparseArray(uint16_t sz, uint8_t mode = SPARSEARRAY_LINEAR);
   ~SparseArray();
 
   uint16_t size();
+  uint8_t  getMode();
   uint16_t count();
   float    sum();
   void     clear();
@@ -41,17 +50,38 @@ public:
   void     boundingSegment(uint16_t &minX, uint16_t &maxX);
 
 
+  //  walk through the non zero elements, in storage order.
+  //  SORTED mode: ordered by x.
+  //  returns false if there is no (next) element.
+  //  set(), add() and clear() during the walk can skip or repeat elements.
+  bool     first(uint16_t &x, float &value);
+  bool     next(uint16_t &x, float &value);
+
+
 protected:
   uint16_t  _size   = 0;
   uint16_t  _count  = 0;
+  uint8_t   _mode   = SPARSEARRAY_LINEAR;
+  uint16_t  _iter   = 0;
 
   uint16_t  *_x     = NULL;  // support array's [0..65535]
   float     *_value = NULL;
 
+  //  HASHED mode, table of indices, power of 2 >= 2 x size.
+  uint16_t  *_table = NULL;
+  uint16_t  _mask   = 0;
+  uint8_t   _shift  = 0;
+
   //  returns index of x if in set
   //  otherwise -1
   int32_t findPos(uint16_t x);
 
+  //  SORTED mode, index of first element >= x
+  uint16_t lowerBound(uint16_t x);
+  //  HASHED mode
+  uint16_t hashSlot(uint16_t x);
+  uint16_t findSlot(uint16_t pos);
+
   //  removes element at position (from findPos)
   //  pre: count > 0
   void    removeElement(uint16_t pos);
@@ -143,6 +143,75 @@ unittest(test_boundingSegment)
 }
 
 
+unittest(test_modes)
+{
+  //  random set / add / clear against the LINEAR reference.
+  //  own LCG as random() does not work.
+  SparseArray ref(200);
+  SparseArray srt(200, SPARSEARRAY_SORTED);
+  SparseArray hsh(200, SPARSEARRAY_HASHED);
+  assertEqual(SPARSEARRAY_LINEAR, ref.getMode());
+  assertEqual(SPARSEARRAY_SORTED, srt.getMode());
+  assertEqual(SPARSEARRAY_HASHED, hsh.getMode());
+  assertEqual(200, hsh.size());
+
+  uint32_t seed = 12345;
+  for (int i = 0; i < 20000; i++)
+  {
+    seed = seed * 1103515245UL + 12345;
+    uint16_t x = (seed >> 8) % 300;
+    float value = (int)((seed >> 20) % 5) - 2;  //  -2..2
+    if ((seed >> 28) < 8)
+    {
+      assertEqual(ref.set(x, value), srt.set(x, value));
+      assertEqual(ref.set(x, value), hsh.set(x, value));
+    }
+    else
+    {
+      bool r = ref.add(x, value);
+      assertEqual(r, srt.add(x, value));
+      assertEqual(r, hsh.add(x, value));
+    }
+    if (i % 5000 == 4999)
+    {
+      ref.clear();
+      srt.clear();
+      hsh.clear();
+    }
+  }
+  assertEqual(ref.count(), srt.count());
+  assertEqual(ref.count(), hsh.count());
+  for (uint16_t x = 0; x < 300; x++)
+  {
+    assertEqual(ref.get(x), srt.get(x));
+    assertEqual(ref.get(x), hsh.get(x));
+  }
+}
+
+
+unittest(test_iterate)
+{
+  SparseArray sar(10, SPARSEARRAY_SORTED);
+  uint16_t x;
+  float value;
+  assertFalse(sar.first(x, value));
+
+  sar.set(7, 7);
+  sar.set(3, 3);
+  sar.set(5, 5);
+  int n = 0;
+  uint16_t prev = 0;
+  for (bool ok = sar.first(x, value); ok; ok = sar.next(x, value))
+  {
+    assertMore(x, prev);
+    assertEqualFloat(x, value, 0.001);
+    prev = x;
+    n++;
+  }
+  assertEqual(3, n);
+}
+
+
 unittest_main()
 
 
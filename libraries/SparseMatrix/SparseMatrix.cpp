@@ -1,7 +1,7 @@
 //
 //    FILE: SparseMatrix.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.4
+// VERSION: 0.3.0
 //    DATE: 2022-07-12
 // PURPOSE: Arduino library for sparse matrices
 //     URL: https://github.com/RobTillaart/SparseMatrix
@@ -10,21 +10,48 @@
 #include "SparseMatrix.h"
 
 
-SparseMatrix::SparseMatrix(uint16_t sz)
+#define SPARSEMATRIX_EMPTY              0xFFFF
+
+
+//  packed key, sorted on y first.
+static inline uint16_t packKey(uint8_t x, uint8_t y)
+{
+  return ((uint16_t)y << 8) | x;
+}
+
+
+SparseMatrix::SparseMatrix(uint16_t sz, uint8_t mode)
 {
   _count = 0;
   _size  = sz;
+  _mode  = mode;
+  if (_mode > SPARSEMATRIX_HASHED) _mode = SPARSEMATRIX_LINEAR;
   if ( _size > SPARSEMATRIX_MAX_SIZE)
   {
     _size = SPARSEMATRIX_MAX_SIZE;
   }
-  _x     = (uint8_t *) malloc(sz);
-  _y     = (uint8_t *) malloc(sz);
-  _value = (float *)   malloc(sz * sizeof(float));
+  _x     = (uint8_t *) malloc(_size);
+  _y     = (uint8_t *) malloc(_size);
+  _value = (float *)   malloc(_size * sizeof(float));
+  if (_mode == SPARSEMATRIX_HASHED)
+  {
+    uint32_t tableSize = 2;
+    _shift = 15;
+    while (tableSize < 2UL * _size)
+    {
+      tableSize <<= 1;
+      _shift--;
+    }
+    _mask  = tableSize - 1;
+    _table = (uint16_t *) malloc(tableSize * sizeof(uint16_t));
+  }
+  clear();
   //  catch malloc error
-  if (_x && _y && _value) return;
+  bool tableOK = (_mode != SPARSEMATRIX_HASHED) || (_table != NULL);
+  if (_x && _y && _value && tableOK) return;
   //  if malloc error set size to zero.
   _size = 0;
+  _mode = SPARSEMATRIX_LINEAR;
 }
 
 
@@ -33,6 +60,8 @@ SparseMatrix::~SparseMatrix()
   if (_x) free(_x);
   if (_y) free(_y);
   if (_value) free(_value);
+  if (_table) free(_table);
+  if (_index) free(_index);
 }
 
 
@@ -42,6 +71,12 @@ uint16_t SparseMatrix::size()
 }
 
 
+uint8_t SparseMatrix::getMode()
+{
+  return _mode;
+}
+
+
 uint16_t SparseMatrix::count()
 {
   return _count;
@@ -51,6 +86,11 @@ uint16_t SparseMatrix::count()
 void SparseMatrix::clear()
 {
   _count = 0;
+  _indexValid = false;
+  if (_table)
+  {
+    for (uint32_t i = 0; i <= _mask; i++) _table[i] = SPARSEMATRIX_EMPTY;
+  }
 }
 
 
@@ -126,12 +166,234 @@ void SparseMatrix::boundingBox(uint8_t &minX, uint8_t &maxX, uint8_t &minY, uint
 }
 
 
+bool SparseMatrix::first(uint8_t &x, uint8_t &y, float &value)
+{
+  _iter = 0;
+  return next(x, y, value);
+}
+
+
+bool SparseMatrix::next(uint8_t &x, uint8_t &y, float &value)
+{
+  if (_iter >= _count) return false;
+  x     = _x[_iter];
+  y     = _y[_iter];
+  value = _value[_iter];
+  _iter++;
+  return true;
+}
+
+
+//////////////////////////////////////////////////////
+//
+//  MATH
+//
+bool SparseMatrix::multiply(const float * vector, uint16_t columns, float * result, uint16_t rows)
+{
+  for (uint16_t r = 0; r < rows; r++) result[r] = 0;
+  if (!buildIndex()) return false;
+
+  //  row by row, accumulate in a local.
+  bool     inRange = true;
+  uint16_t rank = 0;
+  while (rank < _count)
+  {
+    uint8_t row = _y[rankPos(rank)];
+    float   acc = 0;
+    while (rank < _count)
+    {
+      uint16_t pos = rankPos(rank);
+      if (_y[pos] != row) break;
+      if (_x[pos] < columns) acc += _value[pos] * vector[_x[pos]];
+      else inRange = false;
+      rank++;
+    }
+    if (row < rows) result[row] = acc;
+    else inRange = false;
+  }
+  return inRange;
+}
+
+
+bool SparseMatrix::multiplyTransposed(const float * vector, uint16_t rows, float * result, uint16_t columns)
+{
+  for (uint16_t c = 0; c < columns; c++) result[c] = 0;
+  if (!buildIndex()) return false;
+
+  bool inRange = true;
+  for (uint16_t rank = 0; rank < _count; rank++)
+  {
+    uint16_t pos = rankPos(rank);
+    if ((_y[pos] < rows) && (_x[pos] < columns))
+    {
+      result[_x[pos]] += _value[pos] * vector[_y[pos]];
+    }
+    else inRange = false;
+  }
+  return inRange;
+}
+
+
+bool SparseMatrix::multiply(SparseMatrix &A, SparseMatrix &B)
+{
+  if ((&A == this) || (&B == this)) return false;
+  clear();
+  if (!A.buildIndex() || !B.buildIndex()) return false;
+
+  //  C[i][j] += A[i][k] * B[k][j], B row k is a contiguous range.
+  for (uint16_t ra = 0; ra < A._count; ra++)
+  {
+    uint16_t pa = A.rankPos(ra);
+    uint8_t  i  = A._y[pa];
+    uint8_t  k  = A._x[pa];
+    float    a  = A._value[pa];
+    for (uint16_t rb = B.lowerBound((uint16_t)k << 8); rb < B._count; rb++)
+    {
+      uint16_t pb = B.rankPos(rb);
+      if (B._y[pb] != k) break;
+      if (!add(B._x[pb], i, a * B._value[pb])) return false;
+    }
+  }
+  return true;
+}
+
+
+void SparseMatrix::transpose()
+{
+  uint8_t * t = _x;
+  _x = _y;
+  _y = t;
+  _indexValid = false;
+
+  if (_mode == SPARSEMATRIX_SORTED)
+  {
+    sortElements();
+  }
+  else if (_mode == SPARSEMATRIX_HASHED)
+  {
+    //  keys changed, rebuild the table.
+    for (uint32_t i = 0; i <= _mask; i++) _table[i] = SPARSEMATRIX_EMPTY;
+    for (uint16_t pos = 0; pos < _count; pos++)
+    {
+      uint16_t slot = hashSlot(packKey(_x[pos], _y[pos]));
+      while (_table[slot] != SPARSEMATRIX_EMPTY) slot = (slot + 1) & _mask;
+      _table[slot] = pos;
+    }
+  }
+}
+
+
+void SparseMatrix::scale(float factor)
+{
+  //  backwards as removeElement() moves elements after pos.
+  uint16_t pos = _count;
+  while (pos > 0)
+  {
+    pos--;
+    _value[pos] *= factor;
+    if (_value[pos] == 0.0) removeElement(pos);
+  }
+}
+
+
+//////////////////////////////////////////////////////
+//
+//  EXPORT / IMPORT
+//
+bool SparseMatrix::exportCOO(uint8_t * x, uint8_t * y, float * value, uint16_t maxCount)
+{
+  if (_count > maxCount) return false;
+  if (!buildIndex()) return false;
+  for (uint16_t rank = 0; rank < _count; rank++)
+  {
+    uint16_t pos = rankPos(rank);
+    x[rank]     = _x[pos];
+    y[rank]     = _y[pos];
+    value[rank] = _value[pos];
+  }
+  return true;
+}
+
+
+bool SparseMatrix::importCOO(const uint8_t * x, const uint8_t * y, const float * value, uint16_t count)
+{
+  clear();
+  for (uint16_t i = 0; i < count; i++)
+  {
+    if (!add(x[i], y[i], value[i])) return false;
+  }
+  return true;
+}
+
+
+bool SparseMatrix::exportCSR(uint16_t * rowStart, uint16_t rows, uint8_t * x, float * value, uint16_t maxCount)
+{
+  if (_count > maxCount) return false;
+  if (!buildIndex()) return false;
+  uint16_t rank = 0;
+  for (uint16_t r = 0; r < rows; r++)
+  {
+    rowStart[r] = rank;
+    while (rank < _count)
+    {
+      uint16_t pos = rankPos(rank);
+      if (_y[pos] != r) break;
+      x[rank]     = _x[pos];
+      value[rank] = _value[pos];
+      rank++;
+    }
+  }
+  rowStart[rows] = rank;
+  //  elements left have y >= rows.
+  return (rank == _count);
+}
+
+
+bool SparseMatrix::importCSR(const uint16_t * rowStart, uint16_t rows, const uint8_t * x, const float * value)
+{
+  clear();
+  for (uint16_t r = 0; r < rows; r++)
+  {
+    for (uint16_t i = rowStart[r]; i < rowStart[r + 1]; i++)
+    {
+      if (!add(x[i], r, value[i])) return false;
+    }
+  }
+  return true;
+}
+
+
 //////////////////////////////////////////////////////
 //
 //  PRIVATE
 //
 int32_t SparseMatrix::findPos(uint8_t x, uint8_t y)
 {
+  if (_mode == SPARSEMATRIX_SORTED)
+  {
+    uint16_t pos = lowerBound(packKey(x, y));
+    if ((pos < _count) && (_x[pos] == x) && (_y[pos] == y))
+    {
+      return (int32_t)pos;
+    }
+    return -1;
+  }
+
+  if (_mode == SPARSEMATRIX_HASHED)
+  {
+    uint16_t slot = hashSlot(packKey(x, y));
+    while (_table[slot] != SPARSEMATRIX_EMPTY)
+    {
+      uint16_t i = _table[slot];
+      if ((_x[i] == x) && (_y[i] == y))
+      {
+        return (int32_t)i;
+      }
+      slot = (slot + 1) & _mask;
+    }
+    return -1;
+  }
+
   //  linear search - not optimized.
   for (uint16_t i = 0; i < _count; i++)
   {
@@ -146,7 +408,47 @@ int32_t SparseMatrix::findPos(uint8_t x, uint8_t y)
 
 void SparseMatrix::removeElement(uint16_t pos)
 {
-  _count--;
+  _indexValid = false;
+  if (_mode == SPARSEMATRIX_SORTED)
+  {
+    //  keep sorted, shift the tail one place down.
+    _count--;
+    uint16_t n = _count - pos;
+    memmove(&_x[pos],     &_x[pos + 1],     n);
+    memmove(&_y[pos],     &_y[pos + 1],     n);
+    memmove(&_value[pos], &_value[pos + 1], n * sizeof(float));
+    return;
+  }
+
+  if (_mode == SPARSEMATRIX_HASHED)
+  {
+    //  remove pos from the table, backward shift deletion,
+    //  moves entries back that would be unreachable otherwise.
+    uint16_t hole = findSlot(pos);
+    uint16_t slot = hole;
+    while (true)
+    {
+      slot = (slot + 1) & _mask;
+      uint16_t i = _table[slot];
+      if (i == SPARSEMATRIX_EMPTY) break;
+      uint16_t home = hashSlot(packKey(_x[i], _y[i]));
+      //  move if home is not cyclically in (hole, slot]
+      if (((slot - home) & _mask) >= ((slot - hole) & _mask))
+      {
+        _table[hole] = i;
+        hole = slot;
+      }
+    }
+    _table[hole] = SPARSEMATRIX_EMPTY;
+    //  last element moves to pos, update its table entry.
+    _count--;
+    if (pos == _count) return;
+    _table[findSlot(_count)] = pos;
+  }
+  else
+  {
+    _count--;
+  }
   //  move last element
   //  efficiency (keep sorted) is no requirement.
   if (pos == _count) return;
@@ -160,13 +462,132 @@ bool SparseMatrix::newElement(uint8_t x, uint8_t y, float value)
 {
   if (value == 0.0) return true;
   if (_count >= _size) return false;
-  _x[_count]     = x;
-  _y[_count]     = y;
-  _value[_count] = value;
+  _indexValid = false;
+
+  uint16_t pos = _count;
+  if (_mode == SPARSEMATRIX_SORTED)
+  {
+    //  make room at the insertion point.
+    pos = lowerBound(packKey(x, y));
+    uint16_t n = _count - pos;
+    memmove(&_x[pos + 1],     &_x[pos],     n);
+    memmove(&_y[pos + 1],     &_y[pos],     n);
+    memmove(&_value[pos + 1], &_value[pos], n * sizeof(float));
+  }
+  else if (_mode == SPARSEMATRIX_HASHED)
+  {
+    uint16_t slot = hashSlot(packKey(x, y));
+    while (_table[slot] != SPARSEMATRIX_EMPTY) slot = (slot + 1) & _mask;
+    _table[slot] = pos;
+  }
+  _x[pos]     = x;
+  _y[pos]     = y;
+  _value[pos] = value;
   _count++;
   return true;
 }
 
 
+uint16_t SparseMatrix::lowerBound(uint16_t key)
+{
+  uint16_t low  = 0;
+  uint16_t high = _count;
+  while (low < high)
+  {
+    uint16_t mid = low + (high - low) / 2;
+    uint16_t pos = rankPos(mid);
+    if (packKey(_x[pos], _y[pos]) < key) low = mid + 1;
+    else high = mid;
+  }
+  return low;
+}
+
+
+uint16_t SparseMatrix::rankPos(uint16_t rank)
+{
+  if (_mode == SPARSEMATRIX_SORTED) return rank;
+  return _index[rank];
+}
+
+
+//  Shell sort gaps (Ciura)
+static const uint16_t sortGaps[8] = { 701, 301, 132, 57, 23, 10, 4, 1 };
+
+
+bool SparseMatrix::buildIndex()
+{
+  if (_mode == SPARSEMATRIX_SORTED) return true;
+  if (_index == NULL)
+  {
+    _index = (uint16_t *) malloc(_size * sizeof(uint16_t));
+    if (_index == NULL) return false;
+  }
+  if (_indexValid) return true;
+
+  for (uint16_t i = 0; i < _count; i++) _index[i] = i;
+  for (uint8_t g = 0; g < 8; g++)
+  {
+    uint16_t gap = sortGaps[g];
+    for (uint16_t i = gap; i < _count; i++)
+    {
+      uint16_t t   = _index[i];
+      uint16_t key = packKey(_x[t], _y[t]);
+      uint16_t j   = i;
+      while ((j >= gap) && (packKey(_x[_index[j - gap]], _y[_index[j - gap]]) > key))
+      {
+        _index[j] = _index[j - gap];
+        j -= gap;
+      }
+      _index[j] = t;
+    }
+  }
+  _indexValid = true;
+  return true;
+}
+
+
+void SparseMatrix::sortElements()
+{
+  for (uint8_t g = 0; g < 8; g++)
+  {
+    uint16_t gap = sortGaps[g];
+    for (uint16_t i = gap; i < _count; i++)
+    {
+      uint8_t  tx  = _x[i];
+      uint8_t  ty  = _y[i];
+      float    tv  = _value[i];
+      uint16_t key = packKey(tx, ty);
+      uint16_t j   = i;
+      while ((j >= gap) && (packKey(_x[j - gap], _y[j - gap]) > key))
+      {
+        _x[j]     = _x[j - gap];
+        _y[j]     = _y[j - gap];
+        _value[j] = _value[j - gap];
+        j -= gap;
+      }
+      _x[j]     = tx;
+      _y[j]     = ty;
+      _value[j] = tv;
+    }
+  }
+}
+
+
+//  Fibonacci hashing, 40503 = 2^16 / golden ratio, uses the top bits.
+uint16_t SparseMatrix::hashSlot(uint16_t key)
+{
+  return (uint16_t)(key * 40503U) >> _shift;
+}
+
+
+//  table slot holding element pos, pos must be in the table.
+uint16_t SparseMatrix::findSlot(uint16_t pos)
+{
+  uint16_t slot = hashSlot(packKey(_x[pos], _y[pos]));
+  while (_table[slot] != pos) slot = (slot + 1) & _mask;
+  return slot;
+}
+
+
 // -- END OF FILE --
 
@@ -2,7 +2,7 @@
 //
 //    FILE: SparseMatrix.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.4
+// VERSION: 0.3.0
 //    DATE: 2022-07-12
 // PURPOSE: Arduino library for sparse matrices
 //     URL: https://github.com/RobTillaart/SparseMatrix
@@ -11,20 +11,29 @@
 
 #include "Arduino.h"
 
-#define SPARSEMATRIX_LIB_VERSION        (F("0.1.4"))
+#define SPARSEMATRIX_LIB_VERSION        (F("0.3.0"))
 
 #ifndef SPARSEMATRIX_MAX_SIZE
 #define SPARSEMATRIX_MAX_SIZE           1000
 #endif
 
+//  storage modes
+//  LINEAR  unsorted, linear search, no extra memory (pre 0.2.0)
+//  SORTED  sorted on (y, x), binary search, no extra memory
+//  HASHED  unsorted, open addressing hash table, 4 bytes per element extra
+#define SPARSEMATRIX_LINEAR             0
+#define SPARSEMATRIX_SORTED             1
+#define SPARSEMATRIX_HASHED             2
+
 
 class SparseMatrix
 {
 public:
-  SparseMatrix(uint16_t sz);
+  SparseMatrix(uint16_t sz, uint8_t mode = SPARSEMATRIX_LINEAR);
   ~SparseMatrix();
 
   uint16_t size();
+  uint8_t  getMode();
   uint16_t count();
   float    sum();
   void     clear();
@@ -42,18 +51,83 @@ public:
   void     boundingBox(uint8_t &minX, uint8_t &maxX, uint8_t &minY, uint8_t &maxY);
 
 
+  //  walk through the non zero elements, in storage order.
+  //  SORTED mode: ordered by y, then x.
+  //  returns false if there is no (next) element.
+  //  set(), add() and clear() during the walk can skip or repeat elements.
+  bool     first(uint8_t &x, uint8_t &y, float &value);
+  bool     next(uint8_t &x, uint8_t &y, float &value);
+
+
+  //  MATH
+  //  x = column, y = row, M[y][x] == get(x, y).
+  //  the kernels walk the elements sorted on y, then x.
+  //  LINEAR and HASHED mode allocate a sorted index (2 bytes per element)
+  //  on first use, it is rebuilt lazily after elements are added / removed.
+  //  returns false if the index could not be allocated.
+
+  //  result[rows] = M x vector[columns]
+  //  elements outside rows x columns are skipped and return false.
+  bool     multiply(const float * vector, uint16_t columns, float * result, uint16_t rows);
+  //  result[columns] = transpose(M) x vector[rows]
+  bool     multiplyTransposed(const float * vector, uint16_t rows, float * result, uint16_t columns);
+  //  this = A x B, A and B must differ from this.
+  //  returns false if this runs out of slots, the result is then incomplete.
+  bool     multiply(SparseMatrix &A, SparseMatrix &B);
+  //  swap x and y of all elements.
+  void     transpose();
+  //  multiply all elements, elements that become zero are removed.
+  void     scale(float factor);
+
+
+  //  EXPORT / IMPORT
+  //  COO = coordinate list, CSR = compressed sparse row.
+  //  export is sorted on y, then x, returns false if count() > maxCount.
+  bool     exportCOO(uint8_t * x, uint8_t * y, float * value, uint16_t maxCount);
+  //  clears the matrix first, duplicates are added.
+  //  returns false if the matrix is full.
+  bool     importCOO(const uint8_t * x, const uint8_t * y, const float * value, uint16_t count);
+  //  rowStart[rows + 1], row r holds elements rowStart[r] .. rowStart[r+1] - 1
+  //  returns false if count() > maxCount or an element has y >= rows.
+  bool     exportCSR(uint16_t * rowStart, uint16_t rows, uint8_t * x, float * value, uint16_t maxCount);
+  bool     importCSR(const uint16_t * rowStart, uint16_t rows, const uint8_t * x, const float * value);
+
+
 private:
   uint16_t  _size   = 0;
   uint16_t  _count  = 0;
+  uint8_t   _mode   = SPARSEMATRIX_LINEAR;
+  uint16_t  _iter   = 0;
 
   uint8_t   *_x     = NULL;
   uint8_t   *_y     = NULL;
   float     *_value = NULL;
 
+  //  HASHED mode, table of indices, power of 2 >= 2 x size.
+  uint16_t  *_table = NULL;
+  uint16_t  _mask   = 0;
+  uint8_t   _shift  = 0;
+
+  //  LINEAR + HASHED mode, sorted view, maps rank to position.
+  uint16_t  *_index = NULL;
+  bool      _indexValid = false;
+
   //  returns index of x, y if in set
   //  otherwise -1
   int32_t findPos(uint8_t x, uint8_t y);
 
+  //  sorted view, rank of first element >= (x, y)
+  uint16_t lowerBound(uint16_t key);
+  //  position of element with rank in the sorted view.
+  uint16_t rankPos(uint16_t rank);
+  //  prepares the sorted view, false if no memory.
+  bool     buildIndex();
+  //  SORTED mode, restore order after transpose.
+  void     sortElements();
+  //  HASHED mode
+  uint16_t hashSlot(uint16_t key);
+  uint16_t findSlot(uint16_t pos);
+
   //  removes element at pos (from findPos)
   //  pre: count > 0
   void    removeElement(uint16_t pos);
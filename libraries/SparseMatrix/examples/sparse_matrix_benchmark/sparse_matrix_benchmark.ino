@@ -0,0 +1,118 @@
+//
+//    FILE: sparse_matrix_benchmark.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: compare LINEAR, SORTED and HASHED mode, sequential and random access
+//     URL: https://github.com/RobTillaart/SparseMatrix
+//
+//  fills a 32 x N matrix completely, reads it back and empties it again.
+//  sequential = row by row, random = shuffled order (same coordinates).
+
+
+#include  "SparseMatrix.h"
+
+
+//  keep UNO within its 2K RAM
+#if defined(__AVR__)
+const uint16_t ELEMENTS = 128;
+#else
+const uint16_t ELEMENTS = 1000;
+#endif
+
+uint16_t order[ELEMENTS];
+
+uint32_t start, stop;
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println();
+  Serial.println(__FILE__);
+  Serial.print("SPARSEMATRIX_LIB_VERSION: ");
+  Serial.println(SPARSEMATRIX_LIB_VERSION);
+  Serial.println();
+
+  Serial.println("MODE\tACCESS\tset\tget\tadd\tdelete\t(us per call)");
+  for (uint8_t mode = SPARSEMATRIX_LINEAR; mode <= SPARSEMATRIX_HASHED; mode++)
+  {
+    for (uint16_t i = 0; i < ELEMENTS; i++) order[i] = i;
+    benchmark(mode, "seq");
+
+    //  Fisher-Yates shuffle
+    randomSeed(42);
+    for (uint16_t i = ELEMENTS - 1; i > 0; i--)
+    {
+      uint16_t j = random(i + 1);
+      uint16_t t = order[i];
+      order[i] = order[j];
+      order[j] = t;
+    }
+    benchmark(mode, "random");
+  }
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+void benchmark(uint8_t mode, const char * access)
+{
+  SparseMatrix sm(ELEMENTS, mode);
+  if (sm.size() != ELEMENTS)
+  {
+    Serial.println("allocation failed");
+    return;
+  }
+  const char * names[3] = { "LINEAR", "SORTED", "HASHED" };
+  Serial.print(names[mode]);
+  Serial.print('\t');
+  Serial.print(access);
+
+  start = micros();
+  for (uint16_t i = 0; i < ELEMENTS; i++)
+  {
+    sm.set(order[i] % 32, order[i] / 32, 1 + i);
+  }
+  stop = micros();
+  report(stop - start);
+
+  volatile float f = 0;
+  start = micros();
+  for (uint16_t i = 0; i < ELEMENTS; i++)
+  {
+    f = f + sm.get(order[i] % 32, order[i] / 32);
+  }
+  stop = micros();
+  report(stop - start);
+
+  start = micros();
+  for (uint16_t i = 0; i < ELEMENTS; i++)
+  {
+    sm.add(order[i] % 32, order[i] / 32, 1);
+  }
+  stop = micros();
+  report(stop - start);
+
+  start = micros();
+  for (uint16_t i = 0; i < ELEMENTS; i++)
+  {
+    sm.set(order[i] % 32, order[i] / 32, 0);
+  }
+  stop = micros();
+  report(stop - start);
+  Serial.println();
+  if (sm.count() != 0) Serial.println("ERROR: count != 0");
+}
+
+
+void report(uint32_t duration)
+{
+  Serial.print('\t');
+  Serial.print(1.0 * duration / ELEMENTS, 2);
+}
+
+
+//  -- END OF FILE --
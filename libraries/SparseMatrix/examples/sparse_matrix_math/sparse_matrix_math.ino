@@ -0,0 +1,77 @@
+//
+//    FILE: sparse_matrix_math.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: demo matrix x vector, transpose and CSR export
+//     URL: https://github.com/RobTillaart/SparseMatrix
+
+
+#include  "SparseMatrix.h"
+
+
+//  tridiagonal 8 x 8, e.g. a 1D smoothing / diffusion step.
+SparseMatrix sm(30, SPARSEMATRIX_SORTED);
+
+float state[8] = { 0, 0, 0, 10, 0, 0, 0, 0 };
+float next[8];
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println();
+  Serial.println(__FILE__);
+  Serial.print("SPARSEMATRIX_LIB_VERSION: ");
+  Serial.println(SPARSEMATRIX_LIB_VERSION);
+  Serial.println();
+
+  for (int i = 0; i < 8; i++)
+  {
+    sm.set(i, i, 0.5);
+    if (i > 0) sm.set(i - 1, i, 0.25);
+    if (i < 7) sm.set(i + 1, i, 0.25);
+  }
+
+  for (int step = 0; step < 5; step++)
+  {
+    sm.multiply(state, 8, next, 8);
+    for (int i = 0; i < 8; i++)
+    {
+      state[i] = next[i];
+      Serial.print(state[i], 3);
+      Serial.print('\t');
+    }
+    Serial.println();
+  }
+  Serial.println();
+
+  //  CSR export, e.g. to send to a host tool.
+  uint16_t rowStart[9];
+  uint8_t  column[30];
+  float    value[30];
+  if (sm.exportCSR(rowStart, 8, column, value, 30))
+  {
+    Serial.print("rowStart:");
+    for (int r = 0; r <= 8; r++)
+    {
+      Serial.print(' ');
+      Serial.print(rowStart[r]);
+    }
+    Serial.println();
+    Serial.print("column:  ");
+    for (int i = 0; i < sm.count(); i++)
+    {
+      Serial.print(' ');
+      Serial.print(column[i]);
+    }
+    Serial.println();
+  }
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+//  -- END OF FILE --
@@ -139,6 +139,219 @@ unittest(test_bounding_box)
 }
 
 
+unittest(test_modes)
+{
+  //  random set / add / clear against the LINEAR reference.
+  //  own LCG as random() does not work.
+  SparseMatrix ref(200);
+  SparseMatrix srt(200, SPARSEMATRIX_SORTED);
+  SparseMatrix hsh(200, SPARSEMATRIX_HASHED);
+  assertEqual(SPARSEMATRIX_LINEAR, ref.getMode());
+  assertEqual(SPARSEMATRIX_SORTED, srt.getMode());
+  assertEqual(SPARSEMATRIX_HASHED, hsh.getMode());
+  assertEqual(200, hsh.size());
+
+  uint32_t seed = 12345;
+  for (int i = 0; i < 20000; i++)
+  {
+    seed = seed * 1103515245UL + 12345;
+    uint8_t x = (seed >> 8) % 20;
+    uint8_t y = (seed >> 14) % 16;
+    float value = (int)((seed >> 20) % 5) - 2;  //  -2..2
+    if ((seed >> 28) < 8)
+    {
+      assertEqual(ref.set(x, y, value), srt.set(x, y, value));
+      assertEqual(ref.set(x, y, value), hsh.set(x, y, value));
+    }
+    else
+    {
+      bool r = ref.add(x, y, value);
+      assertEqual(r, srt.add(x, y, value));
+      assertEqual(r, hsh.add(x, y, value));
+    }
+    if (i % 5000 == 4999)
+    {
+      ref.clear();
+      srt.clear();
+      hsh.clear();
+    }
+  }
+  assertEqual(ref.count(), srt.count());
+  assertEqual(ref.count(), hsh.count());
+  for (uint8_t x = 0; x < 20; x++)
+  {
+    for (uint8_t y = 0; y < 16; y++)
+    {
+      assertEqual(ref.get(x, y), srt.get(x, y));
+      assertEqual(ref.get(x, y), hsh.get(x, y));
+    }
+  }
+}
+
+
+unittest(test_iterate)
+{
+  SparseMatrix sm(10, SPARSEMATRIX_SORTED);
+  uint8_t x, y;
+  float value;
+  assertFalse(sm.first(x, y, value));
+
+  sm.set(1, 2, 3);
+  sm.set(2, 1, 3);
+  sm.set(0, 2, 2);
+  sm.set(5, 0, 5);
+  //  sorted on y, then x
+  uint8_t xx[4] = { 5, 2, 0, 1 };
+  uint8_t yy[4] = { 0, 1, 2, 2 };
+  int n = 0;
+  for (bool ok = sm.first(x, y, value); ok; ok = sm.next(x, y, value))
+  {
+    assertEqual(xx[n], x);
+    assertEqual(yy[n], y);
+    n++;
+  }
+  assertEqual(4, n);
+}
+
+
+unittest(test_multiply_vector)
+{
+  //  M[y][x] = (x + 1) * (y + 1) on a diagonal band, 6 x 5
+  for (uint8_t mode = SPARSEMATRIX_LINEAR; mode <= SPARSEMATRIX_HASHED; mode++)
+  {
+    SparseMatrix sm(30, mode);
+    float dense[5][6] = { 0 };
+    for (int y = 4; y >= 0; y--)
+    {
+      for (int x = 0; x < 6; x++)
+      {
+        if (abs(x - y) <= 1)
+        {
+          sm.set(x, y, (x + 1) * (y + 1));
+          dense[y][x] = (x + 1) * (y + 1);
+        }
+      }
+    }
+    float v[6] = { 1, -2, 3, 0.5, 2, -1 };
+    float w[5] = { 2, 1, 0, -1, 3 };
+    float result[6];
+
+    assertTrue(sm.multiply(v, 6, result, 5));
+    for (int y = 0; y < 5; y++)
+    {
+      float expect = 0;
+      for (int x = 0; x < 6; x++) expect += dense[y][x] * v[x];
+      assertEqualFloat(expect, result[y], 0.0001);
+    }
+
+    assertTrue(sm.multiplyTransposed(w, 5, result, 6));
+    for (int x = 0; x < 6; x++)
+    {
+      float expect = 0;
+      for (int y = 0; y < 5; y++) expect += dense[y][x] * w[y];
+      assertEqualFloat(expect, result[x], 0.0001);
+    }
+
+    //  too small
+    assertFalse(sm.multiply(v, 4, result, 5));
+    assertFalse(sm.multiply(v, 6, result, 3));
+  }
+}
+
+
+unittest(test_multiply_matrix)
+{
+  for (uint8_t mode = SPARSEMATRIX_LINEAR; mode <= SPARSEMATRIX_HASHED; mode++)
+  {
+    SparseMatrix A(20, mode);
+    SparseMatrix B(20, mode);
+    SparseMatrix C(40, mode);
+    float a[4][4] = { { 1, 0, 2, 0 }, { 0, 3, 0, 0 }, { 4, 0, 0, 5 }, { 0, 0, 6, 0 } };
+    float b[4][4] = { { 0, 1, 0, 0 }, { 2, 0, 0, 3 }, { 0, 0, 4, 0 }, { 5, 0, 6, 0 } };
+    for (int y = 0; y < 4; y++)
+    {
+      for (int x = 0; x < 4; x++)
+      {
+        A.set(x, y, a[y][x]);
+        B.set(3 - x, y, b[y][3 - x]);
+      }
+    }
+    assertFalse(C.multiply(C, B));
+    assertTrue(C.multiply(A, B));
+    for (int y = 0; y < 4; y++)
+    {
+      for (int x = 0; x < 4; x++)
+      {
+        float expect = 0;
+        for (int k = 0; k < 4; k++) expect += a[y][k] * b[k][x];
+        assertEqualFloat(expect, C.get(x, y), 0.0001);
+      }
+    }
+
+    //  transpose
+    A.transpose();
+    for (int y = 0; y < 4; y++)
+    {
+      for (int x = 0; x < 4; x++)
+      {
+        assertEqualFloat(a[y][x], A.get(y, x), 0.0001);
+      }
+    }
+    //  scale
+    A.scale(2);
+    assertEqualFloat(2 * 21, A.sum(), 0.0001);
+    A.scale(0);
+    assertEqual(0, A.count());
+  }
+}
+
+
+unittest(test_export_import)
+{
+  for (uint8_t mode = SPARSEMATRIX_LINEAR; mode <= SPARSEMATRIX_HASHED; mode++)
+  {
+    SparseMatrix sm(10, mode);
+    sm.set(3, 2, 1);
+    sm.set(1, 0, 2);
+    sm.set(0, 2, 3);
+    sm.set(2, 1, 4);
+
+    uint8_t  x[10], y[10];
+    float    v[10];
+    assertFalse(sm.exportCOO(x, y, v, 3));
+    assertTrue(sm.exportCOO(x, y, v, 10));
+    uint8_t ex[4] = { 1, 2, 0, 3 };
+    uint8_t ey[4] = { 0, 1, 2, 2 };
+    for (int i = 0; i < 4; i++)
+    {
+      assertEqual(ex[i], x[i]);
+      assertEqual(ey[i], y[i]);
+    }
+
+    uint16_t rowStart[4];
+    assertFalse(sm.exportCSR(rowStart, 2, x, v, 10));
+    assertTrue(sm.exportCSR(rowStart, 3, x, v, 10));
+    assertEqual(0, rowStart[0]);
+    assertEqual(1, rowStart[1]);
+    assertEqual(2, rowStart[2]);
+    assertEqual(4, rowStart[3]);
+
+    SparseMatrix copy(10, mode);
+    assertTrue(copy.importCSR(rowStart, 3, x, v));
+    assertEqual(4, copy.count());
+    assertEqualFloat(1, copy.get(3, 2), 0.0001);
+    assertEqualFloat(4, copy.get(2, 1), 0.0001);
+
+    assertTrue(sm.exportCOO(x, y, v, 10));
+    assertTrue(copy.importCOO(x, y, v, 4));
+    assertEqual(4, copy.count());
+    assertEqualFloat(3, copy.get(0, 2), 0.0001);
+    assertTrue(copy.importCOO(x, y, v, 0));
+    assertEqual(0, copy.count());
+  }
+}
+
+
 unittest_main()
 
 
@@ -4,7 +4,7 @@
 //  AUTHOR: Rob Tillaart
 //          modified at 0.3 by Gil Ross at physics dot org
 //          template version 1.0.0 by Glen Cornell
-// VERSION: 1.0.1
+// VERSION: 1.1.0
 // PURPOSE: Recursive Statistical library for Arduino
 // HISTORY: See CHANGELOG.md
 //
@@ -37,7 +37,14 @@
 // and HAVE_STDCXX_CSTDINT feature macros in your build environment.
 
 
-#define STATISTIC_LIB_VERSION                     (F("1.0.1"))
+#define STATISTIC_LIB_VERSION                     (F("1.1.0"))
+
+
+// number of values processed per block by add(const T * data, size_t length)
+// the second pass over a block should run from cache.
+#ifndef STATISTIC_BLOCK_SIZE
+#define STATISTIC_BLOCK_SIZE                      256
+#endif
 
 
 #if defined (ARDUINO_AVR_UNO) || defined(ARDUINO_AVR_LEONARDO) || defined(ARDUINO_AVR_MEGA2560)
@@ -91,6 +98,9 @@ namespace std {
 #endif /* HAVE_STDCXX_CSTDINT */
 
 
+#include <stddef.h> // size_t
+
+
 #if HAVE_STDCXX_LIMITS || defined(_GLIBCXX_NUMERIC_LIMITS)
 #include <limits>
 #else
@@ -126,9 +136,11 @@ namespace std {
 
 namespace statistic {
 
-template <typename T = float, typename C = uint32_t, bool _useStdDev = true>
+template <typename T = float, typename C = uint32_t, bool _useStdDev = true, bool _useCompensation = false, bool _useMoments = false>
 class Statistic
 {
+  static_assert(!_useMoments || _useStdDev, "useMoments requires useStdDev");
+
 public:
   typedef T value_type;
   typedef C count_type;
@@ -144,6 +156,8 @@ public:
     _min = 0;
     _max = 0;
     _extra.clear();
+    _comp.clear();
+    _moments.clear();
     // NOTE: _extra "guards" the conditional code e.g. ssqdiff
     // NOTE: ssqdiff = not _ssq but sum of square differences
     // which is SUM(from i = 1 to N) of f(i)-_ave_N)**2
@@ -152,7 +166,7 @@ public:
 
   // returns value actually added
   value_type add(const value_type value) {
-    value_type previousSum = _sum;
+    value_type previousSum = sum();
     if (_cnt == 0)
     {
       _min = value;
@@ -161,12 +175,26 @@ public:
       if (value < _min) _min = value;
       else if (value > _max) _max = value;
     }
-    _sum += value;
+    _comp.add(_sum, value);
     _cnt++;
 
+    if (_useMoments && (_cnt > 1))
+    {
+      // Welford / Pebay update, needs M2 and M3 before the update.
+      value_type n       = _cnt;
+      value_type delta   = value - previousSum / (n - 1);
+      value_type deltaN  = delta / n;
+      value_type deltaN2 = deltaN * deltaN;
+      value_type term1   = delta * deltaN * (n - 1);
+      value_type m2      = _extra.ssqdif();
+      value_type m3      = _moments.m3();
+      _moments.m4(_moments.m4() + term1 * deltaN2 * (n * n - 3 * n + 3) + 6 * deltaN2 * m2 - 4 * deltaN * m3);
+      _moments.m3(m3 + term1 * deltaN * (n - 2) - 3 * deltaN * m2);
+    }
+
     if (_useStdDev && (_cnt > 1))
     {
-      value_type _store = (_sum / _cnt - value);
+      value_type _store = (sum() / _cnt - value);
       _extra.ssqdif(_extra.ssqdif() + _cnt * _store * _store / (_cnt - 1));
 
       // NOTE: pre 1.0.0 code
@@ -177,13 +205,38 @@ public:
       // solution:  TODO verify
       // _ssqdif = _ssqdif + (_store * _store / _cnt) / (_cnt - 1);
     }
-    return _sum - previousSum;
+    return sum() - previousSum;
+  }
+
+
+  // adds an array of values, same result as calling add() for every value.
+  // processed in blocks, every block is summarized with two passes
+  // (sum, min, max first, then the central moments) and merged.
+  // Independent partial sums allow the compiler to pipeline or vectorize.
+  void add(const value_type * data, const size_t length) {
+    size_t i = 0;
+    while (i < length)
+    {
+      size_t n = length - i;
+      if (n > STATISTIC_BLOCK_SIZE) n = STATISTIC_BLOCK_SIZE;
+      _addBlock(data + i, n);
+      i += n;
+    }
+  }
+
+
+  // combines the statistics of another accumulator with this one,
+  // as if all its values were added to this one (Chan et al.)
+  // e.g. one accumulator per core or sensor task, merged at report time.
+  void merge(const Statistic & other) {
+    _merge(other._cnt, other.sum(), other._min, other._max,
+           other._extra.ssqdif(), other._moments.m3(), other._moments.m4());
   }
 
 
   // returns the number of values added
   count_type count() const   { return _cnt; };   // zero if count == zero
-  value_type sum() const     { return _sum; };   // zero if count == zero
+  value_type sum() const     { return _sum + _comp.correction(); };   // zero if count == zero
   value_type minimum() const { return _min; };   // zero if count == zero
   value_type maximum() const { return _max; };   // zero if count == zero
 
@@ -191,7 +244,7 @@ public:
   // NAN if count == zero
   value_type average() const {
     if (_cnt == 0) return NaN; // prevent DIV0 error
-    return _sum / _cnt;
+    return sum() / _cnt;
   }
 
 
@@ -219,6 +272,34 @@ public:
   }
 
 
+  // useMoments must be true to use next three
+  // all return NAN if count == zero or variance == zero
+  // population skewness, 0 for symmetric data
+  value_type skewness() const {
+    if (!_useMoments) return NaN;
+    value_type m2 = _extra.ssqdif();
+    if ((_cnt == 0) || (m2 == 0)) return NaN;
+    value_type n = _cnt;
+    return std::sqrt(n) * _moments.m3() / (m2 * std::sqrt(m2));
+  }
+
+
+  // population kurtosis, 3 for normal distribution
+  value_type kurtosis() const {
+    if (!_useMoments) return NaN;
+    value_type m2 = _extra.ssqdif();
+    if ((_cnt == 0) || (m2 == 0)) return NaN;
+    value_type n = _cnt;
+    return n * _moments.m4() / (m2 * m2);
+  }
+
+
+  // kurtosis - 3, 0 for normal distribution
+  value_type excess_kurtosis() const {
+    return kurtosis() - 3;
+  }
+
+
   // deprecated methods:
   Statistic(bool) {
   } __attribute__ ((deprecated ("use default constructor instead")));
@@ -251,6 +332,160 @@ protected:
 
 
   typename std::conditional<_useStdDev, StdDev, Empty>::type _extra;
+
+
+  // Neumaier's improved Kahan summation, the exact rounding error of every
+  // addition is collected in _c and folded back into the sum so _c stays
+  // small and sum() does not drift.
+  // Note: do not compile with -ffast-math, it removes the compensation.
+  struct NoCompensation {
+    void clear() { }
+    value_type correction() const { return 0; }
+    void add(value_type & sum, const value_type value) { sum += value; }
+  };
+
+
+  struct Compensation {
+    value_type    _c { 0.0 };         // running compensation
+    void clear() { _c = 0.0; }
+    value_type correction() const { return _c; }
+    void add(value_type & sum, const value_type value) {
+      value_type t = sum + value;
+      value_type absSum   = sum < 0 ? -sum : sum;
+      value_type absValue = value < 0 ? -value : value;
+      if (absSum >= absValue) _c += (sum - t) + value;
+      else                    _c += (value - t) + sum;
+      sum = t + _c;
+      _c -= sum - t;
+    }
+  };
+
+
+  typename std::conditional<_useCompensation, Compensation, NoCompensation>::type _comp;
+
+
+  // third and fourth central moment sums for skewness and kurtosis
+  struct NoMoments {
+    void clear() { }
+    value_type m3() const { return NaN; }
+    void m3(value_type v) { }
+    value_type m4() const { return NaN; }
+    void m4(value_type v) { }
+  };
+
+
+  struct Moments {
+    value_type    _m3 { 0.0 };        // sum of cubed differences
+    value_type    _m4 { 0.0 };        // sum of 4th power differences
+    void clear() { _m3 = 0.0; _m4 = 0.0; }
+    value_type m3() const { return _m3; }
+    void m3(value_type v) { _m3 = v; }
+    value_type m4() const { return _m4; }
+    void m4(value_type v) { _m4 = v; }
+  };
+
+
+  typename std::conditional<_useMoments, Moments, NoMoments>::type _moments;
+
+
+  // summarize one block and merge it.
+  void _addBlock(const value_type * data, const size_t length) {
+    if (length == 0) return;
+
+    // pass 1: sum, minimum and maximum
+    value_type s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    value_type mn = data[0];
+    value_type mx = data[0];
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+      s0 += data[i];
+      s1 += data[i + 1];
+      s2 += data[i + 2];
+      s3 += data[i + 3];
+    }
+    for (; i < length; i++) s0 += data[i];
+    for (i = 1; i < length; i++)
+    {
+      if (data[i] < mn) mn = data[i];
+      if (data[i] > mx) mx = data[i];
+    }
+    value_type blockSum = (s0 + s1) + (s2 + s3);
+
+    // pass 2: central moments
+    value_type m2 = 0;
+    value_type m3 = 0;
+    value_type m4 = 0;
+    if (_useStdDev)
+    {
+      value_type mean = blockSum / length;
+      value_type q0 = 0, q1 = 0;
+      for (i = 0; i + 2 <= length; i += 2)
+      {
+        value_type d0 = data[i] - mean;
+        value_type d1 = data[i + 1] - mean;
+        q0 += d0 * d0;
+        q1 += d1 * d1;
+        if (_useMoments)
+        {
+          m3 += d0 * d0 * d0 + d1 * d1 * d1;
+          m4 += d0 * d0 * d0 * d0 + d1 * d1 * d1 * d1;
+        }
+      }
+      for (; i < length; i++)
+      {
+        value_type d = data[i] - mean;
+        q0 += d * d;
+        if (_useMoments)
+        {
+          m3 += d * d * d;
+          m4 += d * d * d * d;
+        }
+      }
+      m2 = q0 + q1;
+    }
+    _merge(length, blockSum, mn, mx, m2, m3, m4);
+  }
+
+
+  // Chan et al. for M2, Pebay for M3 and M4.
+  void _merge(count_type cntB, value_type sumB, value_type minB, value_type maxB,
+              value_type m2B, value_type m3B, value_type m4B) {
+    if (cntB == 0) return;
+    if (_cnt == 0)
+    {
+      _min = minB;
+      _max = maxB;
+    } else {
+      if (minB < _min) _min = minB;
+      if (maxB > _max) _max = maxB;
+    }
+
+    if (_useStdDev)
+    {
+      value_type nA = _cnt;
+      value_type nB = cntB;
+      value_type n  = nA + nB;
+      value_type delta = sumB / nB - ((_cnt == 0) ? 0 : sum() / nA);
+      value_type m2A = _extra.ssqdif();
+      if (_useMoments)
+      {
+        value_type m3A = _moments.m3();
+        value_type m4A = _moments.m4();
+        value_type delta2 = delta * delta;
+        _moments.m4(m4A + m4B
+                    + delta2 * delta2 * nA * nB * (nA * nA - nA * nB + nB * nB) / (n * n * n)
+                    + 6 * delta2 * (nA * nA * m2B + nB * nB * m2A) / (n * n)
+                    + 4 * delta * (nA * m3B - nB * m3A) / n);
+        _moments.m3(m3A + m3B
+                    + delta2 * delta * nA * nB * (nA - nB) / (n * n)
+                    + 3 * delta * (nA * m2B - nB * m2A) / n);
+      }
+      _extra.ssqdif(m2A + m2B + delta * delta * nA * nB / n);
+    }
+    _comp.add(_sum, sumB);
+    _cnt += cntB;
+  }
 };
 
 } // namespace statistic
@@ -0,0 +1,70 @@
+//
+//    FILE: statistic_merge.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: demo merge() of accumulators and add() of an array
+//     URL: https://github.com/RobTillaart/Statistic
+//
+//  Every sensor (or task / core) has its own accumulator,
+//  they are merged when a report is made.
+
+
+#include "Statistic.h"
+
+//  float, uint32_t, stddev, no compensation, skewness + kurtosis
+typedef statistic::Statistic<float, uint32_t, true, false, true> Stat;
+
+Stat sensorA;
+Stat sensorB;
+
+float buffer[100];
+
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("Demo Statistics lib ");
+  Serial.println(STATISTIC_LIB_VERSION);
+}
+
+
+void loop(void)
+{
+  //  sensor A adds one value at a time
+  for (int i = 0; i < 100; i++)
+  {
+    sensorA.add(random(0, 1000) * 0.01);
+  }
+
+  //  sensor B fills a buffer, e.g. by DMA, and adds it in one call
+  for (int i = 0; i < 100; i++)
+  {
+    buffer[i] = 5 + random(0, 1000) * 0.001;
+  }
+  sensorB.add(buffer, 100);
+
+  if (sensorA.count() >= 10000)
+  {
+    Stat total;
+    total.merge(sensorA);
+    total.merge(sensorB);
+
+    Serial.print("        Count: ");
+    Serial.println(total.count());
+    Serial.print("      Average: ");
+    Serial.println(total.average(), 4);
+    Serial.print("    Std. dev.: ");
+    Serial.println(total.unbiased_stdev(), 4);
+    Serial.print("     Skewness: ");
+    Serial.println(total.skewness(), 4);
+    Serial.print("     Kurtosis: ");
+    Serial.println(total.kurtosis(), 4);
+    Serial.println();
+
+    sensorA.clear();
+    sensorB.clear();
+  }
+}
+
+
+// -- END OF FILE --
@@ -81,6 +81,98 @@ unittest(test_basic)
 }
 
 
+unittest(test_compensation)
+{
+  statistic::Statistic<float, uint32_t, true, false> plain;
+  statistic::Statistic<float, uint32_t, true, true>  kahan;
+
+  //  0.1 is not exact in float, plain summation drifts.
+  for (uint32_t i = 0; i < 1000000; i++)
+  {
+    plain.add(0.1);
+    kahan.add(0.1);
+  }
+  assertEqual(1000000, kahan.count());
+  assertEqualFloat(100000, kahan.sum(), 0.01);
+  assertEqualFloat(0.1, kahan.average(), 1e-7);
+  assertMore(fabs(plain.sum() - 100000), 1.0);
+
+  kahan.clear();
+  assertEqualFloat(0, kahan.sum(), 0.0001);
+  assertEqual(0, kahan.count());
+}
+
+
+//  deterministic test data, not symmetric so skewness != 0
+static float testValue(uint32_t & seed)
+{
+  seed = seed * 1103515245 + 12345;
+  float f = (seed >> 16) / 65536.0;
+  return 10 + 5 * f * f;
+}
+
+
+unittest(test_merge)
+{
+  typedef statistic::Statistic<double, uint32_t, true, false, true> Stat;
+  Stat serial;
+  Stat part[4];
+
+  uint32_t seed = 1;
+  for (int i = 0; i < 10000; i++)
+  {
+    float value = testValue(seed);
+    serial.add(value);
+    part[i % 3].add(value);   //  part[3] stays empty
+  }
+  Stat merged;
+  for (int p = 0; p < 4; p++) merged.merge(part[p]);
+
+  assertEqual(serial.count(), merged.count());
+  assertEqualFloat(serial.sum(),             merged.sum(),             1e-6);
+  assertEqualFloat(serial.minimum(),         merged.minimum(),         1e-9);
+  assertEqualFloat(serial.maximum(),         merged.maximum(),         1e-9);
+  assertEqualFloat(serial.average(),         merged.average(),         1e-9);
+  assertEqualFloat(serial.variance(),        merged.variance(),        1e-9);
+  assertEqualFloat(serial.skewness(),        merged.skewness(),        1e-9);
+  assertEqualFloat(serial.kurtosis(),        merged.kurtosis(),        1e-9);
+  //  x^2 with x uniform 0..1, skewness 0.639, kurtosis 2.143
+  assertEqualFloat(0.639, serial.skewness(), 0.02);
+  assertEqualFloat(2.143, serial.kurtosis(), 0.05);
+  assertEqualFloat(-0.857, serial.excess_kurtosis(), 0.05);
+}
+
+
+unittest(test_add_array)
+{
+  const int N = 1000;
+  float data[N];
+  uint32_t seed = 7;
+  for (int i = 0; i < N; i++) data[i] = testValue(seed);
+
+  statistic::Statistic<float, uint32_t, true, false, true> serial;
+  statistic::Statistic<float, uint32_t, true, false, true> block;
+  for (int i = 0; i < N; i++) serial.add(data[i]);
+  block.add(data, 3);           //  odd sizes and several blocks
+  block.add(data + 3, N - 3);
+
+  assertEqual(serial.count(), block.count());
+  assertEqualFloat(serial.sum(),            block.sum(),            0.05);
+  assertEqualFloat(serial.minimum(),        block.minimum(),        0);
+  assertEqualFloat(serial.maximum(),        block.maximum(),        0);
+  assertEqualFloat(serial.average(),        block.average(),        1e-4);
+  assertEqualFloat(serial.unbiased_stdev(), block.unbiased_stdev(), 1e-4);
+  assertEqualFloat(serial.skewness(),       block.skewness(),       1e-3);
+  assertEqualFloat(serial.kurtosis(),       block.kurtosis(),       1e-3);
+
+  //  without standard deviation
+  statistic::Statistic<float, uint32_t, false> simple;
+  simple.add(data, N);
+  assertEqual(N, simple.count());
+  assertEqualFloat(serial.average(), simple.average(), 1e-4);
+  assertNAN(simple.variance());
+}
+
 
 unittest_main()
 
@@ -1,7 +1,7 @@
 //
 //    FILE: UUID.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.4
+// VERSION: 0.2.0
 //    DATE: 2022-06-14
 // PURPOSE: Arduino Library for generating UUID's
 //     URL: https://github.com/RobTillaart/UUID
@@ -29,58 +29,75 @@ void UUID::seed(uint32_t s1, uint32_t s2)
 }
 
 
-//  check version 0.1.1 for more readable code
 void UUID::generate()
 {
-  uint32_t ar[4];
-  for (uint8_t i = 0; i < 4; i++)
+  _generate(_ar);
+  _formatted = false;
+}
+
+
+void UUID::generate(uint8_t * array, uint16_t count)
+{
+  while (count--)
   {
-    ar[i] = _random();
-    //  store binary version globally ?
-    //  _ar[i] = ar[i];
+    _generate(array);
+    array += UUID_SIZE;
   }
+}
 
-  //  Conforming to RFC 4122 Specification
-  //  - byte 7: four most significant bits ==> 0100  --> always 4
-  //  - byte 9: two  most significant bits ==> 10    --> always {8, 9, A, B}.
-  //
-  //  patch bits for version 1 and variant 4 here
-  if (_mode == UUID_MODE_VARIANT4)
+
+char * UUID::toCharArray()
+{
+  if (_formatted == false)
   {
-    ar[1] &= 0xFFF0FFFF;   //  remove 4 bits.
-    ar[1] |= 0x00040000;   //  variant 4
-    ar[2] &= 0xFFFFFFF3;   //  remove 2 bits
-    ar[2] |= 0x00000008;   //  version 1
+    format(_ar, _buffer);
+    _formatted = true;
   }
+  return _buffer;
+}
 
 
-  //  process 16 bytes build up the char array.
-  for (uint8_t i = 0, j = 0; i < 16; i++)
-  {
-    //  multiples of 4 between 8 and 20 get a -.
-    //  but note we are doing 2 digits in one loop.
-    if ((i & 0x1) == 0)
-    {
-      if ((4 <= i) && (i <= 10))  _buffer[j++] = '-';
-    }
+void UUID::getBinary(uint8_t * array)
+{
+  memcpy(array, _ar, UUID_SIZE);
+}
 
-    //  process one byte at the time instead of a nibble
-    uint8_t nr   = i / 4;
-    uint8_t xx   = ar[nr];
-    uint8_t ch   = xx & 0x0F;
-    _buffer[j++]   = (ch < 10) ? '0' + ch : ('a' - 10) + ch;
 
-    ch   = (xx >> 4) & 0x0F;
-    ar[nr] >>= 8;
-    _buffer[j++]   = (ch < 10) ? '0' + ch : ('a' - 10) + ch;
+char * UUID::format(const uint8_t * uuid, char * buffer)
+{
+  static const char hex[17] = "0123456789abcdef";
+  char * p = buffer;
+  for (uint8_t i = 0; i < UUID_SIZE; i++)
+  {
+    //  bytes 4, 6, 8 and 10 are preceded by a -.
+    if ((i >= 4) && (i <= 10) && ((i & 0x01) == 0)) *p++ = '-';
+    uint8_t b = uuid[i];
+    *p++ = hex[b >> 4];
+    *p++ = hex[b & 0x0F];
   }
-  _buffer[36] = 0;
+  *p = 0;
+  return buffer;
 }
 
 
-char * UUID::toCharArray()
+//////////////////////////////////////////////////
+//
+//  VERSION 7 TIME
+//
+void UUID::setTime(uint64_t unixMillis)
 {
-  return _buffer;
+  _lastMillis = millis();
+  _timeOffset = unixMillis - _lastMillis;
+}
+
+
+uint64_t UUID::getTime()
+{
+  uint32_t now = millis();
+  //  millis() wraps around after ~49 days.
+  if (now < _lastMillis) _timeOffset += 0x100000000ULL;
+  _lastMillis = now;
+  return _timeOffset + now;
 }
 
 
@@ -90,10 +107,82 @@ char * UUID::toCharArray()
 //
 size_t UUID::printTo(Print& p) const
 {
-  return p.print(_buffer);
+  if (_formatted) return p.print(_buffer);
+  char buffer[37];
+  return p.print(format(_ar, buffer));
 };
 
 
+//////////////////////////////////////////////////
+//
+//  PRIVATE
+//
+void UUID::_generate(uint8_t * uuid)
+{
+  if (_mode == UUID_MODE_VERSION7)
+  {
+    //  RFC 9562, 48 bit time stamp, 12 bit sequence, 62 random bits.
+    //  sequence starts random (11 bits) every new millisecond
+    //  so UUID's within the same millisecond stay ordered.
+    uint64_t ts = getTime();
+    if (ts <= _lastTime)
+    {
+      ts = _lastTime;
+      if (++_sequence > 0x0FFF)
+      {
+        ts++;
+        _sequence = _random() & 0x07FF;
+      }
+    }
+    else
+    {
+      _sequence = _random() & 0x07FF;
+    }
+    _lastTime = ts;
+
+    for (int8_t i = 5; i >= 0; i--)
+    {
+      uuid[i] = ts & 0xFF;
+      ts >>= 8;
+    }
+    uuid[6] = 0x70 | (_sequence >> 8);
+    uuid[7] = _sequence & 0xFF;
+    uint32_t r = _random();
+    uuid[8]  = 0x80 | (r & 0x3F);
+    uuid[9]  = r >> 8;
+    uuid[10] = r >> 16;
+    uuid[11] = r >> 24;
+    r = _random();
+    uuid[12] = r;
+    uuid[13] = r >> 8;
+    uuid[14] = r >> 16;
+    uuid[15] = r >> 24;
+    return;
+  }
+
+  //  the nibbles are swapped to keep the UUID strings of
+  //  0.1.x for the same seed.
+  for (uint8_t i = 0; i < UUID_SIZE; i += 4)
+  {
+    uint32_t r = _random();
+    r = ((r & 0x0F0F0F0F) << 4) | ((r >> 4) & 0x0F0F0F0F);
+    uuid[i]     = r;
+    uuid[i + 1] = r >> 8;
+    uuid[i + 2] = r >> 16;
+    uuid[i + 3] = r >> 24;
+  }
+
+  //  Conforming to RFC 4122 Specification
+  //  - byte 6: four most significant bits ==> 0100  --> always 4
+  //  - byte 8: two  most significant bits ==> 10    --> always {8, 9, A, B}.
+  if (_mode == UUID_MODE_VARIANT4)
+  {
+    uuid[6] = (uuid[6] & 0x0F) | 0x40;   //  version 4
+    uuid[8] = (uuid[8] & 0x3F) | 0x80;   //  variant 1
+  }
+}
+
+
 //////////////////////////////////////////////////
 //
 //  RANDOM GENERATOR MARSAGLIA
@@ -103,6 +192,7 @@ size_t UUID::printTo(Print& p) const
 //  two initializers (not null)
 uint32_t UUID::_random()
 {
+  if (_rng != NULL) return _rng();
   _m_z = 36969L * (_m_z & 65535L) + (_m_z >> 16);
   _m_w = 18000L * (_m_w & 65535L) + (_m_w >> 16);
   return (_m_z << 16) + _m_w;  /* 32-bit result */
@@ -2,7 +2,7 @@
 //
 //    FILE: UUID.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.4
+// VERSION: 0.2.0
 //    DATE: 2022-06-14
 // PURPOSE: Arduino Library for generating UUID's
 //     URL: https://github.com/RobTillaart/UUID
@@ -15,11 +15,20 @@
 #include "Printable.h"
 
 
-#define UUID_LIB_VERSION              (F("0.1.4"))
+#define UUID_LIB_VERSION              (F("0.2.0"))
 
 //  TODO an enum?
 const uint8_t UUID_MODE_VARIANT4 = 0;
 const uint8_t UUID_MODE_RANDOM   = 1;
+const uint8_t UUID_MODE_VERSION7 = 2;
+
+
+//  binary UUID size in bytes.
+#define UUID_SIZE                     16
+
+
+//  external random generator, must return 32 random bits.
+typedef uint32_t (*UUID_random_t)(void);
 
 
 /////////////////////////////////////////////////
@@ -33,16 +42,33 @@ public:
 
   //  at least one seed value is mandatory, two is better.
   void     seed(uint32_t s1, uint32_t s2 = 0);
+  //  use an external generator e.g. hardware RNG, NULL = internal Marsaglia.
+  void     setRandomGenerator(UUID_random_t rng = NULL) { _rng = rng; };
+
   //  generate a new UUID
   void     generate();
-  //  make a UUID string
+  //  generate count binary UUID's of UUID_SIZE bytes in array,
+  //  no string formatting, the UUID of generate() is not changed.
+  void     generate(uint8_t * array, uint16_t count);
+  //  make a UUID string (formatted on first call after generate())
   char *   toCharArray();
+  //  copy the UUID_SIZE bytes of the last generated UUID.
+  void     getBinary(uint8_t * array);
+
+  //  formats a binary UUID as 36 chars + '\0', returns buffer.
+  static char * format(const uint8_t * uuid, char * buffer);
 
   //  MODE
   void     setVariant4Mode() { _mode = UUID_MODE_VARIANT4; };
   void     setRandomMode()   { _mode = UUID_MODE_RANDOM; };
+  //  time ordered UUID, RFC 9562, needs setTime() for a real time stamp.
+  void     setVersion7Mode() { _mode = UUID_MODE_VERSION7; };
   uint8_t  getMode() { return _mode; };
 
+  //  VERSION 7 TIME, milliseconds since 1970-01-01 (unix time * 1000)
+  void     setTime(uint64_t unixMillis);
+  uint64_t getTime();
+
   //  Printable interface
   size_t   printTo(Print& p) const;
 
@@ -52,9 +78,20 @@ private:
   uint32_t _m_w = 1;
   uint32_t _m_z = 2;
   uint32_t _random();
+  UUID_random_t _rng = NULL;
+
+  void     _generate(uint8_t * uuid);
+
+  //  version 7 state
+  uint64_t _timeOffset = 0;
+  uint32_t _lastMillis = 0;
+  uint64_t _lastTime   = 0;
+  uint16_t _sequence   = 0;
 
-  //  UUID in string format
+  //  UUID in binary and string format
+  uint8_t  _ar[UUID_SIZE];
   char     _buffer[37];
+  bool     _formatted = false;
   uint8_t  _mode = UUID_MODE_VARIANT4;
 };
 
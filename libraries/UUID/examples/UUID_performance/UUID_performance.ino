@@ -10,6 +10,9 @@
 
 UUID uuid;
 
+uint8_t batch[16 * UUID_SIZE];
+char    buffer[37];
+
 
 void setup()
 {
@@ -44,6 +47,55 @@ void setup()
   Serial.print("Generate R: ");
   Serial.print(count);
   Serial.println(" uuid's per second.");
+
+  //  generate() only makes the binary UUID, toCharArray() formats.
+  count = 0;
+  uuid.setVariant4Mode();
+  start = millis();
+  while (millis() - start < 1000)
+  {
+    uuid.generate();
+    uuid.toCharArray();
+    count++;
+  }
+  Serial.print("Generate 4 + toCharArray: ");
+  Serial.print(count);
+  Serial.println(" uuid's per second.");
+
+  //  binary batches of 16
+  uint32_t total = 0;
+  start = millis();
+  while (millis() - start < 1000)
+  {
+    uuid.generate(batch, 16);
+    total += 16;
+  }
+  Serial.print("Generate batch 4: ");
+  Serial.print(total);
+  Serial.println(" uuid's per second.");
+
+  total = 0;
+  uuid.setVersion7Mode();
+  start = millis();
+  while (millis() - start < 1000)
+  {
+    uuid.generate(batch, 16);
+    total += 16;
+  }
+  Serial.print("Generate batch 7: ");
+  Serial.print(total);
+  Serial.println(" uuid's per second.");
+
+  count = 0;
+  start = millis();
+  while (millis() - start < 1000)
+  {
+    UUID::format(batch + (count & 15) * UUID_SIZE, buffer);
+    count++;
+  }
+  Serial.print("format: ");
+  Serial.print(count);
+  Serial.println(" uuid's per second.");
 }
 
 
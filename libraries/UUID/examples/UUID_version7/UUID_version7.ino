@@ -0,0 +1,67 @@
+//
+//    FILE: UUID_version7.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: demo time ordered UUID's with an external random generator
+//     URL: https://github.com/RobTillaart/UUID
+//
+//  Version 7 UUID's start with a 48 bit unix time stamp in milliseconds,
+//  so they sort in creation order, which keeps database indices compact.
+
+
+#include "Arduino.h"
+#include "UUID.h"
+
+
+UUID uuid;
+
+uint8_t batch[8 * UUID_SIZE];
+char    buffer[37];
+
+
+//  any function returning 32 random bits can be used,
+//  e.g. esp_random() on ESP32 or a Prandom object.
+uint32_t myRandom()
+{
+  return ((uint32_t)random(0x10000) << 16) | random(0x10000);
+}
+
+
+void setup()
+{
+  Serial.begin(115200);
+  while (!Serial);
+
+  Serial.println();
+  Serial.println("UUID_version7.ino");
+  Serial.print("UUID_LIB_VERSION: ");
+  Serial.println(UUID_LIB_VERSION);
+  Serial.println();
+
+  uuid.setRandomGenerator(myRandom);
+  uuid.setVersion7Mode();
+  //  get the time from NTP or an RTC, here 2026-01-01 00:00:00 UTC
+  uuid.setTime(1767225600000ULL);
+
+  for (int i = 0; i < 4; i++)
+  {
+    uuid.generate();
+    Serial.println(uuid);
+    delay(10);
+  }
+  Serial.println();
+
+  //  a batch within the same millisecond is ordered by the sequence field.
+  uuid.generate(batch, 8);
+  for (int i = 0; i < 8; i++)
+  {
+    Serial.println(UUID::format(batch + i * UUID_SIZE, buffer));
+  }
+}
+
+
+void loop()
+{
+}
+
+
+// -- END OF FILE --
@@ -42,6 +42,8 @@ unittest(test_constants)
 {
   assertEqual(0, UUID_MODE_VARIANT4);
   assertEqual(1, UUID_MODE_RANDOM);
+  assertEqual(2, UUID_MODE_VERSION7);
+  assertEqual(16, UUID_SIZE);
 }
 
 
@@ -99,6 +101,122 @@ unittest(test_mode)
   assertEqual(UUID_MODE_RANDOM, uuid.getMode());
   uuid.setVariant4Mode();
   assertEqual(UUID_MODE_VARIANT4, uuid.getMode());
+  uuid.setVersion7Mode();
+  assertEqual(UUID_MODE_VERSION7, uuid.getMode());
+}
+
+
+unittest(test_compatible)
+{
+  UUID uuid;
+
+  //  same output as 0.1.4 for the same seed.
+  uuid.seed(12345, 6789);
+  uuid.generate();
+  assertEqual(0, strcmp("0d7abcdb-e3e5-4e6f-b759-35872195aa6e", uuid.toCharArray()));
+  uuid.generate();
+  assertEqual(0, strcmp("daae1236-68cb-48b7-85ec-72ba706a1605", uuid.toCharArray()));
+  uuid.generate();
+  assertEqual(0, strcmp("bd4079a8-a049-4728-9700-a45293b42077", uuid.toCharArray()));
+  uuid.setRandomMode();
+  uuid.generate();
+  assertEqual(0, strcmp("0f71dd58-9af2-7f7f-3612-6fe870e8dc54", uuid.toCharArray()));
+}
+
+
+unittest(test_format_binary)
+{
+  UUID uuid;
+  uint8_t bin[UUID_SIZE];
+  char    buf[37];
+
+  for (uint8_t i = 0; i < UUID_SIZE; i++) bin[i] = i * 17;
+  UUID::format(bin, buf);
+  assertEqual(0, strcmp("00112233-4455-6677-8899-aabbccddeeff", buf));
+
+  uuid.generate();
+  uuid.getBinary(bin);
+  assertEqual(0, strcmp(uuid.toCharArray(), UUID::format(bin, buf)));
+  assertEqual(0x40, bin[6] & 0xF0);
+  assertEqual(0x80, bin[8] & 0xC0);
+}
+
+
+unittest(test_batch)
+{
+  UUID uuid;
+  uint8_t batch[20 * UUID_SIZE];
+  char before[37];
+
+  strcpy(before, uuid.toCharArray());
+  uuid.generate(batch, 20);
+  //  current UUID not changed
+  assertEqual(0, strcmp(before, uuid.toCharArray()));
+
+  for (int i = 0; i < 20; i++)
+  {
+    uint8_t * p = batch + i * UUID_SIZE;
+    assertEqual(0x40, p[6] & 0xF0);
+    assertEqual(0x80, p[8] & 0xC0);
+    for (int j = 0; j < i; j++)
+    {
+      assertNotEqual(0, memcmp(p, batch + j * UUID_SIZE, UUID_SIZE));
+    }
+  }
+}
+
+
+uint32_t counter = 0;
+uint32_t countingRNG()
+{
+  return counter++;
+}
+
+
+unittest(test_random_generator)
+{
+  UUID uuid;
+  uuid.setRandomMode();
+  uuid.setRandomGenerator(countingRNG);
+
+  counter = 0x10325476;
+  uuid.generate();
+  //  bytes are the nibble swapped 0.1.x words, LSB first.
+  assertEqual(0, strcmp("67452301-7745-2301-8745-230197452301", uuid.toCharArray()));
+
+  //  back to internal generator
+  uuid.setRandomGenerator();
+  uuid.generate();
+  assertEqual(0x10325476 + 4, counter);
+}
+
+
+unittest(test_version7)
+{
+  UUID uuid;
+  uint8_t batch[100 * UUID_SIZE];
+
+  uuid.setVersion7Mode();
+  //  2026-01-01 00:00:00 UTC
+  uuid.setTime(1767225600000ULL);
+  uint64_t t = uuid.getTime();
+  assertMoreOrEqual(t, 1767225600000ULL);
+  assertLess(t, 1767225600000ULL + 1000);
+
+  uuid.generate();
+  char * u = uuid.toCharArray();
+  fprintf(stderr, ">%s<\n", u);
+  assertEqual('7', u[14]);
+  assertTrue((u[19] == '8') || (u[19] == '9') || (u[19] == 'a') || (u[19] == 'b'));
+  //  time stamp 0x019b77... in the first 12 digits
+  assertEqual(0, strncmp("019b7", u, 5));
+
+  //  strictly increasing, also within the same millisecond
+  uuid.generate(batch, 100);
+  for (int i = 1; i < 100; i++)
+  {
+    assertLess(0, memcmp(batch + i * UUID_SIZE, batch + (i - 1) * UUID_SIZE, UUID_SIZE));
+  }
 }
 
 
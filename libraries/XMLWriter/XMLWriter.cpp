@@ -1,7 +1,7 @@
 //
 //    FILE: XMLWriter.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.3.3
+// VERSION: 0.4.0
 //    DATE: 2013-11-06
 // PURPOSE: Arduino library for creating XML
 
@@ -9,10 +9,23 @@
 #include "XMLWriter.h"
 
 
-XMLWriter::XMLWriter(Print* stream, uint8_t bufferSize)
+XMLWriter::XMLWriter(Print* stream, size_t bufferSize)
 {
-  _bufferSize = constrain(bufferSize, 2, 250);
+  _bufferSize = max(bufferSize, (size_t)2);
   _buffer = (char *) malloc(_bufferSize);
+  if (_buffer == NULL) _bufferSize = 0;
+  _ownBuffer = true;
+  _stream = stream;
+  reset();
+}
+
+
+XMLWriter::XMLWriter(Print* stream, char * buffer, size_t bufferSize)
+{
+  _bufferSize = bufferSize;
+  _buffer = buffer;
+  if ((_buffer == NULL) || (_bufferSize < 2)) _bufferSize = 0;
+  _ownBuffer = false;
   _stream = stream;
   reset();
 }
@@ -20,7 +33,7 @@ XMLWriter::XMLWriter(Print* stream, uint8_t bufferSize)
 
 XMLWriter::~XMLWriter()
 {
-  if (_buffer != NULL) free(_buffer);
+  if (_ownBuffer && (_buffer != NULL)) free(_buffer);
 }
 
 
@@ -65,7 +78,7 @@ void XMLWriter::debug()
   print(F("  INDENT: "));
   println(_indent);
   print(F(" BUFSIZE: "));
-  println(_bufferSize);
+  println((uint32_t)_bufferSize);
   print(F(" -->\n"));
 }
 
@@ -198,7 +211,7 @@ void XMLWriter::tagField(const char *field, const uint32_t value, const uint8_t
   print(' ');
   print(field);
   print("=\"");
-  print(value, base);
+  _writeNumber(value, base);
   print('"');
 }
 
@@ -226,7 +239,7 @@ void XMLWriter::tagField(const char *field, const int32_t value, const uint8_t b
   print(' ');
   print(field);
   print("=\"");
-  print(value, base);
+  _writeNumber(value, base);
   print('"');
 }
 
@@ -240,12 +253,18 @@ void XMLWriter::tagField(const char *field, const bool value)
 }
 
 
+void XMLWriter::tagField(const char *field, const float value, const uint8_t decimals)
+{
+  tagField(field, (double) value, decimals);
+}
+
+
 void XMLWriter::tagField(const char *field, const double value, const uint8_t decimals)
 {
   print(' ');
   print(field);
   print(F("=\""));
-  print(value, decimals);
+  _writeFloat(value, decimals);
   print('"');
 }
 
@@ -269,7 +288,7 @@ void XMLWriter::writeNode(const char* tag, const uint16_t value, const uint8_t b
 void XMLWriter::writeNode(const char* tag, const uint32_t value, const uint8_t base)
 {
   tagOpen(tag, "", NONEWLINE);
-  print(value, base);
+  _writeNumber(value, base);
   tagClose(NOINDENT);
 }
 
@@ -295,7 +314,7 @@ void XMLWriter::writeNode(const char* tag, const int value, const int base)
 void XMLWriter::writeNode(const char* tag, const int32_t value, const uint8_t base)
 {
   tagOpen(tag, "", NONEWLINE);
-  print(value, base);
+  _writeNumber(value, base);
   tagClose(NOINDENT);
 }
 
@@ -309,10 +328,16 @@ void XMLWriter::writeNode(const char* tag, const bool value)
 }
 
 
+void XMLWriter::writeNode(const char* tag, const float value, const uint8_t decimals)
+{
+  writeNode(tag, (double) value, decimals);
+}
+
+
 void XMLWriter::writeNode(const char* tag, const double value, const uint8_t decimals)
 {
   tagOpen(tag, "", NONEWLINE);
-  print(value, decimals);
+  _writeFloat(value, decimals);
   tagClose(NOINDENT);
 }
 
@@ -321,21 +346,55 @@ void XMLWriter::indent()
 {
   if (_config & XMLWRITER_INDENT)
   {
-    //  as indentation is a multiple of 2
-    //  this is nice balance between speed and RAM.
-    for (uint8_t i = _indent; i > 0; i-= 2) print("  ");
+    //  16 spaces per bulk write is nice balance between speed and RAM.
+    static const char spaces[] = "                ";
+    uint8_t n = _indent;
+    while (n > 16)
+    {
+      write((const uint8_t *) spaces, 16);
+      n -= 16;
+    }
+    write((const uint8_t *) spaces, n);
   }
 }
 
 
 size_t XMLWriter::write(uint8_t c)
 {
+  if (_bufferSize == 0)
+  {
+    _bytesOut++;
+    return _stream->write(c);
+  }
   _buffer[_bufferIndex++] = c;
   if (_bufferIndex == (_bufferSize - 1)) flush();
   return 1;
 };
 
 
+size_t XMLWriter::write(const uint8_t * buffer, size_t size)
+{
+  if (_bufferSize == 0)
+  {
+    _bytesOut += size;
+    return _stream->write(buffer, size);
+  }
+  //  copy in blocks, the stream always gets full buffers.
+  size_t n = size;
+  while (n > 0)
+  {
+    size_t room = _bufferSize - 1 - _bufferIndex;
+    if (room > n) room = n;
+    memcpy(_buffer + _bufferIndex, buffer, room);
+    _bufferIndex += room;
+    buffer += room;
+    n -= room;
+    if (_bufferIndex == (_bufferSize - 1)) flush();
+  }
+  return size;
+}
+
+
 void XMLWriter::flush()
 {
   _bytesOut += _bufferIndex;
@@ -349,13 +408,128 @@ void XMLWriter::flush()
 };
 
 
+////////////////////////////////////////////////////////////////////
+//
+//  NUMBERS
+//
+void XMLWriter::_writeNumber(uint32_t value, uint8_t base, bool negative)
+{
+  //  same as Print, base 0 writes a byte.
+  if (base == 0)
+  {
+    write((uint8_t) value);
+    return;
+  }
+  if (base == 1) base = 10;
+
+  char buf[34];
+  char * end = &buf[sizeof(buf)];
+  char * p = end;
+  if (base == 10)
+  {
+    //  constant divisor, compiles to multiplications on most platforms.
+    do
+    {
+      *--p = '0' + (value % 10);
+      value /= 10;
+    }
+    while (value != 0);
+  }
+  else
+  {
+    do
+    {
+      uint8_t digit = value % base;
+      *--p = (digit < 10) ? '0' + digit : 'A' + digit - 10;
+      value /= base;
+    }
+    while (value != 0);
+  }
+  if (negative) *--p = '-';
+  write((const uint8_t *) p, end - p);
+}
+
+
+void XMLWriter::_writeNumber(int32_t value, uint8_t base)
+{
+  //  same as Print, only base 10 has a sign.
+  if ((base == 10) && (value < 0))
+  {
+    _writeNumber((uint32_t)0 - (uint32_t)value, 10, true);
+  }
+  else
+  {
+    _writeNumber((uint32_t)value, base);
+  }
+}
+
+
+void XMLWriter::_writeFloat(double number, uint8_t digits)
+{
+  //  algorithm of Print::printFloat()
+  if (isnan(number))
+  {
+    print("nan");
+    return;
+  }
+  if (isinf(number))
+  {
+    print("inf");
+    return;
+  }
+  if ((number > 4294967040.0) || (number < -4294967040.0))
+  {
+    print("ovf");
+    return;
+  }
+
+  bool negative = number < 0.0;
+  if (negative) number = -number;
+
+  double rounding = 0.5;
+  for (uint8_t i = 0; i < digits; i++) rounding /= 10.0;
+  number += rounding;
+
+  uint32_t intPart = (uint32_t) number;
+  double remainder = number - (double) intPart;
+  _writeNumber(intPart, 10, negative);
+  if (digits == 0) return;
+
+  char buf[16];
+  uint8_t i = 0;
+  buf[i++] = '.';
+  while (digits-- > 0)
+  {
+    remainder *= 10.0;
+    uint8_t digit = (uint8_t) remainder;
+    buf[i++] = '0' + digit;
+    remainder -= digit;
+    if (i == sizeof(buf))
+    {
+      write((const uint8_t *) buf, i);
+      i = 0;
+    }
+  }
+  write((const uint8_t *) buf, i);
+}
+
+
 ////////////////////////////////////////////////////////////////////
 //
 //  ESCAPE
 //
 
 #ifdef XMLWRITER_ESCAPE_SUPPORT
-static char c[6] = "\"\'<>&";
+
+//  all special chars are in 32..63
+//  escapeIndex[c - 32] = index + 1 in expanded[], 0 = no escape.
+static const uint8_t escapeIndex[32] =
+{
+  0, 0, 1, 0, 0, 0, 5, 2,    //  "  &  '
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 3, 0, 4, 0     //  <  >
+};
 
 #ifdef __PROGMEM__
 PROGMEM const char quote[] = "&quot;";
@@ -377,28 +551,30 @@ static char expanded[][5] = { "quot", "apos","lt","gt","amp"};
 
 void XMLWriter::escape(const char* str)
 {
-  char* p = (char *)str;
+  //  write runs of normal chars in one call.
+  const char* run = str;
+  const char* p = str;
   while (*p != 0)
   {
-    char* q = strchr(c, *p);
-    if (q == NULL) print(*p);
-#ifdef __PROGMEM__
-    else
+    uint8_t x = ((uint8_t) *p) - 32;
+    if ((x < 32) && (escapeIndex[x] != 0))
     {
+      if (p > run) write((const uint8_t *) run, p - run);
+      run = p + 1;
+      uint8_t idx = escapeIndex[x] - 1;
+#ifdef __PROGMEM__
       char buf[8];
-      strcpy_P(buf, (char*)pgm_read_word(&(expanded[q - c])));
+      strcpy_P(buf, (char*)pgm_read_word(&(expanded[idx])));
       print(buf);
-    }
 #else
-    else
-    {
-        print('&');
-        print(expanded[q - c]); //  uint8_t idx = q-c;
-        print(';');
-    }
+      print('&');
+      print(expanded[idx]);
+      print(';');
 #endif
+    }
     p++;
   }
+  if (p > run) write((const uint8_t *) run, p - run);
 }
 #endif
 
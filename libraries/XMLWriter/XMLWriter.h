@@ -2,7 +2,7 @@
 //
 //    FILE: XMLWriter.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.3.3
+// VERSION: 0.4.0
 //    DATE: 2013-11-06
 // PURPOSE: Arduino library for creating XML
 
@@ -10,7 +10,7 @@
 #include "Arduino.h"
 
 
-#define XMLWRITER_VERSION         (F("0.3.3"))
+#define XMLWRITER_VERSION         (F("0.4.0"))
 
 
 //  for comment()
@@ -53,7 +53,10 @@ class XMLWriter : public Print
 {
 public:
   //  default = Serial
-  XMLWriter(Print* stream = &Serial, uint8_t bufferSize = 10);
+  //  bufferSize >= 2, flushes when bufferSize - 1 bytes are buffered.
+  XMLWriter(Print* stream = &Serial, size_t bufferSize = 10);
+  //  caller provided (static) buffer, no allocation, not freed.
+  XMLWriter(Print* stream, char * buffer, size_t bufferSize);
   ~XMLWriter();
 
   void reset();
@@ -149,15 +152,28 @@ public:
   void  flush();
 
 
+  //  Print interface, the bulk write copies blocks into the buffer
+  //  so print(const char *) does not go through write(uint8_t).
+  using    Print::write;
+  size_t   write(uint8_t c);
+  size_t   write(const uint8_t * buffer, size_t size);
+
+
   //  metrics
-  uint8_t  bufferIndex()  { return _bufferIndex; };
+  size_t   bufferIndex()  { return _bufferIndex; };
+  size_t   bufferSize()   { return _bufferSize; };
   uint32_t bytesWritten() { return _bytesOut; };
 
 
 private:
   //  output stream, Print Class
   Print*   _stream;
-  size_t   write(uint8_t c);
+
+  //  format numbers in a local buffer, one bulk write.
+  void     _writeNumber(uint32_t value, uint8_t base, bool negative = false);
+  void     _writeNumber(int32_t value, uint8_t base);
+  //  same output as Print::print(double, decimals)
+  void     _writeFloat(double value, uint8_t decimals);
 
   //  for indentation
   uint8_t  _indent;
@@ -173,8 +189,9 @@ private:
 
   //  output admin
   char *   _buffer;
-  uint8_t  _bufferSize;
-  uint8_t  _bufferIndex;
+  size_t   _bufferSize;
+  size_t   _bufferIndex;
+  bool     _ownBuffer;
   uint32_t _bytesOut;
 };
 
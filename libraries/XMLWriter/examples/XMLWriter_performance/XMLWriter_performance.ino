@@ -0,0 +1,118 @@
+//
+//    FILE: XMLWriter_performance.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: measure XMLWriter speed for documents of 1K .. 1M nodes.
+//    DATE: 2026-10-17
+//     URL: https://github.com/RobTillaart/XMLWriter
+//
+//  Output goes to a sink that only counts bytes, so the time is the
+//  time XMLWriter needs, not the time of Serial or a network client.
+
+
+#include <XMLWriter.h>
+
+
+class NullPrint : public Print
+{
+public:
+  uint32_t count = 0;
+  uint32_t blocks = 0;
+
+  size_t write(uint8_t c)
+  {
+    (void) c;
+    count++;
+    blocks++;
+    return 1;
+  }
+  size_t write(const uint8_t * buffer, size_t size)
+  {
+    (void) buffer;
+    count += size;
+    blocks++;
+    return size;
+  }
+};
+
+
+#if defined(ARDUINO_ARCH_AVR)
+const uint32_t MAXNODES = 10000;
+#else
+const uint32_t MAXNODES = 1000000;
+#endif
+
+//  e.g. the payload of one TCP packet
+static char packet[1460];
+
+NullPrint sink;
+
+
+//  one sensor record = 4 nodes
+void report(XMLWriter &XML, uint32_t nodes)
+{
+  XML.header();
+  XML.tagOpen("report");
+  for (uint32_t i = 0; i < nodes; i += 4)
+  {
+    XML.tagOpen("sensor");
+    XML.writeNode("id", i, (uint8_t) DEC);
+    XML.writeNode("value", i * 0.01, (uint8_t) 2);
+    XML.writeNode("unit", "m/s<2>");
+    XML.tagClose();
+  }
+  XML.tagClose();
+  XML.flush();
+}
+
+
+void measure(const char * name, XMLWriter &XML, uint32_t nodes)
+{
+  sink.count = 0;
+  sink.blocks = 0;
+  uint32_t start = millis();
+  report(XML, nodes);
+  uint32_t duration = millis() - start;
+  Serial.print(name);
+  Serial.print("\t");
+  Serial.print(nodes);
+  Serial.print("\t");
+  Serial.print(sink.count);
+  Serial.print("\t");
+  Serial.print(sink.blocks);
+  Serial.print("\t");
+  Serial.println(duration);
+}
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("XMLWRITER_VERSION: ");
+  Serial.println(XMLWRITER_VERSION);
+  Serial.println();
+
+  Serial.println("buffer\tnodes\tbytes\tblocks\tms");
+  for (uint32_t nodes = 1000; nodes <= MAXNODES; nodes *= 10)
+  {
+    XMLWriter XML10(&sink);
+    measure("10", XML10, nodes);
+
+    XMLWriter XML250(&sink, 250);
+    measure("250", XML250, nodes);
+
+    XMLWriter XMLpacket(&sink, packet, sizeof(packet));
+    measure("1460", XMLpacket, nodes);
+    Serial.println();
+  }
+
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+// -- END OF FILE --
@@ -112,7 +112,7 @@ unittest(test_indent)
   XML.setIndentSize(2);
   XML.indent();
   assertEqual(0, XML.bytesWritten());
-  fprintf(stderr, "%d\n", XML.bufferIndex());
+  fprintf(stderr, "%u\n", (unsigned) XML.bufferIndex());
   assertEqual(0, XML.bufferIndex());
   
   XML.reset();
@@ -120,7 +120,7 @@ unittest(test_indent)
   XML.incrIndent();
   XML.indent();
   assertEqual(0, XML.bytesWritten());
-  fprintf(stderr, "%d\n", XML.bufferIndex());
+  fprintf(stderr, "%u\n", (unsigned) XML.bufferIndex());
   assertEqual(2, XML.bufferIndex());
   
   XML.reset();
@@ -129,7 +129,7 @@ unittest(test_indent)
   XML.decrIndent();
   XML.indent();
   assertEqual(0, XML.bytesWritten());
-  fprintf(stderr, "%d\n", XML.bufferIndex());
+  fprintf(stderr, "%u\n", (unsigned) XML.bufferIndex());
   assertEqual(0, XML.bufferIndex());
 }
 
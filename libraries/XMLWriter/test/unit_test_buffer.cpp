@@ -0,0 +1,212 @@
+//
+//    FILE: unit_test_buffer.cpp
+//  AUTHOR: Rob Tillaart
+//    DATE: 2026-10-17
+// PURPOSE: unit tests for the XMLWriter buffers and formatting
+//          https://github.com/RobTillaart/XMLWriter
+//          https://github.com/Arduino-CI/arduino_ci/blob/master/REFERENCE.md
+//
+
+// supported assertions
+// ----------------------------
+// assertEqual(expected, actual);               // a == b
+// assertNotEqual(unwanted, actual);            // a != b
+// assertComparativeEquivalent(expected, actual);    // abs(a - b) == 0 or (!(a > b) && !(a < b))
+// assertComparativeNotEquivalent(unwanted, actual); // abs(a - b) > 0  or ((a > b) || (a < b))
+// assertLess(upperBound, actual);              // a < b
+// assertMore(lowerBound, actual);              // a > b
+// assertLessOrEqual(upperBound, actual);       // a <= b
+// assertMoreOrEqual(lowerBound, actual);       // a >= b
+// assertTrue(actual);
+// assertFalse(actual);
+// assertNull(actual);
+
+// // special cases for floats
+// assertEqualFloat(expected, actual, epsilon);    // fabs(a - b) <= epsilon
+// assertNotEqualFloat(unwanted, actual, epsilon); // fabs(a - b) >= epsilon
+// assertInfinity(actual);                         // isinf(a)
+// assertNotInfinity(actual);                      // !isinf(a)
+// assertNAN(arg);                                 // isnan(a)
+// assertNotNAN(arg);                              // !isnan(a)
+
+#include <ArduinoUnitTests.h>
+
+#include "Arduino.h"
+#include "XMLWriter.h"
+
+
+
+
+//  captures the output and the largest block written
+class Capture : public Print
+{
+public:
+  char   buf[2048];
+  size_t len = 0;
+  size_t maxBlock = 0;
+  size_t calls = 0;
+
+  size_t write(uint8_t c)
+  {
+    return write(&c, 1);
+  }
+  size_t write(const uint8_t * b, size_t n)
+  {
+    if (len + n >= sizeof(buf)) return 0;
+    memcpy(buf + len, b, n);
+    len += n;
+    buf[len] = 0;
+    if (n > maxBlock) maxBlock = n;
+    calls++;
+    return n;
+  }
+  void clear() { len = 0; buf[0] = 0; maxBlock = 0; calls = 0; }
+};
+
+
+void document(XMLWriter &XML)
+{
+  XML.header();
+  XML.tagOpen("report");
+  XML.writeNode("int", (int32_t) -123, DEC);
+  XML.writeNode("hex", (uint32_t) 0xBEEF, (uint8_t) HEX);
+  XML.writeNode("max", (uint32_t) 4294967295UL);
+  XML.writeNode("float", 3.14159, (uint8_t) 3);
+  XML.writeNode("neg", -0.5, (uint8_t) 2);
+  XML.writeNode("text", "a<b & 'c' > \"d\"");
+  XML.tagStart("field");
+  XML.tagField("bin", (uint8_t) 5, (uint8_t) BIN);
+  XML.tagField("f", 2.5f, (uint8_t) 1);
+  XML.tagEnd();
+  XML.tagClose();
+  XML.flush();
+}
+
+
+const char * expected =
+  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+  "<report>\n"
+  "  <int>-123</int>\n"
+  "  <hex>BEEF</hex>\n"
+  "  <max>4294967295</max>\n"
+  "  <float>3.142</float>\n"
+  "  <neg>-0.50</neg>\n"
+  "  <text>a&lt;b &amp; &apos;c&apos; &gt; &quot;d&quot;</text>\n"
+  "  <field bin=\"101\" f=\"2.5\"/>\n"
+  "</report>\n";
+
+
+unittest_setup()
+{
+  fprintf(stderr, "XMLWRITER_VERSION: %s\n", (char *) XMLWRITER_VERSION);
+}
+
+unittest_teardown()
+{
+}
+
+
+unittest(test_buffer_sizes)
+{
+  Capture out;
+  size_t sizes[] = { 2, 10, 64, 250, 1000 };
+  for (uint8_t i = 0; i < 5; i++)
+  {
+    out.clear();
+    XMLWriter XML(&out, sizes[i]);
+    assertEqual(sizes[i], XML.bufferSize());
+    document(XML);
+    assertEqual(0, strcmp(expected, out.buf));
+    assertEqual(strlen(expected), XML.bytesWritten());
+    assertLessOrEqual(out.maxBlock, sizes[i] - 1);
+  }
+
+  //  minimum
+  XMLWriter XML(&out, 0);
+  assertEqual(2, XML.bufferSize());
+}
+
+
+unittest(test_caller_buffer)
+{
+  Capture out;
+  static char buffer[128];
+  XMLWriter XML(&out, buffer, sizeof(buffer));
+  assertEqual(128, XML.bufferSize());
+  document(XML);
+  assertEqual(0, strcmp(expected, out.buf));
+  assertEqual(127, out.maxBlock);
+
+  //  no buffer, direct to the stream
+  out.clear();
+  XMLWriter XML2(&out, NULL, 0);
+  assertEqual(0, XML2.bufferSize());
+  document(XML2);
+  assertEqual(0, strcmp(expected, out.buf));
+  assertEqual(strlen(expected), XML2.bytesWritten());
+}
+
+
+unittest(test_bulk_write)
+{
+  Capture out;
+  XMLWriter XML(&out, 10);
+  char data[100];
+  for (int i = 0; i < 100; i++) data[i] = 'A' + (i % 26);
+
+  XML.write((const uint8_t *) data, 100);
+  assertEqual(99, XML.bytesWritten());
+  assertEqual(1, XML.bufferIndex());
+  assertEqual(11, out.calls);
+  assertEqual(9, out.maxBlock);
+  XML.flush();
+  assertEqual(100, XML.bytesWritten());
+  assertEqual(0, memcmp(data, out.buf, 100));
+
+  //  char by char gives the same state
+  out.clear();
+  XMLWriter XML2(&out, 10);
+  for (int i = 0; i < 100; i++) XML2.write((uint8_t) data[i]);
+  assertEqual(99, XML2.bytesWritten());
+  assertEqual(1, XML2.bufferIndex());
+}
+
+
+unittest(test_numbers)
+{
+  Capture out;
+  XMLWriter XML(&out, 50);
+  XML.setConfig(XMLWRITER_NONE);
+
+  XML.writeNode("a", (int32_t) -2147483647 - 1, DEC);
+  XML.writeNode("b", (int16_t) -1, (uint8_t) HEX);
+  XML.writeNode("c", (uint8_t) 0);
+  XML.writeNode("d", 0.0, (uint8_t) 0);
+  XML.writeNode("e", 1.0 / 0.0);
+  XML.writeNode("f", 0.0 / 0.0);
+  XML.writeNode("g", 5e9);
+  XML.writeNode("h", true);
+  XML.flush();
+  assertEqual(0, strcmp("<a>-2147483648</a>\n<b>FFFFFFFF</b>\n<c>0</c>\n<d>0</d>\n"
+                        "<e>inf</e>\n<f>nan</f>\n<g>ovf</g>\n<h>true</h>\n", out.buf));
+}
+
+
+unittest(test_indent)
+{
+  Capture out;
+  XMLWriter XML(&out, 50);
+  XML.setIndentSize(20);
+  XML.incrIndent();
+  XML.incrIndent();
+  XML.indent();
+  XML.flush();
+  assertEqual(40, strlen(out.buf));
+  assertEqual(40, strspn(out.buf, " "));
+}
+
+
+unittest_main()
+
+
+//  -- END OF FILE --
@@ -0,0 +1,96 @@
+//
+//    FILE: float16_test_array_bulk.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: test float16 bulk array conversion and compact float16c
+//    DATE: 2026-10-17
+//     URL: https://github.com/RobTillaart/float16
+//
+
+
+#include "float16.h"
+
+
+#if defined(__AVR__)
+const int SIZE = 100;
+#else
+const int SIZE = 1000;
+#endif
+
+float    samples[SIZE];
+float    decoded[SIZE];
+uint16_t packed[SIZE];       //  e.g. to send over serial or store in EEPROM
+float16c compact[10];        //  2 bytes each
+
+uint32_t start, stop;
+
+
+void setup()
+{
+  while (!Serial);
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("FLOAT16_LIB_VERSION: ");
+  Serial.println(FLOAT16_LIB_VERSION);
+  Serial.println();
+
+  Serial.print("sizeof(float16):  ");
+  Serial.println(sizeof(float16));
+  Serial.print("sizeof(float16c): ");
+  Serial.println(sizeof(float16c));
+  Serial.println();
+
+  //  simulated sensor values
+  for (int i = 0; i < SIZE; i++)
+  {
+    samples[i] = 20.0 + (random(10000) - 5000) * 0.001;
+  }
+
+  start = micros();
+  for (int i = 0; i < SIZE; i++) packed[i] = float16(samples[i]).getBinary();
+  stop = micros();
+  Serial.print("float16 loop encode:\t");
+  Serial.println(stop - start);
+  delay(10);
+
+  start = micros();
+  float16_encode_array(samples, packed, SIZE);
+  stop = micros();
+  Serial.print("encode_array:\t\t");
+  Serial.println(stop - start);
+  delay(10);
+
+  start = micros();
+  float16_decode_array(packed, decoded, SIZE);
+  stop = micros();
+  Serial.print("decode_array:\t\t");
+  Serial.println(stop - start);
+  delay(10);
+
+  float maxError = 0;
+  for (int i = 0; i < SIZE; i++)
+  {
+    float e = abs(samples[i] - decoded[i]);
+    if (e > maxError) maxError = e;
+  }
+  Serial.print("max abs error:\t\t");
+  Serial.println(maxError, 6);
+  Serial.println();
+
+  //  compact type converts implicitly
+  for (int i = 0; i < 10; i++) compact[i] = samples[i];
+  for (int i = 0; i < 10; i++)
+  {
+    Serial.print(samples[i], 4);
+    Serial.print("\t");
+    Serial.println((float) compact[i], 4);
+  }
+  Serial.println("\ndone...");
+}
+
+
+void loop()
+{
+}
+
+
+//  -- END OF FILE --
@@ -1,7 +1,7 @@
 //
 //    FILE: float16.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.7
+// VERSION: 0.2.0
 // PURPOSE: library for Float16s for Arduino
 //     URL: http://en.wikipedia.org/wiki/Half-precision_floating-point_format
 //
@@ -174,98 +174,146 @@ bool float16::isInf()
 //
 float float16::f16tof32(uint16_t _value) const
 {
-    uint16_t sgn, man;
-    int exp;
-    double f;
-
-    sgn = (_value & 0x8000) > 0;
-    exp = (_value & 0x7C00) >> 10;
-    man = (_value & 0x03FF);
-
-    // ZERO
-    if ((_value & 0x7FFF) == 0)
-    {
-        return sgn ? -0 : 0;
-    }
-    // NAN & INF
-    if (exp == 0x001F)
-    {
-        if (man == 0) return sgn ? -INFINITY : INFINITY;
-        else return NAN;
-    }
-
-    // SUBNORMAL/NORMAL
-    if (exp == 0)  f = 0;
-    else           f = 1;
-
-    // PROCESS MANTISSE
-    for (int i = 9; i >= 0; i--)
-    {
-        f *= 2;
-        if (man & (1 << i)) f = f + 1;
-    }
-    f = f * pow(2.0, exp - 25);
-    if (exp == 0)
-    {
-        f = f * pow(2.0, -13);    // 5.96046447754e-8;
-    }
-    return sgn ? -f : f;
+  return float16_decode(_value);
 }
 
+
 uint16_t float16::f32tof16(float f) const
 {
-    uint32_t t = *(uint32_t *) &f;
-    // man bits = 10; but we keep 11 for rounding
-    uint16_t man = (t & 0x007FFFFF) >> 12;
-    int16_t  exp = (t & 0x7F800000) >> 23;
-    bool     sgn = (t & 0x80000000);
-
-    // handle 0
-    if ((t & 0x7FFFFFFF) == 0)
-    {
-        return sgn ? 0x8000 : 0x0000;
-    }
-    // denormalized float32 does not fit in float16
-    if (exp == 0x00)
-    {
-        return sgn ? 0x8000 : 0x0000;
-    }
-    // handle infinity & NAN
-    if (exp == 0x00FF)
-    {
-        if (man) return 0xFE00;         //  NAN
-        return sgn ? 0xFC00 : 0x7C00;   // -INF : INF
-    }
-
-    // normal numbers
-    exp = exp - 127 + 15;
-    // overflow does not fit => INF
-    if (exp > 30)
-    {
-        return sgn ? 0xFC00 : 0x7C00;   // -INF : INF
-    }
-    //  subnormal numbers
-    if (exp < -38)
-    {
-        return sgn ? 0x8000 : 0x0000;  // -0 or 0  ?   just 0 ?
-    }
-    if (exp <= 0) // subnormal
-    {
-        man >>= (exp + 14);
-        // rounding
-        man++;
-        man >>= 1;
-        if (sgn) return 0x8000 | man;
-        return man;
-    }
-
-    // normal
-    // TODO rounding
-    exp <<= 10;
-    man++;
-    man >>= 1;
-    if (sgn) return 0x8000 | exp | man;
-    return exp | man;
+  return float16_encode(f);
+}
+
+
+//////////////////////////////////////////////////////////
+//
+// FREE FUNCTIONS
+//
+uint16_t float16_encode(float f)
+{
+  uint32_t x;
+  memcpy(&x, &f, 4);
+  uint16_t sgn = (x >> 16) & 0x8000;
+  x &= 0x7FFFFFFF;
+
+  // NAN, force quiet bit
+  if (x > 0x7F800000) return sgn | 0x7E00 | ((x >> 13) & 0x03FF);
+  // >= 65536 and INF
+  if (x >= 0x47800000) return sgn | 0x7C00;
+  // normal, 65520 .. 65536 rounds to INF here
+  if (x >= 0x38800000)
+  {
+    // rebias exponent (15 - 127), round to nearest even on bit 13
+    x += 0xC8000FFF + ((x >> 13) & 1);
+    return sgn | (x >> 13);
+  }
+  // <= 2^-25 rounds to zero, ties to even
+  if (x <= 0x33000000) return sgn;
+
+  // subnormal, shift 14..24
+  uint8_t  shift = 126 - (x >> 23);
+  uint32_t man   = (x & 0x007FFFFF) | 0x00800000;
+  uint32_t q     = man >> shift;
+  uint32_t rem   = man & ((1UL << shift) - 1);
+  uint32_t half  = 1UL << (shift - 1);
+  if ((rem > half) || ((rem == half) && (q & 1))) q++;
+  return sgn | q;
+}
+
+
+float float16_decode(uint16_t h)
+{
+  uint32_t x;
+  uint16_t em = h & 0x7FFF;
+  if (em >= 0x7C00)
+  {
+    // INF, NAN becomes quiet
+    x = 0x7F800000 | ((uint32_t)(em & 0x03FF) << 13);
+    if (em & 0x03FF) x |= 0x00400000;
+  }
+  else if (em >= 0x0400)
+  {
+    // normal, rebias exponent (127 - 15)
+    x = ((uint32_t)em << 13) + 0x38000000;
+  }
+  else
+  {
+    // subnormal and zero, em * 2^-24 is exact
+    float f = em * 5.9604644775390625e-8f;
+    memcpy(&x, &f, 4);
+  }
+  x |= (uint32_t)(h & 0x8000) << 16;
+  float f;
+  memcpy(&f, &x, 4);
+  return f;
+}
+
+
+//////////////////////////////////////////////////////////
+//
+// ARRAY CONVERSION
+//
+#if defined(__F16C__) && defined(__AVX__)
+#include <immintrin.h>
+#define FLOAT16_F16C
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || (defined(__ARM_FP) && (__ARM_FP & 2)))
+#include <arm_neon.h>
+#define FLOAT16_NEON
+#endif
+
+
+void float16_encode_array(const float * in, uint16_t * out, size_t n)
+{
+  size_t i = 0;
+#if defined(FLOAT16_F16C)
+  for (; i + 8 <= n; i += 8)
+  {
+    __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128((__m128i *) (out + i), h);
+  }
+#elif defined(FLOAT16_NEON)
+  for (; i + 4 <= n; i += 4)
+  {
+    float16x4_t h = vcvt_f16_f32(vld1q_f32(in + i));
+    vst1_u16(out + i, vreinterpret_u16_f16(h));
+  }
+#else
+  for (; i + 4 <= n; i += 4)
+  {
+    out[i]     = float16_encode(in[i]);
+    out[i + 1] = float16_encode(in[i + 1]);
+    out[i + 2] = float16_encode(in[i + 2]);
+    out[i + 3] = float16_encode(in[i + 3]);
+  }
+#endif
+  for (; i < n; i++) out[i] = float16_encode(in[i]);
+}
+
+
+void float16_decode_array(const uint16_t * in, float * out, size_t n)
+{
+  size_t i = 0;
+#if defined(FLOAT16_F16C)
+  for (; i + 8 <= n; i += 8)
+  {
+    __m128i h = _mm_loadu_si128((const __m128i *) (in + i));
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+  }
+#elif defined(FLOAT16_NEON)
+  for (; i + 4 <= n; i += 4)
+  {
+    float16x4_t h = vreinterpret_f16_u16(vld1_u16(in + i));
+    vst1q_f32(out + i, vcvt_f32_f16(h));
+  }
+#else
+  for (; i + 4 <= n; i += 4)
+  {
+    out[i]     = float16_decode(in[i]);
+    out[i + 1] = float16_decode(in[i + 1]);
+    out[i + 2] = float16_decode(in[i + 2]);
+    out[i + 3] = float16_decode(in[i + 3]);
+  }
+#endif
+  for (; i < n; i++) out[i] = float16_decode(in[i]);
 }
 
 
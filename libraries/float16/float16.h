@@ -2,7 +2,7 @@
 //
 //    FILE: float16.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.7
+// VERSION: 0.2.0
 // PURPOSE: Arduino library to implement float16 data type.
 //          half-precision floating point format, 
 //          used for efficient storage and transport.
@@ -12,7 +12,22 @@
 
 #include "Arduino.h"
 
-#define FLOAT16_LIB_VERSION                 (F("0.1.7"))
+#define FLOAT16_LIB_VERSION                 (F("0.2.0"))
+
+
+///////////////////////////////////////////////////////
+//
+// CORE CONVERSION
+//
+//  round to nearest even, subnormals supported,
+//  NaN keeps sign and (truncated) payload and becomes a quiet NaN.
+uint16_t float16_encode(float f);
+float    float16_decode(uint16_t h);
+
+//  bulk conversion, uses F16C (x86) or NEON fp16 (ARM) if available.
+//  same results as the single value functions.
+void     float16_encode_array(const float * in, uint16_t * out, size_t n);
+void     float16_decode_array(const uint16_t * in, float * out, size_t n);
 
 
 class float16: public Printable
@@ -77,5 +92,26 @@ class float16: public Printable
 };
 
 
+///////////////////////////////////////////////////////
+//
+// COMPACT STORAGE
+//
+//  2 bytes, no decimals, no Printable, for (large) arrays.
+//  converts implicitly from and to float.
+class float16c
+{
+  public:
+    float16c(void)                { _value = 0x0000; };
+    float16c(float f)             { _value = float16_encode(f); };
+
+    operator float() const        { return float16_decode(_value); };
+    uint16_t getBinary() const    { return _value; };
+    void     setBinary(uint16_t u) { _value = u; };
+
+  private:
+    uint16_t _value;
+};
+
+
 // -- END OF FILE --
 
@@ -170,6 +170,123 @@ unittest(test_printable)
 }
 
 
+unittest(test_decode_all)
+{
+  //  all 65536 half values against ldexp()
+  for (uint32_t h = 0; h < 65536; h++)
+  {
+    int  e   = (h >> 10) & 0x1F;
+    int  m   = h & 0x03FF;
+    bool neg = h & 0x8000;
+    float f  = float16_decode(h);
+    if (e == 31)
+    {
+      if (m == 0) assertInfinity(f);
+      else assertNAN(f);
+      continue;
+    }
+    double ref = (e == 0) ? ldexp(m, -24) : ldexp(1024 + m, e - 25);
+    if (neg) ref = -ref;
+    assertEqual((float)ref, f);
+    assertEqual(neg, signbit(f) != 0);
+  }
+}
+
+
+unittest(test_encode_rne_all)
+{
+  //  every half round trips, midpoints round to even,
+  //  one float ulp beside the midpoint rounds to the nearest.
+  for (uint32_t h = 0; h < 0x7C00; h++)
+  {
+    for (int neg = 0; neg < 2; neg++)
+    {
+      uint16_t s  = neg ? 0x8000 : 0;
+      float    lo = float16_decode(h | s);
+      assertEqual(h | s, float16_encode(lo));
+
+      //  next half up, 65504 + 32 == 65536 == INF
+      float hi  = (h == 0x7BFF) ? 65536.0 : float16_decode(h + 1);
+      if (neg) hi = -hi;
+      float mid = (lo + hi) / 2;       //  exact, 12 significant bits
+      uint16_t even = (h & 1) ? (h + 1) : h;
+      assertEqual(even | s, float16_encode(mid));
+      assertEqual(h | s, float16_encode(nextafterf(mid, lo)));
+      assertEqual((h + 1) | s, float16_encode(nextafterf(mid, hi)));
+    }
+  }
+  //  INF, NAN, float subnormal
+  assertEqual(0x7C00, float16_encode(INFINITY));
+  assertEqual(0xFC00, float16_encode(-INFINITY));
+  assertEqual(0x7E00, float16_encode(NAN) & 0x7E00);
+  assertEqual(0x0000, float16_encode(1e-40));
+  assertEqual(0x8000, float16_encode(-1e-40));
+  //  NAN round trip keeps payload
+  for (uint16_t m = 0x0200; m < 0x0400; m += 0x11)
+  {
+    assertEqual(0x7C00 | m, float16_encode(float16_decode(0x7C00 | m)));
+  }
+}
+
+
+unittest(test_array)
+{
+  //  odd size to test the tail
+  const int SIZE = 1001;
+  float    f[SIZE], g[SIZE];
+  uint16_t h[SIZE], k[SIZE];
+
+  //  all halves in blocks, encode(decode) must be identity
+  for (uint32_t base = 0; base < 65536; base += SIZE)
+  {
+    int n = (65536 - base < SIZE) ? 65536 - base : SIZE;
+    for (int i = 0; i < n; i++) h[i] = base + i;
+    float16_decode_array(h, f, n);
+    float16_encode_array(f, k, n);
+    for (int i = 0; i < n; i++)
+    {
+      float r = float16_decode(h[i]);
+      if (isnan(r))
+      {
+        assertNAN(f[i]);
+        assertEqual(h[i] | 0x0200, k[i]);     //  quiet NAN
+      }
+      else
+      {
+        assertEqual(r, f[i]);
+        assertEqual(h[i], k[i]);
+      }
+    }
+  }
+
+  //  arbitrary floats, array == single
+  uint32_t seed = 42;
+  for (int i = 0; i < SIZE; i++)
+  {
+    seed = seed * 1664525UL + 1013904223UL;
+    uint32_t bits = (seed & 0x8FFFFFFF) | 0x30000000;  //  ~1e-9 .. ~1e11
+    memcpy(&g[i], &bits, 4);
+  }
+  float16_encode_array(g, h, SIZE);
+  for (int i = 0; i < SIZE; i++) assertEqual(float16_encode(g[i]), h[i]);
+}
+
+
+unittest(test_float16c)
+{
+  assertEqual(2, sizeof(float16c));
+  float16c a[4] = { 1.0, -2.5, 65504, 0.1 };
+  assertEqual(8, sizeof(a));
+  assertEqual(0x3C00, a[0].getBinary());
+  assertEqual(-2.5, (float) a[1]);
+  assertEqual(65504, (float) a[2]);
+  assertEqualFloat(0.1, (float) a[3], 0.0001);
+
+  float16 b(0.1);
+  assertEqual(b.getBinary(), a[3].getBinary());
+}
+
+
 unittest_main()
 
 
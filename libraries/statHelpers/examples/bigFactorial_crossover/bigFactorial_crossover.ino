@@ -0,0 +1,89 @@
+//
+//    FILE: bigFactorial_crossover.ino
+//  AUTHOR: Rob Tillaart
+// PURPOSE: compare loop, Stirling and exact versions of bigFactorial
+//    DATE: 2026-10-17
+//     URL: https://github.com/RobTillaart/statHelpers
+//
+//  the loop version is O(n), the Stirling version O(1),
+//  the exact version needs RAM for all digits (ESP32 or larger).
+
+
+#include "statHelpers.h"
+
+
+uint32_t values[] = { 5, 10, 15, 20, 30, 50, 100, 1000, 10000, 100000, 1000000 };
+
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println(__FILE__);
+  Serial.print("STATHELPERS_LIB_VERSION: ");
+  Serial.println(STATHELPERS_LIB_VERSION);
+  Serial.println();
+
+  Serial.println("n\tloop us\tstirl.us\texact us\tloop mantissa\tstirling mantissa\trel.error bound");
+  for (uint8_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+  {
+    uint32_t n = values[i];
+    double   m1, m2;
+    uint32_t e1, e2;
+    //  repeat small n for a measurable time
+    uint16_t runs = (n < 1000) ? 100 : 1;
+
+    uint32_t start = micros();
+    for (uint16_t r = 0; r < runs; r++) bigFactorial(n, m1, e1);
+    uint32_t duration = micros() - start;
+    float t1 = duration * 1.0 / runs;
+
+    start = micros();
+    double rel = 0;
+    for (uint16_t r = 0; r < runs; r++) rel = bigFactorialStirling(n, m2, e2);
+    duration = micros() - start;
+    float t2 = duration * 1.0 / runs;
+
+    Serial.print(n);
+    Serial.print("\t");
+    Serial.print(t1, 2);
+    Serial.print("\t");
+    Serial.print(t2, 2);
+    Serial.print("\t\t");
+
+    //  exact, digits = exponent + 1
+    char * buffer = NULL;
+    if (n <= 10000) buffer = (char *) malloc(e2 + 2);
+    if (buffer != NULL)
+    {
+      start = micros();
+      bigFactorialExact(n, buffer, e2 + 2);
+      duration = micros() - start;
+      Serial.print(duration);
+      free(buffer);
+    }
+    else
+    {
+      Serial.print("-");
+    }
+    Serial.print("\t\t");
+    Serial.print(m1, 10);
+    Serial.print("e");
+    Serial.print(e1);
+    Serial.print("\t");
+    Serial.print(m2, 10);
+    Serial.print("e");
+    Serial.print(e2);
+    Serial.print("\t");
+    Serial.println(rel, 15);
+  }
+
+  Serial.println("\nDone...");
+}
+
+
+void loop()
+{
+}
+
+
+//  -- END OF FILE --
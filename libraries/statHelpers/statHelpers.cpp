@@ -1,13 +1,14 @@
 //
 //    FILE: statHelpers.cpp
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.6
+// VERSION: 0.2.0
 // PURPOSE: Arduino library with a number of statistic helper functions.
 //    DATE: 2020-07-01
 //     URL: https://github.com/RobTillaart/statHelpers
 
 
 #include "statHelpers.h"
+#include <float.h>
 
 
 ///////////////////////////////////////////////////////////////////////////
@@ -449,6 +450,7 @@ void bigPermutations(uint32_t n, uint32_t k, double &mantissa, uint32_t &exponen
 void bigCombinations(uint32_t n, uint32_t k, double &mantissa, uint32_t &exponent)
 {
   exponent = 0;
+  mantissa = 1;
   if ((k == 0) || (k == n)) return;
   if (k < (n-k)) k = n - k;     //  symmetry
 
@@ -524,6 +526,7 @@ void bigPermutations64(uint64_t n, uint64_t k, double &mantissa, uint64_t &expon
 void bigCombinations64(uint64_t n, uint64_t k, double &mantissa, uint64_t &exponent)
 {
   exponent = 0;
+  mantissa = 1;
   if ((k == 0) || (k == n)) return;
   if (k < (n-k)) k = n - k; // symmetry
 
@@ -548,5 +551,389 @@ void bigCombinations64(uint64_t n, uint64_t k, double &mantissa, uint64_t &expon
 }
 
 
+////////////////////////////////////////////////////////////
+//
+//  STIRLING / LOG GAMMA
+//
+//  log10(n!) with absolute error bound err.
+static double _log10Factorial(double n, double &err)
+{
+  const double eps = DBL_EPSILON;
+  if (n < 20)
+  {
+    double f = 1;
+    for (uint8_t i = 2; i <= n; i++) f *= i;
+    err = 20 * eps;
+    return log10(f);
+  }
+  //  ln(n!) = (n + 1/2) ln(n) - n + ln(2 pi)/2
+  //           + 1/12n - 1/360n^3 + 1/1260n^5 - 1/1680n^7
+  //  truncation error < 1/1188n^9
+  double lnn  = log(n);
+  double a    = (n + 0.5) * lnn;
+  double inv  = 1.0 / n;
+  double inv2 = inv * inv;
+  double ln   = a - n + 0.91893853320467274178;
+  ln += inv * (1.0/12 - inv2 * (1.0/360 - inv2 * (1.0/1260 - inv2 * (1.0/1680))));
+  double trunc = inv * inv2 * inv2 * inv2 * inv2 / 1188;
+  err = (4 * eps * (a + n) + trunc) / M_LN10;
+  return ln / M_LN10;
+}
+
+
+//  log10 of n * (n-1) * ... * (n-k+1) / (1 * 2 * ... * div)
+//  for a small number of terms k.
+//  powers of 2 are split off exactly, so only the final log10,
+//  the scaling by log10(2) and the sum round relative to L.
+//  The factors are computed in uint64_t, a double loop counter
+//  stalls or skips the loop above 2^53.
+static double _log10Product(uint64_t n, uint64_t k, uint64_t div, double &err)
+{
+  double f = 1;
+  int32_t exp2 = 0;
+  for (uint64_t j = 0; j < k; j++)
+  {
+    f *= (double)(n - j);
+    if (div >= 1) f /= div--;
+    if (f > 1e9)
+    {
+      int e;
+      f = frexp(f, &e);
+      exp2 += e;
+    }
+  }
+  double L = log10(f) + exp2 * 0.30102999566398119521;
+  err = (k + 1) * 2 * DBL_EPSILON + 2 * DBL_EPSILON * fabs(L);
+  //  factors above 2^53 (2^24 for 4 byte double) are rounded
+  //  when converted to double, half an ulp each.
+  if ((double)n >= 2 / DBL_EPSILON) err += k * DBL_EPSILON;
+  return L;
+}
+
+
+#define STATHELPERS_STIRLING_LOOP     64
+
+
+static double _log10Permutations(uint64_t n, uint64_t k, double &err)
+{
+  if (k <= STATHELPERS_STIRLING_LOOP) return _log10Product(n, k, 0, err);
+  double e1, e2;
+  double L = _log10Factorial(n, e1) - _log10Factorial(n - k, e2);
+  err = e1 + e2;
+  return L;
+}
+
+
+static double _log10Combinations(uint64_t n, uint64_t k, double &err)
+{
+  if (k > n - k) k = n - k;     //  symmetry
+  if (k <= STATHELPERS_STIRLING_LOOP) return _log10Product(n, k, k, err);
+  double e1, e2, e3;
+  double L = _log10Factorial(n, e1) - _log10Factorial(k, e2) - _log10Factorial(n - k, e3);
+  err = e1 + e2 + e3;
+  return L;
+}
+
+
+//  split log10 value into mantissa and exponent, returns relative error.
+static double _splitLog10(double L, double err, double &mantissa, double &exponent)
+{
+  if (L < 0) L = 0;
+  exponent = floor(L);
+  mantissa = pow(10, L - exponent);
+  //  rounding may give 10.0000
+  if (mantissa >= 10)
+  {
+    mantissa /= 10;
+    exponent += 1;
+  }
+  //  L itself is rounded and pow() adds about 1 ulp.
+  return M_LN10 * (err + fabs(L) * DBL_EPSILON) + 2 * DBL_EPSILON;
+}
+
+
+static double _toExponent32(double L, double err, double &mantissa, uint32_t &exponent)
+{
+  double e;
+  double rel = _splitLog10(L, err, mantissa, e);
+  if (e > 4294967295.0)
+  {
+    mantissa = 0;
+    exponent = 0;
+    return -1;
+  }
+  exponent = e;
+  return rel;
+}
+
+
+static double _toExponent64(double L, double err, double &mantissa, uint64_t &exponent)
+{
+  double e;
+  double rel = _splitLog10(L, err, mantissa, e);
+  exponent = e;
+  return rel;
+}
+
+
+double bigFactorialStirling(uint32_t n, double &mantissa, uint32_t &exponent)
+{
+  double err;
+  double L = _log10Factorial(n, err);
+  return _toExponent32(L, err, mantissa, exponent);
+}
+
+
+double bigPermutationsStirling(uint32_t n, uint32_t k, double &mantissa, uint32_t &exponent)
+{
+  if (k > n) k = n;
+  double err;
+  double L = _log10Permutations(n, k, err);
+  return _toExponent32(L, err, mantissa, exponent);
+}
+
+
+double bigCombinationsStirling(uint32_t n, uint32_t k, double &mantissa, uint32_t &exponent)
+{
+  if (k > n) k = n;
+  double err;
+  double L = _log10Combinations(n, k, err);
+  return _toExponent32(L, err, mantissa, exponent);
+}
+
+
+double bigFactorialStirling64(uint64_t n, double &mantissa, uint64_t &exponent)
+{
+  double err;
+  double L = _log10Factorial(n, err);
+  return _toExponent64(L, err, mantissa, exponent);
+}
+
+
+double bigPermutationsStirling64(uint64_t n, uint64_t k, double &mantissa, uint64_t &exponent)
+{
+  if (k > n) k = n;
+  double err;
+  double L = _log10Permutations(n, k, err);
+  return _toExponent64(L, err, mantissa, exponent);
+}
+
+
+double bigCombinationsStirling64(uint64_t n, uint64_t k, double &mantissa, uint64_t &exponent)
+{
+  if (k > n) k = n;
+  double err;
+  double L = _log10Combinations(n, k, err);
+  return _toExponent64(L, err, mantissa, exponent);
+}
+
+
+////////////////////////////////////////////////////////////
+//
+//  EXACT
+//
+//  numbers are arrays of base 1e9 limbs, least significant first,
+//  so the decimal conversion is trivial.
+#define STATHELPERS_BASE              1000000000UL
+#define STATHELPERS_LEAF              16
+
+
+//  r[0..len) *= m, m < 2^32, r has room for len + 2 limbs.
+static void _bigMulSmall(uint32_t * r, uint32_t &len, uint32_t m)
+{
+  uint64_t carry = 0;
+  for (uint32_t i = 0; i < len; i++)
+  {
+    uint64_t t = (uint64_t)r[i] * m + carry;
+    r[i]  = t % STATHELPERS_BASE;
+    carry = t / STATHELPERS_BASE;
+  }
+  while (carry > 0)
+  {
+    r[len++] = carry % STATHELPERS_BASE;
+    carry /= STATHELPERS_BASE;
+  }
+}
+
+
+//  schoolbook multiplication, returns new array or NULL.
+static uint32_t * _bigMul(const uint32_t * a, uint32_t la, const uint32_t * b, uint32_t lb, uint32_t &len)
+{
+  len = la + lb;
+  uint32_t * r = (uint32_t *) calloc(len, sizeof(uint32_t));
+  if (r == NULL) return NULL;
+  for (uint32_t i = 0; i < la; i++)
+  {
+    uint64_t ai = a[i];
+    if (ai == 0) continue;
+    uint64_t carry = 0;
+    for (uint32_t j = 0; j < lb; j++)
+    {
+      uint64_t t = r[i + j] + ai * b[j] + carry;
+      r[i + j] = t % STATHELPERS_BASE;
+      carry    = t / STATHELPERS_BASE;
+    }
+    r[i + lb] = carry;
+  }
+  while ((len > 1) && (r[len - 1] == 0)) len--;
+  return r;
+}
+
+
+//  product tree of factors[lo..hi) or of the integers lo..hi-1 if factors == NULL.
+//  balanced halves keep the multiplications of equal size.
+static uint32_t * _bigProduct(const uint32_t * factors, uint32_t lo, uint32_t hi, uint32_t &len)
+{
+  if (hi - lo <= STATHELPERS_LEAF)
+  {
+    //  every factor < 2^32 adds at most 2 limbs.
+    uint32_t * r = (uint32_t *) malloc((2 * (hi - lo) + 2) * sizeof(uint32_t));
+    if (r == NULL) return NULL;
+    r[0] = 1;
+    len  = 1;
+    for (uint32_t i = lo; i < hi; i++)
+    {
+      _bigMulSmall(r, len, factors ? factors[i] : i);
+    }
+    return r;
+  }
+  uint32_t mid = lo + (hi - lo) / 2;
+  uint32_t la, lb;
+  uint32_t * a = _bigProduct(factors, lo, mid, la);
+  if (a == NULL) return NULL;
+  uint32_t * b = _bigProduct(factors, mid, hi, lb);
+  if (b == NULL)
+  {
+    free(a);
+    return NULL;
+  }
+  uint32_t * r = _bigMul(a, la, b, lb, len);
+  free(a);
+  free(b);
+  return r;
+}
+
+
+//  writes the decimal digits, frees the number.
+static uint32_t _bigToString(uint32_t * r, uint32_t len, char * buffer, uint32_t size)
+{
+  if (r == NULL) return 0;
+  uint32_t top = r[len - 1];
+  uint8_t topDigits = 1;
+  for (uint32_t t = top; t >= 10; t /= 10) topDigits++;
+  uint32_t digits = topDigits + 9 * (len - 1);
+  if (digits + 1 > size)
+  {
+    free(r);
+    return 0;
+  }
+  char * p = buffer + digits;
+  *p = '\0';
+  for (uint32_t i = 0; i < len - 1; i++)
+  {
+    uint32_t v = r[i];
+    for (uint8_t d = 0; d < 9; d++)
+    {
+      *--p = '0' + v % 10;
+      v /= 10;
+    }
+  }
+  for (uint8_t d = 0; d < topDigits; d++)
+  {
+    *--p = '0' + top % 10;
+    top /= 10;
+  }
+  free(r);
+  return digits;
+}
+
+
+uint32_t bigFactorialExact(uint32_t n, char * buffer, uint32_t size)
+{
+  uint32_t len;
+  if (n < 2) n = 1;
+  uint32_t * r = _bigProduct(NULL, 2, n + 1, len);
+  return _bigToString(r, len, buffer, size);
+}
+
+
+uint32_t bigPermutationsExact(uint32_t n, uint32_t k, char * buffer, uint32_t size)
+{
+  uint32_t len;
+  if (k > n) k = n;
+  uint32_t * r = _bigProduct(NULL, n - k + 1, n + 1, len);
+  return _bigToString(r, len, buffer, size);
+}
+
+
+//  exponent of prime p in C(n, k), Legendre / Kummer.
+static uint32_t _primeExponent(uint32_t n, uint32_t k, uint32_t p)
+{
+  uint32_t e = 0;
+  uint64_t pp = p;
+  while (pp <= n)
+  {
+    e += n / pp - k / pp - (n - k) / pp;
+    pp *= p;
+  }
+  return e;
+}
+
+
+//  packs the prime factors of C(n, k) in words < 2^32,
+//  returns number of words, only counts if factors == NULL.
+static uint32_t _packPrimes(const uint8_t * composite, uint32_t n, uint32_t k, uint32_t * factors)
+{
+  uint32_t count = 0;
+  uint64_t acc = 1;
+  for (uint32_t p = 2; p <= n; p++)
+  {
+    if (composite[p]) continue;
+    uint32_t e = _primeExponent(n, k, p);
+    while (e--)
+    {
+      if (acc * p > 0xFFFFFFFFULL)
+      {
+        if (factors) factors[count] = acc;
+        count++;
+        acc = 1;
+      }
+      acc *= p;
+    }
+  }
+  if (factors) factors[count] = acc;
+  return count + 1;
+}
+
+
+uint32_t bigCombinationsExact(uint32_t n, uint32_t k, char * buffer, uint32_t size)
+{
+  if (k > n) k = n;
+  if (k > n - k) k = n - k;     //  symmetry
+  //  sieve of Eratosthenes
+  uint8_t * composite = (uint8_t *) calloc(n + 1, 1);
+  if (composite == NULL) return 0;
+  for (uint32_t i = 2; (uint64_t)i * i <= n; i++)
+  {
+    if (composite[i]) continue;
+    for (uint32_t j = i * i; j <= n; j += i) composite[j] = 1;
+  }
+  uint32_t count = _packPrimes(composite, n, k, NULL);
+  uint32_t * factors = (uint32_t *) malloc(count * sizeof(uint32_t));
+  if (factors == NULL)
+  {
+    free(composite);
+    return 0;
+  }
+  _packPrimes(composite, n, k, factors);
+  free(composite);
+
+  uint32_t len;
+  uint32_t * r = _bigProduct(factors, 0, count, len);
+  free(factors);
+  return _bigToString(r, len, buffer, size);
+}
+
+
 //  -- END OF FILE --
 
@@ -2,7 +2,7 @@
 //
 //    FILE: statHelpers.h
 //  AUTHOR: Rob Tillaart
-// VERSION: 0.1.6
+// VERSION: 0.2.0
 // PURPOSE: Arduino library with a number of statistic helper functions.
 //    DATE: 2020-07-01
 //     URL: https://github.com/RobTillaart/statHelpers
@@ -11,7 +11,7 @@
 #include "Arduino.h"
 
 
-#define STATHELPERS_LIB_VERSION               (F("0.1.6"))
+#define STATHELPERS_LIB_VERSION               (F("0.2.0"))
 
 
 ///////////////////////////////////////////////////////////////////////////
@@ -263,5 +263,40 @@ void bigPermutations64(uint64_t n, uint64_t k, double &mantissa, uint64_t &expon
 void bigCombinations64(uint64_t n, uint64_t k, double &mantissa, uint64_t &exponent);
 
 
+////////////////////////////////////////////////////////////
+//
+//  STIRLING / LOG GAMMA
+//
+//  constant time versions of the big functions above, based upon the
+//  Stirling series of log(n!) with 4 correction terms.
+//  returns the relative error bound of the mantissa,
+//  or -1 if the exponent does not fit.
+//  small k (or n-k for combinations) use a short product loop instead.
+//  With 8 byte doubles the mantissa has ~10 correct digits for n = 1e6,
+//  ~5 digits for n = 5e8. With 4 byte doubles (AVR) expect 1..3 digits.
+double bigFactorialStirling(uint32_t n, double &mantissa, uint32_t &exponent);
+double bigPermutationsStirling(uint32_t n, uint32_t k, double &mantissa, uint32_t &exponent);
+double bigCombinationsStirling(uint32_t n, uint32_t k, double &mantissa, uint32_t &exponent);
+
+double bigFactorialStirling64(uint64_t n, double &mantissa, uint64_t &exponent);
+double bigPermutationsStirling64(uint64_t n, uint64_t k, double &mantissa, uint64_t &exponent);
+double bigCombinationsStirling64(uint64_t n, uint64_t k, double &mantissa, uint64_t &exponent);
+
+
+////////////////////////////////////////////////////////////
+//
+//  EXACT
+//
+//  arbitrary precision, writes all decimal digits + '\0' in buffer.
+//  returns the number of digits, 0 if buffer is too small or out of memory.
+//  size needed = exponent + 2 of the Stirling version.
+//  product tree of base 1e9 limbs, combinations by prime factorization.
+//  Uses dynamic memory ~3x the size of the result, so for n in the
+//  tens of thousands a board with enough RAM (ESP32) or a host is needed.
+uint32_t bigFactorialExact(uint32_t n, char * buffer, uint32_t size);
+uint32_t bigPermutationsExact(uint32_t n, uint32_t k, char * buffer, uint32_t size);
+uint32_t bigCombinationsExact(uint32_t n, uint32_t k, char * buffer, uint32_t size);
+
+
 //  -- END OF FILE --
 
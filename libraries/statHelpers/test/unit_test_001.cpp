@@ -153,6 +153,157 @@ unittest(test_combinations)
 }
 
 
+unittest(test_stirling)
+{
+  double   m, rel;
+  uint32_t e;
+
+  rel = bigFactorialStirling(0, m, e);
+  assertEqualFloat(1.0, m, 1e-12);
+  assertEqual(0, e);
+
+  rel = bigFactorialStirling(100, m, e);
+  assertEqual(157, e);
+  assertEqualFloat(9.33262154439441, m, m * rel);
+  assertLess(rel, 1e-10);
+
+  rel = bigFactorialStirling(1000000, m, e);
+  assertEqual(5565708, e);
+  assertEqualFloat(8.26393168833124, m, m * rel);
+
+  //  largest n that fits in a 32 bit exponent
+  rel = bigFactorialStirling(518678058, m, e);
+  assertEqual(4294967292, e);
+  assertMore(rel, 0);
+  rel = bigFactorialStirling(518678059, m, e);
+  assertEqual(-1, rel);
+
+  uint64_t e64;
+  rel = bigFactorialStirling64(518678059, m, e64);
+  assertEqual(4294967301ULL, e64);
+
+  //  small k uses the product loop
+  rel = bigPermutationsStirling(1000, 3, m, e);
+  assertEqual(8, e);
+  assertEqualFloat(9.97002, m, 1e-10);
+
+  rel = bigPermutationsStirling(1000, 500, m, e);
+  assertEqual(1433, e);
+  assertEqualFloat(3.2978863640988, m, m * rel);
+
+  rel = bigCombinationsStirling(1000, 500, m, e);
+  assertEqual(299, e);
+  assertEqualFloat(2.7028824094543, m, m * rel);
+
+  rel = bigCombinationsStirling(10, 3, m, e);
+  assertEqual(2, e);
+  assertEqualFloat(1.2, m, 1e-12);
+
+  //  64 bit, n above 2^53 is not exact as double.
+  rel = bigPermutationsStirling64(1ULL << 60, 10, m, e64);
+  assertEqual(180ULL, e64);
+  assertEqualFloat(4.14951556888099, m, m * rel);
+  assertLess(rel, 1e-12);
+  rel = bigCombinationsStirling64(1ULL << 60, 10, m, e64);
+  assertEqual(174ULL, e64);
+  assertEqualFloat(1.14349525156553, m, m * rel);
+
+  //  used to hang, i-- rounds back to i.
+  rel = bigPermutationsStirling64((1ULL << 54) + 4, 4, m, e64);
+  assertEqual(65ULL, e64);
+  assertEqualFloat(1.05312291668557, m, m * rel);
+
+  rel = bigPermutationsStirling64(0xFFFFFFFFFFFFFFFFULL, 64, m, e64);
+  assertEqual(1233ULL, e64);
+  assertEqualFloat(1.04438888141315, m, m * rel);
+  rel = bigCombinationsStirling64(0xFFFFFFFFFFFFFFFFULL, 64, m, e64);
+  assertEqual(1143ULL, e64);
+  assertEqualFloat(8.23086241759841, m, m * rel);
+}
+
+
+unittest(test_exact)
+{
+  char buffer[3000];
+
+  assertEqual(1, bigFactorialExact(0, buffer, 3000));
+  assertEqual(0, strcmp("1", buffer));
+  assertEqual(26, bigFactorialExact(25, buffer, 3000));
+  assertEqual(0, strcmp("15511210043330985984000000", buffer));
+
+  //  1000! has 2568 digits and ends with 249 zeros.
+  assertEqual(2568, bigFactorialExact(1000, buffer, 3000));
+  assertEqual(0, strncmp("402387260077093773543702", buffer, 24));
+  assertEqual('0', buffer[2567]);
+  assertEqual('0', buffer[2568 - 249]);
+  assertNotEqual('0', buffer[2568 - 250]);
+
+  //  buffer too small
+  assertEqual(0, bigFactorialExact(1000, buffer, 2568));
+
+  assertEqual(8, bigPermutationsExact(100, 4, buffer, 3000));
+  assertEqual(0, strcmp("94109400", buffer));
+
+  assertEqual(3, bigCombinationsExact(10, 3, buffer, 3000));
+  assertEqual(0, strcmp("120", buffer));
+  assertEqual(30, bigCombinationsExact(100, 50, buffer, 3000));
+  assertEqual(0, strcmp("100891344545564193334812497256", buffer));
+  assertEqual(1, bigCombinationsExact(100, 0, buffer, 3000));
+  assertEqual(0, strcmp("1", buffer));
+
+  //  exact and Stirling agree
+  double   m;
+  uint32_t e;
+  bigCombinationsStirling(1000, 300, m, e);
+  assertEqual(e + 1, bigCombinationsExact(1000, 300, buffer, 3000));
+}
+
+
+//  the relative error bound must hold against the exact engine.
+unittest(test_stirling_bound)
+{
+  char     buffer[1000];
+  double   m, rel;
+  uint32_t e;
+  uint32_t count = 0;
+  uint32_t fail  = 0;
+  double   worst = 0;
+
+  for (uint32_t n = 1; n <= 2100; n += 13)
+  {
+    for (uint32_t k = 0; k <= n && k <= 80; k++)
+    {
+      for (int comb = 0; comb < 2; comb++)
+      {
+        uint32_t digits;
+        if (comb)
+        {
+          rel = bigCombinationsStirling(n, k, m, e);
+          digits = bigCombinationsExact(n, k, buffer, 1000);
+        }
+        else
+        {
+          rel = bigPermutationsStirling(n, k, m, e);
+          digits = bigPermutationsExact(n, k, buffer, 1000);
+        }
+        //  mantissa of the exact value from its first 20 digits.
+        long double x = 0;
+        uint32_t used = digits < 20 ? digits : 20;
+        for (uint32_t i = 0; i < used; i++) x = x * 10 + (buffer[i] - '0');
+        for (uint32_t i = 1; i < used; i++) x /= 10;
+
+        double err = fabsl((m - x) / x);
+        if (err / rel > worst) worst = err / rel;
+        if ((digits != e + 1) || (err > rel)) fail++;
+        count++;
+      }
+    }
+  }
+  fprintf(stderr, "pairs: %u\tworst error / bound: %f\n", (unsigned) count, worst);
+  assertEqual(0, fail);
+}
+
+
 unittest_main()
 
 // --------